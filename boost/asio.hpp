@@ -45,7 +45,10 @@
 #include <boost/asio/error.hpp>
 #include <boost/asio/handler_alloc_hook.hpp>
 #include <boost/asio/handler_invoke_hook.hpp>
+#include <boost/asio/handler_recycling.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/io_service_pool.hpp>
+#include <boost/asio/io_service_stats.hpp>
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/address_v4.hpp>
 #include <boost/asio/ip/address_v6.hpp>
@@ -76,9 +79,11 @@
 #include <boost/asio/posix/stream_descriptor.hpp>
 #include <boost/asio/posix/stream_descriptor_service.hpp>
 #include <boost/asio/raw_socket_service.hpp>
+#include <boost/asio/reactor_control.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/read_at.hpp>
 #include <boost/asio/read_until.hpp>
+#include <boost/asio/sendfile.hpp>
 #include <boost/asio/seq_packet_socket_service.hpp>
 #include <boost/asio/serial_port.hpp>
 #include <boost/asio/serial_port_base.hpp>
@@ -88,9 +93,11 @@
 #include <boost/asio/socket_acceptor_service.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/asio/strand_control.hpp>
 #include <boost/asio/stream_socket_service.hpp>
 #include <boost/asio/streambuf.hpp>
 #include <boost/asio/time_traits.hpp>
+#include <boost/asio/timer_wheel_traits.hpp>
 #include <boost/asio/version.hpp>
 #include <boost/asio/windows/basic_handle.hpp>
 #include <boost/asio/windows/basic_random_access_handle.hpp>
@@ -102,5 +109,6 @@
 #include <boost/asio/windows/stream_handle_service.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/asio/write_at.hpp>
+#include <boost/asio/zero_copy.hpp>
 
 #endif // BOOST_ASIO_HPP
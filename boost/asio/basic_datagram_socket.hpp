@@ -878,6 +878,361 @@ public:
     this->get_service().async_receive_from(this->get_implementation(), buffers,
         sender_endpoint, flags, BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
   }
+
+#if !defined(BOOST_ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+  /// Send a batch of datagrams.
+  /**
+   * This function is used to send several datagrams with a single system
+   * call, where supported. Each buffer in the sequence holds one datagram.
+   * The function call will block until all of the datagrams have been sent
+   * or an error occurs.
+   *
+   * @param buffers The buffers containing the datagrams to be sent. At most
+   * 64 buffers are used.
+   *
+   * @param destinations A pointer to an array of endpoints, one for each
+   * datagram, to which the datagrams will be sent. May be null if the socket
+   * is connected.
+   *
+   * @returns The number of datagrams sent.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * boost::array<boost::asio::const_buffer, 2> datagrams = {{
+   *     boost::asio::buffer(data1, size1),
+   *     boost::asio::buffer(data2, size2) }};
+   * boost::asio::ip::udp::endpoint destinations[2] = { ep1, ep2 };
+   * socket.send_batch(datagrams, destinations);
+   * @endcode
+   *
+   * @note Uses sendmmsg on Linux. On other platforms the datagrams are sent
+   * one at a time. Not available when I/O completion ports are used.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().send_batch(
+        this->get_implementation(), buffers, destinations, 0, ec);
+    boost::asio::detail::throw_error(ec, "send_batch");
+    return s;
+  }
+
+  /// Send a batch of datagrams.
+  /**
+   * This function is used to send several datagrams with a single system
+   * call, where supported. Each buffer in the sequence holds one datagram.
+   * The function call will block until all of the datagrams have been sent
+   * or an error occurs.
+   *
+   * @param buffers The buffers containing the datagrams to be sent. At most
+   * 64 buffers are used.
+   *
+   * @param destinations A pointer to an array of endpoints, one for each
+   * datagram, to which the datagrams will be sent. May be null if the socket
+   * is connected.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams sent. If an error occurs this may be
+   * fewer than the number of buffers.
+   */
+  template <typename ConstBufferSequence>
+  std::size_t send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags,
+      boost::system::error_code& ec)
+  {
+    return this->get_service().send_batch(this->get_implementation(),
+        buffers, destinations, flags, ec);
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams, using as
+   * few system calls as possible. Each buffer in the sequence holds one
+   * datagram. The function call always returns immediately. The operation
+   * completes when all of the datagrams have been sent or an error occurs.
+   *
+   * @param buffers The buffers containing the datagrams to be sent. At most
+   * 64 buffers are used. Although the buffers object may be copied as
+   * necessary, ownership of the underlying memory blocks is retained by the
+   * caller, which must guarantee that they remain valid until the handler is
+   * called.
+   *
+   * @param destinations A pointer to an array of endpoints, one for each
+   * datagram, to which the datagrams will be sent. May be null if the socket
+   * is connected. Ownership of the array is retained by the caller, which
+   * must guarantee that it is valid until the handler is called.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_sent              // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   *
+   * @note Uses sendmmsg on Linux. On other platforms the datagrams are sent
+   * one at a time. Not available when I/O completion ports are used.
+   */
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    this->get_service().async_send_batch(this->get_implementation(), buffers,
+        destinations, 0, BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Start an asynchronous send of a batch of datagrams.
+  /**
+   * This function is used to asynchronously send several datagrams, using as
+   * few system calls as possible. Each buffer in the sequence holds one
+   * datagram. The function call always returns immediately. The operation
+   * completes when all of the datagrams have been sent or an error occurs.
+   *
+   * @param buffers The buffers containing the datagrams to be sent. At most
+   * 64 buffers are used. Although the buffers object may be copied as
+   * necessary, ownership of the underlying memory blocks is retained by the
+   * caller, which must guarantee that they remain valid until the handler is
+   * called.
+   *
+   * @param destinations A pointer to an array of endpoints, one for each
+   * datagram, to which the datagrams will be sent. May be null if the socket
+   * is connected. Ownership of the array is retained by the caller, which
+   * must guarantee that it is valid until the handler is called.
+   *
+   * @param flags Flags specifying how the send call is to be made.
+   *
+   * @param handler The handler to be called when the send operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_sent              // Number of datagrams sent.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename ConstBufferSequence, typename WriteHandler>
+  void async_send_batch(const ConstBufferSequence& buffers,
+      const endpoint_type* destinations, socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a WriteHandler.
+    BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+    this->get_service().async_send_batch(this->get_implementation(), buffers,
+        destinations, flags, BOOST_ASIO_MOVE_CAST(WriteHandler)(handler));
+  }
+
+  /// Receive a batch of datagrams with the endpoints of the senders.
+  /**
+   * This function is used to receive several datagrams with a single system
+   * call, where supported. Each buffer in the sequence receives one datagram.
+   * The function call will block until at least one datagram has been
+   * received or an error occurs, and then returns the datagrams that are
+   * available without blocking further.
+   *
+   * @param buffers The buffers into which the datagrams will be received. At
+   * most 64 buffers are used.
+   *
+   * @param sender_endpoints A pointer to an array of endpoints, one for each
+   * buffer, that receive the endpoints of the remote senders. May be null if
+   * the senders' endpoints are not required.
+   *
+   * @param sizes A pointer to an array, with one element for each buffer,
+   * that receives the size of each datagram.
+   *
+   * @returns The number of datagrams received, @c n. Only the first @c n
+   * elements of the sender_endpoints and sizes arrays are filled in.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   *
+   * @par Example
+   * @code
+   * char data[16][1500];
+   * boost::array<boost::asio::mutable_buffer, 16> datagrams;
+   * for (std::size_t i = 0; i < 16; ++i)
+   *   datagrams[i] = boost::asio::buffer(data[i]);
+   * boost::asio::ip::udp::endpoint senders[16];
+   * std::size_t sizes[16];
+   * std::size_t n = socket.receive_batch(datagrams, senders, sizes);
+   * @endcode
+   *
+   * @note Uses recvmmsg on Linux. On other platforms the datagrams are
+   * received one at a time. Not available when I/O completion ports are used.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes)
+  {
+    boost::system::error_code ec;
+    std::size_t s = this->get_service().receive_batch(
+        this->get_implementation(), buffers, sender_endpoints, sizes, 0, ec);
+    boost::asio::detail::throw_error(ec, "receive_batch");
+    return s;
+  }
+
+  /// Receive a batch of datagrams with the endpoints of the senders.
+  /**
+   * This function is used to receive several datagrams with a single system
+   * call, where supported. Each buffer in the sequence receives one datagram.
+   * The function call will block until at least one datagram has been
+   * received or an error occurs, and then returns the datagrams that are
+   * available without blocking further.
+   *
+   * @param buffers The buffers into which the datagrams will be received. At
+   * most 64 buffers are used.
+   *
+   * @param sender_endpoints A pointer to an array of endpoints, one for each
+   * buffer, that receive the endpoints of the remote senders. May be null if
+   * the senders' endpoints are not required.
+   *
+   * @param sizes A pointer to an array, with one element for each buffer,
+   * that receives the size of each datagram.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns The number of datagrams received.
+   */
+  template <typename MutableBufferSequence>
+  std::size_t receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    return this->get_service().receive_batch(this->get_implementation(),
+        buffers, sender_endpoints, sizes, flags, ec);
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams with a
+   * single system call, where supported. Each buffer in the sequence receives
+   * one datagram. The function call always returns immediately. The operation
+   * completes when at least one datagram has been received or an error
+   * occurs.
+   *
+   * @param buffers The buffers into which the datagrams will be received. At
+   * most 64 buffers are used. Although the buffers object may be copied as
+   * necessary, ownership of the underlying memory blocks is retained by the
+   * caller, which must guarantee that they remain valid until the handler is
+   * called.
+   *
+   * @param sender_endpoints A pointer to an array of endpoints, one for each
+   * buffer, that receive the endpoints of the remote senders. May be null if
+   * the senders' endpoints are not required. Ownership of the array is
+   * retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param sizes A pointer to an array, with one element for each buffer,
+   * that receives the size of each datagram. Ownership of the array is
+   * retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_received          // Number of datagrams
+   *                                           // received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   *
+   * @note Uses recvmmsg on Linux. On other platforms the datagrams are
+   * received one at a time. Not available when I/O completion ports are used.
+   */
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    this->get_service().async_receive_batch(this->get_implementation(),
+        buffers, sender_endpoints, sizes, 0,
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+
+  /// Start an asynchronous receive of a batch of datagrams.
+  /**
+   * This function is used to asynchronously receive several datagrams with a
+   * single system call, where supported. Each buffer in the sequence receives
+   * one datagram. The function call always returns immediately. The operation
+   * completes when at least one datagram has been received or an error
+   * occurs.
+   *
+   * @param buffers The buffers into which the datagrams will be received. At
+   * most 64 buffers are used. Although the buffers object may be copied as
+   * necessary, ownership of the underlying memory blocks is retained by the
+   * caller, which must guarantee that they remain valid until the handler is
+   * called.
+   *
+   * @param sender_endpoints A pointer to an array of endpoints, one for each
+   * buffer, that receive the endpoints of the remote senders. May be null if
+   * the senders' endpoints are not required. Ownership of the array is
+   * retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param sizes A pointer to an array, with one element for each buffer,
+   * that receives the size of each datagram. Ownership of the array is
+   * retained by the caller, which must guarantee that it is valid until the
+   * handler is called.
+   *
+   * @param flags Flags specifying how the receive call is to be made.
+   *
+   * @param handler The handler to be called when the receive operation
+   * completes. Copies will be made of the handler as required. The function
+   * signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   std::size_t datagrams_received          // Number of datagrams
+   *                                           // received.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the handler will not be invoked from within this function. Invocation
+   * of the handler will be performed in a manner equivalent to using
+   * boost::asio::io_service::post().
+   */
+  template <typename MutableBufferSequence, typename ReadHandler>
+  void async_receive_batch(const MutableBufferSequence& buffers,
+      endpoint_type* sender_endpoints, std::size_t* sizes,
+      socket_base::message_flags flags,
+      BOOST_ASIO_MOVE_ARG(ReadHandler) handler)
+  {
+    // If you get an error on the following line it means that your handler does
+    // not meet the documented type requirements for a ReadHandler.
+    BOOST_ASIO_READ_HANDLER_CHECK(ReadHandler, handler) type_check;
+
+    this->get_service().async_receive_batch(this->get_implementation(),
+        buffers, sender_endpoints, sizes, flags,
+        BOOST_ASIO_MOVE_CAST(ReadHandler)(handler));
+  }
+#endif // !defined(BOOST_ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
 };
 
 } // namespace asio
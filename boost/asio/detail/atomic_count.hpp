@@ -20,7 +20,7 @@
 #if defined(BOOST_ASIO_HAS_STD_ATOMIC)
 # include <atomic>
 #else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
-# include <boost/detail/atomic_count.hpp>
+# include <boost/atomic.hpp>
 #endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
 
 namespace boost {
@@ -29,8 +29,10 @@ namespace detail {
 
 #if defined(BOOST_ASIO_HAS_STD_ATOMIC)
 typedef std::atomic<long> atomic_count;
+inline void increment(atomic_count& a, long b) { a += b; }
 #else // defined(BOOST_ASIO_HAS_STD_ATOMIC)
-typedef boost::detail::atomic_count atomic_count;
+typedef boost::atomic<long> atomic_count;
+inline void increment(atomic_count& a, long b) { a += b; }
 #endif // defined(BOOST_ASIO_HAS_STD_ATOMIC)
 
 } // namespace detail
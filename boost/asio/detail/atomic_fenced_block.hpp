@@ -0,0 +1,52 @@
+//
+// detail/atomic_fenced_block.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_ATOMIC_FENCED_BLOCK_HPP
+#define BOOST_ASIO_DETAIL_ATOMIC_FENCED_BLOCK_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/atomic.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class atomic_fenced_block
+  : private noncopyable
+{
+public:
+  // Constructor. Makes the writes of the thread that queued the handler
+  // visible to the code in the block.
+  atomic_fenced_block()
+  {
+    boost::atomic_thread_fence(boost::memory_order_acquire);
+  }
+
+  // Destructor. Makes the writes made in the block visible to whichever
+  // thread next acquires them.
+  ~atomic_fenced_block()
+  {
+    boost::atomic_thread_fence(boost::memory_order_release);
+  }
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_ATOMIC_FENCED_BLOCK_HPP
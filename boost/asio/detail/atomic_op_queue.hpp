@@ -0,0 +1,181 @@
+//
+// detail/atomic_op_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
+#define BOOST_ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+
+#if !defined(BOOST_HAS_THREADS) || defined(BOOST_ASIO_DISABLE_THREADS)
+# define BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX 1
+#elif defined(BOOST_ASIO_HAS_STD_ATOMIC)
+# include <atomic>
+#elif defined(__GNUC__) \
+  && ((__GNUC__ == 4 && __GNUC_MINOR__ >= 1) || (__GNUC__ > 4)) \
+  && !defined(__INTEL_COMPILER) && !defined(__ICL) \
+  && !defined(__ICC) && !defined(__ECC) && !defined(__PATHSCALE__)
+# define BOOST_ASIO_ATOMIC_OP_QUEUE_USE_GCC_SYNC 1
+#else
+# define BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX 1
+#endif
+
+#if defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX)
+# include <boost/asio/detail/mutex.hpp>
+#endif // defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A multiple-producer, single-consumer queue of operations. Any number of
+// threads may push operations concurrently without taking a lock. Operations
+// are removed in batches by pop_all(), which must not be called concurrently
+// with itself. Because the consumer always takes the entire contents of the
+// queue, the implementation is immune to the ABA problem.
+template <typename Operation>
+class atomic_op_queue
+  : private noncopyable
+{
+public:
+  // Constructor.
+  atomic_op_queue()
+    : head_(0)
+  {
+  }
+
+  // Destructor destroys all operations.
+  ~atomic_op_queue()
+  {
+    op_queue<Operation> ops;
+    pop_all(ops);
+  }
+
+  // Push an operation on to the queue. Acts as a full memory barrier.
+  void push(Operation* op)
+  {
+#if defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX)
+    mutex::scoped_lock lock(mutex_);
+    op_queue_access::next(op, head_);
+    head_ = op;
+#elif defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_GCC_SYNC)
+    for (;;)
+    {
+      Operation* head = head_;
+      op_queue_access::next(op, head);
+      if (__sync_bool_compare_and_swap(&head_, head, op))
+        return;
+    }
+#else
+    Operation* head = head_.load(std::memory_order_relaxed);
+    do
+      op_queue_access::next(op, head);
+    while (!head_.compare_exchange_weak(head, op));
+#endif
+  }
+
+  // Push all operations from an op_queue on to the queue. Acts as a full
+  // memory barrier if the source queue is not empty.
+  template <typename OtherOperation>
+  void push(op_queue<OtherOperation>& q)
+  {
+    while (OtherOperation* op = q.front())
+    {
+      q.pop();
+      push(op);
+    }
+  }
+
+  // Whether the queue is empty.
+  bool empty() const
+  {
+#if defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX)
+    mutex::scoped_lock lock(mutex_);
+    return head_ == 0;
+#elif defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_GCC_SYNC)
+    return head_ == 0;
+#else
+    return head_.load(std::memory_order_acquire) == 0;
+#endif
+  }
+
+  // Remove all operations from the queue and add them to the back of the
+  // given op_queue in the order in which they were pushed.
+  void pop_all(op_queue<Operation>& ops)
+  {
+    if (empty())
+      return;
+
+#if defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX)
+    mutex::scoped_lock lock(mutex_);
+    Operation* list = head_;
+    head_ = 0;
+    lock.unlock();
+#elif defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_GCC_SYNC)
+    Operation* list = head_;
+    while (!__sync_bool_compare_and_swap(
+          &head_, list, static_cast<Operation*>(0)))
+      list = head_;
+#else
+    Operation* list = head_.exchange(static_cast<Operation*>(0));
+#endif
+
+    // Operations were pushed on to the front of the list, so reverse it to
+    // restore FIFO order.
+    Operation* reversed = 0;
+    while (list)
+    {
+      Operation* next = op_queue_access::next(list);
+      op_queue_access::next(list, reversed);
+      reversed = list;
+      list = next;
+    }
+
+    while (reversed)
+    {
+      Operation* next = op_queue_access::next(reversed);
+      ops.push(reversed);
+      reversed = next;
+    }
+  }
+
+private:
+#if defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX)
+  // Mutex to protect the head of the list.
+  mutable mutex mutex_;
+
+  // The most recently pushed operation.
+  Operation* head_;
+#elif defined(BOOST_ASIO_ATOMIC_OP_QUEUE_USE_GCC_SYNC)
+  // The most recently pushed operation.
+  Operation* volatile head_;
+#else
+  // The most recently pushed operation.
+  std::atomic<Operation*> head_;
+#endif
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#undef BOOST_ASIO_ATOMIC_OP_QUEUE_USE_MUTEX
+#undef BOOST_ASIO_ATOMIC_OP_QUEUE_USE_GCC_SYNC
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
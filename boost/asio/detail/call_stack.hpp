@@ -26,8 +26,9 @@ namespace asio {
 namespace detail {
 
 // Helper class to determine whether or not the current thread is inside an
-// invocation of io_service::run() for a specified io_service object.
-template <typename Owner>
+// invocation of io_service::run() for a specified io_service object. Each
+// entry on the stack may also carry a per-thread value for the owner.
+template <typename Owner, typename Value = unsigned char>
 class call_stack
 {
 public:
@@ -39,40 +40,62 @@ public:
     // Push the owner on to the stack.
     explicit context(Owner* d)
       : owner_(d),
-        next_(call_stack<Owner>::top_)
+        value_(reinterpret_cast<Value*>(this)),
+        next_(call_stack<Owner, Value>::top_)
     {
-      call_stack<Owner>::top_ = this;
+      call_stack<Owner, Value>::top_ = this;
+    }
+
+    // Push the owner and its associated value on to the stack.
+    context(Owner* d, Value& v)
+      : owner_(d),
+        value_(&v),
+        next_(call_stack<Owner, Value>::top_)
+    {
+      call_stack<Owner, Value>::top_ = this;
     }
 
     // Pop the owner from the stack.
     ~context()
     {
-      call_stack<Owner>::top_ = next_;
+      call_stack<Owner, Value>::top_ = next_;
     }
 
   private:
-    friend class call_stack<Owner>;
+    friend class call_stack<Owner, Value>;
 
     // The owner associated with the context.
     Owner* owner_;
 
+    // The value associated with the context.
+    Value* value_;
+
     // The next element in the stack.
     context* next_;
   };
 
   friend class context;
 
-  // Determine whether the specified owner is on the stack.
-  static bool contains(Owner* d)
+  // Determine whether the specified owner is on the stack. Returns the
+  // associated value if present, otherwise 0.
+  static Value* contains(Owner* d)
   {
     context* elem = top_;
     while (elem)
     {
       if (elem->owner_ == d)
-        return true;
+        return elem->value_;
       elem = elem->next_;
     }
-    return false;
+    return 0;
+  }
+
+  // Obtain the owner at the top of the stack for the current thread. Returns
+  // 0 if the stack is empty.
+  static Owner* top()
+  {
+    context* elem = top_;
+    return elem ? elem->owner_ : 0;
   }
 
 private:
@@ -80,9 +103,9 @@ private:
   static tss_ptr<context> top_;
 };
 
-template <typename Owner>
-tss_ptr<typename call_stack<Owner>::context>
-call_stack<Owner>::top_;
+template <typename Owner, typename Value>
+tss_ptr<typename call_stack<Owner, Value>::context>
+call_stack<Owner, Value>::top_;
 
 } // namespace detail
 } // namespace asio
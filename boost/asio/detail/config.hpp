@@ -218,7 +218,8 @@
 # endif // defined(_WIN32_WINNT) && (_WIN32_WINNT >= 0x0400)
 #endif // defined(BOOST_WINDOWS) || defined(__CYGWIN__)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd, recvmmsg/sendmmsg, sendfile and
+// MSG_ZEROCOPY.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(BOOST_ASIO_DISABLE_EPOLL)
@@ -236,6 +237,17 @@
 #   define BOOST_ASIO_HAS_TIMERFD 1
 #  endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 # endif // defined(BOOST_ASIO_HAS_EPOLL)
+# if !defined(BOOST_ASIO_DISABLE_MMSG)
+#  if (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+#   define BOOST_ASIO_HAS_MMSG 1
+#  endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 14)
+# endif // !defined(BOOST_ASIO_DISABLE_MMSG)
+# if !defined(BOOST_ASIO_DISABLE_SENDFILE)
+#  define BOOST_ASIO_HAS_SENDFILE 1
+# endif // !defined(BOOST_ASIO_DISABLE_SENDFILE)
+# if !defined(BOOST_ASIO_DISABLE_MSG_ZEROCOPY)
+#  define BOOST_ASIO_HAS_MSG_ZEROCOPY 1
+# endif // !defined(BOOST_ASIO_DISABLE_MSG_ZEROCOPY)
 #endif // defined(__linux__)
 
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
@@ -62,6 +62,28 @@ public:
   // Per-descriptor data.
   typedef descriptor_state* per_descriptor_data;
 
+  // The largest number of events that may be retrieved by one epoll_wait.
+  enum { max_event_batch_size = 1024 };
+
+  // Counters describing the work done by the reactor.
+  struct statistics
+  {
+    // The number of times the reactor has waited for events.
+    std::size_t waits;
+
+    // The number of events returned by epoll_wait.
+    std::size_t events;
+
+    // The number of waits that returned no events.
+    std::size_t empty_waits;
+
+    // The number of waits that filled the event array.
+    std::size_t full_batches;
+
+    // The number of non-blocking calls to epoll_wait made while busy-polling.
+    std::size_t busy_polls;
+  };
+
   // Constructor.
   BOOST_ASIO_DECL epoll_reactor(boost::asio::io_service& io_service);
 
@@ -149,6 +171,38 @@ public:
   // Interrupt the select loop.
   BOOST_ASIO_DECL void interrupt();
 
+  // Set the maximum number of events retrieved by each call to epoll_wait.
+  // The value is clamped to the range [1, max_event_batch_size].
+  BOOST_ASIO_DECL void event_batch_size(std::size_t n);
+
+  // Get the maximum number of events retrieved by each call to epoll_wait.
+  std::size_t event_batch_size() const
+  {
+    return event_batch_size_;
+  }
+
+  // Set the number of non-blocking calls to epoll_wait to make before
+  // blocking. A value of 0 disables busy-polling.
+  void busy_poll_count(std::size_t n)
+  {
+    busy_poll_count_ = n;
+  }
+
+  // Get the number of non-blocking calls to epoll_wait made before blocking.
+  std::size_t busy_poll_count() const
+  {
+    return busy_poll_count_;
+  }
+
+  // Get a snapshot of the reactor's counters.
+  statistics get_statistics() const
+  {
+    return statistics_;
+  }
+
+  // Reset the reactor's counters to zero.
+  BOOST_ASIO_DECL void reset_statistics();
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
@@ -206,6 +260,15 @@ private:
 
   // Keep track of all registered descriptors.
   object_pool<descriptor_state> registered_descriptors_;
+
+  // The maximum number of events retrieved by each call to epoll_wait.
+  std::size_t event_batch_size_;
+
+  // The number of non-blocking calls to epoll_wait to make before blocking.
+  std::size_t busy_poll_count_;
+
+  // The reactor's counters. Only updated by the thread running the task.
+  statistics statistics_;
 };
 
 } // namespace detail
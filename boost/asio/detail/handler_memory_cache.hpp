@@ -0,0 +1,194 @@
+//
+// detail/handler_memory_cache.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_HANDLER_MEMORY_CACHE_HPP
+#define BOOST_ASIO_DETAIL_HANDLER_MEMORY_CACHE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <new>
+#include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class handler_memory_service;
+
+// A thread-private cache of memory blocks for handler-associated objects. A
+// cache is created by each call to io_service::run(), run_one(), poll() and
+// poll_one() and is used for allocations made by the default handler
+// allocation hooks on that thread until the call returns. Blocks are kept in
+// free lists segregated by size so that no locking is needed. A block freed
+// on a different thread to the one that allocated it simply joins the cache
+// of the freeing thread. The caches are only used if
+// BOOST_ASIO_ENABLE_HANDLER_RECYCLING is defined. Otherwise the hooks call
+// operator new and operator delete directly.
+class handler_memory_cache
+  : private noncopyable
+{
+public:
+  // Counters describing the allocations made through a cache.
+  struct statistics
+  {
+    std::size_t allocations;
+    std::size_t deallocations;
+    std::size_t heap_allocations;
+    std::size_t heap_deallocations;
+  };
+
+  // The number of size classes. Class i holds blocks of min_block_size << i
+  // bytes. Larger allocations always go to the heap.
+  enum { size_classes = 5, min_block_size = 64 };
+
+  // The largest block size that is recycled.
+  enum { max_block_size = min_block_size << (size_classes - 1) };
+
+  // The maximum number of free blocks kept for each size class.
+  enum { max_free_blocks = 16 };
+
+  // Constructor installs the cache for the calling thread. The cache is only
+  // active if recycling is enabled for the service. Defined along with the
+  // service, which must be included by any code that creates a cache.
+  BOOST_ASIO_DECL explicit handler_memory_cache(
+      handler_memory_service& service);
+
+  // Destructor releases all cached memory and uninstalls the cache.
+  BOOST_ASIO_DECL ~handler_memory_cache();
+
+  // Allocate memory using the calling thread's cache, if any.
+  static void* allocate(std::size_t size)
+  {
+#if defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+    // Every block carries a trailing tag byte giving its size class, or
+    // size_classes if it is not to be recycled. Only blocks allocated while a
+    // cache is active are rounded up to the full size of their class.
+    // Untagged blocks cannot be used, since a block allocated before recycling
+    // was enabled may still be freed into a cache afterwards.
+    handler_memory_cache* cache = thread_call_stack::top();
+    if (!cache || !cache->active_)
+      return tag(::operator new(size + 1), size, size_classes);
+
+    std::size_t c = size_class(size);
+    ++cache->statistics_.allocations;
+    if (c < size_classes && cache->free_[c])
+    {
+      block* b = cache->free_[c];
+      cache->free_[c] = b->next_;
+      --cache->free_count_[c];
+      return tag(b, size, c);
+    }
+    ++cache->statistics_.heap_allocations;
+
+    if (c < size_classes)
+      return tag(::operator new(block_size(c) + 1), size, c);
+    return tag(::operator new(size + 1), size, size_classes);
+#else // defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+    return ::operator new(size);
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+  }
+
+  // Deallocate memory, returning it to the calling thread's cache if it is
+  // recyclable and there is room for it.
+  static void deallocate(void* pointer, std::size_t size)
+  {
+#if defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+    handler_memory_cache* cache = thread_call_stack::top();
+    if (cache && cache->active_)
+    {
+      ++cache->statistics_.deallocations;
+      std::size_t c = static_cast<unsigned char*>(pointer)[size];
+      if (c < size_classes && cache->free_count_[c] < max_free_blocks)
+      {
+        block* b = static_cast<block*>(pointer);
+        b->next_ = cache->free_[c];
+        cache->free_[c] = b;
+        ++cache->free_count_[c];
+        return;
+      }
+      ++cache->statistics_.heap_deallocations;
+    }
+#else // defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+    (void)size;
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+
+    ::operator delete(pointer);
+  }
+
+private:
+  friend class handler_memory_service;
+
+  // The call stack used to find the calling thread's cache.
+  typedef call_stack<handler_memory_cache> thread_call_stack;
+
+  // A free block.
+  struct block
+  {
+    block* next_;
+  };
+
+  // Record the size class of a block in the byte following the allocation.
+  static void* tag(void* pointer, std::size_t size, std::size_t c)
+  {
+    static_cast<unsigned char*>(pointer)[size] = static_cast<unsigned char>(c);
+    return pointer;
+  }
+
+  // Get the size class for an allocation, or size_classes if it is too large
+  // to be recycled.
+  static std::size_t size_class(std::size_t size)
+  {
+    std::size_t c = 0;
+    while (c < size_classes && block_size(c) < size)
+      ++c;
+    return c;
+  }
+
+  // Get the size of the blocks in a size class.
+  static std::size_t block_size(std::size_t c)
+  {
+    return static_cast<std::size_t>(min_block_size) << c;
+  }
+
+  // The service that owns the enabled flag and aggregates statistics.
+  handler_memory_service& service_;
+
+  // Whether the cache is in use.
+  bool active_;
+
+  // The free lists, one per size class.
+  block* free_[size_classes];
+  std::size_t free_count_[size_classes];
+
+  // The counters for this cache.
+  statistics statistics_;
+
+  // The caches registered with the service.
+  handler_memory_cache* next_;
+  handler_memory_cache* prev_;
+
+  // Installs the cache for the calling thread.
+  thread_call_stack::context context_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_HANDLER_MEMORY_CACHE_HPP
@@ -0,0 +1,106 @@
+//
+// detail/handler_memory_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_HANDLER_MEMORY_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_HANDLER_MEMORY_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/handler_memory_cache.hpp>
+#include <boost/asio/detail/mutex.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Controls handler memory recycling for an io_service, and keeps track of the
+// thread-private caches created by the threads running it.
+class handler_memory_service
+  : public boost::asio::detail::service_base<handler_memory_service>
+{
+public:
+  typedef handler_memory_cache::statistics statistics;
+
+  // Constructor.
+  BOOST_ASIO_DECL handler_memory_service(boost::asio::io_service& io_service);
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown_service();
+
+  // Enable or disable recycling for caches created after the call. Has no
+  // effect unless recycling support is compiled in.
+  void enabled(bool value)
+  {
+#if defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+    enabled_ = value;
+#else // defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+    (void)value;
+#endif // defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+  }
+
+  // Whether recycling is enabled.
+  bool enabled() const
+  {
+    return enabled_;
+  }
+
+  // Get the total of the counters for all caches, both current and past, since
+  // the last reset.
+  BOOST_ASIO_DECL statistics get_statistics() const;
+
+  // Reset the counters to zero.
+  BOOST_ASIO_DECL void reset_statistics();
+
+private:
+  friend class handler_memory_cache;
+
+  // Add a cache to the list of current caches.
+  BOOST_ASIO_DECL void register_cache(handler_memory_cache* cache);
+
+  // Remove a cache from the list, accumulating its counters.
+  BOOST_ASIO_DECL void unregister_cache(handler_memory_cache* cache);
+
+  // Sum the counters. The mutex must be held.
+  BOOST_ASIO_DECL statistics total() const;
+
+  // Mutex to protect access to internal data.
+  mutable mutex mutex_;
+
+  // Whether recycling is enabled. Read without locking when a cache is
+  // created, so a change may not be seen immediately by other threads.
+  bool enabled_;
+
+  // The current caches.
+  handler_memory_cache* first_cache_;
+
+  // The accumulated counters of caches that no longer exist.
+  statistics retired_;
+
+  // The totals at the time of the last reset.
+  statistics baseline_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/handler_memory_service.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_DETAIL_HANDLER_MEMORY_SERVICE_HPP
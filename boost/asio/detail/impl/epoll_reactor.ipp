@@ -42,8 +42,12 @@ epoll_reactor::epoll_reactor(boost::asio::io_service& io_service)
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
     interrupter_(),
-    shutdown_(false)
+    shutdown_(false),
+    event_batch_size_(128),
+    busy_poll_count_(0)
 {
+  reset_statistics();
+
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLET;
@@ -356,9 +360,33 @@ void epoll_reactor::run(bool block, op_queue<operation>& ops)
     timeout = block ? get_timeout() : 0;
   }
 
+  // Poll the epoll descriptor without blocking for a while before blocking,
+  // if busy-polling is enabled.
+  epoll_event events[max_event_batch_size];
+  int max_events = static_cast<int>(event_batch_size_);
+  int num_events = 0;
+  if (timeout != 0)
+  {
+    for (std::size_t i = 0; i < busy_poll_count_ && num_events == 0; ++i)
+    {
+      num_events = epoll_wait(epoll_fd_, events, max_events, 0);
+      ++statistics_.busy_polls;
+    }
+  }
+
   // Block on the epoll descriptor.
-  epoll_event events[128];
-  int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  if (num_events == 0)
+    num_events = epoll_wait(epoll_fd_, events, max_events, timeout);
+
+  ++statistics_.waits;
+  if (num_events > 0)
+  {
+    statistics_.events += num_events;
+    if (num_events == max_events)
+      ++statistics_.full_batches;
+  }
+  else
+    ++statistics_.empty_waits;
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
   bool check_timers = (timer_fd_ == -1);
@@ -442,6 +470,24 @@ void epoll_reactor::interrupt()
   epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
 }
 
+void epoll_reactor::event_batch_size(std::size_t n)
+{
+  if (n < 1)
+    n = 1;
+  if (n > max_event_batch_size)
+    n = max_event_batch_size;
+  event_batch_size_ = n;
+}
+
+void epoll_reactor::reset_statistics()
+{
+  statistics_.waits = 0;
+  statistics_.events = 0;
+  statistics_.empty_waits = 0;
+  statistics_.full_batches = 0;
+  statistics_.busy_polls = 0;
+}
+
 int epoll_reactor::do_epoll_create()
 {
 #if defined(EPOLL_CLOEXEC)
@@ -0,0 +1,146 @@
+//
+// detail/impl/handler_memory_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_HANDLER_MEMORY_SERVICE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_HANDLER_MEMORY_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/handler_memory_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+handler_memory_cache::handler_memory_cache(handler_memory_service& service)
+  : service_(service),
+    active_(service.enabled()),
+    next_(0),
+    prev_(0),
+    context_(this)
+{
+  for (std::size_t c = 0; c < size_classes; ++c)
+  {
+    free_[c] = 0;
+    free_count_[c] = 0;
+  }
+
+  statistics zero = { 0, 0, 0, 0 };
+  statistics_ = zero;
+
+  if (active_)
+    service_.register_cache(this);
+}
+
+handler_memory_cache::~handler_memory_cache()
+{
+  for (std::size_t c = 0; c < size_classes; ++c)
+  {
+    while (block* b = free_[c])
+    {
+      free_[c] = b->next_;
+      ::operator delete(b);
+      ++statistics_.heap_deallocations;
+    }
+  }
+
+  if (active_)
+    service_.unregister_cache(this);
+}
+
+handler_memory_service::handler_memory_service(
+    boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<handler_memory_service>(io_service),
+    mutex_(),
+    enabled_(false),
+    first_cache_(0)
+{
+  statistics zero = { 0, 0, 0, 0 };
+  retired_ = zero;
+  baseline_ = zero;
+}
+
+void handler_memory_service::shutdown_service()
+{
+}
+
+handler_memory_service::statistics
+handler_memory_service::get_statistics() const
+{
+  mutex::scoped_lock lock(mutex_);
+  statistics s = total();
+  s.allocations -= baseline_.allocations;
+  s.deallocations -= baseline_.deallocations;
+  s.heap_allocations -= baseline_.heap_allocations;
+  s.heap_deallocations -= baseline_.heap_deallocations;
+  return s;
+}
+
+void handler_memory_service::reset_statistics()
+{
+  mutex::scoped_lock lock(mutex_);
+  baseline_ = total();
+}
+
+void handler_memory_service::register_cache(handler_memory_cache* cache)
+{
+  mutex::scoped_lock lock(mutex_);
+  cache->next_ = first_cache_;
+  cache->prev_ = 0;
+  if (first_cache_)
+    first_cache_->prev_ = cache;
+  first_cache_ = cache;
+}
+
+void handler_memory_service::unregister_cache(handler_memory_cache* cache)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (first_cache_ == cache)
+    first_cache_ = cache->next_;
+  if (cache->prev_)
+    cache->prev_->next_ = cache->next_;
+  if (cache->next_)
+    cache->next_->prev_ = cache->prev_;
+  cache->next_ = 0;
+  cache->prev_ = 0;
+
+  retired_.allocations += cache->statistics_.allocations;
+  retired_.deallocations += cache->statistics_.deallocations;
+  retired_.heap_allocations += cache->statistics_.heap_allocations;
+  retired_.heap_deallocations += cache->statistics_.heap_deallocations;
+}
+
+handler_memory_service::statistics handler_memory_service::total() const
+{
+  // The counters of current caches are updated without synchronisation by
+  // the threads that own them, so the result may be slightly out of date.
+  statistics s = retired_;
+  for (handler_memory_cache* c = first_cache_; c; c = c->next_)
+  {
+    s.allocations += c->statistics_.allocations;
+    s.deallocations += c->statistics_.deallocations;
+    s.heap_allocations += c->statistics_.heap_allocations;
+    s.heap_deallocations += c->statistics_.heap_deallocations;
+  }
+  return s;
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_IMPL_HANDLER_MEMORY_SERVICE_IPP
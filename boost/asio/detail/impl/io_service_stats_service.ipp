@@ -0,0 +1,120 @@
+//
+// detail/impl/io_service_stats_service.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_IO_SERVICE_STATS_SERVICE_IPP
+#define BOOST_ASIO_DETAIL_IMPL_IO_SERVICE_STATS_SERVICE_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/io_service_stats_service.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+
+#if !defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
+# include <time.h>
+# include <sys/time.h>
+#endif // !defined(BOOST_WINDOWS) && !defined(__CYGWIN__)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+io_service_stats_service::io_service_stats_service(
+    boost::asio::io_service& io_service)
+  : boost::asio::detail::service_base<io_service_stats_service>(io_service),
+    enabled_(false),
+    mutex_()
+{
+  baseline_ = snapshot();
+}
+
+void io_service_stats_service::shutdown_service()
+{
+}
+
+io_service_stats_service::statistics
+io_service_stats_service::get_statistics() const
+{
+  mutex::scoped_lock lock(mutex_);
+  statistics s = snapshot();
+  s.handlers_posted -= baseline_.handlers_posted;
+  s.operations_completed -= baseline_.operations_completed;
+  s.handlers_run -= baseline_.handlers_run;
+  s.task_runs -= baseline_.task_runs;
+  for (std::size_t i = 0; i < histogram_buckets; ++i)
+  {
+    s.queue_depth.counts[i] -= baseline_.queue_depth.counts[i];
+    s.run_delay.counts[i] -= baseline_.run_delay.counts[i];
+    s.execution_time.counts[i] -= baseline_.execution_time.counts[i];
+  }
+  return s;
+}
+
+void io_service_stats_service::reset_statistics()
+{
+  mutex::scoped_lock lock(mutex_);
+  baseline_ = snapshot();
+}
+
+boost::uint64_t io_service_stats_service::now()
+{
+  boost::uint64_t t = 0;
+#if defined(BOOST_WINDOWS) || defined(__CYGWIN__)
+  LARGE_INTEGER frequency, count;
+  if (::QueryPerformanceFrequency(&frequency)
+      && ::QueryPerformanceCounter(&count))
+  {
+    boost::uint64_t f = static_cast<boost::uint64_t>(frequency.QuadPart);
+    boost::uint64_t c = static_cast<boost::uint64_t>(count.QuadPart);
+    t = (c / f) * 1000000000 + ((c % f) * 1000000000) / f;
+  }
+#elif defined(CLOCK_MONOTONIC)
+  timespec ts;
+  if (::clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+    t = static_cast<boost::uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else // defined(CLOCK_MONOTONIC)
+  timeval tv;
+  if (::gettimeofday(&tv, 0) == 0)
+    t = static_cast<boost::uint64_t>(tv.tv_sec) * 1000000000
+      + static_cast<boost::uint64_t>(tv.tv_usec) * 1000;
+#endif // defined(CLOCK_MONOTONIC)
+  return t ? t : 1;
+}
+
+io_service_stats_service::statistics
+io_service_stats_service::snapshot() const
+{
+  // Each counter is read individually, so the snapshot is not guaranteed to
+  // be consistent while the io_service is running.
+  statistics s;
+  s.handlers_posted = static_cast<long>(handlers_posted_.value_);
+  s.operations_completed = static_cast<long>(operations_completed_.value_);
+  s.handlers_run = static_cast<long>(handlers_run_.value_);
+  s.task_runs = static_cast<long>(task_runs_.value_);
+  for (std::size_t i = 0; i < histogram_buckets; ++i)
+  {
+    s.queue_depth.counts[i] = static_cast<long>(queue_depth_[i].value_);
+    s.run_delay.counts[i] = static_cast<long>(run_delay_[i].value_);
+    s.execution_time.counts[i] = static_cast<long>(execution_time_[i].value_);
+  }
+  return s;
+}
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_IMPL_IO_SERVICE_STATS_SERVICE_IPP
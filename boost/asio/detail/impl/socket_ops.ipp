@@ -1274,6 +1274,335 @@ bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+int recvmmsg(socket_type s, buf* bufs, size_t count, int flags,
+    socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec)
+{
+  if (count > max_batch_datagrams)
+    count = max_batch_datagrams;
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+  clear_last_error();
+  mmsghdr msgs[max_batch_datagrams];
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i].msg_hdr = msghdr();
+    if (addrs)
+    {
+      init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, addrs[i]);
+      msgs[i].msg_hdr.msg_namelen = addrlens[i];
+    }
+    msgs[i].msg_hdr.msg_iov = &bufs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_len = 0;
+  }
+
+  // Block for the first datagram only, if the socket is in blocking mode.
+  int result = error_wrapper(::recvmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags | MSG_WAITFORONE, 0), ec);
+  for (int i = 0; i < result; ++i)
+  {
+    sizes[i] = msgs[i].msg_len;
+    if (addrs)
+      addrlens[i] = msgs[i].msg_hdr.msg_namelen;
+  }
+  if (result >= 0)
+    ec = boost::system::error_code();
+  return result;
+#else // defined(BOOST_ASIO_HAS_MMSG)
+  // Receive one datagram at a time until no more are available.
+  size_t i = 0;
+  while (i < count)
+  {
+    std::size_t no_addrlen = 0;
+    int bytes = socket_ops::recvfrom(s, &bufs[i], 1, flags,
+        addrs ? addrs[i] : 0, addrs ? &addrlens[i] : &no_addrlen, ec);
+    if (bytes < 0)
+      break;
+    sizes[i++] = bytes;
+#if defined(MSG_DONTWAIT)
+    flags |= MSG_DONTWAIT;
+#else // defined(MSG_DONTWAIT)
+    break;
+#endif // defined(MSG_DONTWAIT)
+  }
+  if (i == 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return static_cast<int>(i);
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+}
+
+size_t sync_recvmmsg(socket_type s, state_type state, buf* bufs,
+    size_t count, int flags, socket_addr_type* const* addrs,
+    std::size_t* addrlens, std::size_t* sizes, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Read some datagrams.
+  for (;;)
+  {
+    // Try to complete the operation without blocking.
+    int datagrams = socket_ops::recvmmsg(s, bufs, count,
+        flags, addrs, addrlens, sizes, ec);
+
+    // Check if operation succeeded.
+    if (datagrams >= 0)
+      return datagrams;
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return 0;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_read(s, ec) < 0)
+      return 0;
+  }
+}
+
+bool non_blocking_recvmmsg(socket_type s,
+    buf* bufs, size_t count, int flags,
+    socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec,
+    size_t& datagrams_transferred)
+{
+  for (;;)
+  {
+    // Read some datagrams.
+    int datagrams = socket_ops::recvmmsg(s, bufs, count,
+        flags, addrs, addrlens, sizes, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (datagrams >= 0)
+    {
+      ec = boost::system::error_code();
+      datagrams_transferred = datagrams;
+    }
+    else
+      datagrams_transferred = 0;
+
+    return true;
+  }
+}
+
+int sendmmsg(socket_type s, const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec)
+{
+  if (count > max_batch_datagrams)
+    count = max_batch_datagrams;
+
+#if defined(BOOST_ASIO_HAS_MMSG)
+  clear_last_error();
+  mmsghdr msgs[max_batch_datagrams];
+  for (size_t i = 0; i < count; ++i)
+  {
+    msgs[i].msg_hdr = msghdr();
+    if (addrs)
+    {
+      init_msghdr_msg_name(msgs[i].msg_hdr.msg_name, addrs[i]);
+      msgs[i].msg_hdr.msg_namelen = addrlens[i];
+    }
+    msgs[i].msg_hdr.msg_iov = const_cast<buf*>(&bufs[i]);
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_len = 0;
+  }
+
+  int result = error_wrapper(::sendmmsg(s, msgs,
+        static_cast<unsigned int>(count), flags | MSG_NOSIGNAL), ec);
+  if (result >= 0)
+    ec = boost::system::error_code();
+  return result;
+#else // defined(BOOST_ASIO_HAS_MMSG)
+  // Send one datagram at a time until the socket's buffer is full.
+  size_t i = 0;
+  for (; i < count; ++i)
+  {
+    if (socket_ops::sendto(s, &bufs[i], 1, flags, addrs ? addrs[i] : 0,
+          addrs ? addrlens[i] : 0, ec) < 0)
+      break;
+  }
+  if (i == 0)
+    return socket_error_retval;
+  ec = boost::system::error_code();
+  return static_cast<int>(i);
+#endif // defined(BOOST_ASIO_HAS_MMSG)
+}
+
+size_t sync_sendmmsg(socket_type s, state_type state, const buf* bufs,
+    size_t count, int flags, const socket_addr_type* const* addrs,
+    const std::size_t* addrlens, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return 0;
+  }
+
+  // Write all of the datagrams.
+  size_t total = 0;
+  while (total < count)
+  {
+    // Try to complete the operation without blocking.
+    int datagrams = socket_ops::sendmmsg(s, bufs + total, count - total,
+        flags, addrs ? addrs + total : 0, addrs ? addrlens + total : 0, ec);
+
+    // Check if operation succeeded.
+    if (datagrams >= 0)
+    {
+      total += datagrams;
+      continue;
+    }
+
+    // Operation failed.
+    if ((state & user_set_non_blocking)
+        || (ec != boost::asio::error::would_block
+          && ec != boost::asio::error::try_again))
+      return total;
+
+    // Wait for socket to become ready.
+    if (socket_ops::poll_write(s, ec) < 0)
+      return total;
+  }
+
+  return total;
+}
+
+bool non_blocking_sendmmsg(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec, size_t& datagrams_transferred)
+{
+  for (;;)
+  {
+    // Write some datagrams.
+    int datagrams = socket_ops::sendmmsg(s,
+        bufs, count, flags, addrs, addrlens, ec);
+
+    // Retry operation if interrupted by signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // Check if we need to run the operation again.
+    if (ec == boost::asio::error::would_block
+        || ec == boost::asio::error::try_again)
+      return false;
+
+    // Operation is complete.
+    if (datagrams >= 0)
+    {
+      ec = boost::system::error_code();
+      datagrams_transferred = datagrams;
+    }
+    else
+      datagrams_transferred = 0;
+
+    return true;
+  }
+}
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+int sendfile(socket_type s, int fd, boost::uint64_t& offset,
+    size_t count, boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return socket_error_retval;
+  }
+
+  // The kernel transfers at most 0x7ffff000 bytes per call, so the result
+  // always fits in an int.
+  clear_last_error();
+  off_t file_offset = static_cast<off_t>(offset);
+  int result = error_wrapper(static_cast<int>(
+        ::sendfile(s, fd, &file_offset, count)), ec);
+  if (result >= 0)
+  {
+    offset = static_cast<boost::uint64_t>(file_offset);
+    ec = boost::system::error_code();
+  }
+  return result;
+}
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+int recv_zero_copy_completion(socket_type s,
+    boost::uint32_t& first, boost::uint32_t& last, bool& copied,
+    boost::system::error_code& ec)
+{
+  if (s == invalid_socket)
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return socket_error_retval;
+  }
+
+  for (;;)
+  {
+    // Reads from the error queue never block. The operation fails with
+    // would_block when the queue is empty.
+    union
+    {
+      cmsghdr header;
+      char buffer[CMSG_SPACE(sizeof(sock_extended_err)
+          + sizeof(sockaddr_in6_type))];
+    } control;
+    msghdr msg = msghdr();
+    msg.msg_control = &control;
+    msg.msg_controllen = sizeof(control);
+    clear_last_error();
+    int result = error_wrapper(::recvmsg(s, &msg, MSG_ERRQUEUE), ec);
+    if (result < 0)
+      return socket_error_retval;
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+      if ((cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_RECVERR)
+          || (cmsg->cmsg_level == IPPROTO_IPV6
+            && cmsg->cmsg_type == IPV6_RECVERR))
+      {
+        sock_extended_err err;
+        std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+        if (err.ee_origin == zero_copy_origin)
+        {
+          first = err.ee_info;
+          last = err.ee_data;
+          copied = (err.ee_code & zero_copy_copied) != 0;
+          ec = boost::system::error_code();
+          return 0;
+        }
+      }
+    }
+
+    // Discard anything that is not a zero-copy notification.
+  }
+}
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
 socket_type socket(int af, int type, int protocol,
     boost::system::error_code& ec)
 {
@@ -27,9 +27,15 @@ namespace boost {
 namespace asio {
 namespace detail {
 
-inline strand_service::strand_impl::strand_impl()
+inline strand_service::strand_impl::strand_impl(
+    strand_service* service, bool dedicated)
   : operation(&strand_service::do_complete),
-    count_(0)
+    service_(service),
+    dedicated_(dedicated),
+    count_(0),
+    ref_count_(1),
+    next_(0),
+    prev_(0)
 {
 }
 
@@ -40,20 +46,10 @@ struct strand_service::on_dispatch_exit
 
   ~on_dispatch_exit()
   {
-    impl_->mutex_.lock();
-    bool more_handlers = (--impl_->count_ > 0);
-    impl_->mutex_.unlock();
-
-    if (more_handlers)
-      io_service_->post_immediate_completion(impl_);
+    strand_service::finish_upcall(io_service_, impl_);
   }
 };
 
-inline void strand_service::destroy(strand_service::implementation_type& impl)
-{
-  impl = 0;
-}
-
 template <typename Handler>
 void strand_service::dispatch(strand_service::implementation_type& impl,
     Handler handler)
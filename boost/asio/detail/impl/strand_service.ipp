@@ -25,6 +25,10 @@ namespace boost {
 namespace asio {
 namespace detail {
 
+#if !defined(BOOST_ASIO_STRAND_MAX_HANDLERS_PER_DISPATCH)
+# define BOOST_ASIO_STRAND_MAX_HANDLERS_PER_DISPATCH 1
+#endif // !defined(BOOST_ASIO_STRAND_MAX_HANDLERS_PER_DISPATCH)
+
 struct strand_service::on_do_complete_exit
 {
   io_service_impl* owner_;
@@ -32,12 +36,7 @@ struct strand_service::on_do_complete_exit
 
   ~on_do_complete_exit()
   {
-    impl_->mutex_.lock();
-    bool more_handlers = (--impl_->count_ > 0);
-    impl_->mutex_.unlock();
-
-    if (more_handlers)
-      owner_->post_immediate_completion(impl_);
+    strand_service::finish_upcall(owner_, impl_);
   }
 };
 
@@ -45,10 +44,29 @@ strand_service::strand_service(boost::asio::io_service& io_service)
   : boost::asio::detail::service_base<strand_service>(io_service),
     io_service_(boost::asio::use_service<io_service_impl>(io_service)),
     mutex_(),
-    salt_(0)
+    salt_(0),
+#if defined(BOOST_ASIO_ENABLE_DEDICATED_STRANDS)
+    dedicated_implementations_(true),
+#else // defined(BOOST_ASIO_ENABLE_DEDICATED_STRANDS)
+    dedicated_implementations_(false),
+#endif // defined(BOOST_ASIO_ENABLE_DEDICATED_STRANDS)
+    max_handlers_per_dispatch_(BOOST_ASIO_STRAND_MAX_HANDLERS_PER_DISPATCH),
+    first_dedicated_(0)
 {
 }
 
+strand_service::~strand_service()
+{
+  // Dedicated implementations still in use at this point belong to strands
+  // whose handlers were abandoned by the shutdown.
+  while (first_dedicated_)
+  {
+    strand_impl* impl = first_dedicated_;
+    first_dedicated_ = impl->next_;
+    delete impl;
+  }
+}
+
 void strand_service::shutdown_service()
 {
   op_queue<operation> ops;
@@ -58,10 +76,25 @@ void strand_service::shutdown_service()
   for (std::size_t i = 0; i < num_implementations; ++i)
     if (strand_impl* impl = implementations_[i].get())
       ops.push(impl->queue_);
+
+  for (strand_impl* impl = first_dedicated_; impl; impl = impl->next_)
+    ops.push(impl->queue_);
 }
 
 void strand_service::construct(strand_service::implementation_type& impl)
 {
+  if (dedicated_implementations_)
+  {
+    impl = new strand_impl(this, true);
+
+    boost::asio::detail::mutex::scoped_lock lock(mutex_);
+    impl->next_ = first_dedicated_;
+    if (first_dedicated_)
+      first_dedicated_->prev_ = impl;
+    first_dedicated_ = impl;
+    return;
+  }
+
   std::size_t salt = salt_++;
   std::size_t index = reinterpret_cast<std::size_t>(&impl);
   index += (reinterpret_cast<std::size_t>(&impl) >> 3);
@@ -71,15 +104,59 @@ void strand_service::construct(strand_service::implementation_type& impl)
   boost::asio::detail::mutex::scoped_lock lock(mutex_);
 
   if (!implementations_[index].get())
-    implementations_[index].reset(new strand_impl);
+    implementations_[index].reset(new strand_impl(this, false));
   impl = implementations_[index].get();
 }
 
+void strand_service::copy(strand_service::implementation_type& impl,
+    const strand_service::implementation_type& other_impl)
+{
+  impl = other_impl;
+  if (impl->dedicated_)
+  {
+    impl->mutex_.lock();
+    ++impl->ref_count_;
+    impl->mutex_.unlock();
+  }
+}
+
+void strand_service::destroy(strand_service::implementation_type& impl)
+{
+  if (impl->dedicated_)
+  {
+    // The implementation is freed once the last strand object referring to
+    // it is gone and no handlers remain, whichever happens last.
+    impl->mutex_.lock();
+    bool unused = (--impl->ref_count_ == 0 && impl->count_ == 0);
+    impl->mutex_.unlock();
+
+    if (unused)
+      release(impl);
+  }
+
+  impl = 0;
+}
+
+void strand_service::release(strand_impl* impl)
+{
+  boost::asio::detail::mutex::scoped_lock lock(mutex_);
+  if (first_dedicated_ == impl)
+    first_dedicated_ = impl->next_;
+  if (impl->prev_)
+    impl->prev_->next_ = impl->next_;
+  if (impl->next_)
+    impl->next_->prev_ = impl->prev_;
+  lock.unlock();
+
+  delete impl;
+}
+
 bool strand_service::do_dispatch(implementation_type& impl, operation* op)
 {
   // If we are running inside the io_service, and no other handler is queued
   // or running, then the handler can run immediately.
-  bool can_dispatch = call_stack<io_service_impl>::contains(&io_service_);
+  bool can_dispatch =
+    io_service_impl::thread_call_stack::contains(&io_service_) != 0;
   impl->mutex_.lock();
   bool first = (++impl->count_ == 1);
   if (can_dispatch && first)
@@ -120,6 +197,7 @@ void strand_service::do_complete(io_service_impl* owner, operation* base,
   if (owner)
   {
     strand_impl* impl = static_cast<strand_impl*>(base);
+    std::size_t max_handlers = impl->service_->max_handlers_per_dispatch_;
 
     // Get the next handler to be executed.
     impl->mutex_.lock();
@@ -135,9 +213,41 @@ void strand_service::do_complete(io_service_impl* owner, operation* base,
     (void)on_exit;
 
     o->complete(*owner);
+
+    // Run further handlers without going back through the io_service, up to
+    // the limit. The strand is rescheduled for any that remain, so that other
+    // work gets a chance to run.
+    for (std::size_t n = 1; n < max_handlers; ++n)
+    {
+      impl->mutex_.lock();
+      if (impl->count_ == 1)
+      {
+        impl->mutex_.unlock();
+        break;
+      }
+      --impl->count_;
+      o = impl->queue_.front();
+      impl->queue_.pop();
+      impl->mutex_.unlock();
+
+      o->complete(*owner);
+    }
   }
 }
 
+void strand_service::finish_upcall(io_service_impl* owner, strand_impl* impl)
+{
+  impl->mutex_.lock();
+  bool more_handlers = (--impl->count_ > 0);
+  bool unused = (!more_handlers && impl->ref_count_ == 0);
+  impl->mutex_.unlock();
+
+  if (more_handlers)
+    owner->post_immediate_completion(impl);
+  else if (unused && impl->dedicated_)
+    impl->service_->release(impl);
+}
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
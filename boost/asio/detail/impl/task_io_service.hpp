@@ -30,7 +30,7 @@ namespace detail {
 template <typename Handler>
 void task_io_service::dispatch(Handler handler)
 {
-  if (call_stack<task_io_service>::contains(this))
+  if (thread_call_stack::contains(this))
   {
     boost::asio::detail::fenced_block b;
     boost_asio_handler_invoke_helpers::invoke(handler, handler);
@@ -19,57 +19,147 @@
 
 #if !defined(BOOST_ASIO_HAS_IOCP)
 
+#include <new>
 #include <boost/limits.hpp>
-#include <boost/asio/detail/call_stack.hpp>
 #include <boost/asio/detail/event.hpp>
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/task_io_service.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
+// The number of times an idle thread checks for newly posted handlers before
+// blocking. Define to 0 to have idle threads block immediately.
+#if !defined(BOOST_ASIO_TASK_IO_SERVICE_SPIN_COUNT)
+# define BOOST_ASIO_TASK_IO_SERVICE_SPIN_COUNT 2000
+#endif // !defined(BOOST_ASIO_TASK_IO_SERVICE_SPIN_COUNT)
+
 namespace boost {
 namespace asio {
 namespace detail {
 
+struct task_io_service::thread_info
+{
+  event wakeup_event;
+  op_queue<operation> private_op_queue;
+  long private_outstanding_work;
+  thread_info* next;
+};
+
 struct task_io_service::task_cleanup
 {
   ~task_cleanup()
   {
+    if (blocked_)
+      --task_io_service_->waiting_threads_;
+
+    if (this_thread_->private_outstanding_work > 0)
+    {
+      boost::asio::detail::increment(
+          task_io_service_->outstanding_work_,
+          this_thread_->private_outstanding_work);
+    }
+    this_thread_->private_outstanding_work = 0;
+
+    if (task_io_service_->stats_.enabled())
+      task_io_service_->mark_ready(this_thread_->private_op_queue);
+
     // Enqueue the completed operations and reinsert the task at the end of
     // the operation queue.
     lock_->lock();
     task_io_service_->task_interrupted_ = true;
-    task_io_service_->op_queue_.push(*ops_);
+    task_io_service_->op_queue_.push(this_thread_->private_op_queue);
     task_io_service_->op_queue_.push(&task_io_service_->task_operation_);
   }
 
   task_io_service* task_io_service_;
   mutex::scoped_lock* lock_;
-  op_queue<operation>* ops_;
+  thread_info* this_thread_;
+  bool blocked_;
 };
 
-struct task_io_service::work_finished_on_block_exit
+struct task_io_service::timed_operation : operation
 {
-  ~work_finished_on_block_exit()
+  timed_operation(io_service_stats_service& stats,
+      operation* op, boost::uint64_t ready_time)
+    : operation(&timed_operation::do_complete),
+      stats_(stats),
+      op_(op),
+      ready_time_(ready_time)
   {
-    task_io_service_->work_finished();
   }
 
-  task_io_service* task_io_service_;
+  static void do_complete(task_io_service* owner, operation* base,
+      boost::system::error_code /*ec*/, std::size_t /*bytes_transferred*/)
+  {
+    // Free the wrapper before the wrapped operation runs, as its handler may
+    // throw.
+    timed_operation* t = static_cast<timed_operation*>(base);
+    io_service_stats_service& stats = t->stats_;
+    operation* op = t->op_;
+    boost::uint64_t ready_time = t->ready_time_;
+    delete t;
+
+    if (owner)
+    {
+      boost::uint64_t start = io_service_stats_service::now();
+      stats.handler_dequeued(start > ready_time ? start - ready_time : 0);
+      op->complete(*owner); // deletes the operation object
+    }
+    else
+    {
+      stats.handler_discarded();
+      op->destroy();
+    }
+  }
+
+  io_service_stats_service& stats_;
+  operation* op_;
+  boost::uint64_t ready_time_;
 };
 
-struct task_io_service::idle_thread_info
+struct task_io_service::work_cleanup
 {
-  event wakeup_event;
-  idle_thread_info* next;
+  ~work_cleanup()
+  {
+    // The completed handler accounts for one unit of work. Any work started
+    // privately by the handler is folded into the shared count first, so
+    // that the count cannot transiently reach zero.
+    if (this_thread_->private_outstanding_work > 1)
+    {
+      boost::asio::detail::increment(
+          task_io_service_->outstanding_work_,
+          this_thread_->private_outstanding_work - 1);
+    }
+    else if (this_thread_->private_outstanding_work < 1)
+    {
+      task_io_service_->work_finished();
+    }
+    this_thread_->private_outstanding_work = 0;
+
+    if (!this_thread_->private_op_queue.empty())
+    {
+      lock_->lock();
+      task_io_service_->op_queue_.push(this_thread_->private_op_queue);
+    }
+  }
+
+  task_io_service* task_io_service_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
 };
 
 task_io_service::task_io_service(boost::asio::io_service& io_service)
   : boost::asio::detail::service_base<task_io_service>(io_service),
+    one_thread_(false),
+    memory_service_(boost::asio::use_service<handler_memory_service>(
+          io_service)),
+    stats_(boost::asio::use_service<io_service_stats_service>(io_service)),
     mutex_(),
     task_(0),
     task_interrupted_(true),
     outstanding_work_(0),
+    waiting_threads_(0),
+    spin_count_(BOOST_ASIO_TASK_IO_SERVICE_SPIN_COUNT),
     stopped_(false),
     shutdown_(false),
     first_idle_thread_(0)
@@ -77,8 +167,9 @@ task_io_service::task_io_service(boost::asio::io_service& io_service)
   BOOST_ASIO_HANDLER_TRACKING_INIT;
 }
 
-void task_io_service::init(std::size_t /*concurrency_hint*/)
+void task_io_service::init(std::size_t concurrency_hint)
 {
+  one_thread_ = (concurrency_hint == 1);
 }
 
 void task_io_service::shutdown_service()
@@ -88,6 +179,7 @@ void task_io_service::shutdown_service()
   lock.unlock();
 
   // Destroy handler objects.
+  inbox_.pop_all(op_queue_);
   while (!op_queue_.empty())
   {
     operation* o = op_queue_.front();
@@ -120,15 +212,17 @@ std::size_t task_io_service::run(boost::system::error_code& ec)
     return 0;
   }
 
-  call_stack<task_io_service>::context ctx(this);
+  handler_memory_cache memory_cache(memory_service_);
 
-  idle_thread_info this_idle_thread;
-  this_idle_thread.next = 0;
+  thread_info this_thread;
+  this_thread.private_outstanding_work = 0;
+  this_thread.next = 0;
+  thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
   std::size_t n = 0;
-  for (; do_one(lock, &this_idle_thread); lock.lock())
+  for (; do_one(lock, this_thread, false); lock.lock())
     if (n != (std::numeric_limits<std::size_t>::max)())
       ++n;
   return n;
@@ -143,14 +237,16 @@ std::size_t task_io_service::run_one(boost::system::error_code& ec)
     return 0;
   }
 
-  call_stack<task_io_service>::context ctx(this);
+  handler_memory_cache memory_cache(memory_service_);
 
-  idle_thread_info this_idle_thread;
-  this_idle_thread.next = 0;
+  thread_info this_thread;
+  this_thread.private_outstanding_work = 0;
+  this_thread.next = 0;
+  thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
-  return do_one(lock, &this_idle_thread);
+  return do_one(lock, this_thread, false);
 }
 
 std::size_t task_io_service::poll(boost::system::error_code& ec)
@@ -162,12 +258,17 @@ std::size_t task_io_service::poll(boost::system::error_code& ec)
     return 0;
   }
 
-  call_stack<task_io_service>::context ctx(this);
+  handler_memory_cache memory_cache(memory_service_);
+
+  thread_info this_thread;
+  this_thread.private_outstanding_work = 0;
+  this_thread.next = 0;
+  thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
   std::size_t n = 0;
-  for (; do_one(lock, 0); lock.lock())
+  for (; do_one(lock, this_thread, true); lock.lock())
     if (n != (std::numeric_limits<std::size_t>::max)())
       ++n;
   return n;
@@ -182,11 +283,16 @@ std::size_t task_io_service::poll_one(boost::system::error_code& ec)
     return 0;
   }
 
-  call_stack<task_io_service>::context ctx(this);
+  handler_memory_cache memory_cache(memory_service_);
+
+  thread_info this_thread;
+  this_thread.private_outstanding_work = 0;
+  this_thread.next = 0;
+  thread_call_stack::context ctx(this, this_thread);
 
   mutex::scoped_lock lock(mutex_);
 
-  return do_one(lock, 0);
+  return do_one(lock, this_thread, true);
 }
 
 void task_io_service::stop()
@@ -209,15 +315,46 @@ void task_io_service::reset()
 
 void task_io_service::post_immediate_completion(task_io_service::operation* op)
 {
+  if (stats_.enabled())
+  {
+    stats_.handler_posted();
+    op = time_operation(op, io_service_stats_service::now());
+  }
+
+  if (one_thread_)
+  {
+    if (thread_info* this_thread = thread_call_stack::contains(this))
+    {
+      ++this_thread->private_outstanding_work;
+      this_thread->private_op_queue.push(op);
+      return;
+    }
+  }
+
   work_started();
-  post_deferred_completion(op);
+  inbox_.push(op);
+  wake_one_waiting_thread();
 }
 
 void task_io_service::post_deferred_completion(task_io_service::operation* op)
 {
-  mutex::scoped_lock lock(mutex_);
-  op_queue_.push(op);
-  wake_one_thread_and_unlock(lock);
+  if (stats_.enabled())
+  {
+    stats_.operations_completed(1);
+    op = time_operation(op, io_service_stats_service::now());
+  }
+
+  if (one_thread_)
+  {
+    if (thread_info* this_thread = thread_call_stack::contains(this))
+    {
+      this_thread->private_op_queue.push(op);
+      return;
+    }
+  }
+
+  inbox_.push(op);
+  wake_one_waiting_thread();
 }
 
 void task_io_service::post_deferred_completions(
@@ -225,9 +362,20 @@ void task_io_service::post_deferred_completions(
 {
   if (!ops.empty())
   {
-    mutex::scoped_lock lock(mutex_);
-    op_queue_.push(ops);
-    wake_one_thread_and_unlock(lock);
+    if (stats_.enabled())
+      mark_ready(ops);
+
+    if (one_thread_)
+    {
+      if (thread_info* this_thread = thread_call_stack::contains(this))
+      {
+        this_thread->private_op_queue.push(ops);
+        return;
+      }
+    }
+
+    inbox_.push(ops);
+    wake_one_waiting_thread();
   }
 }
 
@@ -239,12 +387,15 @@ void task_io_service::abandon_operations(
 }
 
 std::size_t task_io_service::do_one(mutex::scoped_lock& lock,
-    task_io_service::idle_thread_info* this_idle_thread)
+    task_io_service::thread_info& this_thread, bool polling)
 {
-  bool polling = !this_idle_thread;
   bool task_has_run = false;
+  bool may_spin = !polling && spin_count_ > 0;
   while (!stopped_)
   {
+    // Take ownership of any handlers posted without the mutex.
+    inbox_.pop_all(op_queue_);
+
     if (!op_queue_.empty())
     {
       // Prepare to execute first handler from queue.
@@ -254,8 +405,6 @@ std::size_t task_io_service::do_one(mutex::scoped_lock& lock,
 
       if (o == &task_operation_)
       {
-        task_interrupted_ = more_handlers || polling;
-
         // If the task has already run and we're polling then we're done.
         if (task_has_run && polling)
         {
@@ -265,42 +414,94 @@ std::size_t task_io_service::do_one(mutex::scoped_lock& lock,
         }
         task_has_run = true;
 
-        if (!more_handlers || !wake_one_idle_thread_and_unlock(lock))
+        // Only block if the operation queue is empty and we're not polling,
+        // otherwise we want to return as soon as possible. A blocked task
+        // counts as a waiting thread, so recheck the inbox once it is counted
+        // to avoid missing a handler posted without the mutex.
+        bool block = !more_handlers && !polling;
+        if (block && may_spin)
+        {
+          // Check for newly posted handlers for a short time before blocking
+          // in the task, to avoid the cost of being interrupted.
+          may_spin = false;
+          op_queue_.push(&task_operation_);
+          lock.unlock();
+          spin_for_work();
+          lock.lock();
+          continue;
+        }
+        else if (block)
+        {
+          ++waiting_threads_;
+          if (!inbox_.empty())
+          {
+            --waiting_threads_;
+            inbox_.pop_all(op_queue_);
+            more_handlers = true;
+            block = false;
+          }
+        }
+
+        task_interrupted_ = !block;
+
+        if (!more_handlers || one_thread_
+            || !wake_one_idle_thread_and_unlock(lock))
           lock.unlock();
 
-        op_queue<operation> completed_ops;
-        task_cleanup c = { this, &lock, &completed_ops };
+        task_cleanup c = { this, &lock, &this_thread, block };
         (void)c;
 
-        // Run the task. May throw an exception. Only block if the operation
-        // queue is empty and we're not polling, otherwise we want to return
-        // as soon as possible.
-        task_->run(!more_handlers && !polling, completed_ops);
+        if (stats_.enabled())
+          stats_.task_run();
+
+        // Run the task. May throw an exception.
+        task_->run(block, this_thread.private_op_queue);
       }
       else
       {
-        if (more_handlers)
+        if (more_handlers && !one_thread_)
           wake_one_thread_and_unlock(lock);
         else
           lock.unlock();
 
-        // Ensure the count of outstanding work is decremented on block exit.
-        work_finished_on_block_exit on_exit = { this };
+        // Ensure the count of outstanding work is decremented, and any
+        // privately queued handlers are published, on block exit.
+        work_cleanup on_exit = { this, &lock, &this_thread };
         (void)on_exit;
 
         // Complete the operation. May throw an exception.
-        o->complete(*this); // deletes the operation object
+        if (stats_.enabled())
+          complete_with_stats(o);
+        else
+          o->complete(*this); // deletes the operation object
 
         return 1;
       }
     }
-    else if (this_idle_thread)
+    else if (may_spin)
+    {
+      // Nothing to run right now. Check for newly posted handlers for a short
+      // time before blocking, to avoid the cost of being woken.
+      may_spin = false;
+      lock.unlock();
+      spin_for_work();
+      lock.lock();
+    }
+    else if (!polling)
     {
-      // Nothing to run right now, so just wait for work to do.
-      this_idle_thread->next = first_idle_thread_;
-      first_idle_thread_ = this_idle_thread;
-      this_idle_thread->wakeup_event.clear(lock);
-      this_idle_thread->wakeup_event.wait(lock);
+      // Nothing to run right now, so just wait for work to do. An idle
+      // thread counts as a waiting thread, so recheck the inbox once it is
+      // counted to avoid missing a handler posted without the mutex.
+      ++waiting_threads_;
+      if (inbox_.empty())
+      {
+        this_thread.next = first_idle_thread_;
+        first_idle_thread_ = &this_thread;
+        this_thread.wakeup_event.clear(lock);
+        this_thread.wakeup_event.wait(lock);
+      }
+      --waiting_threads_;
+      may_spin = spin_count_ > 0;
     }
     else
     {
@@ -318,7 +519,7 @@ void task_io_service::stop_all_threads(
 
   while (first_idle_thread_)
   {
-    idle_thread_info* idle_thread = first_idle_thread_;
+    thread_info* idle_thread = first_idle_thread_;
     first_idle_thread_ = idle_thread->next;
     idle_thread->next = 0;
     idle_thread->wakeup_event.signal(lock);
@@ -336,7 +537,7 @@ bool task_io_service::wake_one_idle_thread_and_unlock(
 {
   if (first_idle_thread_)
   {
-    idle_thread_info* idle_thread = first_idle_thread_;
+    thread_info* idle_thread = first_idle_thread_;
     first_idle_thread_ = idle_thread->next;
     idle_thread->next = 0;
     idle_thread->wakeup_event.signal_and_unlock(lock);
@@ -359,6 +560,64 @@ void task_io_service::wake_one_thread_and_unlock(
   }
 }
 
+void task_io_service::wake_one_waiting_thread()
+{
+  // The push on to the inbox acts as a full barrier, so either this check
+  // sees the waiting thread, or the waiting thread sees the new handler.
+  if (waiting_threads_ != 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    wake_one_thread_and_unlock(lock);
+  }
+}
+
+bool task_io_service::spin_for_work()
+{
+  for (std::size_t i = 0; i < spin_count_; ++i)
+    if (!inbox_.empty())
+      return true;
+  return false;
+}
+
+task_io_service::operation* task_io_service::time_operation(
+    task_io_service::operation* op, boost::uint64_t ready_time)
+{
+  // Called from the destructor of task_cleanup, so must not throw. If there
+  // is no memory for the wrapper the operation is simply not timed.
+  timed_operation* t = new (std::nothrow)
+    timed_operation(stats_, op, ready_time);
+  if (!t)
+    return op;
+  stats_.handler_queued();
+  return t;
+}
+
+void task_io_service::mark_ready(op_queue<task_io_service::operation>& ops)
+{
+  boost::uint64_t now = io_service_stats_service::now();
+  long completed = 0;
+  op_queue<operation> timed_ops;
+  while (operation* o = ops.front())
+  {
+    ops.pop();
+    if (o->func_ != &timed_operation::do_complete)
+    {
+      o = time_operation(o, now);
+      ++completed;
+    }
+    timed_ops.push(o);
+  }
+  ops.push(timed_ops);
+  stats_.operations_completed(completed);
+}
+
+void task_io_service::complete_with_stats(task_io_service::operation* op)
+{
+  boost::uint64_t start = io_service_stats_service::now();
+  op->complete(*this); // deletes the operation object
+  stats_.handler_run(io_service_stats_service::now() - start);
+}
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
@@ -64,6 +64,9 @@ struct win_iocp_io_service::timer_thread_function
 
 win_iocp_io_service::win_iocp_io_service(boost::asio::io_service& io_service)
   : boost::asio::detail::service_base<win_iocp_io_service>(io_service),
+    memory_service_(boost::asio::use_service<handler_memory_service>(
+          io_service)),
+    stats_(boost::asio::use_service<io_service_stats_service>(io_service)),
     iocp_(),
     outstanding_work_(0),
     stopped_(0),
@@ -155,6 +158,7 @@ size_t win_iocp_io_service::run(boost::system::error_code& ec)
     return 0;
   }
 
+  handler_memory_cache memory_cache(memory_service_);
   call_stack<win_iocp_io_service>::context ctx(this);
 
   size_t n = 0;
@@ -173,6 +177,7 @@ size_t win_iocp_io_service::run_one(boost::system::error_code& ec)
     return 0;
   }
 
+  handler_memory_cache memory_cache(memory_service_);
   call_stack<win_iocp_io_service>::context ctx(this);
 
   return do_one(true, ec);
@@ -187,6 +192,7 @@ size_t win_iocp_io_service::poll(boost::system::error_code& ec)
     return 0;
   }
 
+  handler_memory_cache memory_cache(memory_service_);
   call_stack<win_iocp_io_service>::context ctx(this);
 
   size_t n = 0;
@@ -205,6 +211,7 @@ size_t win_iocp_io_service::poll_one(boost::system::error_code& ec)
     return 0;
   }
 
+  handler_memory_cache memory_cache(memory_service_);
   call_stack<win_iocp_io_service>::context ctx(this);
 
   return do_one(false, ec);
@@ -395,7 +402,16 @@ size_t win_iocp_io_service::do_one(bool block, boost::system::error_code& ec)
         work_finished_on_block_exit on_exit = { this };
         (void)on_exit;
 
-        op->complete(*this, result_ec, bytes_transferred);
+        if (stats_.enabled())
+        {
+          boost::uint64_t start = io_service_stats_service::now();
+          op->complete(*this, result_ec, bytes_transferred);
+          stats_.handler_run(io_service_stats_service::now() - start);
+        }
+        else
+        {
+          op->complete(*this, result_ec, bytes_transferred);
+        }
         ec = boost::system::error_code();
         return 1;
       }
@@ -0,0 +1,194 @@
+//
+// detail/io_service_stats_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IO_SERVICE_STATS_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_IO_SERVICE_STATS_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/cstdint.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/mutex.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Gathers counters and histograms describing the work done by an io_service.
+// The recording functions are called by the io_service implementation only
+// when enabled() is true, and update the counters without locking.
+class io_service_stats_service
+  : public boost::asio::detail::service_base<io_service_stats_service>
+{
+public:
+  // The number of buckets in each histogram. Bucket 0 counts values of zero,
+  // and bucket i counts values in the range [2^(i-1), 2^i). The last bucket
+  // also counts all larger values.
+  enum { histogram_buckets = 40 };
+
+  // A snapshot of a histogram.
+  struct histogram
+  {
+    std::size_t counts[histogram_buckets];
+  };
+
+  // A snapshot of all counters.
+  struct statistics
+  {
+    std::size_t handlers_posted;
+    std::size_t operations_completed;
+    std::size_t handlers_run;
+    std::size_t task_runs;
+    histogram queue_depth;
+    histogram run_delay;
+    histogram execution_time;
+  };
+
+  // Constructor.
+  BOOST_ASIO_DECL io_service_stats_service(
+      boost::asio::io_service& io_service);
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown_service();
+
+  // Enable or disable recording.
+  void enabled(bool value)
+  {
+    enabled_ = value;
+  }
+
+  // Whether recording is enabled. Read without locking, so a change may not
+  // be seen immediately by other threads.
+  bool enabled() const
+  {
+    return enabled_;
+  }
+
+  // Get the counters accumulated since the last reset.
+  BOOST_ASIO_DECL statistics get_statistics() const;
+
+  // Reset the counters to zero.
+  BOOST_ASIO_DECL void reset_statistics();
+
+  // Get a monotonic time in nanoseconds, measured from an arbitrary epoch.
+  // Never returns 0, so that 0 can be used to mean "no time recorded".
+  BOOST_ASIO_DECL static boost::uint64_t now();
+
+  // Record that a handler has been posted for immediate execution.
+  void handler_posted()
+  {
+    ++handlers_posted_.value_;
+  }
+
+  // Record that asynchronous operations have completed.
+  void operations_completed(long n)
+  {
+    boost::asio::detail::increment(operations_completed_.value_, n);
+  }
+
+  // Record that the task has been run.
+  void task_run()
+  {
+    ++task_runs_.value_;
+  }
+
+  // Record that a handler has been queued to run.
+  void handler_queued()
+  {
+    ++queued_.value_;
+  }
+
+  // Record that a queued handler has been removed from the queue, after
+  // waiting for the given number of nanoseconds.
+  void handler_dequeued(boost::uint64_t delay)
+  {
+    long depth = --queued_.value_;
+    record(queue_depth_, depth > 0 ? depth : 0);
+    record(run_delay_, delay);
+  }
+
+  // Record that a queued handler has been destroyed without being run.
+  void handler_discarded()
+  {
+    --queued_.value_;
+  }
+
+  // Record that a handler has run for the given number of nanoseconds.
+  void handler_run(boost::uint64_t duration)
+  {
+    ++handlers_run_.value_;
+    record(execution_time_, duration);
+  }
+
+private:
+  // A counter that is zero-initialised, as atomic_count may not have a default
+  // constructor.
+  struct counter
+  {
+    counter() : value_(0) {}
+    atomic_count value_;
+  };
+
+  // Add a value to a histogram.
+  static void record(counter* buckets, boost::uint64_t value)
+  {
+    std::size_t i = 0;
+    while (value != 0 && i + 1 < histogram_buckets)
+    {
+      value >>= 1;
+      ++i;
+    }
+    ++buckets[i].value_;
+  }
+
+  // Read the current values of the counters.
+  BOOST_ASIO_DECL statistics snapshot() const;
+
+  // Whether recording is enabled.
+  bool enabled_;
+
+  // The counters.
+  counter handlers_posted_;
+  counter operations_completed_;
+  counter handlers_run_;
+  counter task_runs_;
+  counter queue_depth_[histogram_buckets];
+  counter run_delay_[histogram_buckets];
+  counter execution_time_[histogram_buckets];
+
+  // The number of handlers queued while recording was enabled that have not
+  // yet been dequeued.
+  counter queued_;
+
+  // Mutex to protect access to the baseline.
+  mutable mutex mutex_;
+
+  // The values of the counters at the time of the last reset.
+  statistics baseline_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/io_service_stats_service.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_DETAIL_IO_SERVICE_STATS_SERVICE_HPP
@@ -30,6 +30,8 @@
 #include <boost/asio/detail/reactive_socket_accept_op.hpp>
 #include <boost/asio/detail/reactive_socket_connect_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvfrom_op.hpp>
+#include <boost/asio/detail/reactive_socket_recvmmsg_op.hpp>
+#include <boost/asio/detail/reactive_socket_sendmmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_sendto_op.hpp>
 #include <boost/asio/detail/reactive_socket_service_base.hpp>
 #include <boost/asio/detail/reactor.hpp>
@@ -340,6 +342,117 @@ public:
     p.v = p.p = 0;
   }
 
+  // Send a batch of datagrams, one from each buffer, to the corresponding
+  // endpoints. Returns the number of datagrams sent.
+  template <typename ConstBufferSequence>
+  size_t send_batch(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type* destinations,
+      socket_base::message_flags flags, boost::system::error_code& ec)
+  {
+    buffer_sequence_adapter<boost::asio::const_buffer,
+        ConstBufferSequence> bufs(buffers);
+
+    const socket_addr_type* addrs[socket_ops::max_batch_datagrams];
+    std::size_t addrlens[socket_ops::max_batch_datagrams];
+    std::size_t count = bufs.count() < socket_ops::max_batch_datagrams
+      ? bufs.count() : socket_ops::max_batch_datagrams;
+    if (destinations)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        addrs[i] = destinations[i].data();
+        addrlens[i] = destinations[i].size();
+      }
+    }
+
+    return socket_ops::sync_sendmmsg(impl.socket_, impl.state_,
+        bufs.buffers(), count, flags, destinations ? addrs : 0, addrlens, ec);
+  }
+
+  // Start an asynchronous send of a batch of datagrams. The data being sent
+  // and the destination endpoints must be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler>
+  void async_send_batch(implementation_type& impl,
+      const ConstBufferSequence& buffers, const endpoint_type* destinations,
+      socket_base::message_flags flags, Handler handler)
+  {
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_sendmmsg_op<ConstBufferSequence,
+        endpoint_type, Handler> op;
+    typename op::ptr p = { boost::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers, destinations, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket", &impl, "async_send_batch"));
+
+    start_op(impl, reactor::write_op, p.p, true, false);
+    p.v = p.p = 0;
+  }
+
+  // Receive a batch of datagrams, one into each buffer, with the endpoints of
+  // the senders. Returns the number of datagrams received.
+  template <typename MutableBufferSequence>
+  size_t receive_batch(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, socket_base::message_flags flags,
+      boost::system::error_code& ec)
+  {
+    buffer_sequence_adapter<boost::asio::mutable_buffer,
+        MutableBufferSequence> bufs(buffers);
+
+    socket_addr_type* addrs[socket_ops::max_batch_datagrams];
+    std::size_t addrlens[socket_ops::max_batch_datagrams];
+    std::size_t count = bufs.count() < socket_ops::max_batch_datagrams
+      ? bufs.count() : socket_ops::max_batch_datagrams;
+    if (sender_endpoints)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        addrs[i] = sender_endpoints[i].data();
+        addrlens[i] = sender_endpoints[i].capacity();
+      }
+    }
+
+    std::size_t datagrams = socket_ops::sync_recvmmsg(impl.socket_,
+        impl.state_, bufs.buffers(), count, flags,
+        sender_endpoints ? addrs : 0, addrlens, sizes, ec);
+
+    if (!ec && sender_endpoints)
+      for (std::size_t i = 0; i < datagrams; ++i)
+        sender_endpoints[i].resize(addrlens[i]);
+
+    return datagrams;
+  }
+
+  // Start an asynchronous receive of a batch of datagrams. The buffers for the
+  // data being received, the sender_endpoints array and the sizes array must
+  // all be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence, typename Handler>
+  void async_receive_batch(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type* sender_endpoints,
+      std::size_t* sizes, socket_base::message_flags flags, Handler handler)
+  {
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recvmmsg_op<MutableBufferSequence,
+        endpoint_type, Handler> op;
+    typename op::ptr p = { boost::addressof(handler),
+      boost_asio_handler_alloc_helpers::allocate(
+        sizeof(op), handler), 0 };
+    p.p = new (p.v) op(impl.socket_, buffers,
+        sender_endpoints, sizes, flags, handler);
+
+    BOOST_ASIO_HANDLER_CREATION((p.p, "socket",
+          &impl, "async_receive_batch"));
+
+    start_op(impl,
+        (flags & socket_base::message_out_of_band)
+          ? reactor::except_op : reactor::read_op,
+        p.p, true, false);
+    p.v = p.p = 0;
+  }
+
   // Accept a new connection.
   template <typename Socket>
   boost::system::error_code accept(implementation_type& impl,
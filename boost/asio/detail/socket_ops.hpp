@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 
+#include <boost/cstdint.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/asio/detail/shared_ptr.hpp>
 #include <boost/asio/detail/socket_types.hpp>
@@ -59,6 +60,9 @@ enum
 
 typedef unsigned char state_type;
 
+// The maximum number of datagrams transferred by a single batch operation.
+const std::size_t max_batch_datagrams = 64;
+
 struct noop_deleter { void operator()(void*) {} };
 typedef shared_ptr<void> shared_cancel_token_type;
 typedef weak_ptr<void> weak_cancel_token_type;
@@ -231,6 +235,53 @@ BOOST_ASIO_DECL bool non_blocking_sendto(socket_type s,
 
 #endif // !defined(BOOST_ASIO_HAS_IOCP)
 
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+BOOST_ASIO_DECL int recvmmsg(socket_type s, buf* bufs, size_t count,
+    int flags, socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_recvmmsg(socket_type s, state_type state,
+    buf* bufs, size_t count, int flags, socket_addr_type* const* addrs,
+    std::size_t* addrlens, std::size_t* sizes, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL bool non_blocking_recvmmsg(socket_type s,
+    buf* bufs, size_t count, int flags,
+    socket_addr_type* const* addrs, std::size_t* addrlens,
+    std::size_t* sizes, boost::system::error_code& ec,
+    size_t& datagrams_transferred);
+
+BOOST_ASIO_DECL int sendmmsg(socket_type s, const buf* bufs, size_t count,
+    int flags, const socket_addr_type* const* addrs,
+    const std::size_t* addrlens, boost::system::error_code& ec);
+
+BOOST_ASIO_DECL size_t sync_sendmmsg(socket_type s, state_type state,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec);
+
+BOOST_ASIO_DECL bool non_blocking_sendmmsg(socket_type s,
+    const buf* bufs, size_t count, int flags,
+    const socket_addr_type* const* addrs, const std::size_t* addrlens,
+    boost::system::error_code& ec, size_t& datagrams_transferred);
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+BOOST_ASIO_DECL int sendfile(socket_type s, int fd, boost::uint64_t& offset,
+    size_t count, boost::system::error_code& ec);
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+BOOST_ASIO_DECL int recv_zero_copy_completion(socket_type s,
+    boost::uint32_t& first, boost::uint32_t& last, bool& copied,
+    boost::system::error_code& ec);
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
 BOOST_ASIO_DECL socket_type socket(int af, int type, int protocol,
     boost::system::error_code& ec);
 
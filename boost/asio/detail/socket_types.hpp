@@ -73,6 +73,12 @@
 #  include <sys/filio.h>
 #  include <sys/sockio.h>
 # endif
+# if defined(BOOST_ASIO_HAS_SENDFILE)
+#  include <sys/sendfile.h>
+# endif
+# if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+#  include <linux/errqueue.h>
+# endif
 #endif
 
 #include <boost/asio/detail/push_options.hpp>
@@ -158,6 +164,30 @@ const int message_peek = MSG_PEEK;
 const int message_out_of_band = MSG_OOB;
 const int message_do_not_route = MSG_DONTROUTE;
 const int message_end_of_record = MSG_EOR;
+# if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+// Older C library headers may not define the zero-copy constants, in which
+// case the values from the kernel's generic headers are used.
+#  if defined(MSG_ZEROCOPY)
+const int message_zero_copy = MSG_ZEROCOPY;
+#  else // defined(MSG_ZEROCOPY)
+const int message_zero_copy = 0x4000000;
+#  endif // defined(MSG_ZEROCOPY)
+#  if defined(SO_ZEROCOPY)
+const int so_zerocopy = SO_ZEROCOPY;
+#  else // defined(SO_ZEROCOPY)
+const int so_zerocopy = 60;
+#  endif // defined(SO_ZEROCOPY)
+#  if defined(SO_EE_ORIGIN_ZEROCOPY)
+const int zero_copy_origin = SO_EE_ORIGIN_ZEROCOPY;
+#  else // defined(SO_EE_ORIGIN_ZEROCOPY)
+const int zero_copy_origin = 5;
+#  endif // defined(SO_EE_ORIGIN_ZEROCOPY)
+#  if defined(SO_EE_CODE_ZEROCOPY_COPIED)
+const int zero_copy_copied = SO_EE_CODE_ZEROCOPY_COPIED;
+#  else // defined(SO_EE_CODE_ZEROCOPY_COPIED)
+const int zero_copy_copied = 1;
+#  endif // defined(SO_EE_CODE_ZEROCOPY_COPIED)
+# endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
 # if defined(IOV_MAX)
 const int max_iov_len = IOV_MAX;
 # else
@@ -46,7 +46,7 @@ public:
     : public operation
   {
   public:
-    strand_impl();
+    strand_impl(strand_service* service, bool dedicated);
 
   private:
     // Only this service will have access to the internal values.
@@ -54,6 +54,13 @@ public:
     friend struct on_do_complete_exit;
     friend struct on_dispatch_exit;
 
+    // The service that owns the implementation.
+    strand_service* service_;
+
+    // Whether the implementation belongs to a single strand, rather than
+    // being shared from the service's pool.
+    bool dedicated_;
+
     // Mutex to protect access to internal data.
     boost::asio::detail::mutex mutex_;
 
@@ -62,6 +69,13 @@ public:
 
     // The handlers waiting on the strand.
     op_queue<operation> queue_;
+
+    // The number of strand objects referring to a dedicated implementation.
+    std::size_t ref_count_;
+
+    // The dedicated implementations owned by the service.
+    strand_impl* next_;
+    strand_impl* prev_;
   };
 
   typedef strand_impl* implementation_type;
@@ -72,11 +86,43 @@ public:
   // Destroy all user-defined handler objects owned by the service.
   BOOST_ASIO_DECL void shutdown_service();
 
+  // Destroy all dedicated implementations.
+  BOOST_ASIO_DECL ~strand_service();
+
   // Construct a new strand implementation.
   BOOST_ASIO_DECL void construct(implementation_type& impl);
 
+  // Construct a strand implementation that refers to the same strand as
+  // another.
+  BOOST_ASIO_DECL void copy(implementation_type& impl,
+      const implementation_type& other_impl);
+
   // Destroy a strand implementation.
-  void destroy(implementation_type& impl);
+  BOOST_ASIO_DECL void destroy(implementation_type& impl);
+
+  // Set whether new strands are given dedicated implementations.
+  void dedicated_implementations(bool value)
+  {
+    dedicated_implementations_ = value;
+  }
+
+  // Get whether new strands are given dedicated implementations.
+  bool dedicated_implementations() const
+  {
+    return dedicated_implementations_;
+  }
+
+  // Set the maximum number of handlers run each time a strand is scheduled.
+  void max_handlers_per_dispatch(std::size_t n)
+  {
+    max_handlers_per_dispatch_ = n > 0 ? n : 1;
+  }
+
+  // Get the maximum number of handlers run each time a strand is scheduled.
+  std::size_t max_handlers_per_dispatch() const
+  {
+    return max_handlers_per_dispatch_;
+  }
 
   // Request the io_service to invoke the given handler.
   template <typename Handler>
@@ -98,6 +144,15 @@ private:
       operation* base, boost::system::error_code ec,
       std::size_t bytes_transferred);
 
+  // Helper function to account for a completed upcall, scheduling the strand
+  // again if there are more handlers waiting.
+  BOOST_ASIO_DECL static void finish_upcall(
+      io_service_impl* owner, strand_impl* impl);
+
+  // Helper function to free a dedicated implementation that is no longer in
+  // use.
+  BOOST_ASIO_DECL void release(strand_impl* impl);
+
   // The io_service implementation used to post completions.
   io_service_impl& io_service_;
 
@@ -113,6 +168,15 @@ private:
   // Extra value used when hashing to prevent recycled memory locations from
   // getting the same strand implementation.
   std::size_t salt_;
+
+  // Whether new strands are given dedicated implementations.
+  bool dedicated_implementations_;
+
+  // The maximum number of handlers run each time a strand is scheduled.
+  std::size_t max_handlers_per_dispatch_;
+
+  // The dedicated implementations that have not yet been freed.
+  strand_impl* first_dedicated_;
 };
 
 } // namespace detail
@@ -22,6 +22,10 @@
 #include <boost/system/error_code.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/atomic_op_queue.hpp>
+#include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/handler_memory_service.hpp>
+#include <boost/asio/detail/io_service_stats_service.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/reactor_fwd.hpp>
@@ -37,13 +41,24 @@ namespace detail {
 class task_io_service
   : public boost::asio::detail::service_base<task_io_service>
 {
+private:
+  // Structure containing per-thread information about a thread that is
+  // running the io_service.
+  struct thread_info;
+
 public:
   typedef task_io_service_operation operation;
 
+  // The call stack used to determine whether the current thread is running
+  // the io_service, and to find that thread's information.
+  typedef call_stack<task_io_service, thread_info> thread_call_stack;
+
   // Constructor.
   BOOST_ASIO_DECL task_io_service(boost::asio::io_service& io_service);
 
-  // How many concurrent threads are likely to run the io_service.
+  // How many concurrent threads are likely to run the io_service. A hint of
+  // exactly 1 selects the single-threaded mode, in which handlers posted from
+  // within run() are queued on a thread-private queue without locking.
   BOOST_ASIO_DECL void init(std::size_t concurrency_hint);
 
   // Destroy all user-defined handler objects owned by the service.
@@ -111,12 +126,9 @@ public:
   BOOST_ASIO_DECL void abandon_operations(op_queue<operation>& ops);
 
 private:
-  // Structure containing information about an idle thread.
-  struct idle_thread_info;
-
-  // Run at most one operation. Blocks only if this_idle_thread is non-null.
+  // Run at most one operation. Blocks only if polling is false.
   BOOST_ASIO_DECL std::size_t do_one(mutex::scoped_lock& lock,
-      idle_thread_info* this_idle_thread);
+      thread_info& this_thread, bool polling);
 
   // Stop the task and all idle threads.
   BOOST_ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
@@ -131,12 +143,47 @@ private:
   BOOST_ASIO_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+  // Wake a thread to process operations that were pushed on to the inbox, if
+  // any thread is waiting. Does not lock the mutex unless a thread is waiting.
+  BOOST_ASIO_DECL void wake_one_waiting_thread();
+
+  // Spin briefly waiting for an operation to arrive in the inbox. Called
+  // without the mutex held. Returns true if an operation arrived.
+  BOOST_ASIO_DECL bool spin_for_work();
+
+  // Wrap an operation so that the time it spends in the queue is recorded.
+  // Returns the operation unchanged if the wrapper cannot be allocated.
+  BOOST_ASIO_DECL operation* time_operation(operation* op,
+      boost::uint64_t ready_time);
+
+  // Record the time at which queued operations became ready to run, counting
+  // those not already recorded as completed operations.
+  BOOST_ASIO_DECL void mark_ready(op_queue<operation>& ops);
+
+  // Complete an operation, recording statistics about its execution.
+  BOOST_ASIO_DECL void complete_with_stats(operation* op);
+
+  // Operation that records how long the wrapped operation was queued, so
+  // that only operations queued while recording carry a timestamp.
+  struct timed_operation;
+  friend struct timed_operation;
+
   // Helper class to perform task-related operations on block exit.
   struct task_cleanup;
   friend struct task_cleanup;
 
-  // Helper class to call work_finished() on block exit.
-  struct work_finished_on_block_exit;
+  // Helper class to perform handler-related operations on block exit.
+  struct work_cleanup;
+  friend struct work_cleanup;
+
+  // Whether the io_service is run by at most one thread.
+  bool one_thread_;
+
+  // The service that controls recycling of handler memory.
+  handler_memory_service& memory_service_;
+
+  // The service that records statistics.
+  io_service_stats_service& stats_;
 
   // Mutex to protect access to internal data.
   mutable mutex mutex_;
@@ -159,6 +206,17 @@ private:
   // The queue of handlers that are ready to be delivered.
   op_queue<operation> op_queue_;
 
+  // The lock-free queue used by threads that post handlers without holding
+  // the mutex. Its contents are moved to op_queue_ while the mutex is held.
+  atomic_op_queue<operation> inbox_;
+
+  // The number of threads that are idle or are blocked running the task.
+  // Producers need only lock the mutex to wake a thread when this is non-zero.
+  atomic_count waiting_threads_;
+
+  // The number of times an idle thread checks for new work before blocking.
+  std::size_t spin_count_;
+
   // Flag to indicate that the dispatcher has been stopped.
   bool stopped_;
 
@@ -166,7 +224,7 @@ private:
   bool shutdown_;
 
   // The threads that are currently idle.
-  idle_thread_info* first_idle_thread_;
+  thread_info* first_idle_thread_;
 };
 
 } // namespace detail
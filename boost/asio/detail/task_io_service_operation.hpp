@@ -59,6 +59,7 @@ protected:
 
 private:
   friend class op_queue_access;
+  friend class task_io_service;
   task_io_service_operation* next_;
   func_type func_;
 };
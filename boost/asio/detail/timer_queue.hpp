@@ -23,8 +23,10 @@
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/timer_op.hpp>
 #include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/detail/timer_wheel.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/time_traits.hpp>
+#include <boost/asio/timer_wheel_traits.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
@@ -310,6 +312,14 @@ private:
   std::vector<heap_entry> heap_;
 };
 
+// Time traits wrapped in timer_wheel_traits use a timing wheel in place of
+// the heap.
+template <typename Time_Traits, std::size_t Resolution>
+class timer_queue<timer_wheel_traits<Time_Traits, Resolution> >
+  : public timer_wheel<timer_wheel_traits<Time_Traits, Resolution> >
+{
+};
+
 #if !defined(BOOST_ASIO_HEADER_ONLY)
 
 struct forwarding_posix_time_traits : time_traits<boost::posix_time::ptime> {};
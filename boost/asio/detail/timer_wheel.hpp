@@ -0,0 +1,567 @@
+//
+// detail/timer_wheel.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
+#define BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/limits.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/timer_op.hpp>
+#include <boost/asio/detail/timer_queue_base.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A timer queue implemented as a hierarchical timing wheel. Time is measured
+// in ticks of Time_Traits::resolution microseconds since the queue was
+// created. The first level of the wheel has one slot for each of the next 256
+// ticks. Each of the four higher levels has 64 slots, with each slot covering
+// the entire span of the level below. A timer is linked into the slot that
+// covers its expiry tick, and is moved down a level ("cascaded") when the
+// wheel reaches the start of the span covered by its slot. Scheduling and
+// cancelling a timer are therefore constant time operations.
+template <typename Time_Traits>
+class timer_wheel
+  : public timer_queue_base
+{
+public:
+  // The time type.
+  typedef typename Time_Traits::time_type time_type;
+
+  // The duration type.
+  typedef typename Time_Traits::duration_type duration_type;
+
+  // Per-timer data.
+  class per_timer_data
+  {
+  public:
+    per_timer_data()
+      : expiry_(0),
+        slot_(~static_cast<std::size_t>(0)),
+        next_(0),
+        prev_(0)
+    {
+    }
+
+  private:
+    friend class timer_wheel;
+
+    // The operations waiting on the timer.
+    op_queue<timer_op> op_queue_;
+
+    // The tick at which the timer expires.
+    boost::uint64_t expiry_;
+
+    // The list to which the timer is linked, or not_queued.
+    std::size_t slot_;
+
+    // Pointers to adjacent timers in the slot's linked list.
+    per_timer_data* next_;
+    per_timer_data* prev_;
+  };
+
+  // Constructor.
+  timer_wheel()
+    : origin_(Time_Traits::now()),
+      current_(0),
+      earliest_((std::numeric_limits<boost::uint64_t>::max)()),
+      count_(0),
+      wheel_count_(0)
+  {
+    for (std::size_t i = 0; i < num_lists; ++i)
+      slots_[i] = 0;
+    for (std::size_t i = 0; i < bitmap_words; ++i)
+      bitmap_[i] = 0;
+  }
+
+  // Add a new timer to the queue. Returns true if this timer may be the
+  // earliest in the queue, in which case the reactor's event demultiplexing
+  // function call may need to be interrupted and restarted.
+  bool enqueue_timer(const time_type& time, per_timer_data& timer, timer_op* op)
+  {
+    bool earliest = false;
+
+    // Enqueue the timer object.
+    if (timer.slot_ == not_queued)
+    {
+      if (is_positive_infinity(time))
+      {
+        // Timers that never expire are kept out of the wheel.
+        link_timer(timer, infinite_list);
+      }
+      else
+      {
+        timer.expiry_ = to_ticks(time, true);
+        earliest = timer.expiry_ < earliest_;
+        if (earliest)
+          earliest_ = timer.expiry_;
+        insert_timer(timer);
+      }
+    }
+
+    // Enqueue the individual timer operation.
+    timer.op_queue_.push(op);
+
+    // Interrupt reactor only if newly added timer may be first to expire.
+    return earliest && timer.op_queue_.front() == op;
+  }
+
+  // Whether there are no timers in the queue.
+  virtual bool empty() const
+  {
+    return count_ == 0;
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_msec(long max_duration) const
+  {
+    boost::int64_t usec = wait_duration(max_duration * 1000LL);
+    return static_cast<long>((usec + 999) / 1000);
+  }
+
+  // Get the time for the timer that is earliest in the queue.
+  virtual long wait_duration_usec(long max_duration) const
+  {
+    return static_cast<long>(wait_duration(max_duration));
+  }
+
+  // Dequeue all timers not later than the current time.
+  virtual void get_ready_timers(op_queue<operation>& ops)
+  {
+    boost::uint64_t now = to_ticks(Time_Traits::now(), false);
+
+    // Visit only those ticks at which timers expire or must be cascaded.
+    boost::uint64_t next;
+    while (current_ <= now && (next = next_event()) <= now)
+    {
+      current_ = next;
+      std::size_t index = static_cast<std::size_t>(current_ & level0_mask);
+      if (index == 0)
+        cascade();
+
+      while (per_timer_data* timer = slots_[index])
+      {
+        ops.push(timer->op_queue_);
+        unlink_timer(*timer);
+      }
+
+      ++current_;
+    }
+
+    if (current_ <= now)
+      current_ = now + 1;
+
+    while (per_timer_data* timer = slots_[ready_list])
+    {
+      ops.push(timer->op_queue_);
+      unlink_timer(*timer);
+    }
+  }
+
+  // Dequeue all timers.
+  virtual void get_all_timers(op_queue<operation>& ops)
+  {
+    for (std::size_t i = 0; i < num_lists; ++i)
+    {
+      while (per_timer_data* timer = slots_[i])
+      {
+        ops.push(timer->op_queue_);
+        unlink_timer(*timer);
+      }
+    }
+  }
+
+  // Cancel and dequeue operations for the given timer.
+  std::size_t cancel_timer(per_timer_data& timer, op_queue<operation>& ops,
+      std::size_t max_cancelled = (std::numeric_limits<std::size_t>::max)())
+  {
+    std::size_t num_cancelled = 0;
+    if (timer.slot_ != not_queued)
+    {
+      while (timer_op* op = (num_cancelled != max_cancelled)
+          ? timer.op_queue_.front() : 0)
+      {
+        op->ec_ = boost::asio::error::operation_aborted;
+        timer.op_queue_.pop();
+        ops.push(op);
+        ++num_cancelled;
+      }
+      if (timer.op_queue_.empty())
+        unlink_timer(timer);
+    }
+    return num_cancelled;
+  }
+
+private:
+  // The geometry of the wheel.
+  enum
+  {
+    level0_bits = 8,
+    level0_size = 1 << level0_bits,
+    level0_mask = level0_size - 1,
+    level_bits = 6,
+    level_size = 1 << level_bits,
+    level_mask = level_size - 1,
+    num_levels = 5,
+    num_slots = level0_size + (num_levels - 1) * level_size,
+    max_delta_bits = level0_bits + (num_levels - 1) * level_bits
+  };
+
+  // Lists that are not part of the wheel.
+  enum
+  {
+    // Timers whose expiry tick has already been passed.
+    ready_list = num_slots,
+
+    // Timers that never expire.
+    infinite_list = num_slots + 1,
+
+    // The total number of lists.
+    num_lists = num_slots + 2
+  };
+
+  // The slot value used for timers that are not in the queue.
+  BOOST_STATIC_CONSTANT(std::size_t,
+      not_queued = ~static_cast<std::size_t>(0));
+
+  // The number of words in the bitmap of non-empty slots.
+  BOOST_STATIC_CONSTANT(std::size_t, bitmap_words = num_slots / 32);
+
+  // Convert an absolute time to a tick, rounding up or down.
+  boost::uint64_t to_ticks(const time_type& time, bool round_up) const
+  {
+    boost::posix_time::time_duration d = Time_Traits::to_posix_duration(
+        Time_Traits::subtract(time, origin_));
+    if (d.is_special())
+    {
+      if (d.is_negative())
+        return 0;
+      return (std::numeric_limits<boost::uint64_t>::max)();
+    }
+
+    boost::int64_t usec = d.total_microseconds();
+    if (usec <= 0)
+      return 0;
+
+    boost::uint64_t ticks = static_cast<boost::uint64_t>(usec);
+    if (round_up)
+      ticks += resolution() - 1;
+    return ticks / resolution();
+  }
+
+  // The duration of one tick, in microseconds.
+  static boost::uint64_t resolution()
+  {
+    return Time_Traits::resolution;
+  }
+
+  // Get the number of microseconds until the next tick at which timers may
+  // need to be processed, limited to the given maximum.
+  boost::int64_t wait_duration(boost::int64_t max_duration) const
+  {
+    if (slots_[ready_list])
+    {
+      earliest_ = 0;
+      return 0;
+    }
+    if (wheel_count_ == 0)
+    {
+      earliest_ = (std::numeric_limits<boost::uint64_t>::max)();
+      return max_duration;
+    }
+
+    // Record the tick that the reactor will wait for, so that scheduling an
+    // earlier timer can interrupt the wait.
+    boost::uint64_t next = next_event();
+    earliest_ = next;
+
+    // The elapsed time is measured directly, rather than in ticks, so that the
+    // wait ends on a tick boundary.
+    boost::posix_time::time_duration elapsed = Time_Traits::to_posix_duration(
+        Time_Traits::subtract(Time_Traits::now(), origin_));
+    boost::int64_t usec = static_cast<boost::int64_t>(next * resolution())
+      - elapsed.total_microseconds();
+
+    if (usec > max_duration)
+      return max_duration;
+    if (usec <= 0)
+      return 0;
+    return usec;
+  }
+
+  // Find the first tick, not earlier than current_, at which timers in the
+  // wheel either expire or need to be cascaded. Ticks at which only empty
+  // slots would be cascaded are skipped. Must only be called when the wheel
+  // is not empty.
+  boost::uint64_t next_event() const
+  {
+    boost::uint64_t base = current_;
+    std::size_t first_slot = 0;
+    std::size_t shift = 0;
+    std::size_t bits = level0_bits;
+    for (std::size_t level = 0; level < num_levels; ++level)
+    {
+      if (cascades_at(base))
+        return base;
+
+      // Find the first occupied slot in the rest of this level's rotation.
+      std::size_t size = static_cast<std::size_t>(1) << bits;
+      std::size_t index = static_cast<std::size_t>(
+          (base >> shift) & (size - 1));
+      boost::uint64_t span = static_cast<boost::uint64_t>(1) << (shift + bits);
+      boost::uint64_t rotation_start = base & ~(span - 1);
+
+      std::size_t slot = find_slot(first_slot, size, index);
+      if (slot < size)
+        return rotation_start + (static_cast<boost::uint64_t>(slot) << shift);
+
+      // The slots before the index belong to the level's next rotation, which
+      // starts when the next level is cascaded.
+      boost::uint64_t next_rotation = base == rotation_start
+        ? base : rotation_start + span;
+      if (index != 0 && find_slot(first_slot, size, 0) < index)
+        return next_rotation;
+
+      base = next_rotation;
+      first_slot += size;
+      shift += bits;
+      bits = level_bits;
+    }
+
+    return base;
+  }
+
+  // Whether any timers will be cascaded when the wheel reaches the given tick.
+  bool cascades_at(boost::uint64_t tick) const
+  {
+    if (tick & level0_mask)
+      return false;
+
+    std::size_t shift = level0_bits;
+    for (std::size_t level = 1; level < num_levels; ++level)
+    {
+      std::size_t index = static_cast<std::size_t>(
+          (tick >> shift) & level_mask);
+      if (slots_[level0_size + (level - 1) * level_size + index])
+        return true;
+      if (index != 0)
+        return false;
+      shift += level_bits;
+    }
+
+    return false;
+  }
+
+  // Find the first non-empty slot, with an index not less than the given
+  // index, in the level of the wheel that starts at first_slot. Returns size
+  // if there is none.
+  std::size_t find_slot(std::size_t first_slot,
+      std::size_t size, std::size_t index) const
+  {
+    if (index >= size)
+      return size;
+
+    std::size_t word = (first_slot + index) / 32;
+    std::size_t last_word = (first_slot + size) / 32;
+    boost::uint32_t bits = bitmap_[word]
+      & (~static_cast<boost::uint32_t>(0) << (index % 32));
+    while (bits == 0)
+    {
+      if (++word == last_word)
+        return size;
+      bits = bitmap_[word];
+    }
+
+    return word * 32 + lowest_bit(bits) - first_slot;
+  }
+
+  // Get the index of the lowest set bit in a non-zero value.
+  static std::size_t lowest_bit(boost::uint32_t bits)
+  {
+#if defined(__GNUC__)
+    return __builtin_ctz(bits);
+#else // defined(__GNUC__)
+    std::size_t n = 0;
+    while ((bits & 1) == 0)
+    {
+      bits >>= 1;
+      ++n;
+    }
+    return n;
+#endif // defined(__GNUC__)
+  }
+
+  // Link a timer into the wheel slot that covers its expiry tick.
+  void insert_timer(per_timer_data& timer)
+  {
+    if (timer.expiry_ < current_)
+    {
+      link_timer(timer, ready_list);
+      return;
+    }
+
+    // Timers beyond the range of the wheel are placed in the last slot that
+    // can be reached. They will be reinserted when that slot is cascaded.
+    boost::uint64_t delta = timer.expiry_ - current_;
+    boost::uint64_t expiry = timer.expiry_;
+    if (delta >> max_delta_bits)
+    {
+      delta = (static_cast<boost::uint64_t>(1) << max_delta_bits) - 1;
+      expiry = current_ + delta;
+    }
+
+    if (delta < level0_size)
+    {
+      link_timer(timer, static_cast<std::size_t>(expiry & level0_mask));
+      return;
+    }
+
+    std::size_t level = 1;
+    std::size_t shift = level0_bits;
+    while (delta >> (shift + level_bits))
+    {
+      ++level;
+      shift += level_bits;
+    }
+
+    std::size_t slot = level0_size + (level - 1) * level_size
+      + static_cast<std::size_t>((expiry >> shift) & level_mask);
+    link_timer(timer, slot);
+  }
+
+  // Move timers down from the higher levels of the wheel. Called when the
+  // first level is about to start a new revolution.
+  void cascade()
+  {
+    std::size_t shift = level0_bits;
+    for (std::size_t level = 1; level < num_levels; ++level)
+    {
+      std::size_t index = static_cast<std::size_t>(
+          (current_ >> shift) & level_mask);
+      std::size_t slot = level0_size + (level - 1) * level_size + index;
+
+      // Reinsertion links each timer into a different slot, so the list must be
+      // walked using the saved next pointer.
+      per_timer_data* timer = slots_[slot];
+      while (timer)
+      {
+        per_timer_data* next = timer->next_;
+        unlink_timer(*timer);
+        insert_timer(*timer);
+        timer = next;
+      }
+
+      if (index != 0)
+        break;
+      shift += level_bits;
+    }
+  }
+
+  // Add a timer to the front of the given list.
+  void link_timer(per_timer_data& timer, std::size_t slot)
+  {
+    timer.slot_ = slot;
+    timer.prev_ = 0;
+    timer.next_ = slots_[slot];
+    if (timer.next_)
+      timer.next_->prev_ = &timer;
+    slots_[slot] = &timer;
+
+    if (slot < num_slots)
+    {
+      ++wheel_count_;
+      bitmap_[slot / 32] |= static_cast<boost::uint32_t>(1) << (slot % 32);
+    }
+
+    ++count_;
+  }
+
+  // Remove a timer from the list it is linked to.
+  void unlink_timer(per_timer_data& timer)
+  {
+    std::size_t slot = timer.slot_;
+    if (slots_[slot] == &timer)
+      slots_[slot] = timer.next_;
+    if (timer.prev_)
+      timer.prev_->next_ = timer.next_;
+    if (timer.next_)
+      timer.next_->prev_ = timer.prev_;
+    timer.next_ = 0;
+    timer.prev_ = 0;
+    timer.slot_ = not_queued;
+
+    if (slot < num_slots)
+    {
+      --wheel_count_;
+      if (slots_[slot] == 0)
+        bitmap_[slot / 32] &= ~(static_cast<boost::uint32_t>(1) << (slot % 32));
+    }
+
+    --count_;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  template <typename Time_Type>
+  static bool is_positive_infinity(const Time_Type&)
+  {
+    return false;
+  }
+
+  // Determine if the specified absolute time is positive infinity.
+  static bool is_positive_infinity(const boost::posix_time::ptime& time)
+  {
+    return time == boost::posix_time::pos_infin;
+  }
+
+  // The time corresponding to tick zero.
+  time_type origin_;
+
+  // The next tick to be processed.
+  boost::uint64_t current_;
+
+  // The tick that the reactor was last told to wait for.
+  mutable boost::uint64_t earliest_;
+
+  // The number of timers in the queue.
+  std::size_t count_;
+
+  // The number of timers linked into the slots of the wheel.
+  std::size_t wheel_count_;
+
+  // The heads of the slot lists, followed by the ready and infinite lists.
+  per_timer_data* slots_[num_lists];
+
+  // Bitmap of the non-empty slots of the wheel.
+  boost::uint32_t bitmap_[bitmap_words];
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TIMER_WHEEL_HPP
@@ -21,6 +21,9 @@
 
 #include <boost/limits.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/handler_memory_service.hpp>
+#include <boost/asio/detail/io_service_stats_service.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/scoped_ptr.hpp>
@@ -45,6 +48,10 @@ class win_iocp_io_service
   : public boost::asio::detail::service_base<win_iocp_io_service>
 {
 public:
+  // The call stack used to determine whether the current thread is running
+  // the io_service.
+  typedef call_stack<win_iocp_io_service> thread_call_stack;
+
   // Constructor.
   BOOST_ASIO_DECL win_iocp_io_service(boost::asio::io_service& io_service);
 
@@ -114,6 +121,8 @@ public:
   // that work_started() has not yet been called for the operation.
   void post_immediate_completion(win_iocp_operation* op)
   {
+    if (stats_.enabled())
+      stats_.handler_posted();
     work_started();
     post_deferred_completion(op);
   }
@@ -204,6 +213,12 @@ private:
     ~auto_handle() { if (handle) ::CloseHandle(handle); }
   };
 
+  // The service that controls recycling of handler memory.
+  handler_memory_service& memory_service_;
+
+  // The service that records statistics.
+  io_service_stats_service& stats_;
+
   // The IO completion port used for queueing operations.
   auto_handle iocp_;
 
@@ -17,6 +17,7 @@
 
 #include <boost/asio/detail/config.hpp>
 #include <cstddef>
+#include <boost/asio/detail/handler_memory_cache.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -32,10 +33,11 @@ namespace asio {
  * Implement asio_handler_allocate and asio_handler_deallocate for your own
  * handlers to provide custom allocation for these temporary objects.
  *
- * This default implementation is simply:
- * @code
- * return ::operator new(size);
- * @endcode
+ * The default implementation uses ::operator new(). If handler recycling has
+ * been enabled for an io_service, using boost::asio::handler_recycling, then
+ * allocations made by a thread that is running that io_service are instead
+ * satisfied, where possible, from a cache of recently freed blocks that is
+ * private to the thread.
  *
  * @note All temporary objects associated with a handler will be deallocated
  * before the upcall to the handler is performed. This allows the same memory to
@@ -59,7 +61,7 @@ namespace asio {
  */
 inline void* asio_handler_allocate(std::size_t size, ...)
 {
-  return ::operator new(size);
+  return detail::handler_memory_cache::allocate(size);
 }
 
 /// Default deallocation function for handlers.
@@ -67,17 +69,14 @@ inline void* asio_handler_allocate(std::size_t size, ...)
  * Implement asio_handler_allocate and asio_handler_deallocate for your own
  * handlers to provide custom allocation for the associated temporary objects.
  *
- * This default implementation is simply:
- * @code
- * ::operator delete(pointer);
- * @endcode
+ * The default implementation uses ::operator delete(), or returns the memory
+ * to the calling thread's cache if handler recycling is in use.
  *
  * @sa asio_handler_allocate.
  */
 inline void asio_handler_deallocate(void* pointer, std::size_t size, ...)
 {
-  (void)(size);
-  ::operator delete(pointer);
+  detail::handler_memory_cache::deallocate(pointer, size);
 }
 
 } // namespace asio
@@ -0,0 +1,136 @@
+//
+// handler_recycling.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_HANDLER_RECYCLING_HPP
+#define BOOST_ASIO_HANDLER_RECYCLING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/handler_memory_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Controls the recycling of handler memory for an io_service.
+/**
+ * Each asynchronous operation needs memory to hold a copy of its handler and
+ * other state. Unless a handler provides its own asio_handler_allocate()
+ * function, this memory is obtained from the default allocation hook, which
+ * uses the global operator new.
+ *
+ * When recycling is enabled, each call to the io_service's run(), run_one(),
+ * poll() or poll_one() functions creates a cache that is private to the
+ * calling thread. Memory released by the default hook on that thread is kept
+ * in the cache, in free lists segregated by size, and reused for later
+ * allocations of the same size class without locking. Blocks of up to 1024
+ * bytes are recycled, and a small number of free blocks is kept for each size
+ * class. The cached memory is released when the call returns.
+ *
+ * Recycling is only available if the macro
+ * BOOST_ASIO_ENABLE_HANDLER_RECYCLING is defined, since it adds a byte to
+ * each allocation made by the default hook. Without it, enabled(true) has no
+ * effect. Recycling is disabled by default. A change takes effect for
+ * subsequent calls to run(), run_one(), poll() and poll_one().
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * boost::asio::io_service io_service;
+ * boost::asio::handler_recycling recycling(io_service);
+ * recycling.enabled(true);
+ * ...
+ * io_service.run();
+ * boost::asio::handler_recycling::statistics s = recycling.get_statistics();
+ * std::size_t reused = s.allocations - s.heap_allocations;
+ * @endcode
+ */
+class handler_recycling
+{
+public:
+  /// Counters describing the allocations made through the default hook.
+  /**
+   * Only allocations made by threads inside a call to run(), run_one(),
+   * poll() or poll_one() while recycling is enabled are counted. The counters
+   * are updated without synchronisation by the threads that make the
+   * allocations, so a snapshot taken while the io_service is running may be
+   * slightly out of date.
+   */
+  struct statistics
+  {
+    /// The number of allocations made.
+    std::size_t allocations;
+
+    /// The number of deallocations made.
+    std::size_t deallocations;
+
+    /// The number of allocations that could not reuse a cached block and so
+    /// were passed to the global operator new.
+    std::size_t heap_allocations;
+
+    /// The number of deallocations that were passed to the global operator
+    /// delete, including those made when a cache is destroyed.
+    std::size_t heap_deallocations;
+  };
+
+  /// Construct a handler_recycling object for the specified io_service.
+  explicit handler_recycling(boost::asio::io_service& io_service)
+    : service_(boost::asio::use_service<
+        boost::asio::detail::handler_memory_service>(io_service))
+  {
+  }
+
+  /// Enable or disable recycling.
+  void enabled(bool value)
+  {
+    service_.enabled(value);
+  }
+
+  /// Determine whether recycling is enabled.
+  bool enabled() const
+  {
+    return service_.enabled();
+  }
+
+  /// Get a snapshot of the counters.
+  statistics get_statistics() const
+  {
+    boost::asio::detail::handler_memory_service::statistics s
+      = service_.get_statistics();
+    statistics result = { s.allocations, s.deallocations,
+      s.heap_allocations, s.heap_deallocations };
+    return result;
+  }
+
+  /// Reset the counters to zero.
+  void reset_statistics()
+  {
+    service_.reset_statistics();
+  }
+
+private:
+  boost::asio::detail::handler_memory_service& service_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_HANDLER_RECYCLING_HPP
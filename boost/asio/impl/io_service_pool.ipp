@@ -0,0 +1,140 @@
+//
+// impl/io_service_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
+#define BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/io_service_pool.hpp>
+#include <boost/asio/detail/thread.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+struct io_service_pool::run_function
+{
+  void operator()()
+  {
+    io_service_->run();
+  }
+
+  boost::asio::io_service* io_service_;
+};
+
+io_service_pool::io_service_pool(std::size_t pool_size)
+  : next_io_service_(0)
+{
+  if (pool_size == 0)
+    pool_size = 1;
+
+  io_services_.reserve(pool_size);
+  work_.reserve(pool_size);
+
+  try
+  {
+    // Give all the io_services work to do so that their run() functions will
+    // not exit until they are explicitly stopped.
+    for (std::size_t i = 0; i < pool_size; ++i)
+    {
+      io_services_.push_back(0);
+      io_services_.back() = new boost::asio::io_service(1);
+      work_.push_back(0);
+      work_.back() = new boost::asio::io_service::work(*io_services_.back());
+    }
+  }
+  catch (...)
+  {
+    for (std::size_t i = work_.size(); i > 0; --i)
+      delete work_[i - 1];
+    for (std::size_t i = io_services_.size(); i > 0; --i)
+      delete io_services_[i - 1];
+    throw;
+  }
+}
+
+io_service_pool::~io_service_pool()
+{
+  for (std::size_t i = work_.size(); i > 0; --i)
+    delete work_[i - 1];
+  for (std::size_t i = io_services_.size(); i > 0; --i)
+    delete io_services_[i - 1];
+}
+
+boost::asio::io_service& io_service_pool::get_io_service()
+{
+  // Use a round-robin scheme to choose the next io_service to use.
+  boost::asio::io_service& io_service = *io_services_[next_io_service_];
+  if (++next_io_service_ == io_services_.size())
+    next_io_service_ = 0;
+  return io_service;
+}
+
+void io_service_pool::run()
+{
+  // Run all but the first io_service in new threads, and the first in the
+  // calling thread.
+  std::vector<boost::asio::detail::thread*> threads;
+  threads.reserve(io_services_.size());
+  try
+  {
+    for (std::size_t i = 1; i < io_services_.size(); ++i)
+    {
+      run_function f = { io_services_[i] };
+      threads.push_back(0);
+      threads.back() = new boost::asio::detail::thread(f);
+    }
+    io_services_[0]->run();
+  }
+  catch (...)
+  {
+    stop();
+    for (std::size_t i = 0; i < threads.size(); ++i)
+    {
+      if (threads[i])
+      {
+        threads[i]->join();
+        delete threads[i];
+      }
+    }
+    throw;
+  }
+
+  // Wait for all threads in the pool to exit.
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+}
+
+void io_service_pool::stop()
+{
+  for (std::size_t i = 0; i < io_services_.size(); ++i)
+    io_services_[i]->stop();
+}
+
+void io_service_pool::reset()
+{
+  for (std::size_t i = 0; i < io_services_.size(); ++i)
+    io_services_[i]->reset();
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_IO_SERVICE_POOL_IPP
@@ -0,0 +1,255 @@
+//
+// impl/sendfile.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_SENDFILE_HPP
+#define BOOST_ASIO_IMPL_SENDFILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <boost/asio/detail/handler_type_requirements.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+template <typename Protocol, typename StreamSocketService>
+std::size_t sendfile(basic_stream_socket<Protocol, StreamSocketService>& s,
+    int fd, boost::uint64_t offset, std::size_t length,
+    boost::system::error_code& ec)
+{
+  ec = boost::system::error_code();
+  std::size_t total_transferred = 0;
+  while (total_transferred < length)
+  {
+    int bytes = detail::socket_ops::sendfile(s.native_handle(),
+        fd, offset, length - total_transferred, ec);
+
+    if (bytes > 0)
+    {
+      total_transferred += bytes;
+      continue;
+    }
+
+    // A successful transfer of zero bytes means the end of the file.
+    if (bytes == 0)
+    {
+      ec = boost::asio::error::eof;
+      break;
+    }
+
+    // Retry the operation immediately if interrupted by a signal.
+    if (ec == boost::asio::error::interrupted)
+      continue;
+
+    // The underlying socket may be in non-blocking mode because of an
+    // asynchronous operation. Wait for it to become ready unless the user has
+    // asked for non-blocking behaviour.
+    if ((ec == boost::asio::error::would_block
+          || ec == boost::asio::error::try_again)
+        && !s.non_blocking())
+    {
+      s.write_some(boost::asio::null_buffers(), ec);
+      if (!ec)
+        continue;
+    }
+
+    break;
+  }
+
+  return total_transferred;
+}
+
+template <typename Protocol, typename StreamSocketService>
+inline std::size_t sendfile(
+    basic_stream_socket<Protocol, StreamSocketService>& s,
+    int fd, boost::uint64_t offset, std::size_t length)
+{
+  boost::system::error_code ec;
+  std::size_t bytes_transferred = sendfile(s, fd, offset, length, ec);
+  boost::asio::detail::throw_error(ec, "sendfile");
+  return bytes_transferred;
+}
+
+namespace detail
+{
+  template <typename Protocol, typename StreamSocketService,
+      typename WriteHandler>
+  class sendfile_op
+  {
+  public:
+    sendfile_op(basic_stream_socket<Protocol, StreamSocketService>& socket,
+        int fd, boost::uint64_t offset, std::size_t length,
+        WriteHandler& handler)
+      : socket_(socket),
+        fd_(fd),
+        offset_(offset),
+        length_(length),
+        total_transferred_(0),
+        handler_(BOOST_ASIO_MOVE_CAST(WriteHandler)(handler))
+    {
+    }
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+    sendfile_op(const sendfile_op& other)
+      : socket_(other.socket_),
+        fd_(other.fd_),
+        offset_(other.offset_),
+        length_(other.length_),
+        total_transferred_(other.total_transferred_),
+        handler_(other.handler_)
+    {
+    }
+
+    sendfile_op(sendfile_op&& other)
+      : socket_(other.socket_),
+        fd_(other.fd_),
+        offset_(other.offset_),
+        length_(other.length_),
+        total_transferred_(other.total_transferred_),
+        handler_(BOOST_ASIO_MOVE_CAST(WriteHandler)(other.handler_))
+    {
+    }
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+    void operator()(boost::system::error_code ec,
+        std::size_t /*bytes_transferred*/, int start = 0)
+    {
+      // The system call is made directly, so the socket must be in
+      // non-blocking mode.
+      if (!ec && !socket_.native_non_blocking())
+        socket_.native_non_blocking(true, ec);
+
+      while (!ec && total_transferred_ < length_)
+      {
+        int bytes = socket_ops::sendfile(socket_.native_handle(),
+            fd_, offset_, length_ - total_transferred_, ec);
+
+        if (bytes > 0)
+        {
+          total_transferred_ += bytes;
+        }
+        else if (bytes == 0)
+        {
+          // A successful transfer of zero bytes means the end of the file.
+          ec = boost::asio::error::eof;
+        }
+        else if (ec == boost::asio::error::interrupted)
+        {
+          ec = boost::system::error_code();
+        }
+        else if (ec == boost::asio::error::would_block
+            || ec == boost::asio::error::try_again)
+        {
+          // Wait for the socket to become ready again.
+          socket_.async_write_some(boost::asio::null_buffers(),
+              BOOST_ASIO_MOVE_CAST(sendfile_op)(*this));
+          return;
+        }
+      }
+
+      if (start)
+      {
+        // The handler must not be called from the initiating function.
+        socket_.get_io_service().post(detail::bind_handler(
+              handler_, ec, total_transferred_));
+      }
+      else
+      {
+        handler_(ec, static_cast<const std::size_t&>(total_transferred_));
+      }
+    }
+
+  //private:
+    basic_stream_socket<Protocol, StreamSocketService>& socket_;
+    int fd_;
+    boost::uint64_t offset_;
+    std::size_t length_;
+    std::size_t total_transferred_;
+    WriteHandler handler_;
+  };
+
+  template <typename Protocol, typename StreamSocketService,
+      typename WriteHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      sendfile_op<Protocol, StreamSocketService, WriteHandler>* this_handler)
+  {
+    return boost_asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename StreamSocketService,
+      typename WriteHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      sendfile_op<Protocol, StreamSocketService, WriteHandler>* this_handler)
+  {
+    boost_asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol,
+      typename StreamSocketService, typename WriteHandler>
+  inline void asio_handler_invoke(Function& function,
+      sendfile_op<Protocol, StreamSocketService, WriteHandler>* this_handler)
+  {
+    boost_asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol,
+      typename StreamSocketService, typename WriteHandler>
+  inline void asio_handler_invoke(const Function& function,
+      sendfile_op<Protocol, StreamSocketService, WriteHandler>* this_handler)
+  {
+    boost_asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename StreamSocketService,
+      typename WriteHandler>
+  inline sendfile_op<Protocol, StreamSocketService, WriteHandler>
+  make_sendfile_op(basic_stream_socket<Protocol, StreamSocketService>& s,
+      int fd, boost::uint64_t offset, std::size_t length, WriteHandler handler)
+  {
+    return sendfile_op<Protocol, StreamSocketService, WriteHandler>(
+        s, fd, offset, length, handler);
+  }
+} // namespace detail
+
+template <typename Protocol, typename StreamSocketService,
+    typename WriteHandler>
+inline void async_sendfile(
+    basic_stream_socket<Protocol, StreamSocketService>& s,
+    int fd, boost::uint64_t offset, std::size_t length,
+    BOOST_ASIO_MOVE_ARG(WriteHandler) handler)
+{
+  // If you get an error on the following line it means that your handler does
+  // not meet the documented type requirements for a WriteHandler.
+  BOOST_ASIO_WRITE_HANDLER_CHECK(WriteHandler, handler) type_check;
+
+  detail::make_sendfile_op(s, fd, offset, length,
+      BOOST_ASIO_MOVE_CAST(WriteHandler)(handler))(
+        boost::system::error_code(), 0, 1);
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_SENDFILE_HPP
@@ -0,0 +1,172 @@
+//
+// impl/zero_copy.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_ZERO_COPY_HPP
+#define BOOST_ASIO_IMPL_ZERO_COPY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+template <typename Protocol, typename StreamSocketService>
+bool read_zero_copy_completion(
+    basic_stream_socket<Protocol, StreamSocketService>& s,
+    zero_copy_completion& completion, boost::system::error_code& ec)
+{
+  return detail::socket_ops::recv_zero_copy_completion(s.native_handle(),
+      completion.first, completion.last, completion.copied, ec) == 0;
+}
+
+namespace detail
+{
+  template <typename Protocol, typename StreamSocketService,
+      typename ZeroCopyHandler>
+  class zero_copy_completion_op
+  {
+  public:
+    zero_copy_completion_op(
+        basic_stream_socket<Protocol, StreamSocketService>& socket,
+        ZeroCopyHandler& handler)
+      : socket_(socket),
+        handler_(BOOST_ASIO_MOVE_CAST(ZeroCopyHandler)(handler))
+    {
+    }
+
+#if defined(BOOST_ASIO_HAS_MOVE)
+    zero_copy_completion_op(const zero_copy_completion_op& other)
+      : socket_(other.socket_),
+        handler_(other.handler_)
+    {
+    }
+
+    zero_copy_completion_op(zero_copy_completion_op&& other)
+      : socket_(other.socket_),
+        handler_(BOOST_ASIO_MOVE_CAST(ZeroCopyHandler)(other.handler_))
+    {
+    }
+#endif // defined(BOOST_ASIO_HAS_MOVE)
+
+    void operator()(boost::system::error_code ec,
+        std::size_t /*bytes_transferred*/, int start = 0)
+    {
+      zero_copy_completion completion = { 0, 0, false };
+      if (!ec)
+      {
+        read_zero_copy_completion(socket_, completion, ec);
+        if (ec == boost::asio::error::would_block
+            || ec == boost::asio::error::try_again)
+        {
+          // Wait for the error queue to become non-empty. The reactor reports
+          // error conditions to operations waiting for out-of-band data.
+          socket_.async_receive(boost::asio::null_buffers(),
+              socket_base::message_out_of_band,
+              BOOST_ASIO_MOVE_CAST(zero_copy_completion_op)(*this));
+          return;
+        }
+      }
+
+      if (start)
+      {
+        // The handler must not be called from the initiating function.
+        socket_.get_io_service().post(
+            detail::bind_handler(handler_, ec, completion));
+      }
+      else
+      {
+        handler_(ec, static_cast<const zero_copy_completion&>(completion));
+      }
+    }
+
+  //private:
+    basic_stream_socket<Protocol, StreamSocketService>& socket_;
+    ZeroCopyHandler handler_;
+  };
+
+  template <typename Protocol, typename StreamSocketService,
+      typename ZeroCopyHandler>
+  inline void* asio_handler_allocate(std::size_t size,
+      zero_copy_completion_op<Protocol,
+        StreamSocketService, ZeroCopyHandler>* this_handler)
+  {
+    return boost_asio_handler_alloc_helpers::allocate(
+        size, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename StreamSocketService,
+      typename ZeroCopyHandler>
+  inline void asio_handler_deallocate(void* pointer, std::size_t size,
+      zero_copy_completion_op<Protocol,
+        StreamSocketService, ZeroCopyHandler>* this_handler)
+  {
+    boost_asio_handler_alloc_helpers::deallocate(
+        pointer, size, this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol,
+      typename StreamSocketService, typename ZeroCopyHandler>
+  inline void asio_handler_invoke(Function& function,
+      zero_copy_completion_op<Protocol,
+        StreamSocketService, ZeroCopyHandler>* this_handler)
+  {
+    boost_asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Function, typename Protocol,
+      typename StreamSocketService, typename ZeroCopyHandler>
+  inline void asio_handler_invoke(const Function& function,
+      zero_copy_completion_op<Protocol,
+        StreamSocketService, ZeroCopyHandler>* this_handler)
+  {
+    boost_asio_handler_invoke_helpers::invoke(
+        function, this_handler->handler_);
+  }
+
+  template <typename Protocol, typename StreamSocketService,
+      typename ZeroCopyHandler>
+  inline zero_copy_completion_op<Protocol,
+      StreamSocketService, ZeroCopyHandler>
+  make_zero_copy_completion_op(
+      basic_stream_socket<Protocol, StreamSocketService>& s,
+      ZeroCopyHandler handler)
+  {
+    return zero_copy_completion_op<Protocol,
+      StreamSocketService, ZeroCopyHandler>(s, handler);
+  }
+} // namespace detail
+
+template <typename Protocol, typename StreamSocketService,
+    typename ZeroCopyHandler>
+inline void async_read_zero_copy_completion(
+    basic_stream_socket<Protocol, StreamSocketService>& s,
+    BOOST_ASIO_MOVE_ARG(ZeroCopyHandler) handler)
+{
+  detail::make_zero_copy_completion_op(s,
+      BOOST_ASIO_MOVE_CAST(ZeroCopyHandler)(handler))(
+        boost::system::error_code(), 0, 1);
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_ZERO_COPY_HPP
@@ -211,7 +211,10 @@ public:
    * Construct with a hint about the required level of concurrency.
    *
    * @param concurrency_hint A suggestion to the implementation on how many
-   * threads it should allow to run simultaneously.
+   * threads it should allow to run simultaneously. A value of 1 indicates that
+   * only one thread will call run() on the io_service, and allows handlers
+   * posted from that thread to be queued without locking. See
+   * boost::asio::io_service_pool for running one such io_service per thread.
    */
   BOOST_ASIO_DECL explicit io_service(std::size_t concurrency_hint);
 
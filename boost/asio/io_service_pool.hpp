@@ -0,0 +1,138 @@
+//
+// io_service_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IO_SERVICE_POOL_HPP
+#define BOOST_ASIO_IO_SERVICE_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// A pool of io_service objects, each of which is run by a single thread.
+/**
+ * The io_service_pool class provides a thread-per-reactor alternative to
+ * calling io_service::run() from many threads on one io_service. Each
+ * io_service in the pool is constructed with a concurrency hint of 1 and so
+ * owns its own reactor, timer queues and handler queue. An I/O object is
+ * pinned to the io_service that was used to construct it, and all of its
+ * handlers are invoked by the one thread that runs that io_service. Worker
+ * threads therefore never contend with one another for a shared lock.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe, except that stop() may be called
+ * concurrently from any thread, including from within a handler.
+ *
+ * @par Example
+ * Accepting connections on one io_service and running each connection on the
+ * next io_service in the pool:
+ * @code
+ * boost::asio::io_service_pool pool(4);
+ * boost::asio::ip::tcp::acceptor acceptor(pool.get_io_service(), endpoint);
+ * ...
+ * boost::asio::ip::tcp::socket* socket
+ *   = new boost::asio::ip::tcp::socket(pool.get_io_service());
+ * acceptor.async_accept(*socket, handler);
+ * ...
+ * pool.run(); // Blocks until pool.stop() is called.
+ * @endcode
+ */
+class io_service_pool
+  : private noncopyable
+{
+public:
+  /// Construct a pool containing the specified number of io_service objects.
+  /**
+   * @param pool_size The number of io_service objects, and therefore threads,
+   * in the pool. A value of 0 is treated as 1.
+   */
+  BOOST_ASIO_DECL explicit io_service_pool(std::size_t pool_size);
+
+  /// Destructor.
+  /**
+   * Destroys all io_service objects in the pool. Any threads started by run()
+   * must have exited before the pool is destroyed.
+   */
+  BOOST_ASIO_DECL ~io_service_pool();
+
+  /// Get the number of io_service objects in the pool.
+  std::size_t size() const
+  {
+    return io_services_.size();
+  }
+
+  /// Get the next io_service to use, chosen in round-robin order.
+  BOOST_ASIO_DECL boost::asio::io_service& get_io_service();
+
+  /// Get the io_service at the specified position in the pool.
+  boost::asio::io_service& get_io_service(std::size_t index)
+  {
+    return *io_services_[index];
+  }
+
+  /// Run all io_service objects in the pool.
+  /**
+   * Runs each io_service in its own thread, using the calling thread for the
+   * first, and blocks until all of them have exited. The io_service objects
+   * are kept busy with work, so run() does not return until stop() is called.
+   *
+   * @note Handlers must not allow exceptions to propagate out of the worker
+   * threads started by this function.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  BOOST_ASIO_DECL void run();
+
+  /// Stop all io_service objects in the pool.
+  /**
+   * Causes run() to return as soon as possible. A subsequent call to run()
+   * requires a prior call to reset().
+   */
+  BOOST_ASIO_DECL void stop();
+
+  /// Reset all io_service objects in the pool in preparation for a subsequent
+  /// run() invocation.
+  BOOST_ASIO_DECL void reset();
+
+private:
+  // Helper function object used to run one io_service in its own thread.
+  struct run_function;
+
+  // The pool of io_services.
+  std::vector<boost::asio::io_service*> io_services_;
+
+  // The work that keeps the io_services running.
+  std::vector<boost::asio::io_service::work*> work_;
+
+  // The next io_service to use for an I/O object.
+  std::size_t next_io_service_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/io_service_pool.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_IO_SERVICE_POOL_HPP
@@ -0,0 +1,210 @@
+//
+// io_service_stats.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IO_SERVICE_STATS_HPP
+#define BOOST_ASIO_IO_SERVICE_STATS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/cstdint.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/io_service_stats_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides run-time statistics for an io_service.
+/**
+ * The io_service_stats class records counters and histograms describing the
+ * handlers executed by an io_service. Recording is disabled by default. When
+ * it is enabled, the io_service reads a monotonic clock when each handler is
+ * queued, and before and after each handler runs, and updates the counters
+ * using atomic increments without taking any locks. Statistics may be read
+ * at any time, including while other threads are running the io_service.
+ *
+ * The histograms use buckets whose bounds are powers of two. Bucket 0 counts
+ * values of zero, and bucket @c i counts values in the range
+ * [2<sup>i-1</sup>, 2<sup>i</sup>). The last bucket also counts all larger
+ * values. Durations are measured in nanoseconds.
+ *
+ * The queue depth and delay histograms are only recorded by the io_service
+ * implementation used on platforms other than Windows. On Windows, handlers
+ * whose operations are completed by the operating system are not counted in
+ * @c operations_completed.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * boost::asio::io_service io_service;
+ * boost::asio::io_service_stats stats(io_service);
+ * stats.enabled(true);
+ * ...
+ * boost::asio::io_service_stats::statistics s = stats.get_statistics();
+ * boost::uint64_t p99 = s.run_delay.percentile(0.99);
+ * @endcode
+ */
+class io_service_stats
+{
+public:
+  /// The number of buckets in a histogram.
+#if defined(GENERATING_DOCUMENTATION)
+  static const std::size_t histogram_buckets = implementation_defined;
+#else
+  BOOST_STATIC_CONSTANT(std::size_t, histogram_buckets = boost::asio::detail
+      ::io_service_stats_service::histogram_buckets);
+#endif
+
+  /// A histogram of recorded values.
+  struct histogram
+  {
+    /// The number of values recorded in each bucket.
+    std::size_t counts[histogram_buckets];
+
+    /// Get the total number of values recorded.
+    std::size_t total() const
+    {
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < histogram_buckets; ++i)
+        n += counts[i];
+      return n;
+    }
+
+    /// Get the exclusive upper bound of the values counted by a bucket.
+    static boost::uint64_t upper_bound(std::size_t bucket)
+    {
+      return static_cast<boost::uint64_t>(1) << bucket;
+    }
+
+    /// Estimate a percentile of the recorded values.
+    /**
+     * @param fraction The percentile, as a value between 0 and 1.
+     *
+     * @returns The upper bound of the bucket that contains the percentile, or
+     * 0 if no values have been recorded.
+     */
+    boost::uint64_t percentile(double fraction) const
+    {
+      std::size_t n = total();
+      if (n == 0)
+        return 0;
+      std::size_t rank = static_cast<std::size_t>(fraction * n);
+      if (rank >= n)
+        rank = n - 1;
+      std::size_t seen = 0;
+      for (std::size_t i = 0; i < histogram_buckets; ++i)
+      {
+        seen += counts[i];
+        if (seen > rank)
+          return upper_bound(i);
+      }
+      return upper_bound(histogram_buckets - 1);
+    }
+  };
+
+  /// Counters describing the work done by the io_service.
+  /**
+   * The counters are updated individually, so a snapshot taken while the
+   * io_service is running may not be entirely consistent.
+   */
+  struct statistics
+  {
+    /// The number of handlers posted for immediate execution, such as by
+    /// io_service::post(), strands, or asynchronous operations that complete
+    /// immediately.
+    std::size_t handlers_posted;
+
+    /// The number of asynchronous operations completed by the reactor,
+    /// timers or other background processing.
+    std::size_t operations_completed;
+
+    /// The number of handlers run from the io_service's queue.
+    std::size_t handlers_run;
+
+    /// The number of times the io_service has run its reactor.
+    std::size_t task_runs;
+
+    /// The number of other handlers waiting in the queue each time a handler
+    /// is removed from it.
+    histogram queue_depth;
+
+    /// The time each handler spent in the queue before it was run.
+    histogram run_delay;
+
+    /// The time taken to run each handler.
+    histogram execution_time;
+  };
+
+  /// Construct an io_service_stats object for the specified io_service.
+  explicit io_service_stats(boost::asio::io_service& io_service)
+    : service_(boost::asio::use_service<
+        boost::asio::detail::io_service_stats_service>(io_service))
+  {
+  }
+
+  /// Enable or disable recording.
+  /**
+   * A change may not be seen immediately by threads that are running the
+   * io_service.
+   */
+  void enabled(bool value)
+  {
+    service_.enabled(value);
+  }
+
+  /// Determine whether recording is enabled.
+  bool enabled() const
+  {
+    return service_.enabled();
+  }
+
+  /// Get a snapshot of the statistics recorded since the last reset.
+  statistics get_statistics() const
+  {
+    boost::asio::detail::io_service_stats_service::statistics s
+      = service_.get_statistics();
+    statistics result;
+    result.handlers_posted = s.handlers_posted;
+    result.operations_completed = s.operations_completed;
+    result.handlers_run = s.handlers_run;
+    result.task_runs = s.task_runs;
+    for (std::size_t i = 0; i < histogram_buckets; ++i)
+    {
+      result.queue_depth.counts[i] = s.queue_depth.counts[i];
+      result.run_delay.counts[i] = s.run_delay.counts[i];
+      result.execution_time.counts[i] = s.execution_time.counts[i];
+    }
+    return result;
+  }
+
+  /// Reset the statistics to zero.
+  void reset_statistics()
+  {
+    service_.reset_statistics();
+  }
+
+private:
+  boost::asio::detail::io_service_stats_service& service_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IO_SERVICE_STATS_HPP
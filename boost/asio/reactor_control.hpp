@@ -0,0 +1,163 @@
+//
+// reactor_control.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_REACTOR_CONTROL_HPP
+#define BOOST_ASIO_REACTOR_CONTROL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_EPOLL) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/epoll_reactor.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides tuning and run-time counters for the reactor of an io_service.
+/**
+ * The reactor_control class gives access to the event demultiplexer that an
+ * io_service uses to wait for I/O readiness. It allows the number of events
+ * retrieved per wakeup to be set, and enables a busy-poll mode in which the
+ * reactor polls without blocking for a number of iterations before it blocks.
+ * Busy-polling trades CPU time for lower wakeup latency.
+ *
+ * The settings apply to the io_service as a whole and should be changed
+ * before any thread calls run() on it. This class is only available on
+ * platforms where the reactor is implemented using epoll.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * boost::asio::io_service io_service;
+ * boost::asio::reactor_control control(io_service);
+ * control.event_batch_size(512);
+ * control.busy_poll_count(1000);
+ * ...
+ * boost::asio::reactor_control::statistics s = control.get_statistics();
+ * double events_per_wakeup = s.waits ? double(s.events) / s.waits : 0;
+ * @endcode
+ */
+class reactor_control
+{
+public:
+  /// Counters describing the work done by the reactor.
+  /**
+   * The counters are updated without synchronisation by the thread running
+   * the reactor, so a snapshot taken while the io_service is running may be
+   * slightly out of date.
+   */
+  struct statistics
+  {
+    /// The number of times the reactor has waited for events.
+    std::size_t waits;
+
+    /// The number of events retrieved, including internal wakeup events.
+    std::size_t events;
+
+    /// The number of waits that retrieved no events.
+    std::size_t empty_waits;
+
+    /// The number of waits that retrieved event_batch_size() events. A large
+    /// value relative to waits suggests that the batch size should be raised.
+    std::size_t full_batches;
+
+    /// The number of non-blocking polls made while busy-polling.
+    std::size_t busy_polls;
+  };
+
+  /// The largest supported event batch size.
+#if defined(GENERATING_DOCUMENTATION)
+  static const std::size_t max_event_batch_size = implementation_defined;
+#else
+  BOOST_STATIC_CONSTANT(std::size_t, max_event_batch_size
+      = boost::asio::detail::epoll_reactor::max_event_batch_size);
+#endif
+
+  /// Construct a reactor_control for the specified io_service.
+  explicit reactor_control(boost::asio::io_service& io_service)
+    : reactor_(boost::asio::use_service<
+        boost::asio::detail::epoll_reactor>(io_service))
+  {
+  }
+
+  /// Set the maximum number of events retrieved by each wait.
+  /**
+   * @param n The batch size. Values outside the range
+   * [1, max_event_batch_size] are clamped. The default is 128.
+   */
+  void event_batch_size(std::size_t n)
+  {
+    reactor_.event_batch_size(n);
+  }
+
+  /// Get the maximum number of events retrieved by each wait.
+  std::size_t event_batch_size() const
+  {
+    return reactor_.event_batch_size();
+  }
+
+  /// Set the number of non-blocking polls to make before blocking.
+  /**
+   * @param n The number of polls. A value of 0, the default, disables
+   * busy-polling.
+   */
+  void busy_poll_count(std::size_t n)
+  {
+    reactor_.busy_poll_count(n);
+  }
+
+  /// Get the number of non-blocking polls made before blocking.
+  std::size_t busy_poll_count() const
+  {
+    return reactor_.busy_poll_count();
+  }
+
+  /// Get a snapshot of the reactor's counters.
+  statistics get_statistics() const
+  {
+    boost::asio::detail::epoll_reactor::statistics s
+      = reactor_.get_statistics();
+    statistics result = { s.waits, s.events,
+      s.empty_waits, s.full_batches, s.busy_polls };
+    return result;
+  }
+
+  /// Reset the reactor's counters to zero.
+  void reset_statistics()
+  {
+    reactor_.reset_statistics();
+  }
+
+private:
+  // The reactor being controlled.
+  boost::asio::detail::epoll_reactor& reactor_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_REACTOR_CONTROL_HPP
@@ -0,0 +1,195 @@
+//
+// sendfile.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_SENDFILE_HPP
+#define BOOST_ASIO_SENDFILE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_SENDFILE) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include <boost/cstdint.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/**
+ * @defgroup sendfile boost::asio::sendfile
+ *
+ * @brief Write part of a file to a stream socket before returning.
+ */
+/*@{*/
+
+/// Write part of a file to a stream socket before returning.
+/**
+ * This function is used to write a region of a file to a stream socket. The
+ * data is transferred by the kernel directly from the file to the socket,
+ * without being copied through user memory. The call will block until one of
+ * the following conditions is true:
+ *
+ * @li All @c length bytes have been written.
+ *
+ * @li The end of the file has been reached, in which case the operation fails
+ * with boost::asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param fd A file descriptor, open for reading, for a file that supports
+ * memory mapping.
+ *
+ * @param offset The position in the file at which to start reading. The file
+ * descriptor's own position is not used or modified.
+ *
+ * @param length The number of bytes to write.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @throws boost::system::system_error Thrown on failure.
+ *
+ * @note Only available on Linux.
+ */
+template <typename Protocol, typename StreamSocketService>
+std::size_t sendfile(basic_stream_socket<Protocol, StreamSocketService>& s,
+    int fd, boost::uint64_t offset, std::size_t length);
+
+/// Write part of a file to a stream socket before returning.
+/**
+ * This function is used to write a region of a file to a stream socket. The
+ * data is transferred by the kernel directly from the file to the socket,
+ * without being copied through user memory. The call will block until one of
+ * the following conditions is true:
+ *
+ * @li All @c length bytes have been written.
+ *
+ * @li The end of the file has been reached, in which case the operation fails
+ * with boost::asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * If the socket is in non-blocking mode, the call returns when the socket's
+ * send buffer is full, failing with boost::asio::error::would_block.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param fd A file descriptor, open for reading, for a file that supports
+ * memory mapping.
+ *
+ * @param offset The position in the file at which to start reading. The file
+ * descriptor's own position is not used or modified.
+ *
+ * @param length The number of bytes to write.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ *
+ * @returns The number of bytes transferred.
+ *
+ * @note Only available on Linux.
+ */
+template <typename Protocol, typename StreamSocketService>
+std::size_t sendfile(basic_stream_socket<Protocol, StreamSocketService>& s,
+    int fd, boost::uint64_t offset, std::size_t length,
+    boost::system::error_code& ec);
+
+/*@}*/
+
+/**
+ * @defgroup async_sendfile boost::asio::async_sendfile
+ *
+ * @brief Start an asynchronous operation to write part of a file to a stream
+ * socket.
+ */
+/*@{*/
+
+/// Start an asynchronous operation to write part of a file to a stream
+/// socket.
+/**
+ * This function is used to asynchronously write a region of a file to a
+ * stream socket. The data is transferred by the kernel directly from the file
+ * to the socket, without being copied through user memory. The function call
+ * always returns immediately. The asynchronous operation will continue until
+ * one of the following conditions is true:
+ *
+ * @li All @c length bytes have been written.
+ *
+ * @li The end of the file has been reached, in which case the operation fails
+ * with boost::asio::error::eof.
+ *
+ * @li An error occurred.
+ *
+ * The operation puts the socket into non-blocking mode, as if by calling
+ * native_non_blocking(true). The program must ensure that the socket performs
+ * no other write operations until this operation completes.
+ *
+ * @param s The socket to which the data is to be written.
+ *
+ * @param fd A file descriptor, open for reading, for a file that supports
+ * memory mapping. The descriptor must remain open until the handler is
+ * called.
+ *
+ * @param offset The position in the file at which to start reading. The file
+ * descriptor's own position is not used or modified.
+ *
+ * @param length The number of bytes to write.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const boost::system::error_code& error, // Result of operation.
+ *
+ *   std::size_t bytes_transferred           // Number of bytes written from
+ *                                           // the file.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation
+ * of the handler will be performed in a manner equivalent to using
+ * boost::asio::io_service::post().
+ *
+ * @par Example
+ * @code
+ * int fd = ::open("index.html", O_RDONLY);
+ * struct stat st;
+ * ::fstat(fd, &st);
+ * boost::asio::async_sendfile(socket, fd, 0, st.st_size, handler);
+ * @endcode
+ *
+ * @note Only available on Linux.
+ */
+template <typename Protocol, typename StreamSocketService,
+    typename WriteHandler>
+void async_sendfile(basic_stream_socket<Protocol, StreamSocketService>& s,
+    int fd, boost::uint64_t offset, std::size_t length,
+    BOOST_ASIO_MOVE_ARG(WriteHandler) handler);
+
+/*@}*/
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/impl/sendfile.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_SENDFILE_HPP
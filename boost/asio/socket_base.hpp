@@ -77,6 +77,22 @@ public:
       message_end_of_record = boost::asio::detail::message_end_of_record);
 #endif
 
+#if defined(GENERATING_DOCUMENTATION)
+  /// Send data directly from the caller's buffers, without copying it into
+  /// the kernel.
+  /**
+   * Has an effect only on sockets where the zero_copy option has been set.
+   * When a send operation that specifies this flag completes, the kernel may
+   * still be reading from the buffers, which must not be modified or freed
+   * until the kernel reports their release. See
+   * boost::asio::async_read_zero_copy_completion. Only available on Linux.
+   */
+  static const int message_zero_copy = implementation_defined;
+#elif defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  BOOST_STATIC_CONSTANT(int,
+      message_zero_copy = boost::asio::detail::message_zero_copy);
+#endif
+
   /// Socket option to permit sending of broadcast messages.
   /**
    * Implements the SOL_SOCKET/SO_BROADCAST socket option.
@@ -410,6 +426,43 @@ public:
     SOL_SOCKET, SO_LINGER> linger;
 #endif
 
+  /// Socket option to allow send operations to avoid copying data.
+  /**
+   * Implements the SOL_SOCKET/SO_ZEROCOPY socket option. Setting the option
+   * permits send operations that specify the message_zero_copy flag to
+   * transmit data directly from the caller's buffers. Only available on
+   * Linux, and fails with boost::asio::error::no_protocol_option on kernels
+   * older than 4.14.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::socket socket(io_service); 
+   * ...
+   * boost::asio::socket_base::zero_copy option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::socket socket(io_service); 
+   * ...
+   * boost::asio::socket_base::zero_copy option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined zero_copy;
+#elif defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+  typedef boost::asio::detail::socket_option::boolean<
+    SOL_SOCKET, boost::asio::detail::so_zerocopy> zero_copy;
+#endif
+
   /// Socket option to report aborted connections on accept.
   /**
    * Implements a custom socket option that determines whether or not an accept
@@ -73,6 +73,11 @@ public:
   BOOST_ASIO_DECL boost::system::error_code set_verify_mode(
       verify_mode v, boost::system::error_code& ec);
 
+  // Set the size of each of the buffers in the BIO pair used to exchange data
+  // with the transport. Fails if any data is buffered in the pair.
+  BOOST_ASIO_DECL boost::system::error_code set_buffer_size(
+      std::size_t size, boost::system::error_code& ec);
+
   // Set a peer certificate verification callback.
   BOOST_ASIO_DECL boost::system::error_code set_verify_callback(
       verify_callback_base* callback, boost::system::error_code& ec);
@@ -142,6 +147,10 @@ private:
   // Adapt the SSL_write function to the signature needed for perform().
   BOOST_ASIO_DECL int do_write(void* data, std::size_t length);
 
+  // Get the largest amount of output that may be produced by writing a
+  // single record for the given amount of data.
+  BOOST_ASIO_DECL static std::size_t max_record_size(std::size_t length);
+
   SSL* ssl_;
   BIO* ext_bio_;
 };
@@ -73,6 +73,37 @@ boost::system::error_code engine::set_verify_mode(
   return ec;
 }
 
+boost::system::error_code engine::set_buffer_size(
+    std::size_t size, boost::system::error_code& ec)
+{
+  if (size == 0)
+  {
+    ec = boost::asio::error::invalid_argument;
+    return ec;
+  }
+
+  if (::BIO_ctrl_pending(ext_bio_) != 0 || ::BIO_ctrl_wpending(ext_bio_) != 0)
+  {
+    ec = boost::asio::error::in_progress;
+    return ec;
+  }
+
+  // Replacing the BIO pair frees the old internal BIO.
+  ::BIO* int_bio = 0;
+  ::BIO* ext_bio = 0;
+  if (!::BIO_new_bio_pair(&int_bio, size, &ext_bio, size))
+  {
+    ec = boost::asio::error::no_memory;
+    return ec;
+  }
+  ::SSL_set_bio(ssl_, int_bio, int_bio);
+  ::BIO_free(ext_bio_);
+  ext_bio_ = ext_bio;
+
+  ec = boost::system::error_code();
+  return ec;
+}
+
 boost::system::error_code engine::set_verify_callback(
     verify_callback_base* callback, boost::system::error_code& ec)
 {
@@ -275,7 +306,32 @@ int engine::do_read(void* data, std::size_t length)
 
 int engine::do_write(void* data, std::size_t length)
 {
-  return ::SSL_write(ssl_, data, length < INT_MAX ? length : INT_MAX);
+  // Encrypt as many records as the BIO pair has room for, so that they can be
+  // passed to the transport in a single write. A further record is only
+  // started if it is certain to fit, since a write that cannot complete must
+  // later be retried with the same data. With the default buffer size there
+  // is only room for one full-sized record.
+  unsigned char* p = static_cast<unsigned char*>(data);
+  std::size_t total = 0;
+  if (length > INT_MAX)
+    length = INT_MAX;
+  do
+  {
+    int result = ::SSL_write(ssl_, p + total,
+        static_cast<int>(length - total));
+    if (result <= 0)
+      return total > 0 ? static_cast<int>(total) : result;
+    total += result;
+  } while (total < length && ::BIO_ctrl_get_write_guarantee(
+        ::SSL_get_wbio(ssl_)) >= max_record_size(length - total));
+  return static_cast<int>(total);
+}
+
+std::size_t engine::max_record_size(std::size_t length)
+{
+  if (length > SSL3_RT_MAX_PLAIN_LENGTH)
+    length = SSL3_RT_MAX_PLAIN_LENGTH;
+  return SSL3_RT_HEADER_LENGTH + length + SSL3_RT_MAX_ENCRYPTED_OVERHEAD;
 }
 
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
@@ -34,13 +34,19 @@ namespace detail {
 
 struct stream_core
 {
+  // The default size of the buffers used to exchange data with the transport.
+  // This matches the default size of the engine's BIO pair, so that a single
+  // transport write always drains all pending output, and has room for a
+  // full-sized TLS record together with its header and encryption overhead.
+  enum { default_buffer_size = 17 * 1024 };
+
   stream_core(SSL_CTX* context, boost::asio::io_service& io_service)
     : engine_(context),
       pending_read_(io_service),
       pending_write_(io_service),
-      output_buffer_space_(16384),
+      output_buffer_space_(default_buffer_size),
       output_buffer_(boost::asio::buffer(output_buffer_space_)),
-      input_buffer_space_(16384),
+      input_buffer_space_(default_buffer_size),
       input_buffer_(boost::asio::buffer(input_buffer_space_))
   {
     pending_read_.expires_at(boost::posix_time::neg_infin);
@@ -51,6 +57,28 @@ struct stream_core
   {
   }
 
+  // Set the size of the buffers used to exchange data with the transport.
+  boost::system::error_code set_buffer_size(
+      std::size_t size, boost::system::error_code& ec)
+  {
+    if (boost::asio::buffer_size(input_) != 0
+        || pending_read_.expires_at() != boost::posix_time::neg_infin
+        || pending_write_.expires_at() != boost::posix_time::neg_infin)
+    {
+      ec = boost::asio::error::in_progress;
+      return ec;
+    }
+
+    if (engine_.set_buffer_size(size, ec))
+      return ec;
+
+    output_buffer_space_.resize(size);
+    output_buffer_ = boost::asio::buffer(output_buffer_space_);
+    input_buffer_space_.resize(size);
+    input_buffer_ = boost::asio::buffer(input_buffer_space_);
+    return ec;
+  }
+
   // The SSL engine.
   engine engine_;
 
@@ -64,13 +92,13 @@ struct stream_core
   std::vector<unsigned char> output_buffer_space_; 
 
   // A buffer that may be used to prepare output intended for the transport.
-  const boost::asio::mutable_buffers_1 output_buffer_; 
+  boost::asio::mutable_buffers_1 output_buffer_;
 
   // Buffer space used to read input intended for the engine.
   std::vector<unsigned char> input_buffer_space_; 
 
   // A buffer that may be used to read input intended for the engine.
-  const boost::asio::mutable_buffers_1 input_buffer_;
+  boost::asio::mutable_buffers_1 input_buffer_;
 
   // The buffer pointing to the engine's unconsumed input.
   boost::asio::const_buffer input_;
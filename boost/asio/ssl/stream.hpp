@@ -257,6 +257,56 @@ public:
     return core_.engine_.set_verify_mode(v, ec);
   }
 
+  /// Set the size of the buffers used to exchange data with the next layer.
+  /**
+   * This function may be used to change the size of the buffers through which
+   * encrypted data passes between the stream and the next layer. The default
+   * size of 17408 bytes holds a single TLS record, so each write operation
+   * sends at most one full-sized record to the next layer. With a larger
+   * size, a write operation encrypts as many records as will fit before
+   * sending them with a single write to the next layer, and a read operation
+   * may receive several records with a single read. A size of 65536 bytes
+   * or more is recommended for bulk data transfer.
+   *
+   * The size may only be changed while no data is buffered and no operations
+   * are in progress, such as before the handshake.
+   *
+   * @param size The size of each buffer, in bytes.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  void set_buffer_size(std::size_t size)
+  {
+    boost::system::error_code ec;
+    set_buffer_size(size, ec);
+    boost::asio::detail::throw_error(ec, "set_buffer_size");
+  }
+
+  /// Set the size of the buffers used to exchange data with the next layer.
+  /**
+   * This function may be used to change the size of the buffers through which
+   * encrypted data passes between the stream and the next layer. The default
+   * size of 17408 bytes holds a single TLS record, so each write operation
+   * sends at most one full-sized record to the next layer. With a larger
+   * size, a write operation encrypts as many records as will fit before
+   * sending them with a single write to the next layer, and a read operation
+   * may receive several records with a single read. A size of 65536 bytes
+   * or more is recommended for bulk data transfer.
+   *
+   * The size may only be changed while no data is buffered and no operations
+   * are in progress, such as before the handshake.
+   *
+   * @param size The size of each buffer, in bytes.
+   *
+   * @param ec Set to indicate what error occurred, if any. Set to
+   * boost::asio::error::in_progress if data is buffered.
+   */
+  boost::system::error_code set_buffer_size(
+      std::size_t size, boost::system::error_code& ec)
+  {
+    return core_.set_buffer_size(size, ec);
+  }
+
   /// Set the callback used to verify peer certificates.
   /**
    * This function is used to specify a callback function that will be called
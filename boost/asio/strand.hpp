@@ -72,6 +72,14 @@ namespace asio {
  * happens-before the other. Therefore none of the above conditions are met and
  * no ordering guarantee is made.
  *
+ * @par Strand implementations
+ * By default, strands share the state used to serialise their handlers from
+ * a fixed-size pool, so that creating a strand is cheap. As a consequence,
+ * unrelated strands may occasionally serialise against each other. The
+ * boost::asio::strand_control class can be used to give each new strand its
+ * own state instead, and to limit the number of handlers a strand runs each
+ * time it is scheduled.
+ *
  * @par Thread Safety
  * @e Distinct @e objects: Safe.@n
  * @e Shared @e objects: Safe.
@@ -96,6 +104,18 @@ public:
     service_.construct(impl_);
   }
 
+  /// Copy constructor.
+  /**
+   * Constructs a strand that refers to the same underlying strand as
+   * @c other. Handlers posted through either object are serialised with
+   * respect to each other.
+   */
+  strand(const strand& other)
+    : service_(other.service_)
+  {
+    service_.copy(impl_, other.impl_);
+  }
+
   /// Destructor.
   /**
    * Destroys a strand.
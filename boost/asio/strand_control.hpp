@@ -0,0 +1,111 @@
+//
+// strand_control.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_STRAND_CONTROL_HPP
+#define BOOST_ASIO_STRAND_CONTROL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/detail/strand_service.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Provides tuning of the strands that belong to an io_service.
+/**
+ * By default, each io_service::strand object is assigned its state from a
+ * fixed-size pool shared by all strands on the io_service. This keeps strand
+ * creation cheap, but unrelated strands that happen to be assigned the same
+ * state serialise against each other, and a busy strand can delay the others
+ * that share its state. When dedicated implementations are enabled, each
+ * strand constructed afterwards is given state of its own, which is freed
+ * when the last copy of the strand has been destroyed and all of its
+ * handlers have run. Defining @c BOOST_ASIO_ENABLE_DEDICATED_STRANDS makes
+ * this the default.
+ *
+ * Each time a strand is scheduled by the io_service, it runs at most
+ * max_handlers_per_dispatch() of its waiting handlers before it is scheduled
+ * again behind other ready work. The default of 1, which may be changed by
+ * defining @c BOOST_ASIO_STRAND_MAX_HANDLERS_PER_DISPATCH, gives the fairest
+ * sharing of threads. Larger values reduce the scheduling overhead for busy
+ * strands.
+ *
+ * The settings apply to the io_service as a whole and should be changed
+ * before any strands are created or any thread calls run() on it.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code
+ * boost::asio::io_service io_service;
+ * boost::asio::strand_control control(io_service);
+ * control.dedicated_implementations(true);
+ * control.max_handlers_per_dispatch(16);
+ * boost::asio::io_service::strand strand(io_service);
+ * @endcode
+ */
+class strand_control
+{
+public:
+  /// Construct a strand_control for the specified io_service.
+  explicit strand_control(boost::asio::io_service& io_service)
+    : service_(boost::asio::use_service<
+        boost::asio::detail::strand_service>(io_service))
+  {
+  }
+
+  /// Set whether new strands are given dedicated implementations.
+  void dedicated_implementations(bool value)
+  {
+    service_.dedicated_implementations(value);
+  }
+
+  /// Get whether new strands are given dedicated implementations.
+  bool dedicated_implementations() const
+  {
+    return service_.dedicated_implementations();
+  }
+
+  /// Set the maximum number of handlers a strand runs each time it is
+  /// scheduled.
+  /**
+   * @param n The number of handlers. A value of 0 is treated as 1.
+   */
+  void max_handlers_per_dispatch(std::size_t n)
+  {
+    service_.max_handlers_per_dispatch(n);
+  }
+
+  /// Get the maximum number of handlers a strand runs each time it is
+  /// scheduled.
+  std::size_t max_handlers_per_dispatch() const
+  {
+    return service_.max_handlers_per_dispatch();
+  }
+
+private:
+  boost::asio::detail::strand_service& service_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_STRAND_CONTROL_HPP
@@ -0,0 +1,72 @@
+//
+// timer_wheel_traits.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
+#define BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/config.hpp>
+#include <boost/asio/time_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Time traits that select a timing wheel to hold the pending timers.
+/**
+ * By default, the pending timers of a deadline timer service are kept in a
+ * binary heap, so that starting, cancelling and expiring a timer takes
+ * O(log n) time. When a timer's time traits are wrapped in
+ * timer_wheel_traits, the timers are instead kept in a hierarchical timing
+ * wheel, where these operations take constant time. This suits programs that
+ * have very large numbers of timers that are mostly cancelled before they
+ * expire, such as per-connection idle timeouts.
+ *
+ * The wheel measures time in ticks of @c Resolution microseconds. Expiry
+ * times are rounded up to the next tick, so timers are never completed early
+ * but may complete up to one tick late. All timers that fall due within the
+ * same tick are completed together.
+ *
+ * @par Example
+ * @code
+ * typedef boost::asio::basic_deadline_timer<boost::posix_time::ptime,
+ *     boost::asio::timer_wheel_traits<> > wheel_deadline_timer;
+ *
+ * wheel_deadline_timer timer(io_service);
+ * timer.expires_from_now(boost::posix_time::seconds(30));
+ * timer.async_wait(handler);
+ * @endcode
+ *
+ * @tparam Time_Traits The time traits to be wrapped.
+ *
+ * @tparam Resolution The duration of one tick of the wheel, in microseconds.
+ * Must be greater than zero.
+ */
+template <typename Time_Traits = time_traits<boost::posix_time::ptime>,
+    std::size_t Resolution = 1000>
+struct timer_wheel_traits
+  : Time_Traits
+{
+  /// The duration of one tick of the wheel, in microseconds.
+  BOOST_STATIC_CONSTANT(std::size_t, resolution = Resolution);
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_TIMER_WHEEL_TRAITS_HPP
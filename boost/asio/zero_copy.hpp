@@ -0,0 +1,136 @@
+//
+// zero_copy.hpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_ZERO_COPY_HPP
+#define BOOST_ASIO_ZERO_COPY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <boost/cstdint.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Identifies zero-copy send operations whose buffers have been released.
+/**
+ * When the socket_base::zero_copy option is set on a socket, each system
+ * call that sends data with the socket_base::message_zero_copy flag is given
+ * a sequence number. The first such call is numbered 0, and the numbers wrap
+ * around after 2^32 - 1. Calls that fail do not consume a number. Note that a
+ * single asynchronous send operation makes one such call, while a composed
+ * operation such as boost::asio::async_write may make several.
+ *
+ * A zero_copy_completion reports that the kernel has finished with the
+ * buffers of every call numbered from @c first to @c last inclusive, after
+ * which those buffers may be reused.
+ */
+struct zero_copy_completion
+{
+  /// The sequence number of the first send call in the range.
+  boost::uint32_t first;
+
+  /// The sequence number of the last send call in the range.
+  boost::uint32_t last;
+
+  /// Whether the kernel copied the data rather than sending it directly from
+  /// the caller's buffers. A program may choose to stop using zero-copy sends
+  /// on a socket for which data is being copied, since there is then no
+  /// benefit in doing so.
+  bool copied;
+};
+
+/// Read a buffer release notification from a socket without blocking.
+/**
+ * This function reads the next zero-copy buffer release notification from
+ * the socket's error queue. It never blocks.
+ *
+ * @param s The socket from which the notification is to be read.
+ *
+ * @param completion Receives the range of send calls whose buffers have been
+ * released.
+ *
+ * @param ec Set to indicate what error occurred, if any. Set to
+ * boost::asio::error::would_block if no notification is available.
+ *
+ * @returns @c true if a notification was read.
+ *
+ * @note Only available on Linux.
+ */
+template <typename Protocol, typename StreamSocketService>
+bool read_zero_copy_completion(
+    basic_stream_socket<Protocol, StreamSocketService>& s,
+    zero_copy_completion& completion, boost::system::error_code& ec);
+
+/// Start an asynchronous operation to wait for and read a buffer release
+/// notification from a socket.
+/**
+ * This function is used to asynchronously read the next zero-copy buffer
+ * release notification from the socket's error queue. The function call
+ * always returns immediately.
+ *
+ * The operation waits for the socket's error queue to become non-empty using
+ * an asynchronous receive of boost::asio::null_buffers with the
+ * socket_base::message_out_of_band flag. The program must ensure that the
+ * socket performs no other such receive operations until this operation
+ * completes. The notification is only delivered promptly by reactors that
+ * report error conditions for sockets, such as the one based on epoll.
+ *
+ * @param s The socket from which the notification is to be read.
+ *
+ * @param handler The handler to be called when the operation completes.
+ * Copies will be made of the handler as required. The function signature of
+ * the handler must be:
+ * @code void handler(
+ *   const boost::system::error_code& error,      // Result of operation.
+ *   const boost::asio::zero_copy_completion& c   // The released range.
+ * ); @endcode
+ * Regardless of whether the asynchronous operation completes immediately or
+ * not, the handler will not be invoked from within this function. Invocation
+ * of the handler will be performed in a manner equivalent to using
+ * boost::asio::io_service::post().
+ *
+ * @par Example
+ * @code
+ * socket.set_option(boost::asio::socket_base::zero_copy(true));
+ * socket.async_send(boost::asio::buffer(data),
+ *     boost::asio::socket_base::message_zero_copy, send_handler);
+ * boost::asio::async_read_zero_copy_completion(socket, release_handler);
+ * @endcode
+ *
+ * @note Only available on Linux.
+ */
+template <typename Protocol, typename StreamSocketService,
+    typename ZeroCopyHandler>
+void async_read_zero_copy_completion(
+    basic_stream_socket<Protocol, StreamSocketService>& s,
+    BOOST_ASIO_MOVE_ARG(ZeroCopyHandler) handler);
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/impl/zero_copy.hpp>
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // BOOST_ASIO_ZERO_COPY_HPP
@@ -0,0 +1,554 @@
+#ifndef BOOST_ATOMIC_HPP_INCLUDED
+#define BOOST_ATOMIC_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+//
+//  boost/atomic.hpp
+//
+//  Defines class template boost::atomic<T> and class boost::atomic_flag
+//  per the C++0x working draft
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  T must be trivially copyable and at most 8 bytes in size. atomic<T> is
+//  lock-free when the platform can access an object of sizeof(T) bytes
+//  atomically (see the BOOST_ATOMIC_<type>_LOCK_FREE macros) and uses a
+//  spinlock from spinlock_pool<0> otherwise.
+//
+//  Objects of type T are compared bitwise by compare_exchange_*, so a T
+//  with padding bits may fail to compare equal to a copy of itself.
+//
+
+#include <boost/atomic/detail/config.hpp>
+#include <boost/atomic/detail/lock_based.hpp>
+
+#if defined( BOOST_ATOMIC_DETAIL_GCC_X86 )
+# include <boost/atomic/detail/gcc_x86.hpp>
+#elif defined( BOOST_ATOMIC_DETAIL_GCC_SYNC )
+# include <boost/atomic/detail/gcc_sync.hpp>
+#else
+# include <boost/atomic/detail/spinlock.hpp>
+#endif
+
+#include <boost/memory_order.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace boost
+{
+
+namespace detail
+{
+
+namespace atomics
+{
+
+// The unsigned integer in which an atomic<T> keeps its value
+
+template< std::size_t N > struct storage_type
+{
+    // Round up to the next supported size; nothing is larger than 8 bytes
+
+    typedef typename storage_type< ( N < 8? N + 1: 9 ) >::type type;
+};
+
+template<> struct storage_type< 1 >
+{
+    typedef boost::uint8_t type;
+};
+
+template<> struct storage_type< 2 >
+{
+    typedef boost::uint16_t type;
+};
+
+template<> struct storage_type< 4 >
+{
+    typedef boost::uint32_t type;
+};
+
+template<> struct storage_type< 8 >
+{
+    typedef boost::uint64_t type;
+};
+
+template< std::size_t N > struct is_lock_free_size
+{
+    static bool const value = false;
+};
+
+template<> struct is_lock_free_size< 1 >
+{
+    static bool const value = BOOST_ATOMIC_DETAIL_LOCK_FREE_1 != 0;
+};
+
+template<> struct is_lock_free_size< 2 >
+{
+    static bool const value = BOOST_ATOMIC_DETAIL_LOCK_FREE_2 != 0;
+};
+
+template<> struct is_lock_free_size< 4 >
+{
+    static bool const value = BOOST_ATOMIC_DETAIL_LOCK_FREE_4 != 0;
+};
+
+template<> struct is_lock_free_size< 8 >
+{
+    static bool const value = BOOST_ATOMIC_DETAIL_LOCK_FREE_8 != 0;
+};
+
+template< class Storage, bool LockFree = is_lock_free_size< sizeof( Storage ) >::value > struct operations: lock_based_operations< Storage >
+{
+};
+
+template< class Storage > struct operations< Storage, true >: lock_free_operations< Storage >
+{
+};
+
+inline memory_order failure_order( memory_order order )
+{
+    // The failure order of a compare-exchange may not include release
+
+    switch( order )
+    {
+    case memory_order_acq_rel:
+        return memory_order_acquire;
+
+    case memory_order_release:
+        return memory_order_relaxed;
+
+    default:
+        return order;
+    }
+}
+
+// Conversions between T and its storage
+
+template< class T, class Storage > struct bitwise_cast
+{
+    static Storage to_storage( T const & v )
+    {
+        Storage r = 0; // clear the bytes past sizeof( T ) so that compare_exchange sees them equal
+        std::memcpy( &r, &v, sizeof( T ) );
+        return r;
+    }
+
+    static T from_storage( Storage s )
+    {
+        boost::aligned_storage< sizeof( T ), boost::alignment_of< T >::value > r;
+        std::memcpy( r.address(), &s, sizeof( T ) );
+        return *static_cast< T const * >( r.address() );
+    }
+};
+
+template< class T, class Storage > struct integral_cast
+{
+    static Storage to_storage( T v )
+    {
+        return static_cast< Storage >( v );
+    }
+
+    static T from_storage( Storage s )
+    {
+        return static_cast< T >( s );
+    }
+};
+
+template< class T, class Storage > struct pointer_cast
+{
+    static Storage to_storage( T v )
+    {
+        return reinterpret_cast< Storage >( v );
+    }
+
+    static T from_storage( Storage s )
+    {
+        return reinterpret_cast< T >( s );
+    }
+};
+
+// load, store, exchange and compare_exchange, common to all atomic<>
+
+template< class T, template< class, class > class Cast > class atomic_base
+{
+protected:
+
+    typedef typename storage_type< sizeof( T ) >::type storage_t;
+    typedef operations< storage_t > ops;
+    typedef Cast< T, storage_t > cast;
+
+    storage_t volatile v_;
+
+    atomic_base(): v_( 0 )
+    {
+    }
+
+    explicit atomic_base( T v ): v_( cast::to_storage( v ) )
+    {
+    }
+
+private:
+
+    atomic_base( atomic_base const & );
+    atomic_base & operator=( atomic_base const & );
+
+public:
+
+    bool is_lock_free() const volatile
+    {
+        return is_lock_free_size< sizeof( storage_t ) >::value;
+    }
+
+    void store( T v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        ops::store( v_, cast::to_storage( v ), order );
+    }
+
+    T load( memory_order order = memory_order_seq_cst ) const volatile
+    {
+        return cast::from_storage( ops::load( v_, order ) );
+    }
+
+    operator T() const volatile
+    {
+        return load();
+    }
+
+    T exchange( T v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return cast::from_storage( ops::exchange( v_, cast::to_storage( v ), order ) );
+    }
+
+    bool compare_exchange_strong( T & expected, T desired, memory_order success, memory_order failure ) volatile
+    {
+        storage_t e = cast::to_storage( expected );
+
+        if( ops::compare_exchange( v_, e, cast::to_storage( desired ), success, failure ) )
+        {
+            return true;
+        }
+        else
+        {
+            expected = cast::from_storage( e );
+            return false;
+        }
+    }
+
+    bool compare_exchange_strong( T & expected, T desired, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return compare_exchange_strong( expected, desired, order, failure_order( order ) );
+    }
+
+    // None of the implementations fail spuriously
+
+    bool compare_exchange_weak( T & expected, T desired, memory_order success, memory_order failure ) volatile
+    {
+        return compare_exchange_strong( expected, desired, success, failure );
+    }
+
+    bool compare_exchange_weak( T & expected, T desired, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return compare_exchange_strong( expected, desired, order, failure_order( order ) );
+    }
+};
+
+template< class T > class atomic_integral: public atomic_base< T, integral_cast >
+{
+private:
+
+    typedef atomic_base< T, integral_cast > base;
+    typedef typename base::storage_t storage_t;
+    typedef typename base::ops ops;
+    typedef typename base::cast cast;
+
+protected:
+
+    atomic_integral()
+    {
+    }
+
+    explicit atomic_integral( T v ): base( v )
+    {
+    }
+
+public:
+
+    T fetch_add( T v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return cast::from_storage( ops::fetch_add( this->v_, cast::to_storage( v ), order ) );
+    }
+
+    T fetch_sub( T v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        // Unsigned negation wraps, so adding it subtracts v
+        return cast::from_storage( ops::fetch_add( this->v_, static_cast< storage_t >( 0 - cast::to_storage( v ) ), order ) );
+    }
+
+    T fetch_and( T v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return cast::from_storage( ops::fetch_and( this->v_, cast::to_storage( v ), order ) );
+    }
+
+    T fetch_or( T v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return cast::from_storage( ops::fetch_or( this->v_, cast::to_storage( v ), order ) );
+    }
+
+    T fetch_xor( T v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return cast::from_storage( ops::fetch_xor( this->v_, cast::to_storage( v ), order ) );
+    }
+
+    T operator++( int ) volatile
+    {
+        return fetch_add( 1 );
+    }
+
+    T operator--( int ) volatile
+    {
+        return fetch_sub( 1 );
+    }
+
+    T operator++() volatile
+    {
+        return static_cast< T >( fetch_add( 1 ) + 1 );
+    }
+
+    T operator--() volatile
+    {
+        return static_cast< T >( fetch_sub( 1 ) - 1 );
+    }
+
+    T operator+=( T v ) volatile
+    {
+        return static_cast< T >( fetch_add( v ) + v );
+    }
+
+    T operator-=( T v ) volatile
+    {
+        return static_cast< T >( fetch_sub( v ) - v );
+    }
+
+    T operator&=( T v ) volatile
+    {
+        return static_cast< T >( fetch_and( v ) & v );
+    }
+
+    T operator|=( T v ) volatile
+    {
+        return static_cast< T >( fetch_or( v ) | v );
+    }
+
+    T operator^=( T v ) volatile
+    {
+        return static_cast< T >( fetch_xor( v ) ^ v );
+    }
+};
+
+template< class T, bool Integral = boost::is_integral< T >::value && !boost::is_same< T, bool >::value > struct select_base
+{
+    typedef atomic_base< T, bitwise_cast > type;
+};
+
+template< class T > struct select_base< T, true >
+{
+    typedef atomic_integral< T > type;
+};
+
+} // namespace atomics
+
+} // namespace detail
+
+template< class T > class atomic: public detail::atomics::select_base< T >::type
+{
+private:
+
+    typedef typename detail::atomics::select_base< T >::type base;
+
+    BOOST_STATIC_ASSERT( sizeof( T ) <= 8 );
+
+    atomic( atomic const & );
+    atomic & operator=( atomic const & );
+
+public:
+
+    atomic()
+    {
+    }
+
+    atomic( T v ): base( v )
+    {
+    }
+
+    T operator=( T v )
+    {
+        this->store( v );
+        return v;
+    }
+
+    T operator=( T v ) volatile
+    {
+        this->store( v );
+        return v;
+    }
+};
+
+template< class T > class atomic< T * >: public detail::atomics::atomic_base< T *, detail::atomics::pointer_cast >
+{
+private:
+
+    typedef detail::atomics::atomic_base< T *, detail::atomics::pointer_cast > base;
+    typedef typename base::storage_t storage_t;
+    typedef typename base::ops ops;
+    typedef typename base::cast cast;
+
+    atomic( atomic const & );
+    atomic & operator=( atomic const & );
+
+    static storage_t bytes( std::ptrdiff_t v )
+    {
+        return static_cast< storage_t >( v * static_cast< std::ptrdiff_t >( sizeof( T ) ) );
+    }
+
+public:
+
+    atomic()
+    {
+    }
+
+    atomic( T * v ): base( v )
+    {
+    }
+
+    T * operator=( T * v )
+    {
+        this->store( v );
+        return v;
+    }
+
+    T * operator=( T * v ) volatile
+    {
+        this->store( v );
+        return v;
+    }
+
+    T * fetch_add( std::ptrdiff_t v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return cast::from_storage( ops::fetch_add( this->v_, bytes( v ), order ) );
+    }
+
+    T * fetch_sub( std::ptrdiff_t v, memory_order order = memory_order_seq_cst ) volatile
+    {
+        return cast::from_storage( ops::fetch_add( this->v_, bytes( -v ), order ) );
+    }
+
+    T * operator++( int ) volatile
+    {
+        return fetch_add( 1 );
+    }
+
+    T * operator--( int ) volatile
+    {
+        return fetch_sub( 1 );
+    }
+
+    T * operator++() volatile
+    {
+        return fetch_add( 1 ) + 1;
+    }
+
+    T * operator--() volatile
+    {
+        return fetch_sub( 1 ) - 1;
+    }
+
+    T * operator+=( std::ptrdiff_t v ) volatile
+    {
+        return fetch_add( v ) + v;
+    }
+
+    T * operator-=( std::ptrdiff_t v ) volatile
+    {
+        return fetch_sub( v ) - v;
+    }
+};
+
+class atomic_flag
+{
+private:
+
+    typedef detail::atomics::operations< boost::uint32_t > ops;
+
+    boost::uint32_t volatile v_;
+
+    atomic_flag( atomic_flag const & );
+    atomic_flag & operator=( atomic_flag const & );
+
+public:
+
+    // Unlike std::atomic_flag, starts out clear
+
+    atomic_flag(): v_( 0 )
+    {
+    }
+
+    bool test_and_set( memory_order order = memory_order_seq_cst ) volatile
+    {
+        return ops::exchange( v_, 1, order ) != 0;
+    }
+
+    void clear( memory_order order = memory_order_seq_cst ) volatile
+    {
+        ops::store( v_, 0, order );
+    }
+};
+
+inline void atomic_thread_fence( memory_order order )
+{
+    detail::atomics::thread_fence( order );
+}
+
+inline void atomic_signal_fence( memory_order order )
+{
+    detail::atomics::signal_fence( order );
+}
+
+typedef atomic< bool > atomic_bool;
+typedef atomic< char > atomic_char;
+typedef atomic< signed char > atomic_schar;
+typedef atomic< unsigned char > atomic_uchar;
+typedef atomic< short > atomic_short;
+typedef atomic< unsigned short > atomic_ushort;
+typedef atomic< int > atomic_int;
+typedef atomic< unsigned int > atomic_uint;
+typedef atomic< long > atomic_long;
+typedef atomic< unsigned long > atomic_ulong;
+
+#if defined( BOOST_HAS_LONG_LONG )
+
+typedef atomic< boost::long_long_type > atomic_llong;
+typedef atomic< boost::ulong_long_type > atomic_ullong;
+
+#endif
+
+typedef atomic< std::size_t > atomic_size_t;
+typedef atomic< std::ptrdiff_t > atomic_ptrdiff_t;
+
+} // namespace boost
+
+#endif // #ifndef BOOST_ATOMIC_HPP_INCLUDED
@@ -0,0 +1,135 @@
+#ifndef BOOST_ATOMIC_DETAIL_CONFIG_HPP_INCLUDED
+#define BOOST_ATOMIC_DETAIL_CONFIG_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+//
+//  boost/atomic/detail/config.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Selects the implementation of boost::atomic<> and defines the
+//  BOOST_ATOMIC_<type>_LOCK_FREE macros, which are 2 when atomic<type>
+//  is always lock-free and 0 when it is implemented with spinlocks.
+//
+//  #define BOOST_ATOMIC_USE_SPINLOCK to force the spinlock implementation.
+//
+
+#include <boost/config.hpp>
+#include <boost/smart_ptr/detail/sp_has_sync.hpp>
+#include <limits.h>
+
+#if defined( BOOST_ATOMIC_USE_SPINLOCK )
+
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_1 0
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_2 0
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_4 0
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_8 0
+
+#elif defined( __GNUC__ ) && ( defined( __i386__ ) || defined( __x86_64__ ) ) && defined( BOOST_SP_HAS_SYNC )
+
+# define BOOST_ATOMIC_DETAIL_GCC_X86
+
+// Aligned loads and stores of up to the register width are atomic
+
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_1 2
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_2 2
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_4 2
+
+# if defined( __x86_64__ )
+#  define BOOST_ATOMIC_DETAIL_LOCK_FREE_8 2
+# else
+#  define BOOST_ATOMIC_DETAIL_LOCK_FREE_8 0
+# endif
+
+#elif defined( BOOST_SP_HAS_SYNC )
+
+# define BOOST_ATOMIC_DETAIL_GCC_SYNC
+
+// g++ 4.3 and later say which sizes the __sync intrinsics support;
+// before that, assume 32 bits only
+
+# if defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_4 )
+
+#  if defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_1 )
+#   define BOOST_ATOMIC_DETAIL_LOCK_FREE_1 2
+#  else
+#   define BOOST_ATOMIC_DETAIL_LOCK_FREE_1 0
+#  endif
+
+#  if defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_2 )
+#   define BOOST_ATOMIC_DETAIL_LOCK_FREE_2 2
+#  else
+#   define BOOST_ATOMIC_DETAIL_LOCK_FREE_2 0
+#  endif
+
+#  define BOOST_ATOMIC_DETAIL_LOCK_FREE_4 2
+
+// Plain 64 bit loads and stores are only atomic on 64 bit targets
+
+#  if defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8 ) && ( defined( __LP64__ ) || defined( _LP64 ) )
+#   define BOOST_ATOMIC_DETAIL_LOCK_FREE_8 2
+#  else
+#   define BOOST_ATOMIC_DETAIL_LOCK_FREE_8 0
+#  endif
+
+# else
+
+#  define BOOST_ATOMIC_DETAIL_LOCK_FREE_1 0
+#  define BOOST_ATOMIC_DETAIL_LOCK_FREE_2 0
+#  define BOOST_ATOMIC_DETAIL_LOCK_FREE_4 2
+#  define BOOST_ATOMIC_DETAIL_LOCK_FREE_8 0
+
+# endif
+
+#else
+
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_1 0
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_2 0
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_4 0
+# define BOOST_ATOMIC_DETAIL_LOCK_FREE_8 0
+
+#endif
+
+#define BOOST_ATOMIC_CHAR_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_1
+#define BOOST_ATOMIC_BOOL_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_1
+
+#if USHRT_MAX == 0xFFFF
+# define BOOST_ATOMIC_SHORT_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_2
+#else
+# define BOOST_ATOMIC_SHORT_LOCK_FREE 0
+#endif
+
+#if UINT_MAX == 0xFFFFFFFF
+# define BOOST_ATOMIC_INT_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_4
+#else
+# define BOOST_ATOMIC_INT_LOCK_FREE 0
+#endif
+
+#if ULONG_MAX == 0xFFFFFFFF
+# define BOOST_ATOMIC_LONG_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_4
+#elif defined( __LP64__ ) || defined( _LP64 )
+# define BOOST_ATOMIC_LONG_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_8
+#else
+# define BOOST_ATOMIC_LONG_LOCK_FREE 0
+#endif
+
+#if defined( BOOST_HAS_LONG_LONG )
+# define BOOST_ATOMIC_LLONG_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_8
+#endif
+
+#if defined( __LP64__ ) || defined( _LP64 ) || defined( _WIN64 )
+# define BOOST_ATOMIC_POINTER_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_8
+#else
+# define BOOST_ATOMIC_POINTER_LOCK_FREE BOOST_ATOMIC_DETAIL_LOCK_FREE_4
+#endif
+
+#endif // #ifndef BOOST_ATOMIC_DETAIL_CONFIG_HPP_INCLUDED
@@ -0,0 +1,148 @@
+#ifndef BOOST_ATOMIC_DETAIL_GCC_SYNC_HPP_INCLUDED
+#define BOOST_ATOMIC_DETAIL_GCC_SYNC_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+//
+//  boost/atomic/detail/gcc_sync.hpp - g++ 4.1+ __sync intrinsics
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  The read-modify-write intrinsics are full barriers. Loads and stores
+//  are plain accesses surrounded by __sync_synchronize as the requested
+//  ordering demands.
+//
+//  __sync_lock_test_and_set is not used for exchange because some targets
+//  can only store the value 1 with it.
+//
+
+#include <boost/memory_order.hpp>
+
+#if defined( __ia64__ ) && defined( __INTEL_COMPILER )
+# include <ia64intrin.h>
+#endif
+
+namespace boost
+{
+
+namespace detail
+{
+
+namespace atomics
+{
+
+inline void thread_fence( memory_order order )
+{
+    if( order != memory_order_relaxed )
+    {
+        __sync_synchronize();
+    }
+}
+
+inline void signal_fence( memory_order order )
+{
+    if( order != memory_order_relaxed )
+    {
+        __asm__ __volatile__( "" ::: "memory" );
+    }
+}
+
+template< class Storage > struct lock_free_operations
+{
+    static Storage load( Storage const volatile & s, memory_order order )
+    {
+        if( order == memory_order_seq_cst )
+        {
+            __sync_synchronize();
+        }
+
+        Storage r = s;
+
+        if( order != memory_order_relaxed && order != memory_order_release )
+        {
+            __sync_synchronize();
+        }
+
+        return r;
+    }
+
+    static void store( Storage volatile & s, Storage v, memory_order order )
+    {
+        if( order != memory_order_relaxed )
+        {
+            __sync_synchronize();
+        }
+
+        s = v;
+
+        if( order == memory_order_seq_cst )
+        {
+            __sync_synchronize();
+        }
+    }
+
+    static Storage exchange( Storage volatile & s, Storage v, memory_order )
+    {
+        Storage r = s;
+
+        for( ;; )
+        {
+            Storage r2 = __sync_val_compare_and_swap( &s, r, v );
+
+            if( r2 == r ) return r;
+
+            r = r2;
+        }
+    }
+
+    static bool compare_exchange( Storage volatile & s, Storage & expected, Storage desired, memory_order, memory_order )
+    {
+        Storage r = __sync_val_compare_and_swap( &s, expected, desired );
+
+        if( r == expected )
+        {
+            return true;
+        }
+        else
+        {
+            expected = r;
+            return false;
+        }
+    }
+
+    static Storage fetch_add( Storage volatile & s, Storage v, memory_order )
+    {
+        return __sync_fetch_and_add( &s, v );
+    }
+
+    static Storage fetch_and( Storage volatile & s, Storage v, memory_order )
+    {
+        return __sync_fetch_and_and( &s, v );
+    }
+
+    static Storage fetch_or( Storage volatile & s, Storage v, memory_order )
+    {
+        return __sync_fetch_and_or( &s, v );
+    }
+
+    static Storage fetch_xor( Storage volatile & s, Storage v, memory_order )
+    {
+        return __sync_fetch_and_xor( &s, v );
+    }
+};
+
+} // namespace atomics
+
+} // namespace detail
+
+} // namespace boost
+
+#endif // #ifndef BOOST_ATOMIC_DETAIL_GCC_SYNC_HPP_INCLUDED
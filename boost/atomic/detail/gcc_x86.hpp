@@ -0,0 +1,158 @@
+#ifndef BOOST_ATOMIC_DETAIL_GCC_X86_HPP_INCLUDED
+#define BOOST_ATOMIC_DETAIL_GCC_X86_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+//
+//  boost/atomic/detail/gcc_x86.hpp - g++ 4.1+ on 486+ or AMD64
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  x86 never reorders a load with an earlier load or a store with an
+//  earlier store, so plain loads already have acquire semantics and plain
+//  stores release semantics; only the compiler needs to be restrained.
+//  Locked instructions (and xchg, which is implicitly locked) are full
+//  barriers. A seq_cst store is done with xchg so that seq_cst loads can
+//  remain plain loads.
+//
+
+#include <boost/memory_order.hpp>
+
+namespace boost
+{
+
+namespace detail
+{
+
+namespace atomics
+{
+
+inline void compiler_barrier()
+{
+    __asm__ __volatile__( "" ::: "memory" );
+}
+
+inline void thread_fence( memory_order order )
+{
+    if( order == memory_order_seq_cst )
+    {
+        __sync_synchronize();
+    }
+    else if( order != memory_order_relaxed )
+    {
+        compiler_barrier();
+    }
+}
+
+inline void signal_fence( memory_order order )
+{
+    if( order != memory_order_relaxed )
+    {
+        compiler_barrier();
+    }
+}
+
+template< class Storage > struct lock_free_operations
+{
+    static Storage load( Storage const volatile & s, memory_order order )
+    {
+        Storage r = s;
+
+        if( order != memory_order_relaxed )
+        {
+            compiler_barrier();
+        }
+
+        return r;
+    }
+
+    static void store( Storage volatile & s, Storage v, memory_order order )
+    {
+        if( order == memory_order_seq_cst )
+        {
+            exchange( s, v, order );
+        }
+        else
+        {
+            if( order != memory_order_relaxed )
+            {
+                compiler_barrier();
+            }
+
+            s = v;
+        }
+    }
+
+    static Storage exchange( Storage volatile & s, Storage v, memory_order )
+    {
+        __asm__ __volatile__
+        (
+            "xchg %0, %1":
+            "+q"( v ), "+m"( s ): // outputs (%0, %1)
+            : // inputs
+            "memory" // clobbers
+        );
+
+        return v;
+    }
+
+    static bool compare_exchange( Storage volatile & s, Storage & expected, Storage desired, memory_order, memory_order )
+    {
+        Storage r = __sync_val_compare_and_swap( &s, expected, desired );
+
+        if( r == expected )
+        {
+            return true;
+        }
+        else
+        {
+            expected = r;
+            return false;
+        }
+    }
+
+    static Storage fetch_add( Storage volatile & s, Storage v, memory_order )
+    {
+        __asm__ __volatile__
+        (
+            "lock\n\t"
+            "xadd %0, %1":
+            "+q"( v ), "+m"( s ): // outputs (%0, %1)
+            : // inputs
+            "memory", "cc" // clobbers
+        );
+
+        return v;
+    }
+
+    static Storage fetch_and( Storage volatile & s, Storage v, memory_order )
+    {
+        return __sync_fetch_and_and( &s, v );
+    }
+
+    static Storage fetch_or( Storage volatile & s, Storage v, memory_order )
+    {
+        return __sync_fetch_and_or( &s, v );
+    }
+
+    static Storage fetch_xor( Storage volatile & s, Storage v, memory_order )
+    {
+        return __sync_fetch_and_xor( &s, v );
+    }
+};
+
+} // namespace atomics
+
+} // namespace detail
+
+} // namespace boost
+
+#endif // #ifndef BOOST_ATOMIC_DETAIL_GCC_X86_HPP_INCLUDED
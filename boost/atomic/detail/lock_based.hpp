@@ -0,0 +1,123 @@
+#ifndef BOOST_ATOMIC_DETAIL_LOCK_BASED_HPP_INCLUDED
+#define BOOST_ATOMIC_DETAIL_LOCK_BASED_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+//
+//  boost/atomic/detail/lock_based.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Operations on objects that the platform cannot access atomically.
+//  Each one locks the spinlock_pool<0> entry for the address of the
+//  object, so the lock acquire and release supply all ordering and the
+//  memory_order arguments are ignored.
+//
+
+#include <boost/memory_order.hpp>
+#include <boost/smart_ptr/detail/spinlock_pool.hpp>
+
+namespace boost
+{
+
+namespace detail
+{
+
+namespace atomics
+{
+
+template< class Storage > struct lock_based_operations
+{
+    typedef spinlock_pool<0>::scoped_lock scoped_lock;
+
+    static Storage load( Storage const volatile & s, memory_order )
+    {
+        scoped_lock lock( const_cast< Storage const * >( &s ) );
+        return s;
+    }
+
+    static void store( Storage volatile & s, Storage v, memory_order )
+    {
+        scoped_lock lock( const_cast< Storage * >( &s ) );
+        s = v;
+    }
+
+    static Storage exchange( Storage volatile & s, Storage v, memory_order )
+    {
+        scoped_lock lock( const_cast< Storage * >( &s ) );
+
+        Storage r = s;
+        s = v;
+        return r;
+    }
+
+    static bool compare_exchange( Storage volatile & s, Storage & expected, Storage desired, memory_order, memory_order )
+    {
+        scoped_lock lock( const_cast< Storage * >( &s ) );
+
+        Storage r = s;
+
+        if( r == expected )
+        {
+            s = desired;
+            return true;
+        }
+        else
+        {
+            expected = r;
+            return false;
+        }
+    }
+
+    static Storage fetch_add( Storage volatile & s, Storage v, memory_order )
+    {
+        scoped_lock lock( const_cast< Storage * >( &s ) );
+
+        Storage r = s;
+        s = static_cast< Storage >( r + v );
+        return r;
+    }
+
+    static Storage fetch_and( Storage volatile & s, Storage v, memory_order )
+    {
+        scoped_lock lock( const_cast< Storage * >( &s ) );
+
+        Storage r = s;
+        s = static_cast< Storage >( r & v );
+        return r;
+    }
+
+    static Storage fetch_or( Storage volatile & s, Storage v, memory_order )
+    {
+        scoped_lock lock( const_cast< Storage * >( &s ) );
+
+        Storage r = s;
+        s = static_cast< Storage >( r | v );
+        return r;
+    }
+
+    static Storage fetch_xor( Storage volatile & s, Storage v, memory_order )
+    {
+        scoped_lock lock( const_cast< Storage * >( &s ) );
+
+        Storage r = s;
+        s = static_cast< Storage >( r ^ v );
+        return r;
+    }
+};
+
+} // namespace atomics
+
+} // namespace detail
+
+} // namespace boost
+
+#endif // #ifndef BOOST_ATOMIC_DETAIL_LOCK_BASED_HPP_INCLUDED
@@ -0,0 +1,57 @@
+#ifndef BOOST_ATOMIC_DETAIL_SPINLOCK_HPP_INCLUDED
+#define BOOST_ATOMIC_DETAIL_SPINLOCK_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+//
+//  boost/atomic/detail/spinlock.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Fences for platforms without lock-free operations. Every atomic<>
+//  is lock_based_operations, so locking and unlocking any spinlock from
+//  the pool orders memory as strongly as the atomics themselves do.
+//
+
+#include <boost/memory_order.hpp>
+#include <boost/smart_ptr/detail/spinlock_pool.hpp>
+
+namespace boost
+{
+
+namespace detail
+{
+
+namespace atomics
+{
+
+template< class Storage > struct lock_free_operations;
+
+inline void thread_fence( memory_order order )
+{
+    if( order != memory_order_relaxed )
+    {
+        spinlock_pool<0>::scoped_lock lock( &order );
+    }
+}
+
+inline void signal_fence( memory_order order )
+{
+    thread_fence( order );
+}
+
+} // namespace atomics
+
+} // namespace detail
+
+} // namespace boost
+
+#endif // #ifndef BOOST_ATOMIC_DETAIL_SPINLOCK_HPP_INCLUDED
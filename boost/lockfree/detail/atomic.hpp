@@ -0,0 +1,46 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  The queues use boost::atomic<> for their shared indices and links. This
+//  header adds the few helpers they share.
+
+#ifndef BOOST_LOCKFREE_DETAIL_ATOMIC_HPP
+#define BOOST_LOCKFREE_DETAIL_ATOMIC_HPP
+
+#include <boost/config.hpp>
+#include <boost/atomic.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+#include <cstddef>
+
+// When boost::atomic<> falls back to spinlocks for pointers, and so for
+// the pointer-sized std::size_t, the queues are correct but not lock-free.
+#if BOOST_ATOMIC_POINTER_LOCK_FREE!=2
+#define BOOST_LOCKFREE_USES_SPINLOCKS
+#endif
+
+namespace boost
+{
+namespace lockfree
+{
+namespace detail
+{
+
+inline void cpu_relax()
+{
+#if defined(BOOST_SMT_PAUSE)
+    BOOST_SMT_PAUSE
+#endif
+}
+
+// Keeps frequently written members of different threads on separate cache
+// lines.
+std::size_t const cache_line_size=64;
+
+} // namespace detail
+} // namespace lockfree
+} // namespace boost
+
+#endif // BOOST_LOCKFREE_DETAIL_ATOMIC_HPP
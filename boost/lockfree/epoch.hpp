@@ -0,0 +1,386 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_EPOCH_HPP
+#define BOOST_LOCKFREE_EPOCH_HPP
+
+#include <boost/atomic.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+namespace boost
+{
+namespace lockfree
+{
+
+class epoch_domain;
+class epoch_guard;
+
+namespace detail
+{
+    // An object passed to epoch_domain::retire(), and the function that
+    // will destroy it.
+    struct retired_object
+    {
+        void* object;
+        void (*reclaim)(void*);
+
+        retired_object(void* object_,void (*reclaim_)(void*)):
+            object(object_),reclaim(reclaim_)
+        {}
+    };
+
+    // Objects retired by one thread, tagged with the global epoch read
+    // after the last of them was retired.
+    struct retired_batch
+    {
+        unsigned epoch;
+        std::vector<retired_object> objects;
+    };
+
+    inline void reclaim_batch(retired_batch& batch)
+    {
+        for(std::size_t i=0;i<batch.objects.size();++i)
+        {
+            batch.objects[i].reclaim(batch.objects[i].object);
+        }
+        batch.objects.clear();
+    }
+
+    struct epoch_state;
+
+    // The per-thread part of an epoch_domain. Records are never freed
+    // while the domain exists; when a thread exits its record is marked
+    // free for the next thread that uses the domain.
+    struct epoch_record:
+        boost::noncopyable
+    {
+        // The epoch the thread is pinned to, plus one, or zero if the
+        // thread is not inside an epoch_guard. Epochs are even numbers.
+        boost::atomic<unsigned> pinned;
+        boost::atomic<bool> in_use;
+        epoch_record* next;
+
+        // The remaining members are only used by the owning thread.
+        unsigned nesting;
+        // Whether the thread is running reclaim functions in collect().
+        bool collecting;
+        std::vector<retired_object> pending;
+        std::deque<retired_batch> batches;
+        boost::shared_ptr<epoch_state> owner;
+
+        epoch_record():
+            pinned(0),in_use(true),next(0),nesting(0),collecting(false)
+        {}
+    };
+
+    struct epoch_state:
+        boost::noncopyable
+    {
+        // The number of objects a thread retires before it tries to
+        // advance the epoch and reclaim its earlier batches.
+        static std::size_t const batch_size=64;
+
+        boost::atomic<unsigned> global_epoch;
+        boost::atomic<epoch_record*> records;
+
+        // Batches left behind by threads that exited before they could be
+        // reclaimed.
+        boost::mutex orphan_mutex;
+        boost::atomic<bool> has_orphans;
+        std::deque<retired_batch> orphans;
+
+        epoch_state():
+            global_epoch(0),records(0),has_orphans(false)
+        {}
+
+        ~epoch_state()
+        {
+            // Every thread has released its record, so nothing can still
+            // be reading a retired object.
+            for(std::size_t i=0;i<orphans.size();++i)
+            {
+                reclaim_batch(orphans[i]);
+            }
+            epoch_record* r=records.load(boost::memory_order_acquire);
+            while(r)
+            {
+                epoch_record* const next=r->next;
+                delete r;
+                r=next;
+            }
+        }
+
+        static epoch_record* acquire_record(boost::shared_ptr<epoch_state> const& self)
+        {
+            epoch_record* r=self->records.load(boost::memory_order_acquire);
+            for(;r;r=r->next)
+            {
+                bool expected=false;
+                if(!r->in_use.load(boost::memory_order_relaxed) &&
+                   r->in_use.compare_exchange_strong(expected,true,boost::memory_order_acquire))
+                {
+                    break;
+                }
+            }
+            if(!r)
+            {
+                r=new epoch_record;
+                epoch_record* head=self->records.load(boost::memory_order_relaxed);
+                do
+                {
+                    r->next=head;
+                }
+                while(!self->records.compare_exchange_weak(head,r,boost::memory_order_release,boost::memory_order_relaxed));
+            }
+            r->owner=self;
+            return r;
+        }
+
+        // The thread_specific_ptr cleanup function, run when a thread that
+        // used the domain exits.
+        static void release_record(epoch_record* r)
+        {
+            epoch_state& state=*r->owner;
+            state.seal(*r);
+            if(!r->batches.empty())
+            {
+                boost::lock_guard<boost::mutex> lk(state.orphan_mutex);
+                state.orphans.insert(state.orphans.end(),r->batches.begin(),r->batches.end());
+                state.has_orphans.store(true,boost::memory_order_relaxed);
+            }
+            r->batches.clear();
+            r->pinned.store(0,boost::memory_order_release);
+            r->nesting=0;
+
+            // This may be the last reference to the domain's state, which
+            // deletes r, so the record is not touched after this.
+            boost::shared_ptr<epoch_state> owner;
+            owner.swap(r->owner);
+            r->in_use.store(false,boost::memory_order_release);
+        }
+
+        void pin(epoch_record& r)
+        {
+            if(!r.nesting++)
+            {
+                r.pinned.store(global_epoch.load(boost::memory_order_relaxed)+1,boost::memory_order_relaxed);
+                // Pairs with the fence in try_advance(): either this thread
+                // sees every pointer unlinked before the epoch advanced, or
+                // the advancing thread sees this thread pinned.
+                boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            }
+        }
+
+        void unpin(epoch_record& r)
+        {
+            if(!--r.nesting)
+            {
+                r.pinned.store(0,boost::memory_order_release);
+                if(r.pending.size()>=batch_size)
+                {
+                    collect(r);
+                }
+            }
+        }
+
+        // Moves the objects retired since the last call into a batch tagged
+        // with the current epoch. They were all unlinked before the fence,
+        // so a thread pinned to a later epoch cannot reach any of them.
+        void seal(epoch_record& r)
+        {
+            if(!r.pending.empty())
+            {
+                boost::atomic_thread_fence(boost::memory_order_seq_cst);
+                r.batches.push_back(retired_batch());
+                r.batches.back().epoch=global_epoch.load(boost::memory_order_relaxed);
+                r.batches.back().objects.swap(r.pending);
+            }
+        }
+
+        // Advances the global epoch if every pinned thread has seen the
+        // current one.
+        void try_advance()
+        {
+            unsigned epoch=global_epoch.load(boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            for(epoch_record* r=records.load(boost::memory_order_acquire);r;r=r->next)
+            {
+                unsigned const pinned=r->pinned.load(boost::memory_order_relaxed);
+                if(pinned && pinned!=epoch+1)
+                {
+                    return;
+                }
+            }
+            boost::atomic_thread_fence(boost::memory_order_acquire);
+            global_epoch.compare_exchange_strong(epoch,epoch+2,boost::memory_order_release,boost::memory_order_relaxed);
+        }
+
+        // A batch tagged with epoch e can be reclaimed once the global
+        // epoch has advanced twice past it: every thread pinned when it was
+        // tagged has since unpinned.
+        static bool reclaimable(retired_batch const& batch,unsigned epoch)
+        {
+            return epoch-batch.epoch>=4;
+        }
+
+        void collect(epoch_record& r)
+        {
+            // A reclaim function may retire more objects, or enter and
+            // leave an epoch_guard; neither starts a nested collect().
+            if(r.collecting)
+            {
+                return;
+            }
+            seal(r);
+            try_advance();
+            unsigned const epoch=global_epoch.load(boost::memory_order_acquire);
+            r.collecting=true;
+            while(!r.batches.empty() && reclaimable(r.batches.front(),epoch))
+            {
+                reclaim_batch(r.batches.front());
+                r.batches.pop_front();
+            }
+            if(has_orphans.load(boost::memory_order_relaxed))
+            {
+                std::deque<retired_batch> ready;
+                {
+                    boost::lock_guard<boost::mutex> lk(orphan_mutex);
+                    while(!orphans.empty() && reclaimable(orphans.front(),epoch))
+                    {
+                        ready.push_back(retired_batch());
+                        ready.back().objects.swap(orphans.front().objects);
+                        orphans.pop_front();
+                    }
+                    has_orphans.store(!orphans.empty(),boost::memory_order_relaxed);
+                }
+                for(std::size_t i=0;i<ready.size();++i)
+                {
+                    reclaim_batch(ready[i]);
+                }
+            }
+            r.collecting=false;
+        }
+    };
+
+    template<typename T>
+    void delete_retired(void* p)
+    {
+        delete static_cast<T*>(p);
+    }
+}
+
+//! Epoch-based memory reclamation.
+//!
+//! Threads read a shared lock-free structure inside an epoch_guard. A thread
+//! that unlinks a node passes it to retire() instead of deleting it, and
+//! the domain deletes the node once every thread that was inside an
+//! epoch_guard at the time has left it. Readers only write to their own
+//! per-thread record, so traversing a structure involves no atomic
+//! read-modify-write operations and no shared cache line traffic.
+//!
+//! Each thread that uses a domain is given a record the first time it does
+//! so. When the thread exits, objects it retired that have not been
+//! reclaimed are handed to the domain and reclaimed by another thread.
+class epoch_domain:
+    boost::noncopyable
+{
+public:
+    epoch_domain():
+        state(boost::make_shared<detail::epoch_state>()),
+        records(&detail::epoch_state::release_record)
+    {}
+
+    //! No thread may be inside an epoch_guard for *this. Objects retired
+    //! by threads that are still running are reclaimed when the last of
+    //! those threads exits; the rest are reclaimed immediately.
+    ~epoch_domain()
+    {
+        records.reset();
+    }
+
+    //! Arranges for p to be deleted once no thread can still be reading
+    //! it. p must already be unreachable by threads entering a new
+    //! epoch_guard.
+    template<typename T>
+    void retire(T* p)
+    {
+        retire(p,&detail::delete_retired<T>);
+    }
+
+    //! Arranges for reclaim(p) to be called once no thread can still be
+    //! reading p. reclaim must not throw.
+    void retire(void* p,void (*reclaim)(void*))
+    {
+        detail::epoch_record& r=record();
+        r.pending.push_back(detail::retired_object(p,reclaim));
+        if(!r.nesting && r.pending.size()>=detail::epoch_state::batch_size)
+        {
+            state->collect(r);
+        }
+    }
+
+    //! Tries to advance the epoch, and reclaims the objects retired by this
+    //! thread and by threads that have exited that are no longer reachable.
+    void collect()
+    {
+        state->collect(record());
+    }
+
+private:
+    friend class epoch_guard;
+
+    detail::epoch_record& record()
+    {
+        detail::epoch_record* r=records.get();
+        // A record from a destroyed domain at the same address is still
+        // owned by that domain's state.
+        if(!r || r->owner!=state)
+        {
+            r=detail::epoch_state::acquire_record(state);
+            records.reset(r);
+        }
+        return *r;
+    }
+
+    boost::shared_ptr<detail::epoch_state> state;
+    boost::thread_specific_ptr<detail::epoch_record> records;
+};
+
+//! Pins the calling thread to the current epoch of a domain for the
+//! lifetime of the guard. Pointers read from a structure protected by the
+//! domain remain valid until the guard is destroyed. Guards may be nested.
+class epoch_guard:
+    boost::noncopyable
+{
+public:
+    explicit epoch_guard(epoch_domain& domain_):
+        state(*domain_.state),record(domain_.record())
+    {
+        state.pin(record);
+    }
+
+    ~epoch_guard()
+    {
+        state.unpin(record);
+    }
+
+private:
+    detail::epoch_state& state;
+    detail::epoch_record& record;
+};
+
+} // namespace lockfree
+} // namespace boost
+
+#endif // BOOST_LOCKFREE_EPOCH_HPP
@@ -0,0 +1,189 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_MPMC_QUEUE_HPP
+#define BOOST_LOCKFREE_MPMC_QUEUE_HPP
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+
+namespace boost
+{
+namespace lockfree
+{
+
+//! A bounded queue for any number of producer and consumer threads.
+//!
+//! Each slot of the ring buffer carries a sequence number that tells a
+//! producer whether the slot is free for the current lap of the ring, and a
+//! consumer whether it has been filled. Threads claim slots with a single
+//! compare-and-swap on the shared enqueue or dequeue position, so push() and
+//! pop() never allocate and never block.
+//!
+//! The copy constructor, copy assignment operator and destructor of T must
+//! not throw.
+template<typename T>
+class mpmc_queue:
+    boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    //! Constructs an empty queue that can hold at least capacity elements.
+    //! The capacity is rounded up to a power of two.
+    explicit mpmc_queue(size_type capacity):
+        enqueue_position(0),dequeue_position(0),mask(round_up(capacity)-1),cells(0)
+    {
+        cells=static_cast<cell*>(::operator new((mask+1)*sizeof(cell)));
+        for(size_type i=0;i<=mask;++i)
+        {
+            new (&cells[i]) cell(i);
+        }
+    }
+
+    ~mpmc_queue()
+    {
+        size_type const end=enqueue_position.load(boost::memory_order_relaxed);
+        for(size_type i=dequeue_position.load(boost::memory_order_relaxed);i!=end;++i)
+        {
+            cells[i&mask].element()->~T();
+        }
+        ::operator delete(cells);
+    }
+
+    //! Copies value onto the back of the queue and returns true, or returns
+    //! false if the queue is full.
+    bool push(T const& value)
+    {
+        size_type position=enqueue_position.load(boost::memory_order_relaxed);
+        cell* c;
+        for(;;)
+        {
+            c=&cells[position&mask];
+            size_type const sequence=c->sequence.load(boost::memory_order_acquire);
+            std::ptrdiff_t const difference=static_cast<std::ptrdiff_t>(sequence-position);
+            if(!difference)
+            {
+                // The sequence numbers order the accesses to the elements,
+                // so claiming the slot needs no ordering of its own. On
+                // failure, position is updated to the current value.
+                if(enqueue_position.compare_exchange_weak(position,position+1,boost::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if(difference<0)
+            {
+                return false;
+            }
+            else
+            {
+                position=enqueue_position.load(boost::memory_order_relaxed);
+            }
+        }
+        new (c->element()) T(value);
+        c->sequence.store(position+1,boost::memory_order_release);
+        return true;
+    }
+
+    //! Assigns the front element to value, removes it and returns true, or
+    //! returns false if the queue is empty.
+    bool pop(T& value)
+    {
+        size_type position=dequeue_position.load(boost::memory_order_relaxed);
+        cell* c;
+        for(;;)
+        {
+            c=&cells[position&mask];
+            size_type const sequence=c->sequence.load(boost::memory_order_acquire);
+            std::ptrdiff_t const difference=static_cast<std::ptrdiff_t>(sequence-(position+1));
+            if(!difference)
+            {
+                if(dequeue_position.compare_exchange_weak(position,position+1,boost::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if(difference<0)
+            {
+                return false;
+            }
+            else
+            {
+                position=dequeue_position.load(boost::memory_order_relaxed);
+            }
+        }
+        T* const front=c->element();
+        value=*front;
+        front->~T();
+        c->sequence.store(position+mask+1,boost::memory_order_release);
+        return true;
+    }
+
+    //! Returns true if the queue was empty at some point during the call.
+    bool empty() const
+    {
+        size_type const position=dequeue_position.load(boost::memory_order_acquire);
+        return cells[position&mask].sequence.load(boost::memory_order_acquire)!=position+1;
+    }
+
+    size_type capacity() const
+    {
+        return mask+1;
+    }
+
+private:
+    typedef typename boost::aligned_storage<sizeof(T),boost::alignment_of<T>::value>::type storage_type;
+
+    struct cell
+    {
+        boost::atomic<size_type> sequence;
+        storage_type storage;
+
+        explicit cell(size_type sequence_):
+            sequence(sequence_)
+        {}
+
+        T* element()
+        {
+            return static_cast<T*>(static_cast<void*>(&storage));
+        }
+    };
+
+    static size_type round_up(size_type capacity)
+    {
+        if(!capacity)
+        {
+            boost::throw_exception(std::invalid_argument("mpmc_queue capacity must not be zero"));
+        }
+        size_type size=1;
+        while(size<capacity)
+        {
+            size*=2;
+        }
+        return size;
+    }
+
+    char padding0[detail::cache_line_size];
+    boost::atomic<size_type> enqueue_position;
+    char padding1[detail::cache_line_size-sizeof(boost::atomic<size_type>)];
+    boost::atomic<size_type> dequeue_position;
+    char padding2[detail::cache_line_size-sizeof(boost::atomic<size_type>)];
+    size_type const mask;
+    cell* cells;
+};
+
+} // namespace lockfree
+} // namespace boost
+
+#endif // BOOST_LOCKFREE_MPMC_QUEUE_HPP
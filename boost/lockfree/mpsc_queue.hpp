@@ -0,0 +1,194 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_MPSC_QUEUE_HPP
+#define BOOST_LOCKFREE_MPSC_QUEUE_HPP
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/lockfree/mpmc_queue.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/noncopyable.hpp>
+#include <cstddef>
+#include <new>
+
+namespace boost
+{
+namespace lockfree
+{
+
+//! An unbounded queue for any number of producer threads and one consumer
+//! thread.
+//!
+//! Producers link a new node onto the back of the list with a single atomic
+//! exchange, and never wait for each other or for the consumer. Nodes
+//! released by the consumer are kept in a bounded mpmc_queue for producers
+//! to reuse, so a queue whose length stays below that bound stops
+//! allocating once it has warmed up.
+//!
+//! The copy constructor, copy assignment operator and destructor of T must
+//! not throw.
+template<typename T>
+class mpsc_queue:
+    boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    //! Constructs an empty queue that keeps up to recycle_capacity (rounded
+    //! up to a power of two) released nodes for reuse.
+    explicit mpsc_queue(size_type recycle_capacity=1024):
+        head(0),tail(0),free_nodes(recycle_capacity),consumer_waiting(false)
+    {
+        tail=new node;
+        head.store(tail,boost::memory_order_relaxed);
+    }
+
+    ~mpsc_queue()
+    {
+        node* n=tail->next.load(boost::memory_order_relaxed);
+        delete tail;
+        while(n)
+        {
+            node* const next=n->next.load(boost::memory_order_relaxed);
+            n->element()->~T();
+            delete n;
+            n=next;
+        }
+        while(free_nodes.pop(n))
+        {
+            delete n;
+        }
+    }
+
+    //! May be called by any thread. Copies value onto the back of the queue.
+    //! Throws std::bad_alloc if a node cannot be allocated.
+    void push(T const& value)
+    {
+        node* n;
+        if(!free_nodes.pop(n))
+        {
+            n=new node;
+        }
+        new (n->element()) T(value);
+        n->next.store(0,boost::memory_order_relaxed);
+        node* const previous=head.exchange(n,boost::memory_order_acq_rel);
+        previous->next.store(n,boost::memory_order_release);
+
+        // Pairs with the fence in wait_and_pop(): either the consumer sees
+        // the new node or this thread sees that the consumer is waiting.
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        if(consumer_waiting.load(boost::memory_order_relaxed))
+        {
+            boost::lock_guard<boost::mutex> lk(wait_mutex);
+            not_empty.notify_one();
+        }
+    }
+
+    //! Called only by the consumer. Assigns the front element to value,
+    //! removes it and returns true, or returns false if the queue is empty.
+    //! May also return false while a push() that has started to link its
+    //! node has not yet completed.
+    bool pop(T& value)
+    {
+        node* const front=tail;
+        node* const next=front->next.load(boost::memory_order_acquire);
+        if(!next)
+        {
+            return false;
+        }
+        T* const element=next->element();
+        value=*element;
+        element->~T();
+        tail=next;
+        if(!free_nodes.push(front))
+        {
+            delete front;
+        }
+        return true;
+    }
+
+    //! Called only by the consumer. Assigns the front element to value and
+    //! removes it, blocking until the queue is not empty if necessary.
+    //! Requires the Boost.Thread library. This function is an interruption
+    //! point.
+    void wait_and_pop(T& value)
+    {
+        for(unsigned k=0;k<spin_count;++k)
+        {
+            if(pop(value))
+            {
+                return;
+            }
+            detail::cpu_relax();
+        }
+        boost::unique_lock<boost::mutex> lk(wait_mutex);
+        consumer_waiting.store(true,boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        try
+        {
+            while(!pop(value))
+            {
+                not_empty.wait(lk);
+            }
+        }
+        catch(...)
+        {
+            consumer_waiting.store(false,boost::memory_order_relaxed);
+            throw;
+        }
+        consumer_waiting.store(false,boost::memory_order_relaxed);
+    }
+
+    //! Called only by the consumer. Returns true if the queue was empty when
+    //! checked.
+    bool empty() const
+    {
+        return !tail->next.load(boost::memory_order_acquire);
+    }
+
+private:
+    typedef typename boost::aligned_storage<sizeof(T),boost::alignment_of<T>::value>::type storage_type;
+
+    struct node
+    {
+        boost::atomic<node*> next;
+        storage_type storage;
+
+        node():
+            next(0)
+        {}
+
+        T* element()
+        {
+            return static_cast<T*>(static_cast<void*>(&storage));
+        }
+    };
+
+    // The number of attempts wait_and_pop() makes before it sleeps.
+    static unsigned const spin_count=64;
+
+    char padding0[detail::cache_line_size];
+    boost::atomic<node*> head;
+    char padding1[detail::cache_line_size-sizeof(boost::atomic<node*>)];
+    // tail->next is the front of the queue: tail itself is the node that
+    // held the previous element, or the initial dummy node.
+    node* tail;
+    char padding2[detail::cache_line_size-sizeof(node*)];
+    mpmc_queue<node*> free_nodes;
+    boost::atomic<bool> consumer_waiting;
+    boost::mutex wait_mutex;
+    boost::condition_variable not_empty;
+};
+
+} // namespace lockfree
+} // namespace boost
+
+#endif // BOOST_LOCKFREE_MPSC_QUEUE_HPP
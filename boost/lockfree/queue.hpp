@@ -0,0 +1,14 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_QUEUE_HPP
+#define BOOST_LOCKFREE_QUEUE_HPP
+
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/lockfree/mpmc_queue.hpp>
+#include <boost/lockfree/mpsc_queue.hpp>
+
+#endif // BOOST_LOCKFREE_QUEUE_HPP
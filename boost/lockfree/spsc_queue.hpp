@@ -0,0 +1,138 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_LOCKFREE_SPSC_QUEUE_HPP
+#define BOOST_LOCKFREE_SPSC_QUEUE_HPP
+
+#include <boost/lockfree/detail/atomic.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+
+namespace boost
+{
+namespace lockfree
+{
+
+//! A bounded queue for exactly one producer thread and one consumer thread.
+//! Elements are stored in a ring buffer allocated by the constructor, so
+//! push() and pop() never allocate and never block.
+template<typename T>
+class spsc_queue:
+    boost::noncopyable
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+
+    //! Constructs an empty queue that can hold up to capacity elements.
+    explicit spsc_queue(size_type capacity):
+        write_index(0),cached_read_index(0),read_index(0),cached_write_index(0),
+        slot_count(capacity+1),slots(0)
+    {
+        if(!capacity)
+        {
+            boost::throw_exception(std::invalid_argument("spsc_queue capacity must not be zero"));
+        }
+        slots=static_cast<storage_type*>(::operator new(slot_count*sizeof(storage_type)));
+    }
+
+    ~spsc_queue()
+    {
+        size_type const w=write_index.load(boost::memory_order_relaxed);
+        for(size_type i=read_index.load(boost::memory_order_relaxed);i!=w;i=next(i))
+        {
+            element(i)->~T();
+        }
+        ::operator delete(slots);
+    }
+
+    //! Called only by the producer. Copies value onto the back of the queue
+    //! and returns true, or returns false if the queue is full.
+    bool push(T const& value)
+    {
+        size_type const w=write_index.load(boost::memory_order_relaxed);
+        size_type const n=next(w);
+        if(n==cached_read_index)
+        {
+            cached_read_index=read_index.load(boost::memory_order_acquire);
+            if(n==cached_read_index)
+            {
+                return false;
+            }
+        }
+        new (element(w)) T(value);
+        write_index.store(n,boost::memory_order_release);
+        return true;
+    }
+
+    //! Called only by the consumer. Assigns the front element to value,
+    //! removes it and returns true, or returns false if the queue is empty.
+    bool pop(T& value)
+    {
+        size_type const r=read_index.load(boost::memory_order_relaxed);
+        if(r==cached_write_index)
+        {
+            cached_write_index=write_index.load(boost::memory_order_acquire);
+            if(r==cached_write_index)
+            {
+                return false;
+            }
+        }
+        T* const front=element(r);
+        value=*front;
+        front->~T();
+        read_index.store(next(r),boost::memory_order_release);
+        return true;
+    }
+
+    //! Returns true if the queue was empty at some point during the call.
+    bool empty() const
+    {
+        return read_index.load(boost::memory_order_acquire)==write_index.load(boost::memory_order_acquire);
+    }
+
+    size_type capacity() const
+    {
+        return slot_count-1;
+    }
+
+private:
+    typedef typename boost::aligned_storage<sizeof(T),boost::alignment_of<T>::value>::type storage_type;
+
+    size_type next(size_type i) const
+    {
+        return ++i==slot_count?0:i;
+    }
+
+    T* element(size_type i) const
+    {
+        return static_cast<T*>(static_cast<void*>(slots+i));
+    }
+
+    // The producer's indices and the consumer's indices are kept on
+    // separate cache lines. Each side keeps a copy of the other side's
+    // index and only reloads it when the copy says the queue is full or
+    // empty.
+    char padding0[detail::cache_line_size];
+    boost::atomic<size_type> write_index;
+    size_type cached_read_index;
+    char padding1[detail::cache_line_size-sizeof(boost::atomic<size_type>)-sizeof(size_type)];
+    boost::atomic<size_type> read_index;
+    size_type cached_write_index;
+    char padding2[detail::cache_line_size-sizeof(boost::atomic<size_type>)-sizeof(size_type)];
+    size_type const slot_count;
+    storage_type* slots;
+};
+
+} // namespace lockfree
+} // namespace boost
+
+#endif // BOOST_LOCKFREE_SPSC_QUEUE_HPP
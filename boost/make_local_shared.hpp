@@ -0,0 +1,17 @@
+#ifndef BOOST_MAKE_LOCAL_SHARED_HPP_INCLUDED
+#define BOOST_MAKE_LOCAL_SHARED_HPP_INCLUDED
+
+//  make_local_shared.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+//  See http://www.boost.org/libs/smart_ptr/local_shared_ptr.html
+//  for documentation.
+
+#include <boost/smart_ptr/make_local_shared.hpp>
+
+#endif // #ifndef BOOST_MAKE_LOCAL_SHARED_HPP_INCLUDED
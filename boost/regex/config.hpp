@@ -277,6 +277,21 @@
 #ifndef BOOST_REGEX_MAX_STATE_COUNT
 #  define BOOST_REGEX_MAX_STATE_COUNT 100000000
 #endif
+/*
+ * The number of states the lazy DFA may build for one expression before
+ * searches with that expression go back to the backtracking matcher:
+ */
+#ifndef BOOST_REGEX_MAX_DFA_STATES
+#  define BOOST_REGEX_MAX_DFA_STATES 4096
+#endif
+/*
+ * Whether regex_search can use SSE2 to scan narrow character input for
+ * literals and for the characters that can start a match:
+ */
+#if !defined(BOOST_REGEX_NO_SIMD) && !defined(BOOST_REGEX_HAS_SSE2) \
+   && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#  define BOOST_REGEX_HAS_SSE2
+#endif
 
 
 /*****************************************************************************
@@ -86,5 +86,14 @@
 // down quite a bit).
 // #define BOOST_REGEX_MATCH_EXTRA
 
+// define this if you want to set the maximum number of states the lazy
+// DFA may build for one expression: once an expression reaches this many
+// states, searches with it use the backtracking matcher instead.
+// #define BOOST_REGEX_MAX_DFA_STATES 4096
+
+// define this if you don't want regex_search to use SSE2 instructions
+// when scanning ahead for literals, even if the compiler targets them.
+// #define BOOST_REGEX_NO_SIMD
+
 // define this if you want to enable support for Unicode via ICU.
 // #define BOOST_HAS_ICU
@@ -46,6 +46,8 @@ namespace re_detail{
 //
 template <class charT, class traits>
 class basic_regex_parser;
+template <class charT, class traits>
+class lazy_dfa;
 
 template <class I>
 void bubble_down_one(I first, I last)
@@ -177,12 +179,20 @@ struct regex_data : public named_subexpressions
    unsigned                    m_restart_type;            // search optimisation type
    unsigned char               m_startmap[1 << CHAR_BIT]; // which characters can start a match
    unsigned int                m_can_be_null;             // whether we can match a null string
+   const charT*                m_required;                // a literal that every match contains, may be null
+   std::size_t                 m_required_length;         // the length of m_required
+   bool                        m_required_is_prefix;      // whether every match starts with m_required
+   unsigned char               m_start_chars[3];          // the characters that can start a match, if there are no more than 3 ...
+   unsigned                    m_start_char_count;        // ... and how many of them there are, otherwise 0
    re_detail::raw_storage      m_data;                    // the buffer in which our states are constructed
    typename traits::char_class_type    m_word_mask;       // mask used to determine if a character is a word character
    std::vector<
       std::pair<
       std::size_t, std::size_t> > m_subs;                 // Position of sub-expressions within the *string*.
    bool                        m_has_recursions;          // whether we have recursive expressions;
+   ::boost::shared_ptr<
+      re_detail::lazy_dfa<
+      charT, traits> >         m_dfa;                     // DFA for expressions that need no backtracking, may be null.
 };
 //
 // class basic_regex_implementation
@@ -256,11 +256,17 @@ private:
    int calculate_backstep(re_syntax_base* state);
    void create_startmap(re_syntax_base* state, unsigned char* l_map, unsigned int* pnull, unsigned char mask);
    unsigned get_restart_type(re_syntax_base* state);
+   void find_required_literal(re_syntax_base* state);
+   void find_start_chars();
    void set_all_masks(unsigned char* bits, unsigned char);
    bool is_bad_repeat(re_syntax_base* pt);
    void set_bad_repeat(re_syntax_base* pt);
    syntax_element_type get_repeat_type(re_syntax_base* state);
    void probe_leading_repeat(re_syntax_base* state);
+   void create_dfa(mpl::true_*);
+   void create_dfa(mpl::false_*);
+   bool can_use_dfa(re_syntax_base* state);
+   bool can_skip_repeat_body(re_repeat* rep);
 };
 
 template <class charT, class traits>
@@ -715,8 +721,14 @@ void basic_regex_creator<charT, traits>::finalize(const charT* p1, const charT*
    create_startmap(m_pdata->m_first_state, m_pdata->m_startmap, &(m_pdata->m_can_be_null), mask_all);
    // get the restart type:
    m_pdata->m_restart_type = get_restart_type(m_pdata->m_first_state);
+   // find what regex_search can scan for before running the machine:
+   find_required_literal(m_pdata->m_first_state);
+   find_start_chars();
    // optimise a leading repeat if there is one:
    probe_leading_repeat(m_pdata->m_first_state);
+   // create a DFA if the machine never needs to backtrack:
+   typedef mpl::bool_< (sizeof(charT) == 1) > truth_type;
+   create_dfa(static_cast<truth_type*>(0));
 }
 
 template <class charT, class traits>
@@ -1168,32 +1180,42 @@ void basic_regex_creator<charT, traits>::create_startmap(re_syntax_base* state,
       }
       case syntax_element_word_start:
       {
-         // recurse, then AND with all the word characters:
-         create_startmap(state->next.p, l_map, pnull, mask);
+         // recurse into a scratch map, then AND with all the word characters,
+         // l_map may already hold characters from an enclosing repeat that
+         // must not be masked out:
          if(l_map)
          {
+            unsigned char w_map[1u << CHAR_BIT] = { 0, };
+            create_startmap(state->next.p, w_map, pnull, mask);
             l_map[0] |= mask_init;
             for(unsigned int i = 0; i < (1u << CHAR_BIT); ++i)
             {
-               if(!m_traits.isctype(static_cast<charT>(i), m_word_mask))
-                  l_map[i] &= static_cast<unsigned char>(~mask);
+               if(m_traits.isctype(static_cast<charT>(i), m_word_mask))
+                  l_map[i] |= static_cast<unsigned char>(w_map[i] & mask);
             }
          }
+         else
+            create_startmap(state->next.p, 0, pnull, mask);
          return;
       }
       case syntax_element_word_end:
       {
-         // recurse, then AND with all the word characters:
-         create_startmap(state->next.p, l_map, pnull, mask);
+         // recurse into a scratch map, then AND with all the word characters,
+         // l_map may already hold characters from an enclosing repeat that
+         // must not be masked out:
          if(l_map)
          {
+            unsigned char w_map[1u << CHAR_BIT] = { 0, };
+            create_startmap(state->next.p, w_map, pnull, mask);
             l_map[0] |= mask_init;
             for(unsigned int i = 0; i < (1u << CHAR_BIT); ++i)
             {
-               if(m_traits.isctype(static_cast<charT>(i), m_word_mask))
-                  l_map[i] &= static_cast<unsigned char>(~mask);
+               if(!m_traits.isctype(static_cast<charT>(i), m_word_mask))
+                  l_map[i] |= static_cast<unsigned char>(w_map[i] & mask);
             }
          }
+         else
+            create_startmap(state->next.p, 0, pnull, mask);
          return;
       }
       case syntax_element_buffer_end:
@@ -1389,6 +1411,97 @@ unsigned basic_regex_creator<charT, traits>::get_restart_type(re_syntax_base* st
    return regbase::restart_any;
 }
 
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::find_required_literal(re_syntax_base* state)
+{
+   //
+   // Follows the states that every match passes through, from the start
+   // of the machine up to the first alternative, stepping over repeats,
+   // and records the longest literal among them: if it's the first thing
+   // matched then every match starts with it.  Only case sensitive
+   // literals are used, and only if the traits class doesn't translate
+   // characters:
+   //
+   m_pdata->m_required = 0;
+   m_pdata->m_required_length = 0;
+   m_pdata->m_required_is_prefix = false;
+   if(m_pdata->m_flags & regbase::icase)
+      return;
+   for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+   {
+      if(m_traits.translate(static_cast<charT>(c), false) != static_cast<charT>(c))
+         return;
+   }
+   bool at_start = true;
+   while(state)
+   {
+      switch(state->type)
+      {
+      case syntax_element_startmark:
+         // assertions, independent sub-expressions and conditionals aren't always matched:
+         if(static_cast<re_brace*>(state)->index < 0)
+            return;
+         break;
+      case syntax_element_literal:
+         if(static_cast<re_literal*>(state)->length > m_pdata->m_required_length)
+         {
+            m_pdata->m_required = reinterpret_cast<const charT*>(static_cast<re_literal*>(state) + 1);
+            m_pdata->m_required_length = static_cast<re_literal*>(state)->length;
+            m_pdata->m_required_is_prefix = at_start;
+         }
+         at_start = false;
+         break;
+      case syntax_element_wild:
+      case syntax_element_set:
+      case syntax_element_long_set:
+         at_start = false;
+         break;
+      case syntax_element_rep:
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+      case syntax_element_long_set_rep:
+         // whatever the repeat matches, every match carries on after it:
+         at_start = false;
+         state = static_cast<re_repeat*>(state)->alt.p;
+         continue;
+      case syntax_element_endmark:
+      case syntax_element_start_line:
+      case syntax_element_end_line:
+      case syntax_element_word_boundary:
+      case syntax_element_within_word:
+      case syntax_element_word_start:
+      case syntax_element_word_end:
+      case syntax_element_buffer_start:
+      case syntax_element_buffer_end:
+         break;
+      default:
+         return;
+      }
+      state = state->next.p;
+   }
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::find_start_chars()
+{
+   // records the characters that can start a match, if there are only a few:
+   m_pdata->m_start_char_count = 0;
+   if(m_pdata->m_can_be_null)
+      return;
+   unsigned count = 0;
+   for(unsigned c = 0; c < (1u << CHAR_BIT); ++c)
+   {
+      if(m_pdata->m_startmap[c] & mask_any)
+      {
+         if(count == sizeof(m_pdata->m_start_chars))
+            return;
+         m_pdata->m_start_chars[count++] = static_cast<unsigned char>(c);
+      }
+   }
+   m_pdata->m_start_char_count = count;
+}
+
 template <class charT, class traits>
 void basic_regex_creator<charT, traits>::set_all_masks(unsigned char* bits, unsigned char mask)
 {
@@ -1537,6 +1650,137 @@ void basic_regex_creator<charT, traits>::probe_leading_repeat(re_syntax_base* st
 }
 
 
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::create_dfa(mpl::true_*)
+{
+   m_pdata->m_dfa.reset();
+   if(!m_has_backrefs && !m_has_recursions && can_use_dfa(m_pdata->m_first_state))
+      m_pdata->m_dfa.reset(new lazy_dfa<charT, traits>(*m_pdata));
+}
+
+template <class charT, class traits>
+void basic_regex_creator<charT, traits>::create_dfa(mpl::false_*)
+{
+   // wide character expressions always use perl_matcher:
+   m_pdata->m_dfa.reset();
+}
+
+template <class charT, class traits>
+bool basic_regex_creator<charT, traits>::can_use_dfa(re_syntax_base* state)
+{
+   //
+   // Returns true if none of the states in the machine need backtracking,
+   // and the repeats are ones whose counts lazy_dfa can track:
+   //
+   static const std::size_t max_count = 255;
+   bool icase = m_pdata->m_flags & regbase::icase;
+   while(state)
+   {
+      switch(state->type)
+      {
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+         // no (?...) extensions, and no change of case sensitivity:
+         if((static_cast<re_brace*>(state)->index < 0) || (static_cast<re_brace*>(state)->icase != icase))
+            return false;
+         break;
+      case syntax_element_literal:
+      case syntax_element_start_line:
+      case syntax_element_end_line:
+      case syntax_element_wild:
+      case syntax_element_match:
+      case syntax_element_word_boundary:
+      case syntax_element_within_word:
+      case syntax_element_word_start:
+      case syntax_element_word_end:
+      case syntax_element_buffer_start:
+      case syntax_element_buffer_end:
+      case syntax_element_set:
+      case syntax_element_jump:
+      case syntax_element_alt:
+         break;
+      case syntax_element_rep:
+         {
+            // only ?, * and + - lazy_dfa counts a repeat as entered or not:
+            re_repeat* rep = static_cast<re_repeat*>(state);
+            if((rep->min > 1) || (rep->min > rep->max)
+               || ((rep->max != 1) && (rep->max != (std::numeric_limits<std::size_t>::max)())))
+               return false;
+            if(can_skip_repeat_body(rep))
+               return false;
+            break;
+         }
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+         {
+            re_repeat* rep = static_cast<re_repeat*>(state);
+            if((rep->min > max_count)
+               || ((rep->max > max_count) && (rep->max != (std::numeric_limits<std::size_t>::max)())))
+               return false;
+            break;
+         }
+      default:
+         return false;
+      }
+      state = state->next.p;
+   }
+   return true;
+}
+
+template <class charT, class traits>
+bool basic_regex_creator<charT, traits>::can_skip_repeat_body(re_repeat* rep)
+{
+   //
+   // Returns true if we can get from the start of the repeat's body back
+   // to the repeat without matching any characters:
+   //
+   std::vector<re_syntax_base*> stack;
+   std::set<re_syntax_base*> seen;
+   stack.push_back(rep->next.p);
+   while(!stack.empty())
+   {
+      re_syntax_base* state = stack.back();
+      stack.pop_back();
+      if(state == rep)
+         return true;
+      if(!state || !seen.insert(state).second)
+         continue;
+      switch(state->type)
+      {
+      case syntax_element_literal:
+      case syntax_element_wild:
+      case syntax_element_set:
+      case syntax_element_match:
+         break;
+      case syntax_element_jump:
+         stack.push_back(static_cast<re_jump*>(state)->alt.p);
+         break;
+      case syntax_element_alt:
+         stack.push_back(static_cast<re_jump*>(state)->alt.p);
+         stack.push_back(state->next.p);
+         break;
+      case syntax_element_rep:
+         if(static_cast<re_repeat*>(state)->min == 0)
+            stack.push_back(static_cast<re_jump*>(state)->alt.p);
+         stack.push_back(state->next.p);
+         break;
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+         if(static_cast<re_repeat*>(state)->min == 0)
+            stack.push_back(static_cast<re_jump*>(state)->alt.p);
+         break;
+      default:
+         // brackets and assertions match nothing:
+         stack.push_back(state->next.p);
+         break;
+      }
+   }
+   return false;
+}
+
 } // namespace re_detail
 
 } // namespace boost
@@ -0,0 +1,172 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         fast_scan.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Scans narrow character buffers for literals and for a few
+  *                characters at a time, using SSE2 where it's available.
+  */
+
+#ifndef BOOST_REGEX_V4_FAST_SCAN_HPP
+#define BOOST_REGEX_V4_FAST_SCAN_HPP
+
+#include <cstring>
+#ifdef BOOST_REGEX_HAS_SSE2
+#  include <emmintrin.h>
+#  if defined(BOOST_MSVC) && !defined(__GNUC__)
+#     include <intrin.h>
+#  endif
+#endif
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+namespace boost{
+namespace re_detail{
+
+#ifdef BOOST_REGEX_HAS_SSE2
+inline unsigned find_first_bit(unsigned mask)
+{
+   BOOST_ASSERT(mask);
+#if defined(__GNUC__)
+   return static_cast<unsigned>(__builtin_ctz(mask));
+#elif defined(BOOST_MSVC)
+   unsigned long result;
+   _BitScanForward(&result, mask);
+   return static_cast<unsigned>(result);
+#else
+   unsigned result = 0;
+   while((mask & 1u) == 0)
+   {
+      mask >>= 1;
+      ++result;
+   }
+   return result;
+#endif
+}
+#endif
+
+//
+// Returns the first position in [first, last) that holds one of the count
+// characters in chars, or last if there is none; count is 1, 2 or 3:
+//
+inline const char* find_any_of(const char* first, const char* last, const unsigned char* chars, unsigned count)
+{
+   BOOST_ASSERT((count > 0) && (count <= 3));
+   if(count == 1)
+   {
+      // the C library's memchr is usually as fast as anything we could do:
+      const void* p = std::memchr(first, chars[0], static_cast<std::size_t>(last - first));
+      return p ? static_cast<const char*>(p) : last;
+   }
+   unsigned char c0 = chars[0];
+   unsigned char c1 = chars[1];
+   unsigned char c2 = chars[count - 1];
+#ifdef BOOST_REGEX_HAS_SSE2
+   __m128i v0 = _mm_set1_epi8(static_cast<char>(c0));
+   __m128i v1 = _mm_set1_epi8(static_cast<char>(c1));
+   __m128i v2 = _mm_set1_epi8(static_cast<char>(c2));
+   while(last - first >= 16)
+   {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+      __m128i found = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, v0), _mm_cmpeq_epi8(block, v1)), _mm_cmpeq_epi8(block, v2));
+      unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(found));
+      if(mask)
+         return first + find_first_bit(mask);
+      first += 16;
+   }
+#endif
+   for(; first != last; ++first)
+   {
+      unsigned char c = static_cast<unsigned char>(*first);
+      if((c == c0) || (c == c1) || (c == c2))
+         return first;
+   }
+   return last;
+}
+
+//
+// Returns the start of the first occurrence of the literal [s, s + len)
+// in [first, last), or last if there is none; len must not be zero:
+//
+inline const char* find_literal(const char* first, const char* last, const char* s, std::size_t len)
+{
+   BOOST_ASSERT(len);
+   if(static_cast<std::size_t>(last - first) < len)
+      return last;
+   // one past the last position at which the literal can start:
+   const char* end = last - (len - 1);
+#ifdef BOOST_REGEX_HAS_SSE2
+   if(len > 1)
+   {
+      //
+      // A position is a candidate if both the first and last characters
+      // of the literal are found where they should be, which rules out
+      // most positions 16 at a time:
+      //
+      __m128i v0 = _mm_set1_epi8(s[0]);
+      __m128i v1 = _mm_set1_epi8(s[len - 1]);
+      while(end - first >= 16)
+      {
+         __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+         __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + len - 1));
+         unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, v0), _mm_cmpeq_epi8(tail, v1))));
+         while(mask)
+         {
+            const char* p = first + find_first_bit(mask);
+            if(std::memcmp(p + 1, s + 1, len - 2) == 0)
+               return p;
+            mask &= mask - 1;
+         }
+         first += 16;
+      }
+   }
+#endif
+   while(first != end)
+   {
+      const void* p = std::memchr(first, s[0], static_cast<std::size_t>(end - first));
+      if(p == 0)
+         return last;
+      first = static_cast<const char*>(p);
+      if(std::memcmp(first + 1, s + 1, len - 1) == 0)
+         return first;
+      ++first;
+   }
+   return last;
+}
+
+} // namespace re_detail
+} // namespace boost
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+#endif // BOOST_REGEX_V4_FAST_SCAN_HPP
+
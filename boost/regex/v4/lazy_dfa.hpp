@@ -0,0 +1,1083 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         lazy_dfa.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares template class lazy_dfa, which runs expressions
+  *                that need no backtracking on a DFA that is built as
+  *                the input is read.
+  */
+
+#ifndef BOOST_REGEX_V4_LAZY_DFA_HPP
+#define BOOST_REGEX_V4_LAZY_DFA_HPP
+
+#include <boost/atomic.hpp>
+#include <boost/detail/lightweight_mutex.hpp>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+#ifdef BOOST_MSVC
+#  pragma warning(push)
+#  pragma warning(disable: 4800)
+#endif
+
+namespace boost{
+namespace re_detail{
+
+//
+// The state machine built by basic_regex_creator is run here as an NFA
+// whose threads are (state, count) pairs: for a literal the count is the
+// number of characters matched so far, for a single character repeat it
+// is the number of repeats so far, and for any other repeat it records
+// whether we got there through the jump at the end of the repeat's body.
+// Threads are kept in the order in which perl_matcher would try them, so
+// the first thread to reach the end of the machine gives the match that
+// perl_matcher would have found.
+//
+// Each DFA state is one such ordered list of threads, together with what
+// we need to know about the previous character to evaluate ^, $ and \b.
+// States and transitions are created the first time they are needed and
+// are then shared by every search with the expression: transitions are
+// read without locking, new states are created under a mutex.  Once
+// BOOST_REGEX_MAX_DFA_STATES states exist no more are created, and
+// searches go back to perl_matcher.
+//
+// The DFA may be built from the machines of several expressions, which
+// are then tried in turn as if they were alternatives, or all at once
+// for a basic_regex_set: in that case the order of the threads doesn't
+// matter, and a state records which machines have a match ending just
+// before it.
+//
+enum dfa_run_type
+{
+   dfa_anchored = 0,      // the match starts at the first character
+   dfa_unanchored = 1,    // the match starts anywhere
+   dfa_whole = 2,         // the match starts at the first character and ends at the last
+   dfa_set = 3            // each machine matches on its own, starting anywhere
+};
+
+enum dfa_result
+{
+   dfa_no_match = 0,
+   dfa_match = 1,
+   dfa_gave_up = 2        // too many states, use perl_matcher instead
+};
+
+template <class charT, class traits>
+class lazy_dfa
+{
+public:
+   lazy_dfa(const regex_data<charT, traits>& data);
+   lazy_dfa(const regex_data<charT, traits>* const* machines, std::size_t count);
+   ~lazy_dfa();
+
+   // whether the machines of a and b can share a DFA:
+   static bool compatible(const regex_data<charT, traits>& a, const regex_data<charT, traits>& b);
+   std::size_t size()const
+   {
+      return m_machine_start.size();
+   }
+   bool can_start(charT c)const
+   {
+      return m_can_start[static_cast<unsigned char>(c)];
+   }
+
+   //
+   // Runs the DFA from first, with the threads that start there, until
+   // the match can't be extended, or until we've read the character at
+   // stop.  end is set to where the last match found ends, or to where
+   // the first match ends if stop_at_first is set.  If restart is not
+   // null it is set to the last position before the first match at
+   // which every live thread started.  If machine is not null it is set
+   // to the index of the machine that found the match.
+   //
+   template <class BidiIterator>
+   dfa_result run(dfa_run_type type, match_flag_type f, BidiIterator first, BidiIterator last, BidiIterator backstop, BidiIterator stop, bool stop_at_first, BidiIterator& end, BidiIterator* restart, int* machine = 0)const;
+   //
+   // Runs every machine over [first, last) at once, setting found[i] for
+   // each machine i that matches somewhere, and stops early once they all
+   // have; found must hold size() elements, all false.
+   //
+   template <class BidiIterator>
+   dfa_result run_set(match_flag_type f, BidiIterator first, BidiIterator last, BidiIterator backstop, std::vector<bool>& found)const;
+
+private:
+   lazy_dfa(const lazy_dfa&);
+   lazy_dfa& operator=(const lazy_dfa&);
+
+   typedef std::pair<int, int> thread_type;
+
+   struct node
+   {
+      syntax_element_type type;
+      int next;            // index of the next state, -1 for none
+      int alt;             // index of the jump, alternative or repeat target
+      std::size_t min, max;
+      bool greedy;
+      bool back;           // a jump back to the start of a repeat
+      int test;            // index in m_node_tests of the first character test, -1 for '.'
+      unsigned length;     // length of a literal
+      unsigned char mask;  // re_dot::mask for '.'
+      int machine;         // the machine this state belongs to
+   };
+
+   struct dfa_state
+   {
+      const std::vector<int>* key;
+      boost::atomic<dfa_state*>* next;   // one per character class
+      mutable boost::atomic<int> end;    // -1 until we know whether there is a match at the end of input
+      unsigned flags;
+      int machine;                       // the machine with a match ending here, for state_match
+      const int* matches;                // for dfa_set, the machines with a match ending here
+      unsigned match_count;
+   };
+
+   enum
+   {
+      // properties of a character:
+      prop_word = 1,
+      prop_sep = 2,
+      prop_cr = 4,
+      prop_nl = 8,
+      prop_null = 16,
+      // context of a position:
+      ctx_prev = 32,          // there is a previous character
+      ctx_backstop = 64,      // the position is the backstop
+      ctx_end = 128,          // the position is the end of input
+      ctx_count = 128         // number of distinct contexts before a position
+   };
+
+   enum
+   {
+      // state flags, held in the key:
+      state_match = 1,        // a match ended before the character that led here
+      state_restart = 2,      // every thread started at the character that led here
+      // state flags, not held in the key:
+      state_dead = 4,         // no more matches are possible
+      state_idle = 8          // no threads, a match may start at the next character
+   };
+
+   enum
+   {
+      // layout of a state's key, followed by its threads:
+      key_type = 0,
+      key_mode = 1,
+      key_prev = 2,
+      key_flags = 3,
+      key_matched = 4,        // there was a match before this state
+      key_machine = 5,        // the machine with a match ending here
+      key_threads = 6,        // the number of threads, for dfa_set these are followed by the matches
+      key_size = 7
+   };
+
+   typedef std::map<std::vector<int>, dfa_state*> state_map;
+
+   // the start states for one mode, created when first needed:
+   struct start_cache
+   {
+      int mode;
+      boost::atomic<dfa_state*> states[4][ctx_count];
+   };
+   enum { start_cache_count = 8 };   // the number of modes whose start states are cached
+
+   int mode(match_flag_type f)const
+   {
+      // only the flags that some state tests are part of a state:
+      return static_cast<int>(f & m_mode_mask);
+   }
+   template <class BidiIterator>
+   int context(BidiIterator position, BidiIterator backstop, match_flag_type f)const
+   {
+      if(position == backstop)
+      {
+         if((f & match_prev_avail) == 0)
+            return ctx_backstop;
+         --position;
+         return m_props[m_class[static_cast<unsigned char>(*position)]] | ctx_prev | ctx_backstop;
+      }
+      --position;
+      return m_props[m_class[static_cast<unsigned char>(*position)]] | ctx_prev;
+   }
+
+   static int add_test(const std::vector<unsigned char>& bytes, std::vector<std::vector<unsigned char> >& tests, std::map<std::vector<unsigned char>, int>& ids);
+   bool check(const node& n, int mode, int prev, int next)const;
+   bool accepts(const thread_type& t, int mode, unsigned c)const;
+   thread_type advance(const thread_type& t)const;
+   void init(const regex_data<charT, traits>* const* machines, std::size_t count);
+   int follow(thread_type t, dfa_run_type type, int mode, int prev, int next, std::vector<thread_type>& list, std::set<thread_type>& seen, std::vector<int>* matches)const;
+   int closure(const std::vector<int>& key, int next, std::vector<thread_type>& list, std::size_t& injected, std::vector<int>* matches)const;
+   int match_at_end(const dfa_state* s)const;
+   const dfa_state* start(dfa_run_type type, match_flag_type f, int prev)const;
+   const dfa_state* transition(const dfa_state* s, unsigned c)const;
+   const dfa_state* transition_end(const dfa_state* s)const;
+   dfa_state* find_state(const std::vector<int>& key)const;
+
+   std::vector<node>                 m_nodes;
+   std::vector<int>                  m_machine_start;        // the first state of each machine
+   unsigned char                     m_class[1 << CHAR_BIT]; // character class of each character
+   unsigned                          m_class_count;
+   std::vector<unsigned char>        m_props;                // properties of each character class
+   std::vector<int>                  m_node_tests;           // the tests made by each state
+   std::vector<unsigned char>        m_tests;                // m_tests[test * m_class_count + class]
+   bool                              m_can_start[1 << CHAR_BIT]; // characters that may start a match
+   match_flag_type                   m_mode_mask;            // the match flags that change the result
+   mutable boost::detail::lightweight_mutex m_mutex;         // protects m_states
+   mutable state_map                 m_states;
+   mutable boost::atomic<start_cache*> m_start[start_cache_count]; // start states for the first modes used
+   mutable boost::atomic<bool>       m_full;
+};
+
+template <class charT, class traits>
+lazy_dfa<charT, traits>::lazy_dfa(const regex_data<charT, traits>& data)
+   : m_full(false)
+{
+   const regex_data<charT, traits>* p = &data;
+   init(&p, 1);
+}
+
+template <class charT, class traits>
+lazy_dfa<charT, traits>::lazy_dfa(const regex_data<charT, traits>* const* machines, std::size_t count)
+   : m_full(false)
+{
+   BOOST_ASSERT(count);
+   init(machines, count);
+}
+
+template <class charT, class traits>
+bool lazy_dfa<charT, traits>::compatible(const regex_data<charT, traits>& a, const regex_data<charT, traits>& b)
+{
+   // the machines share the properties of each character:
+   for(unsigned i = 0; i < (1u << CHAR_BIT); ++i)
+   {
+      charT c = static_cast<charT>(i);
+      if(a.m_ptraits->isctype(c, a.m_word_mask) != b.m_ptraits->isctype(c, b.m_word_mask))
+         return false;
+   }
+   return true;
+}
+
+template <class charT, class traits>
+void lazy_dfa<charT, traits>::init(const regex_data<charT, traits>* const* machines, std::size_t count)
+{
+   //
+   // number the states, one machine after another:
+   //
+   std::map<const re_syntax_base*, int> ids;
+   const re_syntax_base* state;
+   std::size_t k;
+   for(k = 0; k < count; ++k)
+   {
+      m_machine_start.push_back(static_cast<int>(ids.size()));
+      for(state = machines[k]->m_first_state; state; state = state->next.p)
+      {
+         int id = static_cast<int>(ids.size());
+         ids[state] = id;
+      }
+   }
+   m_nodes.resize(ids.size());
+   //
+   // describe each state, and collect the tests it makes on characters
+   // as a table indexed by character:
+   //
+   std::map<std::vector<unsigned char>, int> test_ids;
+   std::vector<std::vector<unsigned char> > tests;
+   std::vector<unsigned char> bytes(1u << CHAR_BIT);
+   unsigned i, j;
+   for(k = 0; k < count; ++k)
+   {
+      const ::boost::regex_traits_wrapper<traits>& t = *machines[k]->m_ptraits;
+      bool icase = machines[k]->m_flags & regbase::icase;
+      for(state = machines[k]->m_first_state; state; state = state->next.p)
+      {
+         node& n = m_nodes[ids[state]];
+         n.type = state->type;
+         n.next = state->next.p ? ids[state->next.p] : -1;
+         n.alt = -1;
+         n.min = n.max = 0;
+         n.greedy = n.back = false;
+         n.test = -1;
+         n.length = 0;
+         n.mask = 0;
+         n.machine = static_cast<int>(k);
+         const charT* what = 0;
+         const unsigned char* map = 0;
+         switch(state->type)
+         {
+         case syntax_element_literal:
+            n.length = static_cast<const re_literal*>(state)->length;
+            what = reinterpret_cast<const charT*>(static_cast<const re_literal*>(state) + 1);
+            break;
+         case syntax_element_set:
+            map = static_cast<const re_set*>(state)->_map;
+            break;
+         case syntax_element_wild:
+            n.mask = static_cast<const re_dot*>(state)->mask;
+            break;
+         case syntax_element_jump:
+            n.alt = ids[static_cast<const re_jump*>(state)->alt.p];
+            n.back = (static_cast<const re_jump*>(state)->alt.p->type == syntax_element_rep) && (n.alt < ids[state]);
+            break;
+         case syntax_element_alt:
+            n.alt = ids[static_cast<const re_jump*>(state)->alt.p];
+            break;
+         case syntax_element_rep:
+         case syntax_element_dot_rep:
+         case syntax_element_char_rep:
+         case syntax_element_short_set_rep:
+            n.alt = ids[static_cast<const re_jump*>(state)->alt.p];
+            n.min = static_cast<const re_repeat*>(state)->min;
+            n.max = static_cast<const re_repeat*>(state)->max;
+            n.greedy = static_cast<const re_repeat*>(state)->greedy;
+            if(state->type == syntax_element_dot_rep)
+               n.mask = static_cast<const re_dot*>(state->next.p)->mask;
+            else if(state->type == syntax_element_char_rep)
+               what = reinterpret_cast<const charT*>(static_cast<const re_literal*>(state->next.p) + 1);
+            else if(state->type == syntax_element_short_set_rep)
+               map = static_cast<const re_set*>(state->next.p)->_map;
+            break;
+         default:
+            break;
+         }
+         if(what)
+         {
+            // one test per character, held consecutively in m_node_tests:
+            n.test = static_cast<int>(m_node_tests.size());
+            unsigned len = (state->type == syntax_element_literal) ? n.length : 1;
+            for(j = 0; j < len; ++j)
+            {
+               for(i = 0; i < bytes.size(); ++i)
+                  bytes[i] = t.translate(static_cast<charT>(i), icase) == what[j];
+               m_node_tests.push_back(add_test(bytes, tests, test_ids));
+            }
+         }
+         else if(map)
+         {
+            for(i = 0; i < bytes.size(); ++i)
+               bytes[i] = map[static_cast<unsigned char>(t.translate(static_cast<charT>(i), icase))] != 0;
+            n.test = static_cast<int>(m_node_tests.size());
+            m_node_tests.push_back(add_test(bytes, tests, test_ids));
+         }
+      }
+   }
+   //
+   // now divide the characters into classes which no test, and no
+   // assertion, can tell apart:
+   //
+   const regex_data<charT, traits>& data = *machines[0];
+   std::map<std::vector<unsigned char>, unsigned> classes;
+   std::vector<std::vector<unsigned char> > signatures(1u << CHAR_BIT);
+   for(i = 0; i < signatures.size(); ++i)
+   {
+      charT c = static_cast<charT>(i);
+      unsigned char p = 0;
+      if(data.m_ptraits->isctype(c, data.m_word_mask))
+         p |= prop_word;
+      if(is_separator(c))
+         p |= prop_sep;
+      if(c == static_cast<charT>('\r'))
+         p |= prop_cr;
+      if(c == static_cast<charT>('\n'))
+         p |= prop_nl;
+      if(c == static_cast<charT>(0))
+         p |= prop_null;
+      std::vector<unsigned char>& s = signatures[i];
+      s.push_back(p);
+      for(j = 0; j < tests.size(); ++j)
+         s.push_back(tests[j][i]);
+      std::pair<typename std::map<std::vector<unsigned char>, unsigned>::iterator, bool> r
+         = classes.insert(std::make_pair(s, static_cast<unsigned>(classes.size())));
+      m_class[i] = static_cast<unsigned char>(r.first->second);
+      if(r.second)
+         m_props.push_back(p);
+   }
+   m_class_count = static_cast<unsigned>(classes.size());
+   m_tests.resize(tests.size() * m_class_count);
+   for(j = 0; j < tests.size(); ++j)
+      for(i = 0; i < signatures.size(); ++i)
+         m_tests[j * m_class_count + m_class[i]] = tests[j][i];
+   //
+   // perl_matcher's start maps tell us where a match can't start:
+   //
+   for(i = 0; i < (1u << CHAR_BIT); ++i)
+   {
+      m_can_start[i] = false;
+      for(k = 0; k < count; ++k)
+         m_can_start[i] = m_can_start[i] || ((machines[k]->m_startmap[i] & mask_any) != 0);
+   }
+   m_mode_mask = match_default;
+   for(i = 0; i < m_nodes.size(); ++i)
+   {
+      switch(m_nodes[i].type)
+      {
+      case syntax_element_start_line:
+         m_mode_mask |= match_not_bol | match_single_line;
+         break;
+      case syntax_element_end_line:
+         m_mode_mask |= match_not_eol | match_single_line;
+         break;
+      case syntax_element_word_boundary:
+      case syntax_element_word_start:
+      case syntax_element_word_end:
+         m_mode_mask |= match_not_bow | match_not_eow;
+         break;
+      case syntax_element_buffer_start:
+         m_mode_mask |= match_not_bob;
+         break;
+      case syntax_element_buffer_end:
+         m_mode_mask |= match_not_eob;
+         break;
+      case syntax_element_wild:
+      case syntax_element_dot_rep:
+         m_mode_mask |= match_not_dot_newline | match_not_dot_null;
+         break;
+      default:
+         break;
+      }
+   }
+   for(i = 0; i < start_cache_count; ++i)
+      m_start[i].store(0, boost::memory_order_relaxed);
+}
+
+template <class charT, class traits>
+lazy_dfa<charT, traits>::~lazy_dfa()
+{
+   for(typename state_map::iterator i = m_states.begin(); i != m_states.end(); ++i)
+   {
+      delete[] i->second->next;
+      delete i->second;
+   }
+   for(unsigned j = 0; j < start_cache_count; ++j)
+      delete m_start[j].load(boost::memory_order_relaxed);
+}
+
+template <class charT, class traits>
+int lazy_dfa<charT, traits>::add_test(const std::vector<unsigned char>& bytes, std::vector<std::vector<unsigned char> >& tests, std::map<std::vector<unsigned char>, int>& ids)
+{
+   // returns the index of the test that accepts the characters in bytes:
+   std::pair<std::map<std::vector<unsigned char>, int>::iterator, bool> r
+      = ids.insert(std::make_pair(bytes, static_cast<int>(tests.size())));
+   if(r.second)
+      tests.push_back(bytes);
+   return r.first->second;
+}
+
+template <class charT, class traits>
+bool lazy_dfa<charT, traits>::check(const node& n, int mode, int prev, int next)const
+{
+   //
+   // These follow match_start_line and friends in perl_matcher_common.hpp,
+   // "valid" here is "there is a previous character":
+   //
+   bool valid = prev & ctx_prev;
+   bool b;
+   switch(n.type)
+   {
+   case syntax_element_start_line:
+      if(prev & ctx_backstop)
+      {
+         if(!valid)
+            return (mode & match_not_bol) == 0;
+      }
+      else if(mode & match_single_line)
+         return false;
+      if(next & ctx_end)
+         return prev & prop_sep;
+      return (prev & prop_sep) && !((prev & prop_cr) && (next & prop_nl));
+   case syntax_element_end_line:
+      if(next & ctx_end)
+         return (mode & match_not_eol) == 0;
+      if(mode & match_single_line)
+         return false;
+      if(next & prop_sep)
+         return !(valid && (prev & prop_cr) && (next & prop_nl));
+      return false;
+   case syntax_element_word_boundary:
+      b = (next & ctx_end) ? static_cast<bool>(mode & match_not_eow) : static_cast<bool>(next & prop_word);
+      if(!valid)
+         b ^= static_cast<bool>(mode & match_not_bow);
+      else
+         b ^= static_cast<bool>(prev & prop_word);
+      return b;
+   case syntax_element_within_word:
+      if((next & ctx_end) || !valid)
+         return false;
+      return static_cast<bool>(prev & prop_word) == static_cast<bool>(next & prop_word);
+   case syntax_element_word_start:
+      if((next & ctx_end) || !(next & prop_word))
+         return false;
+      if(!valid)
+         return (mode & match_not_bow) == 0;
+      return !(prev & prop_word);
+   case syntax_element_word_end:
+      if(!valid || !(prev & prop_word))
+         return false;
+      if(next & ctx_end)
+         return (mode & match_not_eow) == 0;
+      return !(next & prop_word);
+   case syntax_element_buffer_start:
+      return (prev & ctx_backstop) && ((mode & match_not_bob) == 0);
+   case syntax_element_buffer_end:
+      return (next & ctx_end) && ((mode & match_not_eob) == 0);
+   default:
+      BOOST_ASSERT(0);
+   }
+   return false;
+}
+
+template <class charT, class traits>
+bool lazy_dfa<charT, traits>::accepts(const thread_type& t, int mode, unsigned c)const
+{
+   const node& n = m_nodes[t.first];
+   if(n.test < 0)
+   {
+      // '.' as in perl_matcher::match_wild:
+      unsigned char any_mask = static_cast<unsigned char>((mode & match_not_dot_newline) ? test_not_newline : test_newline);
+      if((m_props[c] & prop_sep) && ((any_mask & n.mask) == 0))
+         return false;
+      if((m_props[c] & prop_null) && (mode & match_not_dot_null))
+         return false;
+      return true;
+   }
+   int test = n.test;
+   if(n.type == syntax_element_literal)
+      test += t.second;
+   return m_tests[m_node_tests[test] * m_class_count + c];
+}
+
+template <class charT, class traits>
+typename lazy_dfa<charT, traits>::thread_type lazy_dfa<charT, traits>::advance(const thread_type& t)const
+{
+   const node& n = m_nodes[t.first];
+   int count = t.second + 1;
+   switch(n.type)
+   {
+   case syntax_element_literal:
+      if(count < static_cast<int>(n.length))
+         return thread_type(t.first, count);
+      break;
+   case syntax_element_dot_rep:
+   case syntax_element_char_rep:
+   case syntax_element_short_set_rep:
+      // once past the minimum, an unbounded repeat's count doesn't matter:
+      if((n.max == (std::numeric_limits<std::size_t>::max)()) && (static_cast<std::size_t>(count) > n.min))
+         count = static_cast<int>(n.min);
+      return thread_type(t.first, count);
+   default:
+      break;
+   }
+   return thread_type(n.next, 0);
+}
+
+template <class charT, class traits>
+int lazy_dfa<charT, traits>::follow(thread_type t, dfa_run_type type, int mode, int prev, int next, std::vector<thread_type>& list, std::set<thread_type>& seen, std::vector<int>* matches)const
+{
+   //
+   // Appends to list the threads that read the next character and are
+   // reachable from t, in the order perl_matcher would try them; returns
+   // the machine as soon as one of them reaches the end of a machine, or
+   // -1 if none does.  For dfa_set the machine is added to matches and we
+   // carry on.  The stack holds the alternatives still to try, the second
+   // member of an entry is set for a single character repeat that is to
+   // read the next character.
+   //
+   std::vector<std::pair<thread_type, bool> > stack;
+   stack.push_back(std::make_pair(t, false));
+   while(!stack.empty())
+   {
+      std::pair<thread_type, bool> e = stack.back();
+      stack.pop_back();
+      if(e.second)
+      {
+         list.push_back(e.first);
+         continue;
+      }
+      if(!seen.insert(e.first).second)
+         continue;
+      const node& n = m_nodes[e.first.first];
+      std::size_t count = e.first.second;
+      switch(n.type)
+      {
+      case syntax_element_startmark:
+      case syntax_element_endmark:
+         stack.push_back(std::make_pair(thread_type(n.next, 0), false));
+         break;
+      case syntax_element_literal:
+      case syntax_element_wild:
+      case syntax_element_set:
+         list.push_back(e.first);
+         break;
+      case syntax_element_match:
+         if(type == dfa_set)
+            matches->push_back(n.machine);
+         else if((type != dfa_whole) || (next & ctx_end))
+            return n.machine;
+         break;
+      case syntax_element_jump:
+         stack.push_back(std::make_pair(thread_type(n.alt, n.back ? 1 : 0), false));
+         break;
+      case syntax_element_alt:
+         stack.push_back(std::make_pair(thread_type(n.alt, 0), false));
+         stack.push_back(std::make_pair(thread_type(n.next, 0), false));
+         break;
+      case syntax_element_rep:
+         // count is 1 if we've been round the repeat already:
+         if(count < n.min)
+            stack.push_back(std::make_pair(thread_type(n.next, 0), false));
+         else if(n.greedy)
+         {
+            stack.push_back(std::make_pair(thread_type(n.alt, 0), false));
+            if(count < n.max)
+               stack.push_back(std::make_pair(thread_type(n.next, 0), false));
+         }
+         else
+         {
+            if(count < n.max)
+               stack.push_back(std::make_pair(thread_type(n.next, 0), false));
+            stack.push_back(std::make_pair(thread_type(n.alt, 0), false));
+         }
+         break;
+      case syntax_element_dot_rep:
+      case syntax_element_char_rep:
+      case syntax_element_short_set_rep:
+         if(n.greedy)
+         {
+            if(count >= n.min)
+               stack.push_back(std::make_pair(thread_type(n.alt, 0), false));
+            if(count < n.max)
+               stack.push_back(std::make_pair(e.first, true));
+         }
+         else
+         {
+            if(count < n.max)
+               stack.push_back(std::make_pair(e.first, true));
+            if(count >= n.min)
+               stack.push_back(std::make_pair(thread_type(n.alt, 0), false));
+         }
+         break;
+      default:
+         if(check(n, mode, prev, next))
+            stack.push_back(std::make_pair(thread_type(n.next, 0), false));
+         break;
+      }
+   }
+   return -1;
+}
+
+template <class charT, class traits>
+int lazy_dfa<charT, traits>::closure(const std::vector<int>& key, int next, std::vector<thread_type>& list, std::size_t& injected, std::vector<int>* matches)const
+{
+   //
+   // Finds the threads of the state with this key that read the next
+   // character, followed by those of a match starting here if we're
+   // still looking for one: these are the threads from injected onwards.
+   // Returns the machine if a match ends here, in which case any threads
+   // that perl_matcher would have tried after the match are dropped, or
+   // -1.  For dfa_set every match is added to matches instead.
+   //
+   dfa_run_type type = static_cast<dfa_run_type>(key[key_type]);
+   int mode = key[key_mode];
+   int prev = key[key_prev];
+   std::set<thread_type> seen;
+   std::size_t i, end = key_size + 2 * key[key_threads];
+   int machine;
+   for(i = key_size; i < end; i += 2)
+   {
+      machine = follow(thread_type(key[i], key[i + 1]), type, mode, prev, next, list, seen, matches);
+      if(machine >= 0)
+      {
+         injected = list.size();
+         return machine;
+      }
+   }
+   injected = list.size();
+   if((type == dfa_set) || ((type == dfa_unanchored) && !key[key_matched]))
+   {
+      for(i = 0; i < m_machine_start.size(); ++i)
+      {
+         machine = follow(thread_type(m_machine_start[i], 0), type, mode, prev, next, list, seen, matches);
+         if(machine >= 0)
+            return machine;
+      }
+   }
+   return -1;
+}
+
+template <class charT, class traits>
+int lazy_dfa<charT, traits>::match_at_end(const dfa_state* s)const
+{
+   // returns the machine with a match at the end of input, or -1:
+   int r = s->end.load(boost::memory_order_relaxed);
+   if(r < 0)
+   {
+      std::vector<thread_type> list;
+      std::size_t injected;
+      r = closure(*s->key, ctx_end, list, injected, 0) + 1;
+      s->end.store(r, boost::memory_order_relaxed);
+   }
+   return r - 1;
+}
+
+template <class charT, class traits>
+typename lazy_dfa<charT, traits>::dfa_state* lazy_dfa<charT, traits>::find_state(const std::vector<int>& key)const
+{
+   // must be called with m_mutex locked.
+   typename state_map::iterator pos = m_states.find(key);
+   if(pos != m_states.end())
+      return pos->second;
+   if(m_states.size() >= BOOST_REGEX_MAX_DFA_STATES)
+   {
+      m_full.store(true, boost::memory_order_relaxed);
+      return 0;
+   }
+   dfa_state* s = new dfa_state;
+   s->next = 0;
+#ifndef BOOST_NO_EXCEPTIONS
+   try{
+#endif
+      // one more for the end of input, used by dfa_set:
+      s->next = new boost::atomic<dfa_state*>[m_class_count + 1];
+      for(unsigned i = 0; i <= m_class_count; ++i)
+         s->next[i].store(0, boost::memory_order_relaxed);
+      pos = m_states.insert(std::make_pair(key, s)).first;
+#ifndef BOOST_NO_EXCEPTIONS
+   }
+   catch(...)
+   {
+      delete[] s->next;
+      delete s;
+      throw;
+   }
+#endif
+   s->key = &pos->first;
+   s->end.store(-1, boost::memory_order_relaxed);
+   s->flags = key[key_flags];
+   s->machine = key[key_machine];
+   std::size_t threads = key_size + 2 * key[key_threads];
+   s->match_count = static_cast<unsigned>(key.size() - threads);
+   s->matches = s->match_count ? &pos->first[threads] : 0;
+   if(key[key_threads] == 0)
+   {
+      if((key[key_type] == dfa_set) || ((key[key_type] == dfa_unanchored) && !key[key_matched]))
+         s->flags |= state_idle;
+      else
+         s->flags |= state_dead;
+   }
+   return s;
+}
+
+template <class charT, class traits>
+const typename lazy_dfa<charT, traits>::dfa_state* lazy_dfa<charT, traits>::start(dfa_run_type type, match_flag_type f, int prev)const
+{
+   int m = mode(f);
+   //
+   // the start states of the first few modes used are cached, so that
+   // repeated searches need neither a key nor the lock; a cache is never
+   // removed once published, and its mode never changes:
+   //
+   for(unsigned i = 0; i < start_cache_count; ++i)
+   {
+      const start_cache* c = m_start[i].load(boost::memory_order_acquire);
+      if(c == 0)
+         break;
+      if(c->mode == m)
+      {
+         const dfa_state* s = c->states[type][prev].load(boost::memory_order_acquire);
+         if(s)
+            return s;
+         break;
+      }
+   }
+   if(m_full.load(boost::memory_order_relaxed))
+      return 0;
+   std::vector<int> key(key_size);
+   key[key_type] = type;
+   key[key_mode] = m;
+   key[key_prev] = prev;
+   key[key_machine] = -1;
+   if((type == dfa_anchored) || (type == dfa_whole))
+   {
+      for(std::size_t i = 0; i < m_machine_start.size(); ++i)
+      {
+         key.push_back(m_machine_start[i]);
+         key.push_back(0);
+      }
+      key[key_threads] = static_cast<int>(m_machine_start.size());
+   }
+   boost::detail::lightweight_mutex::scoped_lock lock(m_mutex);
+   dfa_state* s = find_state(key);
+   if(s)
+   {
+      for(unsigned i = 0; i < start_cache_count; ++i)
+      {
+         start_cache* c = m_start[i].load(boost::memory_order_relaxed);
+         if(c == 0)
+         {
+            c = new start_cache;
+            c->mode = m;
+            for(unsigned t = 0; t < 4; ++t)
+               for(unsigned j = 0; j < ctx_count; ++j)
+                  c->states[t][j].store(0, boost::memory_order_relaxed);
+            m_start[i].store(c, boost::memory_order_release);
+         }
+         if(c->mode == m)
+         {
+            c->states[type][prev].store(s, boost::memory_order_release);
+            break;
+         }
+      }
+   }
+   return s;
+}
+
+template <class charT, class traits>
+const typename lazy_dfa<charT, traits>::dfa_state* lazy_dfa<charT, traits>::transition(const dfa_state* s, unsigned c)const
+{
+   if(m_full.load(boost::memory_order_relaxed))
+      return 0;
+   const std::vector<int>& key = *s->key;
+   dfa_run_type type = static_cast<dfa_run_type>(key[key_type]);
+   std::vector<thread_type> list;
+   std::vector<int> matches;
+   std::size_t injected;
+   int machine = closure(key, m_props[c], list, injected, &matches);
+   bool matched = (machine >= 0) || !matches.empty();
+   //
+   // read the character:
+   //
+   std::vector<int> next_key(key_size);
+   next_key[key_type] = type;
+   next_key[key_mode] = key[key_mode];
+   next_key[key_prev] = m_props[c] | ctx_prev;
+   next_key[key_flags] = matched ? static_cast<int>(state_match) : 0;
+   next_key[key_matched] = (type != dfa_set) && (matched || key[key_matched]);
+   next_key[key_machine] = machine;
+   std::set<thread_type> seen;
+   bool restart = type == dfa_unanchored;
+   for(std::size_t i = 0; i < list.size(); ++i)
+   {
+      if(accepts(list[i], key[key_mode], c))
+      {
+         thread_type t = advance(list[i]);
+         if(seen.insert(t).second)
+         {
+            next_key.push_back(t.first);
+            next_key.push_back(t.second);
+            if(i < injected)
+               restart = false;
+         }
+      }
+   }
+   next_key[key_threads] = static_cast<int>((next_key.size() - key_size) / 2);
+   if(restart)
+      next_key[key_flags] |= state_restart;
+   if(type == dfa_set)
+   {
+      //
+      // the order of the threads doesn't matter, so sort them to share
+      // states, and record which machines matched:
+      //
+      std::vector<thread_type> threads(seen.begin(), seen.end());
+      next_key.resize(key_size);
+      for(std::size_t i = 0; i < threads.size(); ++i)
+      {
+         next_key.push_back(threads[i].first);
+         next_key.push_back(threads[i].second);
+      }
+      std::sort(matches.begin(), matches.end());
+      next_key.insert(next_key.end(), matches.begin(), matches.end());
+   }
+
+   boost::detail::lightweight_mutex::scoped_lock lock(m_mutex);
+   dfa_state* t = s->next[c].load(boost::memory_order_relaxed);
+   if(t == 0)
+   {
+      t = find_state(next_key);
+      if(t)
+         s->next[c].store(t, boost::memory_order_release);
+   }
+   return t;
+}
+
+template <class charT, class traits>
+const typename lazy_dfa<charT, traits>::dfa_state* lazy_dfa<charT, traits>::transition_end(const dfa_state* s)const
+{
+   //
+   // for dfa_set, a state with no threads that records the matches
+   // at the end of input:
+   //
+   const dfa_state* t = s->next[m_class_count].load(boost::memory_order_acquire);
+   if(t || m_full.load(boost::memory_order_relaxed))
+      return t;
+   const std::vector<int>& key = *s->key;
+   std::vector<thread_type> list;
+   std::vector<int> matches;
+   std::size_t injected;
+   closure(key, ctx_end, list, injected, &matches);
+   std::vector<int> next_key(key_size);
+   next_key[key_type] = dfa_set;
+   next_key[key_mode] = key[key_mode];
+   next_key[key_prev] = ctx_end;
+   next_key[key_flags] = matches.empty() ? 0 : static_cast<int>(state_match);
+   next_key[key_machine] = -1;
+   std::sort(matches.begin(), matches.end());
+   next_key.insert(next_key.end(), matches.begin(), matches.end());
+
+   boost::detail::lightweight_mutex::scoped_lock lock(m_mutex);
+   dfa_state* r = s->next[m_class_count].load(boost::memory_order_relaxed);
+   if(r == 0)
+   {
+      r = find_state(next_key);
+      if(r)
+         s->next[m_class_count].store(r, boost::memory_order_release);
+   }
+   return r;
+}
+
+template <class charT, class traits>
+template <class BidiIterator>
+dfa_result lazy_dfa<charT, traits>::run(dfa_run_type type, match_flag_type f, BidiIterator first, BidiIterator last, BidiIterator backstop, BidiIterator stop, bool stop_at_first, BidiIterator& end, BidiIterator* restart, int* machine)const
+{
+   BOOST_ASSERT(type != dfa_set);
+   const dfa_state* s = start(type, f, context(first, backstop, f));
+   if(s == 0)
+      return dfa_gave_up;
+   bool matched = false;
+   for(BidiIterator position = first; position != last; ++position)
+   {
+      if(s->flags & state_idle)
+      {
+         //
+         // skip characters at which no match can start, but read the
+         // last of them to get the context of the one that follows:
+         //
+         BidiIterator next(position);
+         while((position != stop) && (++next != last)
+            && !m_can_start[static_cast<unsigned char>(*position)]
+            && !m_can_start[static_cast<unsigned char>(*next)])
+            position = next;
+      }
+      unsigned c = m_class[static_cast<unsigned char>(*position)];
+      const dfa_state* t = s->next[c].load(boost::memory_order_acquire);
+      if((t == 0) && ((t = transition(s, c)) == 0))
+         return dfa_gave_up;
+      if(t->flags)
+      {
+         if(t->flags & state_match)
+         {
+            matched = true;
+            end = position;
+            if(machine)
+               *machine = t->machine;
+            if(stop_at_first)
+               return dfa_match;
+         }
+         if(t->flags & state_dead)
+            return matched ? dfa_match : dfa_no_match;
+         if((t->flags & state_restart) && restart && !matched)
+            *restart = position;
+      }
+      if(position == stop)
+         return matched ? dfa_match : dfa_no_match;
+      s = t;
+   }
+   int m = match_at_end(s);
+   if(m >= 0)
+   {
+      end = last;
+      if(machine)
+         *machine = m;
+      return dfa_match;
+   }
+   return matched ? dfa_match : dfa_no_match;
+}
+
+template <class charT, class traits>
+template <class BidiIterator>
+dfa_result lazy_dfa<charT, traits>::run_set(match_flag_type f, BidiIterator first, BidiIterator last, BidiIterator backstop, std::vector<bool>& found)const
+{
+   BOOST_ASSERT(found.size() == size());
+   const dfa_state* s = start(dfa_set, f, context(first, backstop, f));
+   if(s == 0)
+      return dfa_gave_up;
+   std::size_t count = 0;
+   for(BidiIterator position = first; ; ++position)
+   {
+      const dfa_state* t;
+      if(position == last)
+      {
+         if((t = transition_end(s)) == 0)
+            return dfa_gave_up;
+      }
+      else
+      {
+         if(s->flags & state_idle)
+         {
+            BidiIterator next(position);
+            while((++next != last)
+               && !m_can_start[static_cast<unsigned char>(*position)]
+               && !m_can_start[static_cast<unsigned char>(*next)])
+               position = next;
+         }
+         unsigned c = m_class[static_cast<unsigned char>(*position)];
+         t = s->next[c].load(boost::memory_order_acquire);
+         if((t == 0) && ((t = transition(s, c)) == 0))
+            return dfa_gave_up;
+      }
+      for(unsigned i = 0; i < t->match_count; ++i)
+      {
+         if(!found[t->matches[i]])
+         {
+            found[t->matches[i]] = true;
+            if(++count == found.size())
+               return dfa_match;
+         }
+      }
+      if(position == last)
+         break;
+      s = t;
+   }
+   return count ? dfa_match : dfa_no_match;
+}
+
+} // namespace re_detail
+} // namespace boost
+
+#ifdef BOOST_MSVC
+#  pragma warning(pop)
+#endif
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+#endif
@@ -55,8 +55,8 @@ typedef enum _match_flags
    match_nosubs = match_posix << 1,                  /* don't trap marked subs */
    match_extra = match_nosubs << 1,                  /* include full capture information for repeated captures */
    match_single_line = match_extra << 1,             /* treat text as single line and ignor any \n's when matching ^ and $. */
-   match_unused1 = match_single_line << 1,           /* unused */
-   match_unused2 = match_unused1 << 1,               /* unused */
+   match_no_dfa = match_single_line << 1,            /* always use the backtracking matcher, never the lazy DFA */
+   match_unused2 = match_no_dfa << 1,                /* unused */
    match_unused3 = match_unused2 << 1,               /* unused */
    match_max = match_unused3,
 
@@ -123,6 +123,7 @@ using regex_constants::match_posix;
 using regex_constants::match_nosubs;
 using regex_constants::match_extra;
 using regex_constants::match_single_line;
+using regex_constants::match_no_dfa;
 /*using regex_constants::match_max; */
 using regex_constants::format_all;
 using regex_constants::format_sed;
@@ -13,6 +13,7 @@
 #define BOOST_REGEX_MATCHER_HPP
 
 #include <boost/regex/v4/iterator_category.hpp>
+#include <boost/regex/v4/fast_scan.hpp>
 
 #ifdef BOOST_MSVC
 #pragma warning(push)
@@ -38,6 +39,21 @@ namespace re_detail{
 //
 BOOST_REGEX_DECL void BOOST_REGEX_CALL verify_options(boost::regex_constants::syntax_option_type ef, match_flag_type mf);
 //
+// whether BidiIterator points into a contiguous buffer of narrow characters,
+// which perl_matcher::scan_ahead can search with fast_scan.hpp:
+//
+template <class BidiIterator, class charT>
+struct is_contiguous_narrow
+{
+   typedef typename regex_iterator_traits<BidiIterator>::value_type value_type;
+   BOOST_STATIC_CONSTANT(bool, value = (::boost::is_same<charT, char>::value && (sizeof(value_type) == 1)
+      && (::boost::is_pointer<BidiIterator>::value
+         || ::boost::is_same<BidiIterator, std::string::const_iterator>::value
+         || ::boost::is_same<BidiIterator, std::string::iterator>::value
+         || ::boost::is_same<BidiIterator, std::vector<char>::const_iterator>::value
+         || ::boost::is_same<BidiIterator, std::vector<char>::iterator>::value)));
+};
+//
 // function can_start:
 //
 template <class charT>
@@ -342,6 +358,68 @@ struct recursion_info
    repeater_count<iterator>* repeater_stack;
 };
 
+//
+// Memory that perl_matcher can keep from one search to the next, rather
+// than taking it afresh each time: the blocks that hold backtracking
+// state, the recursion stack and the results used by POSIX matching.
+// There's no locking, so each thread needs its own, see regex_matcher:
+//
+template <class Results>
+class matcher_storage
+{
+public:
+   matcher_storage()
+#ifdef BOOST_REGEX_NON_RECURSIVE
+      : m_free_blocks(0)
+#endif
+   {}
+   ~matcher_storage()
+   {
+      release();
+   }
+#ifdef BOOST_REGEX_NON_RECURSIVE
+   void* get_block()
+   {
+      if(m_free_blocks)
+      {
+         void* result = m_free_blocks;
+         m_free_blocks = *static_cast<void**>(result);
+         return result;
+      }
+      return ::operator new(BOOST_REGEX_BLOCKSIZE);
+   }
+   void put_block(void* p)
+   {
+      *static_cast<void**>(p) = m_free_blocks;
+      m_free_blocks = p;
+   }
+#endif
+   void release()
+   {
+#ifdef BOOST_REGEX_NON_RECURSIVE
+      while(m_free_blocks)
+         ::operator delete(get_block());
+#endif
+      std::vector<recursion_info<Results> >().swap(recursion_stack);
+      Results().swap(temp_match);
+   }
+
+   std::vector<recursion_info<Results> > recursion_stack;
+   Results temp_match;
+private:
+#ifdef BOOST_REGEX_NON_RECURSIVE
+   // singly linked list of unused blocks, each points to the next:
+   void* m_free_blocks;
+#endif
+   matcher_storage(const matcher_storage&);
+   matcher_storage& operator=(const matcher_storage&);
+};
+
+#ifdef BOOST_REGEX_NON_RECURSIVE
+template <class Matcher>
+struct save_state_init;
+#endif
+
 #ifdef BOOST_MSVC
 #pragma warning(push)
 #pragma warning(disable : 4251 4231 4660)
@@ -363,10 +441,12 @@ public:
       match_results<BidiIterator, Allocator>& what, 
       const basic_regex<char_type, traits>& e,
       match_flag_type f,
-      BidiIterator l_base)
+      BidiIterator l_base,
+      matcher_storage<results_type>* storage = 0)
       :  m_result(what), base(first), last(end), 
          position(first), backstop(l_base), re(e), traits_inst(e.get_traits()), 
-         m_independent(false), next_count(&rep_obj), rep_obj(&next_count)
+         m_independent(false), next_count(&rep_obj), rep_obj(&next_count),
+         m_storage(storage), recursion_stack(storage ? storage->recursion_stack : m_own_recursion_stack)
    {
       construct_init(e, f);
    }
@@ -392,6 +472,13 @@ private:
    void estimate_max_state_count(void*);
    bool match_prefix();
    bool match_all_states();
+   const lazy_dfa<char_type, traits>* get_dfa(match_flag_type unsupported)const;
+   bool find_dfa(bool& result);
+   bool scan_ahead(mpl::true_*);
+   bool scan_ahead(mpl::false_*)
+   {
+      return true;
+   }
 
    // match procs, stored in s_match_vtable:
    bool match_startmark();
@@ -487,15 +574,30 @@ private:
    typename traits::char_class_type m_word_mask;
    // the bitmask to use when determining whether a match_any matches a newline or not:
    unsigned char match_any_mask;
-   // recursion information:
-   std::vector<recursion_info<results_type> > recursion_stack;
+   // memory kept between searches, or null:
+   matcher_storage<results_type>* m_storage;
+   // recursion information, our own unless m_storage provides it:
+   std::vector<recursion_info<results_type> > m_own_recursion_stack;
+   std::vector<recursion_info<results_type> >& recursion_stack;
 
 #ifdef BOOST_REGEX_NON_RECURSIVE
    //
    // additional members for non-recursive version:
    //
    typedef bool (self_type::*unwind_proc_type)(bool);
+   friend struct save_state_init<self_type>;
 
+   void* get_block()
+   {
+      return m_storage ? m_storage->get_block() : get_mem_block();
+   }
+   void put_block(void* p)
+   {
+      if(m_storage)
+         m_storage->put_block(p);
+      else
+         put_mem_block(p);
+   }
    void extend_stack();
    bool unwind(bool);
    bool unwind_end(bool);
@@ -543,7 +645,8 @@ private:
       return *this;
    }
    perl_matcher(const perl_matcher& that)
-      : m_result(that.m_result), re(that.re), traits_inst(that.traits_inst), rep_obj(0) {}
+      : m_result(that.m_result), re(that.re), traits_inst(that.traits_inst), rep_obj(0),
+        m_storage(0), recursion_stack(m_own_recursion_stack) {}
 };
 
 #ifdef BOOST_MSVC
@@ -70,11 +70,18 @@ void perl_matcher<BidiIterator, Allocator, traits>::construct_init(const basic_r
    }
    if(m_match_flags & match_posix)
    {
-      m_temp_match.reset(new match_results<BidiIterator, Allocator>());
-      m_presult = m_temp_match.get();
+      if(m_storage)
+         m_presult = &m_storage->temp_match;
+      else
+      {
+         m_temp_match.reset(new match_results<BidiIterator, Allocator>());
+         m_presult = m_temp_match.get();
+      }
    }
    else
       m_presult = &m_result;
+   // a stack left over from a previous search that threw is of no use to us:
+   recursion_stack.clear();
 #ifdef BOOST_REGEX_NON_RECURSIVE
    m_stack_base = 0;
    m_backup_state = 0;
@@ -186,7 +193,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_imp()
 {
    // initialise our stack if we are non-recursive:
 #ifdef BOOST_REGEX_NON_RECURSIVE
-   save_state_init init(&m_stack_base, &m_backup_state);
+   save_state_init<self_type> init(this, &m_stack_base, &m_backup_state);
    used_block_count = BOOST_REGEX_MAX_BLOCKS;
 #if !defined(BOOST_NO_EXCEPTIONS)
    try{
@@ -204,6 +211,20 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_imp()
    if(m_match_flags & match_posix)
       m_result = *m_presult;
    verify_options(re.flags(), m_match_flags);
+   if(const lazy_dfa<char_type, traits>* dfa = get_dfa(match_default))
+   {
+      // if the DFA finds a match we only need perl_matcher for the sub-expressions:
+      BidiIterator end;
+      dfa_result r = dfa->run(dfa_whole, m_match_flags, base, last, backstop, last, false, end, static_cast<BidiIterator*>(0));
+      if(r == dfa_no_match)
+         return false;
+      if((r == dfa_match) && ((m_match_flags & match_nosubs) || (re.mark_count() == 1)))
+      {
+         m_presult->set_first(base);
+         m_presult->set_second(last);
+         return true;
+      }
+   }
    if(0 == match_prefix())
       return false;
    return (m_result[0].second == last) && (m_result[0].first == base);
@@ -247,7 +268,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
 
    // initialise our stack if we are non-recursive:
 #ifdef BOOST_REGEX_NON_RECURSIVE
-   save_state_init init(&m_stack_base, &m_backup_state);
+   save_state_init<self_type> init(this, &m_stack_base, &m_backup_state);
    used_block_count = BOOST_REGEX_MAX_BLOCKS;
 #if !defined(BOOST_NO_EXCEPTIONS)
    try{
@@ -290,6 +311,14 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
    }
 
    verify_options(re.flags(), m_match_flags);
+   // skip input that can't match, if we can do so quickly:
+   typedef mpl::bool_<is_contiguous_narrow<BidiIterator, char_type>::value> contiguous_type;
+   if(!scan_ahead(static_cast<contiguous_type*>(0)))
+      return false;
+   // expressions that never backtrack can be searched for with a DFA:
+   bool result;
+   if(find_dfa(result))
+      return result;
    // find out what kind of expression we have:
    unsigned type = (m_match_flags & match_continuous) ? 
       static_cast<unsigned int>(regbase::restart_continue) 
@@ -312,6 +341,98 @@ bool perl_matcher<BidiIterator, Allocator, traits>::find_imp()
 #endif
 }
 
+template <class BidiIterator, class Allocator, class traits>
+const lazy_dfa<typename traits::char_type, traits>* perl_matcher<BidiIterator, Allocator, traits>::get_dfa(match_flag_type unsupported)const
+{
+   //
+   // returns the DFA for the expression, or null if there isn't one or
+   // it can't honour the flags we've been given:
+   //
+   if(m_match_flags & (unsupported | match_posix | match_partial | match_not_null 
+      | regex_constants::match_not_initial_null | match_extra | match_no_dfa))
+      return 0;
+   return re.get_data().m_dfa.get();
+}
+
+template <class BidiIterator, class Allocator, class traits>
+bool perl_matcher<BidiIterator, Allocator, traits>::find_dfa(bool& result)
+{
+   //
+   // Searches with the DFA, returns false if the search has to be done
+   // by perl_matcher after all, otherwise sets result and returns true.
+   // The DFA tells us where the first match ends, and we then find where
+   // it starts by running the DFA again from each possible start position,
+   // the first to match ending no later than the first match is the start.
+   // With match_any the scan stops at the first match end, which may be
+   // the end of a later-starting match, so the leftmost match starts no
+   // later than that end but may end after it: those runs are not cut off.
+   //
+   const lazy_dfa<char_type, traits>* dfa = get_dfa(match_all);
+   if(dfa == 0)
+      return false;
+   // how many start positions to try before we leave it to perl_matcher:
+   static const unsigned max_tries = 64;
+   bool any = m_match_flags & match_any;
+   BidiIterator start(position), end(position);
+   dfa_result r;
+   if(m_match_flags & match_continuous)
+      r = dfa->run(dfa_anchored, m_match_flags, position, last, backstop, last, any, end, static_cast<BidiIterator*>(0));
+   else
+   {
+      r = dfa->run(dfa_unanchored, m_match_flags, position, last, backstop, last, any, end, &start);
+      if(r == dfa_match)
+      {
+         const unsigned char* _map = re.get_map();
+         unsigned tries = 0;
+         BidiIterator stop(end);
+         for(;;)
+         {
+            if(re.can_be_null() || (start == stop) || can_start(*start, _map, (unsigned char)mask_any))
+            {
+               if(++tries > max_tries)
+               {
+                  // no match can start before start:
+                  position = start;
+                  return false;
+               }
+               BidiIterator e;
+               r = dfa->run(dfa_anchored, m_match_flags, start, last, backstop, any ? last : stop, any, e, static_cast<BidiIterator*>(0));
+               if(r == dfa_match)
+               {
+                  if(any)
+                     end = e;
+                  break;
+               }
+               if(r == dfa_gave_up)
+                  return false;
+            }
+            if(start == stop)
+               return false;
+            ++start;
+         }
+      }
+   }
+   if(r == dfa_gave_up)
+      return false;
+   result = (r == dfa_match);
+   if(result)
+   {
+      if((m_match_flags & match_nosubs) || (re.mark_count() == 1))
+      {
+         m_presult->set_first(start);
+         m_presult->set_second(end);
+         position = end;
+      }
+      else
+      {
+         // let perl_matcher fill in the sub-expressions:
+         position = start;
+         result = match_prefix();
+      }
+   }
+   return true;
+}
+
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::match_prefix()
 {
@@ -792,6 +913,45 @@ bool perl_matcher<BidiIterator, Allocator, traits>::match_toggle_case()
 }
 
 
+template <class BidiIterator, class Allocator, class traits>
+bool perl_matcher<BidiIterator, Allocator, traits>::scan_ahead(mpl::true_*)
+{
+   //
+   // Every match contains the expression's required literal, if it has
+   // one, so if it isn't there we needn't search at all.  If the literal
+   // starts every match, or there are only a few characters that can
+   // start one, we can also skip to the first place a match can start.
+   // Returns false if there can't be a match.
+   //
+   const regex_data<char_type, traits>& data = re.get_data();
+   if((data.m_required_length == 0) && (data.m_start_char_count == 0))
+      return true;
+   // a partial match needn't contain the literal:
+   if(m_match_flags & match_partial)
+      return true;
+   if(position == last)
+      return data.m_required_length == 0;
+   const char* first = reinterpret_cast<const char*>(&*position);
+   const char* end = first + (last - position);
+   const char* start = first;
+   if(data.m_required_length)
+   {
+      const char* p = find_literal(first, end, data.m_required, data.m_required_length);
+      if(p == end)
+         return false;
+      if(data.m_required_is_prefix)
+         start = p;
+   }
+   // only find_restart_any, and the DFA, search from every position:
+   if(((m_match_flags & match_continuous) == 0) && (re.get_restart_type() == regbase::restart_any))
+   {
+      if((start == first) && data.m_start_char_count)
+         start = find_any_of(first, end, data.m_start_chars, data.m_start_char_count);
+      std::advance(position, start - first);
+   }
+   return true;
+}
+
 template <class BidiIterator, class Allocator, class traits>
 bool perl_matcher<BidiIterator, Allocator, traits>::find_restart_any()
 {
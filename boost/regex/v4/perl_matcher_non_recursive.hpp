@@ -98,13 +98,15 @@ struct saved_extra_block : public saved_state
       : saved_state(saved_state_extra_block), base(b), end(e) {}
 };
 
+template <class Matcher>
 struct save_state_init
 {
+   Matcher* matcher;
    saved_state** stack;
-   save_state_init(saved_state** base, saved_state** end)
-      : stack(base)
+   save_state_init(Matcher* m, saved_state** base, saved_state** end)
+      : matcher(m), stack(base)
    {
-      *base = static_cast<saved_state*>(get_mem_block());
+      *base = static_cast<saved_state*>(m->get_block());
       *end = reinterpret_cast<saved_state*>(reinterpret_cast<char*>(*base)+BOOST_REGEX_BLOCKSIZE);
       --(*end);
       (void) new (*end)saved_state(0);
@@ -112,7 +114,7 @@ struct save_state_init
    }
    ~save_state_init()
    {
-      put_mem_block(*stack);
+      matcher->put_block(*stack);
       *stack = 0;
    }
 };
@@ -210,7 +212,7 @@ void perl_matcher<BidiIterator, Allocator, traits>::extend_stack()
       --used_block_count;
       saved_state* stack_base;
       saved_state* backup_state;
-      stack_base = static_cast<saved_state*>(get_mem_block());
+      stack_base = static_cast<saved_state*>(get_block());
       backup_state = reinterpret_cast<saved_state*>(reinterpret_cast<char*>(stack_base)+BOOST_REGEX_BLOCKSIZE);
       saved_extra_block* block = static_cast<saved_extra_block*>(backup_state);
       --block;
@@ -1114,7 +1116,7 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_extra_block(bool)
    m_stack_base = pmp->base;
    m_backup_state = pmp->end;
    boost::re_detail::inplace_destroy(pmp);
-   put_mem_block(condemmed);
+   put_block(condemmed);
    return true; // keep looking
 }
 
@@ -1334,8 +1336,9 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_char_repeat(bool r)
          pstate = rep->next.p;
       }while((count < rep->max) && (position != last) && !can_start(*position, rep->_map, mask_skip));
    }   
-   // remember where we got to if this is a leading repeat:
-   if((rep->leading) && (count < rep->max))
+   // remember where we got to if this is a leading repeat, a later start
+   // can only get further if the repeat is bounded:
+   if((rep->leading) && (rep->max == (std::numeric_limits<std::size_t>::max)()))
       restart = position;
    if(position == last)
    {
@@ -1403,8 +1406,9 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_short_set_repeat(bool
          pstate = rep->next.p;
       }while((count < rep->max) && (position != last) && !can_start(*position, rep->_map, mask_skip));
    }   
-   // remember where we got to if this is a leading repeat:
-   if((rep->leading) && (count < rep->max))
+   // remember where we got to if this is a leading repeat, a later start
+   // can only get further if the repeat is bounded:
+   if((rep->leading) && (rep->max == (std::numeric_limits<std::size_t>::max)()))
       restart = position;
    if(position == last)
    {
@@ -1473,8 +1477,9 @@ bool perl_matcher<BidiIterator, Allocator, traits>::unwind_long_set_repeat(bool
          pstate = rep->next.p;
       }while((count < rep->max) && (position != last) && !can_start(*position, rep->_map, mask_skip));
    }   
-   // remember where we got to if this is a leading repeat:
-   if((rep->leading) && (count < rep->max))
+   // remember where we got to if this is a leading repeat, a later start
+   // can only get further if the repeat is bounded:
+   if((rep->leading) && (rep->max == (std::numeric_limits<std::size_t>::max)()))
       restart = position;
    if(position == last)
    {
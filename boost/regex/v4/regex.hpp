@@ -66,6 +66,9 @@
 #ifndef BOOST_REGEX_V4_BASIC_REGEX_HPP
 #include <boost/regex/v4/basic_regex.hpp>
 #endif
+#ifndef BOOST_REGEX_V4_LAZY_DFA_HPP
+#include <boost/regex/v4/lazy_dfa.hpp>
+#endif
 #ifndef BOOST_REGEX_V4_BASIC_REGEX_CREATOR_HPP
 #include <boost/regex/v4/basic_regex_creator.hpp>
 #endif
@@ -147,9 +150,15 @@ typedef match_results<std::wstring::const_iterator> wsmatch;
 #ifndef BOOST_REGEX_V4_REGEX_SEARCH_HPP
 #include <boost/regex/v4/regex_search.hpp>
 #endif
+#ifndef BOOST_REGEX_V4_REGEX_MATCHER_HPP
+#include <boost/regex/v4/regex_matcher.hpp>
+#endif
 #ifndef BOOST_REGEX_ITERATOR_HPP
 #include <boost/regex/v4/regex_iterator.hpp>
 #endif
+#ifndef BOOST_REGEX_V4_REGEX_SET_HPP
+#include <boost/regex/v4/regex_set.hpp>
+#endif
 #ifndef BOOST_REGEX_TOKEN_ITERATOR_HPP
 #include <boost/regex/v4/regex_token_iterator.hpp>
 #endif
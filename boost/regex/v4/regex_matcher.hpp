@@ -0,0 +1,119 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_matcher.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Provides regex_matcher, which keeps the memory used by
+  *                regex_search and regex_match from one call to the next.
+  */
+
+#ifndef BOOST_REGEX_V4_REGEX_MATCHER_HPP
+#define BOOST_REGEX_V4_REGEX_MATCHER_HPP
+
+namespace boost{
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+//
+// A regex_matcher searches as regex_search and regex_match do, but keeps
+// its results and all the memory the matcher needs between calls, so that
+// once it has seen the largest search it's given, no further memory is
+// allocated and no lock is taken.  It's not thread safe: give each thread
+// its own.
+//
+template <class BidirectionalIterator,
+          class charT = BOOST_DEDUCED_TYPENAME re_detail::regex_iterator_traits<BidirectionalIterator>::value_type,
+          class traits = regex_traits<charT> >
+class regex_matcher
+{
+public:
+   typedef basic_regex<charT, traits>                 regex_type;
+   typedef match_results<BidirectionalIterator>       results_type;
+   typedef typename results_type::allocator_type      allocator_type;
+
+   regex_matcher(){}
+
+   bool search(BidirectionalIterator first, BidirectionalIterator last,
+               const regex_type& e,
+               match_flag_type flags = match_default)
+   {
+      return search(first, last, e, flags, first);
+   }
+   bool search(BidirectionalIterator first, BidirectionalIterator last,
+               const regex_type& e,
+               match_flag_type flags,
+               BidirectionalIterator base)
+   {
+      if(e.flags() & regex_constants::failbit)
+         return false;
+      re_detail::perl_matcher<BidirectionalIterator, allocator_type, traits> matcher(first, last, m_results, e, flags, base, &m_storage);
+      return matcher.find();
+   }
+   bool match(BidirectionalIterator first, BidirectionalIterator last,
+              const regex_type& e,
+              match_flag_type flags = match_default)
+   {
+      re_detail::perl_matcher<BidirectionalIterator, allocator_type, traits> matcher(first, last, m_results, e, flags, first, &m_storage);
+      return matcher.match();
+   }
+
+   const results_type& results()const
+   {
+      return m_results;
+   }
+   // frees the memory kept so far, and the results:
+   void release()
+   {
+      m_storage.release();
+      results_type().swap(m_results);
+   }
+
+private:
+   results_type m_results;
+   re_detail::matcher_storage<results_type> m_storage;
+
+   regex_matcher(const regex_matcher&);
+   regex_matcher& operator=(const regex_matcher&);
+};
+
+typedef regex_matcher<const char*> cregex_matcher;
+typedef regex_matcher<std::string::const_iterator> sregex_matcher;
+#ifndef BOOST_NO_WREGEX
+typedef regex_matcher<const wchar_t*> wcregex_matcher;
+typedef regex_matcher<std::wstring::const_iterator> wsregex_matcher;
+#endif
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // namespace boost
+
+#endif // BOOST_REGEX_V4_REGEX_MATCHER_HPP
+
@@ -0,0 +1,620 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         regex_set.hpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Declares basic_regex_set, set_match_results and
+  *                regex_set_iterator, which search for several
+  *                expressions in a single pass over the input.
+  */
+
+#ifndef BOOST_REGEX_V4_REGEX_SET_HPP
+#define BOOST_REGEX_V4_REGEX_SET_HPP
+
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/detail/lightweight_mutex.hpp>
+#include <vector>
+
+namespace boost{
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_PREFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+namespace re_detail{
+
+//
+// The DFA shared by the expressions of a basic_regex_set, and by its
+// copies.  It's built the first time the set is searched, from those
+// expressions that have a DFA of their own and can share one: the
+// others are searched one at a time.
+//
+template <class charT, class traits>
+class regex_set_data
+{
+public:
+   typedef basic_regex<charT, traits> regex_type;
+
+   regex_set_data() : m_built(false) {}
+
+   //
+   // Returns the DFA to search with given these flags, or null if the
+   // expressions have to be searched one at a time; the other members
+   // may only be called after this one.
+   //
+   const lazy_dfa<charT, traits>* get(const std::vector<regex_type>& e, match_flag_type f)const
+   {
+      if(!m_built.load(boost::memory_order_acquire))
+      {
+         boost::detail::lightweight_mutex::scoped_lock lock(m_mutex);
+         if(!m_built.load(boost::memory_order_relaxed))
+         {
+            typedef mpl::bool_< (sizeof(charT) == 1) > truth_type;
+            build(e, static_cast<truth_type*>(0));
+            m_built.store(true, boost::memory_order_release);
+         }
+      }
+      if(f & (match_posix | match_partial | match_not_null | regex_constants::match_not_initial_null | match_extra | match_no_dfa))
+         return 0;
+      return m_dfa.get();
+   }
+   // the expression searched by a machine of the DFA:
+   std::size_t expression(int machine)const
+   {
+      return m_machines[machine];
+   }
+   // the expressions searched one at a time, all of them if there's no DFA:
+   const std::vector<std::size_t>& others(bool have_dfa)const
+   {
+      return have_dfa ? m_others : m_all;
+   }
+
+private:
+   regex_set_data(const regex_set_data&);
+   regex_set_data& operator=(const regex_set_data&);
+
+   void build(const std::vector<regex_type>& e, mpl::true_*)const;
+   void build(const std::vector<regex_type>& e, mpl::false_*)const;
+   static bool is_perl(typename regex_type::flag_type f)
+   {
+      // as in perl_matcher::construct_init, the DFA follows perl's rules:
+      return ((f & (regbase::main_option_type|regbase::no_perl_ex)) == 0)
+         || ((f & (regbase::main_option_type|regbase::emacs_ex)) == (regbase::basic_syntax_group|regbase::emacs_ex));
+   }
+
+   mutable boost::detail::lightweight_mutex        m_mutex;    // protects the build
+   mutable boost::atomic<bool>                     m_built;
+   mutable shared_ptr<lazy_dfa<charT, traits> >    m_dfa;
+   mutable std::vector<std::size_t>                m_machines; // the expression of each machine
+   mutable std::vector<std::size_t>                m_others;   // expressions not in m_dfa
+   mutable std::vector<std::size_t>                m_all;
+};
+
+template <class charT, class traits>
+void regex_set_data<charT, traits>::build(const std::vector<regex_type>& e, mpl::true_*)const
+{
+   std::vector<const regex_data<charT, traits>*> machines;
+   for(std::size_t i = 0; i < e.size(); ++i)
+   {
+      m_all.push_back(i);
+      if(e[i].empty() || e[i].status())
+         continue;
+      const regex_data<charT, traits>& d = e[i].get_data();
+      if(d.m_dfa && is_perl(e[i].flags())
+         && (machines.empty() || lazy_dfa<charT, traits>::compatible(*machines.front(), d)))
+      {
+         machines.push_back(&d);
+         m_machines.push_back(i);
+      }
+      else
+         m_others.push_back(i);
+   }
+   if(!machines.empty())
+      m_dfa.reset(new lazy_dfa<charT, traits>(&machines[0], machines.size()));
+}
+
+template <class charT, class traits>
+void regex_set_data<charT, traits>::build(const std::vector<regex_type>& e, mpl::false_*)const
+{
+   // wide character expressions always use perl_matcher:
+   for(std::size_t i = 0; i < e.size(); ++i)
+      m_all.push_back(i);
+}
+
+} // namespace re_detail
+
+template <class charT, class traits = regex_traits<charT> >
+class basic_regex_set
+{
+public:
+   typedef basic_regex<charT, traits>              regex_type;
+   typedef typename regex_type::flag_type          flag_type;
+   typedef charT                                   value_type;
+   typedef std::size_t                             size_type;
+
+   basic_regex_set()
+      : m_pdata(new re_detail::regex_set_data<charT, traits>()) {}
+
+   //
+   // add returns the index of the new expression:
+   //
+   size_type add(const regex_type& e)
+   {
+      m_expressions.push_back(e);
+      // copies of the set keep the old DFA:
+      m_pdata.reset(new re_detail::regex_set_data<charT, traits>());
+      return m_expressions.size() - 1;
+   }
+   size_type add(const charT* p, flag_type f = regex_constants::normal)
+   {
+      return add(regex_type(p, f));
+   }
+   size_type add(const charT* p1, const charT* p2, flag_type f = regex_constants::normal)
+   {
+      return add(regex_type(p1, p2, f));
+   }
+   template <class ST, class SA>
+   size_type add(const std::basic_string<charT, ST, SA>& p, flag_type f = regex_constants::normal)
+   {
+      return add(regex_type(p, f));
+   }
+
+   size_type size()const
+   {
+      return m_expressions.size();
+   }
+   bool empty()const
+   {
+      return m_expressions.empty();
+   }
+   const regex_type& operator[](size_type i)const
+   {
+      return m_expressions[i];
+   }
+   void clear()
+   {
+      m_expressions.clear();
+      m_pdata.reset(new re_detail::regex_set_data<charT, traits>());
+   }
+   void swap(basic_regex_set& that)
+   {
+      m_expressions.swap(that.m_expressions);
+      m_pdata.swap(that.m_pdata);
+   }
+
+   //
+   // private access methods:
+   //
+   const re_detail::lazy_dfa<charT, traits>* get_dfa(match_flag_type f)const
+   {
+      return m_pdata->get(m_expressions, f);
+   }
+   const re_detail::regex_set_data<charT, traits>& get_data()const
+   {
+      return *m_pdata;
+   }
+
+private:
+   std::vector<regex_type>                                    m_expressions;
+   shared_ptr<re_detail::regex_set_data<charT, traits> >      m_pdata;
+};
+
+typedef basic_regex_set<char> regex_set;
+#ifndef BOOST_NO_WREGEX
+typedef basic_regex_set<wchar_t> wregex_set;
+#endif
+
+//
+// The result of searching for every expression of a set: which of them
+// matched, and where each first matched.
+//
+template <class BidiIterator, class Allocator = std::allocator<sub_match<BidiIterator> > >
+class set_match_results
+{
+public:
+   typedef match_results<BidiIterator, Allocator>  value_type;
+   typedef const value_type&                       const_reference;
+   typedef std::size_t                             size_type;
+
+   set_match_results() : m_count(0) {}
+
+   // the number of expressions searched for:
+   size_type size()const
+   {
+      return m_matched.size();
+   }
+   bool empty()const
+   {
+      return m_matched.empty();
+   }
+   // the number of expressions that matched:
+   size_type count()const
+   {
+      return m_count;
+   }
+   bool matched(size_type i)const
+   {
+      return (i < m_matched.size()) && m_matched[i];
+   }
+   const_reference operator[](size_type i)const
+   {
+      return m_results[i];
+   }
+   void swap(set_match_results& that)
+   {
+      m_matched.swap(that.m_matched);
+      m_results.swap(that.m_results);
+      std::swap(m_count, that.m_count);
+   }
+
+   //
+   // private access methods:
+   //
+   void set_size(size_type n)
+   {
+      m_matched.assign(n, false);
+      m_results.assign(n, value_type());
+      m_count = 0;
+   }
+   void set_matched(size_type i)
+   {
+      if(!m_matched[i])
+      {
+         m_matched[i] = true;
+         ++m_count;
+      }
+   }
+   value_type& get(size_type i)
+   {
+      return m_results[i];
+   }
+
+private:
+   std::vector<bool>       m_matched;
+   std::vector<value_type> m_results;
+   size_type               m_count;
+};
+
+//
+// Finds every expression of the set that matches somewhere in
+// [first, last), and unless match_any is set where each first matches:
+//
+template <class BidiIterator, class Allocator, class charT, class traits>
+bool regex_search(BidiIterator first, BidiIterator last,
+                  set_match_results<BidiIterator, Allocator>& m,
+                  const basic_regex_set<charT, traits>& e,
+                  match_flag_type flags = match_default)
+{
+   m.set_size(e.size());
+   bool positions = (flags & match_any) == 0;
+   const re_detail::lazy_dfa<charT, traits>* dfa = e.get_dfa(flags);
+   // the DFA only looks for every expression at once anywhere in the input:
+   if(flags & match_continuous)
+      dfa = 0;
+   if(dfa)
+   {
+      std::vector<bool> found(dfa->size(), false);
+      re_detail::dfa_result r = dfa->run_set(flags, first, last, first, found);
+      if(r == re_detail::dfa_gave_up)
+         dfa = 0;
+      else
+      {
+         for(std::size_t i = 0; i < found.size(); ++i)
+         {
+            if(found[i])
+            {
+               std::size_t k = e.get_data().expression(static_cast<int>(i));
+               m.set_matched(k);
+               // the expression's own search tells us where:
+               if(positions)
+                  regex_search(first, last, m.get(k), e[k], flags);
+            }
+         }
+      }
+   }
+   const std::vector<std::size_t>& others = e.get_data().others(dfa != 0);
+   match_results<BidiIterator, Allocator> what;
+   for(std::size_t i = 0; i < others.size(); ++i)
+   {
+      std::size_t k = others[i];
+      if(regex_search(first, last, positions ? m.get(k) : what, e[k], flags))
+         m.set_matched(k);
+   }
+   return m.count() != 0;
+}
+
+//
+// Returns true if any expression of the set matches in [first, last):
+//
+template <class BidiIterator, class charT, class traits>
+bool regex_search(BidiIterator first, BidiIterator last,
+                  const basic_regex_set<charT, traits>& e,
+                  match_flag_type flags = match_default)
+{
+   const re_detail::lazy_dfa<charT, traits>* dfa = e.get_dfa(flags);
+   if(dfa)
+   {
+      BidiIterator end;
+      re_detail::dfa_result r = dfa->run((flags & match_continuous) ? re_detail::dfa_anchored : re_detail::dfa_unanchored,
+         flags, first, last, first, last, true, end, static_cast<BidiIterator*>(0));
+      if(r == re_detail::dfa_match)
+         return true;
+      if(r == re_detail::dfa_gave_up)
+         dfa = 0;
+   }
+   const std::vector<std::size_t>& others = e.get_data().others(dfa != 0);
+   for(std::size_t i = 0; i < others.size(); ++i)
+   {
+      if(regex_search(first, last, e[others[i]], flags | match_any))
+         return true;
+   }
+   return false;
+}
+
+//
+// regex_search convenience interfaces:
+#ifndef BOOST_NO_FUNCTION_TEMPLATE_ORDERING
+template <class charT, class Allocator, class traits>
+inline bool regex_search(const charT* str,
+                        set_match_results<const charT*, Allocator>& m,
+                        const basic_regex_set<charT, traits>& e,
+                        match_flag_type flags = match_default)
+{
+   return regex_search(str, str + traits::length(str), m, e, flags);
+}
+
+template <class ST, class SA, class Allocator, class charT, class traits>
+inline bool regex_search(const std::basic_string<charT, ST, SA>& s,
+                 set_match_results<typename std::basic_string<charT, ST, SA>::const_iterator, Allocator>& m,
+                 const basic_regex_set<charT, traits>& e,
+                 match_flag_type flags = match_default)
+{
+   return regex_search(s.begin(), s.end(), m, e, flags);
+}
+
+template <class charT, class traits>
+inline bool regex_search(const charT* str,
+                        const basic_regex_set<charT, traits>& e,
+                        match_flag_type flags = match_default)
+{
+   return regex_search(str, str + traits::length(str), e, flags);
+}
+
+template <class ST, class SA, class charT, class traits>
+inline bool regex_search(const std::basic_string<charT, ST, SA>& s,
+                 const basic_regex_set<charT, traits>& e,
+                 match_flag_type flags = match_default)
+{
+   return regex_search(s.begin(), s.end(), e, flags);
+}
+#endif
+
+namespace re_detail{
+
+//
+// Finds the match that the alternation of the set's expressions would
+// find, setting index to the expression that matched.  The DFA tells us
+// which expression that is, the expression's own search then fills in
+// m, and the expressions without a DFA have to be searched as well to
+// see whether any of them matches first:
+//
+template <class BidiIterator, class Allocator, class charT, class traits>
+bool find_in_set(BidiIterator first, BidiIterator last,
+                 match_results<BidiIterator, Allocator>& m, std::size_t& index,
+                 const basic_regex_set<charT, traits>& e,
+                 match_flag_type flags, BidiIterator base)
+{
+   bool found = false;
+   const lazy_dfa<charT, traits>* dfa = e.get_dfa(flags);
+   if(dfa)
+   {
+      BidiIterator end;
+      int machine = -1;
+      dfa_result r = dfa->run((flags & match_continuous) ? dfa_anchored : dfa_unanchored,
+         flags, first, last, base, last, false, end, static_cast<BidiIterator*>(0), &machine);
+      if(r == dfa_match)
+      {
+         index = e.get_data().expression(machine);
+         found = regex_search(first, last, m, e[index], flags, base);
+         BOOST_ASSERT(found);
+      }
+      else if(r == dfa_gave_up)
+         dfa = 0;
+   }
+   const std::vector<std::size_t>& others = e.get_data().others(dfa != 0);
+   match_results<BidiIterator, Allocator> what;
+   for(std::size_t i = 0; i < others.size(); ++i)
+   {
+      std::size_t k = others[i];
+      if(found && (m[0].first == first) && (k > index))
+         break;  // nothing can match sooner
+      if(regex_search(first, last, what, e[k], flags, base))
+      {
+         // leftmost first, then the first expression added:
+         if(!found || (std::distance(first, what[0].first) < std::distance(first, m[0].first))
+            || ((what[0].first == m[0].first) && (k < index)))
+         {
+            m.swap(what);
+            index = k;
+            found = true;
+         }
+      }
+   }
+   return found;
+}
+
+} // namespace re_detail
+
+template <class BidirectionalIterator,
+          class charT,
+          class traits>
+class regex_set_iterator_implementation
+{
+   typedef basic_regex_set<charT, traits> regex_set_type;
+
+   match_results<BidirectionalIterator> what;  // current match
+   std::size_t                          index; // the expression that matched
+   BidirectionalIterator                base;  // start of sequence
+   BidirectionalIterator                end;   // end of sequence
+   const regex_set_type                 re;    // the expressions
+   match_flag_type                      flags; // flags for matching
+
+public:
+   regex_set_iterator_implementation(const regex_set_type* p, BidirectionalIterator last, match_flag_type f)
+      : index(0), base(), end(last), re(*p), flags(f){}
+   bool init(BidirectionalIterator first)
+   {
+      base = first;
+      return re_detail::find_in_set(first, end, what, index, re, flags, base);
+   }
+   bool compare(const regex_set_iterator_implementation& that)
+   {
+      if(this == &that) return true;
+      return (&re.get_data() == &that.re.get_data()) && (end == that.end) && (flags == that.flags) && (what[0].first == that.what[0].first) && (what[0].second == that.what[0].second);
+   }
+   const match_results<BidirectionalIterator>& get()
+   { return what; }
+   std::size_t get_index()
+   { return index; }
+   bool next()
+   {
+      BidirectionalIterator next_start = what[0].second;
+      match_flag_type f(flags);
+      if(!what.length())
+         f |= regex_constants::match_not_initial_null;
+      bool result = re_detail::find_in_set(next_start, end, what, index, re, f, base);
+      if(result)
+         what.set_base(base);
+      return result;
+   }
+private:
+   regex_set_iterator_implementation& operator=(const regex_set_iterator_implementation&);
+};
+
+template <class BidirectionalIterator,
+          class charT = BOOST_DEDUCED_TYPENAME re_detail::regex_iterator_traits<BidirectionalIterator>::value_type,
+          class traits = regex_traits<charT> >
+class regex_set_iterator
+#ifndef BOOST_NO_STD_ITERATOR
+   : public std::iterator<
+         std::forward_iterator_tag,
+         match_results<BidirectionalIterator>,
+         typename re_detail::regex_iterator_traits<BidirectionalIterator>::difference_type,
+         const match_results<BidirectionalIterator>*,
+         const match_results<BidirectionalIterator>& >
+#endif
+{
+private:
+   typedef regex_set_iterator_implementation<BidirectionalIterator, charT, traits> impl;
+   typedef shared_ptr<impl> pimpl;
+public:
+   typedef          basic_regex_set<charT, traits>                          regex_set_type;
+   typedef          match_results<BidirectionalIterator>                    value_type;
+   typedef typename re_detail::regex_iterator_traits<BidirectionalIterator>::difference_type
+                                                                            difference_type;
+   typedef          const value_type*                                       pointer;
+   typedef          const value_type&                                       reference;
+   typedef          std::forward_iterator_tag                               iterator_category;
+
+   regex_set_iterator(){}
+   regex_set_iterator(BidirectionalIterator a, BidirectionalIterator b,
+                  const regex_set_type& re,
+                  match_flag_type m = match_default)
+                  : pdata(new impl(&re, b, m))
+   {
+      if(!pdata->init(a))
+      {
+         pdata.reset();
+      }
+   }
+   regex_set_iterator(const regex_set_iterator& that)
+      : pdata(that.pdata) {}
+   regex_set_iterator& operator=(const regex_set_iterator& that)
+   {
+      pdata = that.pdata;
+      return *this;
+   }
+   bool operator==(const regex_set_iterator& that)const
+   {
+      if((pdata.get() == 0) || (that.pdata.get() == 0))
+         return pdata.get() == that.pdata.get();
+      return pdata->compare(*(that.pdata.get()));
+   }
+   bool operator!=(const regex_set_iterator& that)const
+   { return !(*this == that); }
+   const value_type& operator*()const
+   { return pdata->get(); }
+   const value_type* operator->()const
+   { return &(pdata->get()); }
+   // the index in the set of the expression that matched:
+   std::size_t index()const
+   { return pdata->get_index(); }
+   regex_set_iterator& operator++()
+   {
+      cow();
+      if(0 == pdata->next())
+      {
+         pdata.reset();
+      }
+      return *this;
+   }
+   regex_set_iterator operator++(int)
+   {
+      regex_set_iterator result(*this);
+      ++(*this);
+      return result;
+   }
+private:
+
+   pimpl pdata;
+
+   void cow()
+   {
+      // copy-on-write
+      if(pdata.get() && !pdata.unique())
+      {
+         pdata.reset(new impl(*(pdata.get())));
+      }
+   }
+};
+
+typedef regex_set_iterator<const char*> cregex_set_iterator;
+typedef regex_set_iterator<std::string::const_iterator> sregex_set_iterator;
+#ifndef BOOST_NO_WREGEX
+typedef regex_set_iterator<const wchar_t*> wcregex_set_iterator;
+typedef regex_set_iterator<std::wstring::const_iterator> wsregex_set_iterator;
+#endif
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4103)
+#endif
+#ifdef BOOST_HAS_ABI_HEADERS
+#  include BOOST_ABI_SUFFIX
+#endif
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+} // namespace boost
+
+#endif // BOOST_REGEX_V4_REGEX_SET_HPP
+
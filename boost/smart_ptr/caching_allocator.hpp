@@ -0,0 +1,127 @@
+#ifndef BOOST_SMART_PTR_CACHING_ALLOCATOR_HPP_INCLUDED
+#define BOOST_SMART_PTR_CACHING_ALLOCATOR_HPP_INCLUDED
+
+//
+//  caching_allocator.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+//  See http://www.boost.org/libs/smart_ptr/make_shared.html
+//  for documentation.
+//
+//  A stateless allocator that takes small blocks from a per-thread cache,
+//  for use with allocate_shared:
+//
+//      boost::allocate_shared<X>( boost::caching_allocator<X>(), args... );
+//
+
+#include <boost/config.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/smart_ptr/detail/sp_thread_cache.hpp>
+#include <new>              // std::bad_alloc, placement new
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+
+namespace boost
+{
+
+template< class T > class caching_allocator;
+
+template<> class caching_allocator< void >
+{
+public:
+
+    typedef void value_type;
+    typedef void * pointer;
+    typedef void const * const_pointer;
+
+    template< class U > struct rebind
+    {
+        typedef caching_allocator< U > other;
+    };
+};
+
+template< class T > class caching_allocator
+{
+public:
+
+    typedef T value_type;
+    typedef T * pointer;
+    typedef T const * const_pointer;
+    typedef T & reference;
+    typedef T const & const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template< class U > struct rebind
+    {
+        typedef caching_allocator< U > other;
+    };
+
+    caching_allocator()
+    {
+    }
+
+    template< class U > caching_allocator( caching_allocator< U > const & )
+    {
+    }
+
+    pointer address( reference r ) const
+    {
+        return &r;
+    }
+
+    const_pointer address( const_reference r ) const
+    {
+        return &r;
+    }
+
+    pointer allocate( size_type n, void const * = 0 )
+    {
+        if( n > max_size() )
+        {
+            boost::throw_exception( std::bad_alloc() );
+        }
+
+        return static_cast< pointer >( boost::detail::sp_thread_cache::allocate( n * sizeof( T ) ) );
+    }
+
+    void deallocate( pointer p, size_type n )
+    {
+        boost::detail::sp_thread_cache::deallocate( p, n * sizeof( T ) );
+    }
+
+    size_type max_size() const
+    {
+        return static_cast< size_type >( -1 ) / sizeof( T );
+    }
+
+    void construct( pointer p, T const & t )
+    {
+        ::new( static_cast< void * >( p ) ) T( t );
+    }
+
+    void destroy( pointer p )
+    {
+        p->~T();
+    }
+};
+
+// blocks may be freed through any instance, on any thread
+
+template< class T, class U > inline bool operator==( caching_allocator< T > const &, caching_allocator< U > const & )
+{
+    return true;
+}
+
+template< class T, class U > inline bool operator!=( caching_allocator< T > const &, caching_allocator< U > const & )
+{
+    return false;
+}
+
+} // namespace boost
+
+#endif  // #ifndef BOOST_SMART_PTR_CACHING_ALLOCATOR_HPP_INCLUDED
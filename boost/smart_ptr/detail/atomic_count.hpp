@@ -74,6 +74,7 @@
 
 #include <boost/config.hpp>
 #include <boost/smart_ptr/detail/sp_has_sync.hpp>
+#include <boost/atomic/detail/config.hpp>
 
 #ifndef BOOST_HAS_THREADS
 
@@ -92,14 +93,17 @@ typedef long atomic_count;
 #elif defined(BOOST_AC_USE_PTHREADS)
 #  include <boost/smart_ptr/detail/atomic_count_pthreads.hpp>
 
+#elif defined( BOOST_ATOMIC_DETAIL_GCC_X86 )
+#  include <boost/smart_ptr/detail/atomic_count_atomic.hpp>
+
 #elif defined( __GNUC__ ) && ( defined( __i386__ ) || defined( __x86_64__ ) )
 #  include <boost/smart_ptr/detail/atomic_count_gcc_x86.hpp>
 
 #elif defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__CYGWIN__)
 #  include <boost/smart_ptr/detail/atomic_count_win32.hpp>
 
-#elif defined( BOOST_SP_HAS_SYNC )
-#  include <boost/smart_ptr/detail/atomic_count_sync.hpp>
+#elif defined( BOOST_ATOMIC_DETAIL_GCC_SYNC ) && BOOST_ATOMIC_LONG_LOCK_FREE == 2
+#  include <boost/smart_ptr/detail/atomic_count_atomic.hpp>
 
 #elif defined(__GLIBCPP__) || defined(__GLIBCXX__)
 #  include <boost/smart_ptr/detail/atomic_count_gcc.hpp>
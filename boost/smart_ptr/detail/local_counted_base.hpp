@@ -0,0 +1,135 @@
+#ifndef BOOST_SMART_PTR_DETAIL_LOCAL_COUNTED_BASE_HPP_INCLUDED
+#define BOOST_SMART_PTR_DETAIL_LOCAL_COUNTED_BASE_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+//
+//  detail/local_counted_base.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+//  The count shared by a group of local_shared_ptr instances. It is only
+//  ever touched by one thread, so it is a plain long. The whole group holds
+//  a single reference to the shared_ptr control block, obtained through
+//  local_cb_get_shared_count().
+//
+
+#include <boost/smart_ptr/detail/shared_count.hpp>
+
+namespace boost
+{
+
+namespace detail
+{
+
+class local_counted_base
+{
+private:
+
+    local_counted_base & operator= ( local_counted_base const & );
+
+    long local_use_count_;
+
+public:
+
+    local_counted_base(): local_use_count_( 1 )
+    {
+    }
+
+    local_counted_base( local_counted_base const & ): local_use_count_( 1 )
+    {
+    }
+
+    virtual ~local_counted_base() // nothrow
+    {
+    }
+
+    virtual void local_cb_destroy() = 0; // nothrow
+
+    virtual shared_count local_cb_get_shared_count() const = 0; // nothrow
+
+    void add_ref() // nothrow
+    {
+        ++local_use_count_;
+    }
+
+    void release() // nothrow
+    {
+        if( --local_use_count_ == 0 )
+        {
+            local_cb_destroy();
+        }
+    }
+
+    long local_use_count() const // nothrow
+    {
+        return local_use_count_;
+    }
+};
+
+// Allocated separately, when a local_shared_ptr is created from a pointer
+// or from a shared_ptr
+
+class local_counted_impl: public local_counted_base
+{
+private:
+
+    local_counted_impl( local_counted_impl const & );
+
+    shared_count pn_;
+
+public:
+
+    explicit local_counted_impl( shared_count const & pn ): pn_( pn )
+    {
+    }
+
+    virtual void local_cb_destroy() // nothrow
+    {
+        delete this;
+    }
+
+    virtual shared_count local_cb_get_shared_count() const // nothrow
+    {
+        return pn_;
+    }
+};
+
+// Embedded in the control block by make_local_shared. pn_ refers to the
+// control block that contains *this, so local_cb_destroy must not touch
+// the object after releasing it.
+
+class local_counted_impl_em: public local_counted_base
+{
+public:
+
+    shared_count pn_;
+
+    virtual void local_cb_destroy() // nothrow
+    {
+        shared_count().swap( pn_ );
+    }
+
+    virtual shared_count local_cb_get_shared_count() const // nothrow
+    {
+        return pn_;
+    }
+};
+
+struct lsp_internal_constructor_tag
+{
+};
+
+} // namespace detail
+
+} // namespace boost
+
+#endif  // #ifndef BOOST_SMART_PTR_DETAIL_LOCAL_COUNTED_BASE_HPP_INCLUDED
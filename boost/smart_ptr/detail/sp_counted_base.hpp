@@ -19,6 +19,7 @@
 
 #include <boost/config.hpp>
 #include <boost/smart_ptr/detail/sp_has_sync.hpp>
+#include <boost/atomic/detail/config.hpp>
 
 #if defined( BOOST_SP_DISABLE_THREADS )
 # include <boost/smart_ptr/detail/sp_counted_base_nt.hpp>
@@ -32,6 +33,9 @@
 #elif defined( BOOST_DISABLE_THREADS ) && !defined( BOOST_SP_ENABLE_THREADS ) && !defined( BOOST_DISABLE_WIN32 )
 # include <boost/smart_ptr/detail/sp_counted_base_nt.hpp>
 
+#elif defined( BOOST_ATOMIC_DETAIL_GCC_X86 )
+# include <boost/smart_ptr/detail/sp_counted_base_atomic.hpp>
+
 #elif defined( __GNUC__ ) && ( defined( __i386__ ) || defined( __x86_64__ ) )
 # include <boost/smart_ptr/detail/sp_counted_base_gcc_x86.hpp>
 
@@ -50,8 +54,8 @@
 #elif defined( __GNUC__ ) && ( defined( __mips__ ) || defined( _mips ) )
 # include <boost/smart_ptr/detail/sp_counted_base_gcc_mips.hpp>
 
-#elif defined( BOOST_SP_HAS_SYNC )
-# include <boost/smart_ptr/detail/sp_counted_base_sync.hpp>
+#elif defined( BOOST_ATOMIC_DETAIL_GCC_SYNC )
+# include <boost/smart_ptr/detail/sp_counted_base_atomic.hpp>
 
 #elif defined(__GNUC__) && ( defined( __sparcv9 ) || ( defined( __sparcv8 ) && ( __GNUC__ * 100 + __GNUC_MINOR__ >= 402 ) ) )
 # include <boost/smart_ptr/detail/sp_counted_base_gcc_sparc.hpp>
@@ -1,5 +1,5 @@
-#ifndef BOOST_SMART_PTR_DETAIL_SP_COUNTED_BASE_SYNC_HPP_INCLUDED
-#define BOOST_SMART_PTR_DETAIL_SP_COUNTED_BASE_SYNC_HPP_INCLUDED
+#ifndef BOOST_SMART_PTR_DETAIL_SP_COUNTED_BASE_ATOMIC_HPP_INCLUDED
+#define BOOST_SMART_PTR_DETAIL_SP_COUNTED_BASE_ATOMIC_HPP_INCLUDED
 
 // MS compatible compilers support #pragma once
 
@@ -7,20 +7,22 @@
 # pragma once
 #endif
 
-//  detail/sp_counted_base_sync.hpp - g++ 4.1+ __sync intrinsics
+//  detail/sp_counted_base_atomic.hpp - boost::atomic<>
 //
-//  Copyright (c) 2007 Peter Dimov
+//  Copyright (c) 2007, 2011 Peter Dimov
 //
 //  Distributed under the Boost Software License, Version 1.0.
 //  See accompanying file LICENSE_1_0.txt or copy at
 //  http://www.boost.org/LICENSE_1_0.txt
+//
+//  Incrementing a count needs no ordering, since the thread doing it
+//  already owns a reference. Decrementing it is acq_rel, so that all
+//  uses of the object by other owners happen before dispose().
+//
 
 #include <boost/detail/sp_typeinfo.hpp>
-#include <limits.h>
-
-#if defined( __ia64__ ) && defined( __INTEL_COMPILER )
-# include <ia64intrin.h>
-#endif
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 
 namespace boost
 {
@@ -28,33 +30,23 @@ namespace boost
 namespace detail
 {
 
-#if INT_MAX >= 2147483647
-
-typedef int sp_int32_t;
-
-#else
-
-typedef long sp_int32_t;
-
-#endif
-
-inline void atomic_increment( sp_int32_t * pw )
+inline void atomic_increment( atomic< boost::int_least32_t > * pw )
 {
-    __sync_fetch_and_add( pw, 1 );
+    pw->fetch_add( 1, memory_order_relaxed );
 }
 
-inline sp_int32_t atomic_decrement( sp_int32_t * pw )
+inline boost::int_least32_t atomic_decrement( atomic< boost::int_least32_t > * pw )
 {
-    return __sync_fetch_and_add( pw, -1 );
+    return pw->fetch_sub( 1, memory_order_acq_rel );
 }
 
-inline sp_int32_t atomic_conditional_increment( sp_int32_t * pw )
+inline boost::int_least32_t atomic_conditional_increment( atomic< boost::int_least32_t > * pw )
 {
     // long r = *pw;
     // if( r != 0 ) ++*pw;
     // return r;
 
-    sp_int32_t r = *pw;
+    boost::int_least32_t r = pw->load( memory_order_relaxed );
 
     for( ;; )
     {
@@ -63,16 +55,10 @@ inline sp_int32_t atomic_conditional_increment( sp_int32_t * pw )
             return r;
         }
 
-        sp_int32_t r2 = __sync_val_compare_and_swap( pw, r, r + 1 );
-
-        if( r2 == r )
+        if( pw->compare_exchange_weak( r, r + 1, memory_order_relaxed, memory_order_relaxed ) )
         {
             return r;
         }
-        else
-        {
-            r = r2;
-        }
     }    
 }
 
@@ -83,8 +69,8 @@ private:
     sp_counted_base( sp_counted_base const & );
     sp_counted_base & operator= ( sp_counted_base const & );
 
-    sp_int32_t use_count_;        // #shared
-    sp_int32_t weak_count_;       // #weak + (#shared != 0)
+    atomic< boost::int_least32_t > use_count_;     // #shared
+    atomic< boost::int_least32_t > weak_count_;    // #weak + (#shared != 0)
 
 public:
 
@@ -144,7 +130,7 @@ public:
 
     long use_count() const // nothrow
     {
-        return const_cast< sp_int32_t const volatile & >( use_count_ );
+        return use_count_.load( memory_order_relaxed );
     }
 };
 
@@ -152,4 +138,4 @@ public:
 
 } // namespace boost
 
-#endif  // #ifndef BOOST_SMART_PTR_DETAIL_SP_COUNTED_BASE_SYNC_HPP_INCLUDED
+#endif  // #ifndef BOOST_SMART_PTR_DETAIL_SP_COUNTED_BASE_ATOMIC_HPP_INCLUDED
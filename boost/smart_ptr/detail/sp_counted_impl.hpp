@@ -24,6 +24,10 @@
 # error BOOST_SP_USE_STD_ALLOCATOR and BOOST_SP_USE_QUICK_ALLOCATOR are incompatible.
 #endif
 
+#if defined(BOOST_SP_USE_CACHING_ALLOCATOR) && ( defined(BOOST_SP_USE_STD_ALLOCATOR) || defined(BOOST_SP_USE_QUICK_ALLOCATOR) )
+# error BOOST_SP_USE_CACHING_ALLOCATOR is incompatible with BOOST_SP_USE_STD_ALLOCATOR and BOOST_SP_USE_QUICK_ALLOCATOR.
+#endif
+
 #include <boost/checked_delete.hpp>
 #include <boost/smart_ptr/detail/sp_counted_base.hpp>
 
@@ -35,6 +39,10 @@
 #include <memory>           // std::allocator
 #endif
 
+#if defined(BOOST_SP_USE_CACHING_ALLOCATOR)
+#include <boost/smart_ptr/detail/sp_thread_cache.hpp>
+#endif
+
 #include <cstddef>          // std::size_t
 
 namespace boost
@@ -109,6 +117,20 @@ public:
         quick_allocator<this_type>::dealloc( p );
     }
 
+#endif
+
+#if defined(BOOST_SP_USE_CACHING_ALLOCATOR)
+
+    void * operator new( std::size_t )
+    {
+        return sp_thread_cache::allocate( sizeof( this_type ) );
+    }
+
+    void operator delete( void * p )
+    {
+        sp_thread_cache::deallocate( p, sizeof( this_type ) );
+    }
+
 #endif
 };
 
@@ -179,6 +201,20 @@ public:
         quick_allocator<this_type>::dealloc( p );
     }
 
+#endif
+
+#if defined(BOOST_SP_USE_CACHING_ALLOCATOR)
+
+    void * operator new( std::size_t )
+    {
+        return sp_thread_cache::allocate( sizeof( this_type ) );
+    }
+
+    void operator delete( void * p )
+    {
+        sp_thread_cache::deallocate( p, sizeof( this_type ) );
+    }
+
 #endif
 };
 
@@ -0,0 +1,455 @@
+#ifndef BOOST_SMART_PTR_DETAIL_SP_THREAD_CACHE_HPP_INCLUDED
+#define BOOST_SMART_PTR_DETAIL_SP_THREAD_CACHE_HPP_INCLUDED
+
+// MS compatible compilers support #pragma once
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+//
+//  detail/sp_thread_cache.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+//  A per-thread cache of small blocks, in size classes of 16 bytes up to
+//  256 bytes. Larger requests go to ::operator new.
+//
+//  Every block is preceded by a header naming the cache that allocated it.
+//  A block freed by its owning thread goes on that thread's free list. A
+//  block freed by another thread is pushed onto the owner's lock-free
+//  remote list, which the owner drains when one of its free lists runs dry.
+//
+//  When a thread exits, its cache returns the blocks it holds to the heap
+//  and closes its remote list; blocks freed after that go straight to the
+//  heap. The cache itself is destroyed when the last block it allocated
+//  has been freed.
+//
+//  The cache is per thread only with POSIX threads. Without threads a
+//  single cache is used. With other thread models every block comes from
+//  ::operator new.
+//
+
+#include <boost/config.hpp>
+#include <boost/atomic.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <new>              // ::operator new, ::operator delete
+#include <cstddef>          // std::size_t
+
+#if defined( BOOST_HAS_THREADS ) && defined( BOOST_HAS_PTHREADS )
+#include <pthread.h>
+#endif
+
+namespace boost
+{
+
+namespace detail
+{
+
+class sp_thread_cache;
+
+struct sp_tc_block
+{
+    sp_tc_block * next;
+};
+
+struct sp_tc_header_info
+{
+    sp_thread_cache * owner;
+    std::size_t size_class;
+};
+
+// max_align keeps the block that follows the header suitably aligned
+
+union sp_tc_header
+{
+    sp_tc_header_info info;
+    boost::detail::max_align align_;
+};
+
+#if defined( BOOST_HAS_THREADS ) && defined( BOOST_HAS_PTHREADS )
+
+// The key only serves to destroy the cache at thread exit when the
+// compiler supports __thread, which is considerably faster to read
+
+#if defined( __GNUC__ ) && ( __GNUC__ * 100 + __GNUC_MINOR__ >= 303 ) && !defined( __APPLE__ )
+# define BOOST_SP_TC_HAS_THREAD_KEYWORD
+#endif
+
+template< int I > struct sp_tc_tss
+{
+    static pthread_key_t key_;
+    static pthread_once_t once_;
+
+#if defined( BOOST_SP_TC_HAS_THREAD_KEYWORD )
+
+    static __thread sp_thread_cache * pc_;
+
+#endif
+
+    static void cleanup( void * pv );
+
+    static void init()
+    {
+        pthread_key_create( &key_, cleanup );
+    }
+
+    static sp_thread_cache * get()
+    {
+#if defined( BOOST_SP_TC_HAS_THREAD_KEYWORD )
+
+        return pc_;
+
+#else
+
+        pthread_once( &once_, init );
+        return static_cast< sp_thread_cache * >( pthread_getspecific( key_ ) );
+
+#endif
+    }
+
+    static void set( sp_thread_cache * pc )
+    {
+        pthread_once( &once_, init );
+        pthread_setspecific( key_, pc );
+
+#if defined( BOOST_SP_TC_HAS_THREAD_KEYWORD )
+
+        pc_ = pc;
+
+#endif
+    }
+};
+
+template< int I > pthread_key_t sp_tc_tss< I >::key_;
+template< int I > pthread_once_t sp_tc_tss< I >::once_ = PTHREAD_ONCE_INIT;
+
+#if defined( BOOST_SP_TC_HAS_THREAD_KEYWORD )
+
+template< int I > __thread sp_thread_cache * sp_tc_tss< I >::pc_ = 0;
+
+#endif
+
+#elif !defined( BOOST_HAS_THREADS )
+
+template< int I > struct sp_tc_tss
+{
+    static sp_thread_cache * pc_;
+
+    static sp_thread_cache * get()
+    {
+        return pc_;
+    }
+
+    static void set( sp_thread_cache * pc )
+    {
+        pc_ = pc;
+    }
+};
+
+template< int I > sp_thread_cache * sp_tc_tss< I >::pc_ = 0;
+
+#endif
+
+class sp_thread_cache
+{
+private:
+
+    sp_thread_cache( sp_thread_cache const & );
+    sp_thread_cache & operator=( sp_thread_cache const & );
+
+public:
+
+    enum { granularity = 16 };
+    enum { size_classes = 16 };
+    enum { max_size = granularity * size_classes };
+
+    // blocks kept per size class; the rest are returned to the heap
+    enum { max_cached = 64 };
+
+    static void * allocate( std::size_t n )
+    {
+        if( n > max_size )
+        {
+            return ::operator new( n );
+        }
+
+        std::size_t c = n == 0? 0: ( n - 1 ) / granularity;
+
+        sp_thread_cache * pc = current();
+
+        if( pc == 0 )
+        {
+            return new_block( 0, c );
+        }
+        else
+        {
+            return pc->allocate_block( c );
+        }
+    }
+
+    static void deallocate( void * p, std::size_t n )
+    {
+        if( p == 0 )
+        {
+            return;
+        }
+
+        if( n > max_size )
+        {
+            ::operator delete( p );
+            return;
+        }
+
+        sp_tc_block * pb = static_cast< sp_tc_block * >( p );
+        sp_thread_cache * owner = header( pb )->info.owner;
+
+        if( owner == 0 )
+        {
+            ::operator delete( header( pb ) );
+        }
+        else if( owner == existing() )
+        {
+            owner->free_block( pb );
+        }
+        else
+        {
+            owner->remote_free( pb );
+        }
+    }
+
+#if defined( BOOST_HAS_THREADS ) && defined( BOOST_HAS_PTHREADS )
+
+    // called at thread exit
+
+    void close()
+    {
+        std::size_t released = 0;
+
+        for( std::size_t c = 0; c < size_classes; ++c )
+        {
+            while( free_[ c ] != 0 )
+            {
+                sp_tc_block * pb = free_[ c ];
+                free_[ c ] = pb->next;
+
+                ::operator delete( header( pb ) );
+                ++released;
+            }
+
+            count_[ c ] = 0;
+        }
+
+        sp_tc_block * pb = remote_.exchange( closed(), boost::memory_order_acquire );
+
+        while( pb != 0 )
+        {
+            sp_tc_block * next = pb->next;
+
+            ::operator delete( header( pb ) );
+            ++released;
+
+            pb = next;
+        }
+
+        // one for the thread itself
+        ++released;
+
+        if( refs_.fetch_sub( released, boost::memory_order_acq_rel ) == released )
+        {
+            delete this;
+        }
+    }
+
+#endif
+
+private:
+
+    sp_tc_block * free_[ size_classes ];
+    std::size_t count_[ size_classes ];
+
+    // blocks freed by other threads, or closed() once the thread has exited
+    boost::atomic< sp_tc_block * > remote_;
+
+    // blocks allocated from the heap and not yet returned, plus one while
+    // the owning thread is running
+    boost::atomic< std::size_t > refs_;
+
+    sp_thread_cache(): remote_( 0 ), refs_( 1 )
+    {
+        for( std::size_t c = 0; c < size_classes; ++c )
+        {
+            free_[ c ] = 0;
+            count_[ c ] = 0;
+        }
+    }
+
+    static sp_tc_header * header( sp_tc_block * pb )
+    {
+        return reinterpret_cast< sp_tc_header * >( pb ) - 1;
+    }
+
+    sp_tc_block * closed()
+    {
+        // no block can have the address of the cache
+        return reinterpret_cast< sp_tc_block * >( this );
+    }
+
+#if defined( BOOST_HAS_THREADS ) && !defined( BOOST_HAS_PTHREADS )
+
+    static sp_thread_cache * existing()
+    {
+        return 0;
+    }
+
+    static sp_thread_cache * current()
+    {
+        return 0;
+    }
+
+#else
+
+    static sp_thread_cache * existing()
+    {
+        return sp_tc_tss< 0 >::get();
+    }
+
+    static sp_thread_cache * current()
+    {
+        sp_thread_cache * pc = sp_tc_tss< 0 >::get();
+
+        if( pc == 0 )
+        {
+            pc = new sp_thread_cache;
+            sp_tc_tss< 0 >::set( pc );
+        }
+
+        return pc;
+    }
+
+#endif
+
+    static void * new_block( sp_thread_cache * owner, std::size_t c )
+    {
+        sp_tc_header * ph = static_cast< sp_tc_header * >( ::operator new( sizeof( sp_tc_header ) + ( c + 1 ) * granularity ) );
+
+        ph->info.owner = owner;
+        ph->info.size_class = c;
+
+        if( owner != 0 )
+        {
+            owner->refs_.fetch_add( 1, boost::memory_order_relaxed );
+        }
+
+        return ph + 1;
+    }
+
+    void * allocate_block( std::size_t c )
+    {
+        if( free_[ c ] == 0 )
+        {
+            drain_remote();
+        }
+
+        sp_tc_block * pb = free_[ c ];
+
+        if( pb != 0 )
+        {
+            free_[ c ] = pb->next;
+            --count_[ c ];
+            return pb;
+        }
+
+        return new_block( this, c );
+    }
+
+    void free_block( sp_tc_block * pb )
+    {
+        std::size_t c = header( pb )->info.size_class;
+
+        if( count_[ c ] < max_cached )
+        {
+            pb->next = free_[ c ];
+            free_[ c ] = pb;
+            ++count_[ c ];
+        }
+        else
+        {
+            ::operator delete( header( pb ) );
+
+            // cannot reach zero, the thread holds a reference
+            refs_.fetch_sub( 1, boost::memory_order_relaxed );
+        }
+    }
+
+    void drain_remote()
+    {
+        if( remote_.load( boost::memory_order_relaxed ) == 0 )
+        {
+            return;
+        }
+
+        sp_tc_block * pb = remote_.exchange( 0, boost::memory_order_acquire );
+
+        while( pb != 0 )
+        {
+            sp_tc_block * next = pb->next;
+            free_block( pb );
+            pb = next;
+        }
+    }
+
+    void remote_free( sp_tc_block * pb )
+    {
+        sp_tc_block * head = remote_.load( boost::memory_order_relaxed );
+
+        for( ;; )
+        {
+            if( head == closed() )
+            {
+                ::operator delete( header( pb ) );
+
+                if( refs_.fetch_sub( 1, boost::memory_order_acq_rel ) == 1 )
+                {
+                    delete this;
+                }
+
+                return;
+            }
+
+            pb->next = head;
+
+            if( remote_.compare_exchange_weak( head, pb, boost::memory_order_release, boost::memory_order_relaxed ) )
+            {
+                return;
+            }
+        }
+    }
+};
+
+#if defined( BOOST_HAS_THREADS ) && defined( BOOST_HAS_PTHREADS )
+
+template< int I > void sp_tc_tss< I >::cleanup( void * pv )
+{
+#if defined( BOOST_SP_TC_HAS_THREAD_KEYWORD )
+
+    pc_ = 0;
+
+#endif
+
+    static_cast< sp_thread_cache * >( pv )->close();
+}
+
+#endif
+
+} // namespace detail
+
+} // namespace boost
+
+#undef BOOST_SP_TC_HAS_THREAD_KEYWORD
+
+#endif  // #ifndef BOOST_SMART_PTR_DETAIL_SP_THREAD_CACHE_HPP_INCLUDED
@@ -16,7 +16,7 @@
 //  See accompanying file LICENSE_1_0.txt or copy at
 //  http://www.boost.org/LICENSE_1_0.txt)
 //
-//  spinlock_pool<0> is reserved for atomic<>, when/if it arrives
+//  spinlock_pool<0> is used by atomic<>
 //  spinlock_pool<1> is reserved for shared_ptr reference counts
 //  spinlock_pool<2> is reserved for shared_ptr atomic access
 //
@@ -0,0 +1,317 @@
+#ifndef BOOST_SMART_PTR_LOCAL_SHARED_PTR_HPP_INCLUDED
+#define BOOST_SMART_PTR_LOCAL_SHARED_PTR_HPP_INCLUDED
+
+//
+//  local_shared_ptr.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+//  See http://www.boost.org/libs/smart_ptr/local_shared_ptr.html
+//  for documentation.
+//
+
+#include <boost/config.hpp>
+#include <boost/assert.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/smart_ptr/detail/local_counted_base.hpp>
+#include <boost/smart_ptr/detail/sp_convertible.hpp>
+#include <algorithm>            // for std::swap
+
+namespace boost
+{
+
+//
+//  local_shared_ptr
+//
+//  Like shared_ptr, but copies of a local_shared_ptr share a non-atomic
+//  count, and together hold a single reference to the shared_ptr control
+//  block. A group of local_shared_ptr instances derived from one another
+//  must only be used by one thread at a time; convert to shared_ptr to
+//  hand the object to another thread.
+//
+
+template<class T> class local_shared_ptr
+{
+private:
+
+    typedef local_shared_ptr<T> this_type;
+
+public:
+
+    typedef T element_type;
+    typedef T value_type;
+    typedef T * pointer;
+    typedef typename boost::detail::shared_ptr_traits<T>::reference reference;
+
+    local_shared_ptr(): px( 0 ), pn( 0 ) // never throws
+    {
+    }
+
+    template<class Y>
+    explicit local_shared_ptr( Y * p ): px( p ), pn( 0 ) // Y must be complete
+    {
+        boost::shared_ptr<T> r( p );
+        pn = new boost::detail::local_counted_impl( r.pn );
+    }
+
+    template<class Y, class D> local_shared_ptr( Y * p, D d ): px( p ), pn( 0 )
+    {
+        boost::shared_ptr<T> r( p, d );
+        pn = new boost::detail::local_counted_impl( r.pn );
+    }
+
+    template<class Y>
+#if !defined( BOOST_SP_NO_SP_CONVERTIBLE )
+
+    local_shared_ptr( shared_ptr<Y> const & r, typename boost::detail::sp_enable_if_convertible<Y,T>::type = boost::detail::sp_empty() )
+
+#else
+
+    local_shared_ptr( shared_ptr<Y> const & r )
+
+#endif
+    : px( r.px ), pn( 0 )
+    {
+        if( !r.pn.empty() )
+        {
+            pn = new boost::detail::local_counted_impl( r.pn );
+        }
+    }
+
+    // used by make_local_shared; pn is embedded in the control block owned by r
+    template<class Y>
+    local_shared_ptr( boost::detail::lsp_internal_constructor_tag, T * p, shared_ptr<Y> const & r, boost::detail::local_counted_impl_em * pe ): px( p ), pn( pe ) // never throws
+    {
+        pe->pn_ = r.pn;
+    }
+
+    local_shared_ptr( local_shared_ptr const & r ): px( r.px ), pn( r.pn ) // never throws
+    {
+        if( pn != 0 ) pn->add_ref();
+    }
+
+    template<class Y>
+#if !defined( BOOST_SP_NO_SP_CONVERTIBLE )
+
+    local_shared_ptr( local_shared_ptr<Y> const & r, typename boost::detail::sp_enable_if_convertible<Y,T>::type = boost::detail::sp_empty() )
+
+#else
+
+    local_shared_ptr( local_shared_ptr<Y> const & r )
+
+#endif
+    : px( r.px ), pn( r.pn ) // never throws
+    {
+        if( pn != 0 ) pn->add_ref();
+    }
+
+    // aliasing
+    template< class Y >
+    local_shared_ptr( local_shared_ptr<Y> const & r, T * p ): px( p ), pn( r.pn ) // never throws
+    {
+        if( pn != 0 ) pn->add_ref();
+    }
+
+    ~local_shared_ptr() // never throws
+    {
+        if( pn != 0 ) pn->release();
+    }
+
+    local_shared_ptr & operator=( local_shared_ptr const & r ) // never throws
+    {
+        this_type( r ).swap( *this );
+        return *this;
+    }
+
+    template<class Y>
+    local_shared_ptr & operator=( local_shared_ptr<Y> const & r ) // never throws
+    {
+        this_type( r ).swap( *this );
+        return *this;
+    }
+
+    template<class Y>
+    local_shared_ptr & operator=( shared_ptr<Y> const & r )
+    {
+        this_type( r ).swap( *this );
+        return *this;
+    }
+
+// Move support
+
+#if defined( BOOST_HAS_RVALUE_REFS )
+
+    local_shared_ptr( local_shared_ptr && r ): px( r.px ), pn( r.pn ) // never throws
+    {
+        r.px = 0;
+        r.pn = 0;
+    }
+
+    template<class Y>
+#if !defined( BOOST_SP_NO_SP_CONVERTIBLE )
+
+    local_shared_ptr( local_shared_ptr<Y> && r, typename boost::detail::sp_enable_if_convertible<Y,T>::type = boost::detail::sp_empty() )
+
+#else
+
+    local_shared_ptr( local_shared_ptr<Y> && r )
+
+#endif
+    : px( r.px ), pn( r.pn ) // never throws
+    {
+        r.px = 0;
+        r.pn = 0;
+    }
+
+    local_shared_ptr & operator=( local_shared_ptr && r ) // never throws
+    {
+        this_type( static_cast< local_shared_ptr && >( r ) ).swap( *this );
+        return *this;
+    }
+
+    template<class Y>
+    local_shared_ptr & operator=( local_shared_ptr<Y> && r ) // never throws
+    {
+        this_type( static_cast< local_shared_ptr<Y> && >( r ) ).swap( *this );
+        return *this;
+    }
+
+#endif
+
+    void reset() // never throws
+    {
+        this_type().swap( *this );
+    }
+
+    template<class Y> void reset( Y * p ) // Y must be complete
+    {
+        BOOST_ASSERT( p == 0 || p != px ); // catch self-reset errors
+        this_type( p ).swap( *this );
+    }
+
+    template<class Y, class D> void reset( Y * p, D d )
+    {
+        this_type( p, d ).swap( *this );
+    }
+
+    template<class Y> void reset( local_shared_ptr<Y> const & r, T * p )
+    {
+        this_type( r, p ).swap( *this );
+    }
+
+    reference operator* () const // never throws
+    {
+        BOOST_ASSERT( px != 0 );
+        return *px;
+    }
+
+    T * operator-> () const // never throws
+    {
+        BOOST_ASSERT( px != 0 );
+        return px;
+    }
+
+    T * get() const // never throws
+    {
+        return px;
+    }
+
+// implicit conversion to "bool"
+#include <boost/smart_ptr/detail/operator_bool.hpp>
+
+    // the number of local_shared_ptr instances sharing the local count
+    long local_use_count() const // never throws
+    {
+        return pn != 0? pn->local_use_count(): 0;
+    }
+
+    // the only operation that touches the atomic count
+    template<class Y> operator shared_ptr<Y>() const // never throws
+    {
+        shared_ptr<Y> r;
+
+        if( pn != 0 )
+        {
+            r.px = px;
+            r.pn = pn->local_cb_get_shared_count();
+        }
+
+        return r;
+    }
+
+    void swap( local_shared_ptr & other ) // never throws
+    {
+        std::swap( px, other.px );
+        std::swap( pn, other.pn );
+    }
+
+    bool _internal_equiv( local_shared_ptr const & r ) const
+    {
+        return px == r.px && pn == r.pn;
+    }
+
+// Tasteless as this may seem, making all members public allows member templates
+// to work in the absence of member template friends. (Matthew Langston)
+
+#ifndef BOOST_NO_MEMBER_TEMPLATE_FRIENDS
+
+private:
+
+    template<class Y> friend class local_shared_ptr;
+
+#endif
+
+    T * px;                                 // contained pointer
+    boost::detail::local_counted_base * pn; // local reference counter
+
+};  // local_shared_ptr
+
+template<class T, class U> inline bool operator==( local_shared_ptr<T> const & a, local_shared_ptr<U> const & b )
+{
+    return a.get() == b.get();
+}
+
+template<class T, class U> inline bool operator!=( local_shared_ptr<T> const & a, local_shared_ptr<U> const & b )
+{
+    return a.get() != b.get();
+}
+
+template<class T, class U> inline bool operator==( local_shared_ptr<T> const & a, shared_ptr<U> const & b )
+{
+    return a.get() == b.get();
+}
+
+template<class T, class U> inline bool operator!=( local_shared_ptr<T> const & a, shared_ptr<U> const & b )
+{
+    return a.get() != b.get();
+}
+
+template<class T, class U> inline bool operator==( shared_ptr<T> const & a, local_shared_ptr<U> const & b )
+{
+    return a.get() == b.get();
+}
+
+template<class T, class U> inline bool operator!=( shared_ptr<T> const & a, local_shared_ptr<U> const & b )
+{
+    return a.get() != b.get();
+}
+
+template<class T> inline void swap( local_shared_ptr<T> & a, local_shared_ptr<T> & b )
+{
+    a.swap( b );
+}
+
+// get_pointer() enables boost::mem_fn to recognize local_shared_ptr
+
+template<class T> inline T * get_pointer( local_shared_ptr<T> const & p )
+{
+    return p.get();
+}
+
+} // namespace boost
+
+#endif  // #ifndef BOOST_SMART_PTR_LOCAL_SHARED_PTR_HPP_INCLUDED
@@ -0,0 +1,925 @@
+#ifndef BOOST_SMART_PTR_MAKE_LOCAL_SHARED_HPP_INCLUDED
+#define BOOST_SMART_PTR_MAKE_LOCAL_SHARED_HPP_INCLUDED
+
+//  make_local_shared.hpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+//  See http://www.boost.org/libs/smart_ptr/local_shared_ptr.html
+//  for documentation.
+
+#include <boost/config.hpp>
+#include <boost/smart_ptr/make_shared.hpp>
+#include <boost/smart_ptr/local_shared_ptr.hpp>
+#include <boost/smart_ptr/detail/local_counted_base.hpp>
+
+namespace boost
+{
+
+namespace detail
+{
+
+// The make_shared deleter, plus the local count, so that make_local_shared
+// needs a single allocation like make_shared
+
+template< class T > class lsp_ms_deleter: public local_counted_impl_em
+{
+private:
+
+    sp_ms_deleter< T > d_;
+
+public:
+
+    void operator()( T * p )
+    {
+        d_( p );
+    }
+
+    void * address()
+    {
+        return d_.address();
+    }
+
+    void set_initialized()
+    {
+        d_.set_initialized();
+    }
+};
+
+} // namespace detail
+
+#if !defined( BOOST_NO_FUNCTION_TEMPLATE_ORDERING )
+# define BOOST_LSP_MSD( T ) boost::detail::sp_inplace_tag< boost::detail::lsp_ms_deleter< T > >()
+#else
+# define BOOST_LSP_MSD( T ) boost::detail::lsp_ms_deleter< T >()
+#endif
+
+// Zero-argument versions
+//
+// Used even when variadic templates are available because of the new T() vs new T issue
+
+template< class T > boost::local_shared_ptr< T > make_local_shared()
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T();
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A > boost::local_shared_ptr< T > allocate_local_shared( A const & a )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T();
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+#if defined( BOOST_HAS_VARIADIC_TMPL ) && defined( BOOST_HAS_RVALUE_REFS )
+
+// Variadic templates, rvalue reference
+
+template< class T, class Arg1, class... Args > boost::local_shared_ptr< T > make_local_shared( Arg1 && arg1, Args && ... args )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( boost::detail::sp_forward<Arg1>( arg1 ), boost::detail::sp_forward<Args>( args )... );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class Arg1, class... Args > boost::local_shared_ptr< T > allocate_local_shared( A const & a, Arg1 && arg1, Args && ... args )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( boost::detail::sp_forward<Arg1>( arg1 ), boost::detail::sp_forward<Args>( args )... );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+#elif defined( BOOST_HAS_RVALUE_REFS )
+
+// For example MSVC 10.0
+
+template< class T, class A1 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1, A2 && a2 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1, A2 && a2 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1, A2 && a2, A3 && a3 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1, A2 && a2, A3 && a3 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1, A2 && a2, A3 && a3, A4 && a4 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1, A2 && a2, A3 && a3, A4 && a4 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5, class A6 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5, A6 && a6 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 ),
+        boost::detail::sp_forward<A6>( a6 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5, class A6 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5, A6 && a6 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 ),
+        boost::detail::sp_forward<A6>( a6 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5, A6 && a6, A7 && a7 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 ),
+        boost::detail::sp_forward<A6>( a6 ),
+        boost::detail::sp_forward<A7>( a7 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5, A6 && a6, A7 && a7 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 ),
+        boost::detail::sp_forward<A6>( a6 ),
+        boost::detail::sp_forward<A7>( a7 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5, A6 && a6, A7 && a7, A8 && a8 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 ),
+        boost::detail::sp_forward<A6>( a6 ),
+        boost::detail::sp_forward<A7>( a7 ),
+        boost::detail::sp_forward<A8>( a8 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5, A6 && a6, A7 && a7, A8 && a8 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 ),
+        boost::detail::sp_forward<A6>( a6 ),
+        boost::detail::sp_forward<A7>( a7 ),
+        boost::detail::sp_forward<A8>( a8 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9 >
+boost::local_shared_ptr< T > make_local_shared( A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5, A6 && a6, A7 && a7, A8 && a8, A9 && a9 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 ),
+        boost::detail::sp_forward<A6>( a6 ),
+        boost::detail::sp_forward<A7>( a7 ),
+        boost::detail::sp_forward<A8>( a8 ),
+        boost::detail::sp_forward<A9>( a9 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 && a1, A2 && a2, A3 && a3, A4 && a4, A5 && a5, A6 && a6, A7 && a7, A8 && a8, A9 && a9 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T(
+        boost::detail::sp_forward<A1>( a1 ),
+        boost::detail::sp_forward<A2>( a2 ),
+        boost::detail::sp_forward<A3>( a3 ),
+        boost::detail::sp_forward<A4>( a4 ),
+        boost::detail::sp_forward<A5>( a5 ),
+        boost::detail::sp_forward<A6>( a6 ),
+        boost::detail::sp_forward<A7>( a7 ),
+        boost::detail::sp_forward<A8>( a8 ),
+        boost::detail::sp_forward<A9>( a9 )
+        );
+
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+#else
+
+// C++03 version
+
+template< class T, class A1 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1, A2 const & a2 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1, A2 const & a2 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1, A2 const & a2, A3 const & a3 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1, A2 const & a2, A3 const & a3 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5, class A6 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5, A6 const & a6 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5, a6 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5, class A6 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5, A6 const & a6 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5, a6 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5, A6 const & a6, A7 const & a7 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5, a6, a7 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5, A6 const & a6, A7 const & a7 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5, a6, a7 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5, A6 const & a6, A7 const & a7, A8 const & a8 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5, a6, a7, a8 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5, A6 const & a6, A7 const & a7, A8 const & a8 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5, a6, a7, a8 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9 >
+boost::local_shared_ptr< T > make_local_shared( A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5, A6 const & a6, A7 const & a7, A8 const & a8, A9 const & a9 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ) );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5, a6, a7, a8, a9 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+template< class T, class A, class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9 >
+boost::local_shared_ptr< T > allocate_local_shared( A const & a, A1 const & a1, A2 const & a2, A3 const & a3, A4 const & a4, A5 const & a5, A6 const & a6, A7 const & a7, A8 const & a8, A9 const & a9 )
+{
+    boost::shared_ptr< T > pt( static_cast< T* >( 0 ), BOOST_LSP_MSD( T ), a );
+
+    boost::detail::lsp_ms_deleter< T > * pd = boost::get_deleter< boost::detail::lsp_ms_deleter< T > >( pt );
+
+    void * pv = pd->address();
+
+    ::new( pv ) T( a1, a2, a3, a4, a5, a6, a7, a8, a9 );
+    pd->set_initialized();
+
+    T * pt2 = static_cast< T* >( pv );
+
+    boost::detail::sp_enable_shared_from_this( &pt, pt2, pt2 );
+    return boost::local_shared_ptr< T >( boost::detail::lsp_internal_constructor_tag(), pt2, pt, pd );
+}
+
+#endif
+
+#undef BOOST_LSP_MSD
+
+} // namespace boost
+
+#endif // #ifndef BOOST_SMART_PTR_MAKE_LOCAL_SHARED_HPP_INCLUDED
@@ -56,6 +56,7 @@ namespace boost
 
 template<class T> class shared_ptr;
 template<class T> class weak_ptr;
+template<class T> class local_shared_ptr;
 template<class T> class enable_shared_from_this;
 class enable_shared_from_raw;
 
@@ -457,6 +458,7 @@ private:
 
     template<class Y> friend class shared_ptr;
     template<class Y> friend class weak_ptr;
+    template<class Y> friend class local_shared_ptr;
 
 
 #endif
@@ -16,11 +16,14 @@
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/once.hpp>
 #include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/adaptive_mutex.hpp>
 #include <boost/thread/tss.hpp>
 #include <boost/thread/thread_time.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/scalable_shared_mutex.hpp>
 #include <boost/thread/barrier.hpp>
 #include <boost/thread/future.hpp>
+#include <boost/thread/thread_pool.hpp>
 
 #endif
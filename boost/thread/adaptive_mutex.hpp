@@ -0,0 +1,30 @@
+#ifndef BOOST_THREAD_ADAPTIVE_MUTEX_HPP
+#define BOOST_THREAD_ADAPTIVE_MUTEX_HPP
+
+//  adaptive_mutex.hpp
+//
+//  (C) Copyright 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/platform.hpp>
+#if defined(BOOST_THREAD_PLATFORM_PTHREAD)
+#include <boost/thread/pthread/futex.hpp>
+#endif
+
+#if defined(BOOST_THREAD_HAS_FUTEX)
+#include <boost/thread/pthread/adaptive_mutex.hpp>
+#else
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace boost
+{
+    typedef mutex adaptive_mutex;
+    typedef condition_variable adaptive_condition_variable;
+}
+#endif
+
+#endif
@@ -0,0 +1,244 @@
+#ifndef BOOST_THREAD_DETAIL_WORK_STEALING_DEQUE_HPP
+#define BOOST_THREAD_DETAIL_WORK_STEALING_DEQUE_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// (C) Copyright 2011 Anthony Williams
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/config.hpp>
+#include <boost/atomic.hpp>
+
+#if (BOOST_ATOMIC_LONG_LOCK_FREE!=2) || (BOOST_ATOMIC_POINTER_LOCK_FREE!=2)
+#define BOOST_THREAD_DETAIL_WORK_STEALING_USES_MUTEX
+#include <deque>
+#include <boost/thread/mutex.hpp>
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+    namespace detail
+    {
+#if !defined(BOOST_THREAD_DETAIL_WORK_STEALING_USES_MUTEX)
+
+        // A Chase-Lev work-stealing deque of pointers. The owning thread pushes
+        // and pops at the bottom without locking, while any number of other
+        // threads may steal from the top. Only the pointers are stored: the
+        // caller owns the objects.
+        template<typename T>
+        class work_stealing_deque
+        {
+        private:
+            struct circular_array
+            {
+                long const log_size;
+                boost::atomic<T*>* const items;
+                circular_array* const previous;
+
+                circular_array(long log_size_,circular_array* previous_):
+                    log_size(log_size_),items(new boost::atomic<T*>[1L<<log_size_]),previous(previous_)
+                {}
+
+                ~circular_array()
+                {
+                    delete[] items;
+                }
+
+                long size() const
+                {
+                    return 1L<<log_size;
+                }
+
+                T* get(long i) const
+                {
+                    return items[i&(size()-1)].load(boost::memory_order_relaxed);
+                }
+
+                void put(long i,T* value)
+                {
+                    items[i&(size()-1)].store(value,boost::memory_order_relaxed);
+                }
+
+                circular_array* grow(long bottom,long top)
+                {
+                    circular_array* const result=new circular_array(log_size+1,this);
+                    for(long i=top;i<bottom;++i)
+                    {
+                        result->put(i,get(i));
+                    }
+                    return result;
+                }
+            private:
+                circular_array(circular_array&);
+                void operator=(circular_array&);
+            };
+
+            // top is written by thieves and bottom by the owner, so keep them on
+            // separate cache lines.
+            boost::atomic<long> top;
+            char padding1[64-sizeof(boost::atomic<long>)];
+            boost::atomic<long> bottom;
+            boost::atomic<circular_array*> array;
+            char padding2[64-sizeof(boost::atomic<long>)-sizeof(boost::atomic<circular_array*>)];
+
+            work_stealing_deque(work_stealing_deque&);
+            void operator=(work_stealing_deque&);
+
+        public:
+            work_stealing_deque():
+                top(0),bottom(0),array(new circular_array(5,0))
+            {}
+
+            // Arrays that have been replaced by larger ones may still be read by
+            // a thief that loaded the old pointer, so they are kept until the
+            // deque is destroyed.
+            ~work_stealing_deque()
+            {
+                circular_array* a=array.load(boost::memory_order_relaxed);
+                while(a)
+                {
+                    circular_array* const previous=a->previous;
+                    delete a;
+                    a=previous;
+                }
+            }
+
+            // Called only by the owning thread.
+            void push(T* value)
+            {
+                long const b=bottom.load(boost::memory_order_relaxed);
+                long const t=top.load(boost::memory_order_acquire);
+                circular_array* a=array.load(boost::memory_order_relaxed);
+                if(b-t>a->size()-1)
+                {
+                    a=a->grow(b,t);
+                    array.store(a,boost::memory_order_release);
+                }
+                a->put(b,value);
+                bottom.store(b+1,boost::memory_order_release);
+            }
+
+            // Called only by the owning thread. Returns the most recently pushed
+            // pointer, or null if the deque is empty.
+            T* pop()
+            {
+                long const b=bottom.load(boost::memory_order_relaxed)-1;
+                circular_array* const a=array.load(boost::memory_order_relaxed);
+                bottom.store(b,boost::memory_order_relaxed);
+                // Either this thread sees a thief's increment of top, or
+                // the thief sees the decrement of bottom.
+                boost::atomic_thread_fence(boost::memory_order_seq_cst);
+                long t=top.load(boost::memory_order_relaxed);
+                if(t>b)
+                {
+                    bottom.store(b+1,boost::memory_order_relaxed);
+                    return 0;
+                }
+                T* value=a->get(b);
+                if(t==b)
+                {
+                    // The last item may be being stolen at the same time.
+                    if(!top.compare_exchange_strong(t,t+1,boost::memory_order_seq_cst,boost::memory_order_relaxed))
+                    {
+                        value=0;
+                    }
+                    bottom.store(b+1,boost::memory_order_relaxed);
+                }
+                return value;
+            }
+
+            // May be called by any thread. Returns the least recently pushed
+            // pointer, or null if the deque is empty or the steal lost a race
+            // with another thread.
+            T* steal()
+            {
+                long t=top.load(boost::memory_order_acquire);
+                boost::atomic_thread_fence(boost::memory_order_seq_cst);
+                long const b=bottom.load(boost::memory_order_acquire);
+                if(t>=b)
+                {
+                    return 0;
+                }
+                circular_array* const a=array.load(boost::memory_order_acquire);
+                T* const value=a->get(t);
+                if(!top.compare_exchange_strong(t,t+1,boost::memory_order_seq_cst,boost::memory_order_relaxed))
+                {
+                    return 0;
+                }
+                return value;
+            }
+
+            // May be called by any thread. The result may be out of date by the
+            // time it is returned.
+            bool empty() const
+            {
+                long const t=top.load(boost::memory_order_acquire);
+                long const b=bottom.load(boost::memory_order_acquire);
+                return b<=t;
+            }
+        };
+
+#else
+
+        // Without lock-free atomic operations, the deque is protected by a
+        // mutex.
+        template<typename T>
+        class work_stealing_deque
+        {
+        private:
+            mutable boost::mutex m;
+            std::deque<T*> items;
+
+            work_stealing_deque(work_stealing_deque&);
+            void operator=(work_stealing_deque&);
+
+        public:
+            work_stealing_deque()
+            {}
+
+            void push(T* value)
+            {
+                boost::lock_guard<boost::mutex> lk(m);
+                items.push_back(value);
+            }
+
+            T* pop()
+            {
+                boost::lock_guard<boost::mutex> lk(m);
+                if(items.empty())
+                {
+                    return 0;
+                }
+                T* const value=items.back();
+                items.pop_back();
+                return value;
+            }
+
+            T* steal()
+            {
+                boost::lock_guard<boost::mutex> lk(m);
+                if(items.empty())
+                {
+                    return 0;
+                }
+                T* const value=items.front();
+                items.pop_front();
+                return value;
+            }
+
+            bool empty() const
+            {
+                boost::lock_guard<boost::mutex> lk(m);
+                return items.empty();
+            }
+        };
+
+#endif
+    }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
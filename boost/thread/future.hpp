@@ -27,6 +27,8 @@
 #include <boost/utility/enable_if.hpp>
 #include <list>
 #include <boost/next_prior.hpp>
+#include <boost/utility/result_of.hpp>
+#include <iterator>
 #include <vector>
 
 namespace boost
@@ -98,6 +100,8 @@ namespace boost
             typedef std::list<boost::condition_variable_any*> waiter_list;
             waiter_list external_waiters;
             boost::function<void()> callback;
+            typedef std::vector<boost::function<void()> > continuation_list;
+            continuation_list continuations;
 
             future_object_base():
                 done(false)
@@ -118,6 +122,48 @@ namespace boost
                 external_waiters.erase(it);
             }
 
+            // Continuations are run by the thread that makes the future ready,
+            // after it has released the mutex, or immediately by the thread that
+            // adds them if the future is already ready.
+            void add_continuation(boost::function<void()> const& continuation)
+            {
+                {
+                    boost::unique_lock<boost::mutex> lock(mutex);
+                    do_callback(lock);
+                    if(!done)
+                    {
+                        continuations.push_back(continuation);
+                        return;
+                    }
+                }
+                continuation();
+            }
+
+            // Called with the mutex locked, after the future has been made
+            // ready.
+            void take_continuations(continuation_list& ready)
+            {
+                ready.swap(continuations);
+            }
+
+            // Called without the mutex locked. A continuation that throws must
+            // not prevent the others from being run, so exceptions are
+            // discarded: the continuations created by then(), when_all() and
+            // when_any() report their failures through their own futures.
+            static void run_continuations(continuation_list& ready)
+            {
+                for(continuation_list::size_type i=0;i<ready.size();++i)
+                {
+                    try
+                    {
+                        ready[i]();
+                    }
+                    catch(...)
+                    {
+                    }
+                }
+            }
+
             void mark_finished_internal()
             {
                 done=true;
@@ -193,8 +239,13 @@ namespace boost
             }
             void mark_exceptional_finish()
             {
-                boost::lock_guard<boost::mutex> lock(mutex);
-                mark_exceptional_finish_internal(boost::current_exception());
+                continuation_list ready;
+                {
+                    boost::lock_guard<boost::mutex> lock(mutex);
+                    mark_exceptional_finish_internal(boost::current_exception());
+                    take_continuations(ready);
+                }
+                run_continuations(ready);
             }
 
             bool has_value()
@@ -316,13 +367,23 @@ namespace boost
 
             void mark_finished_with_result(source_reference_type result_)
             {
-                boost::lock_guard<boost::mutex> lock(mutex);
-                mark_finished_with_result_internal(result_);
+                continuation_list ready;
+                {
+                    boost::lock_guard<boost::mutex> lock(mutex);
+                    mark_finished_with_result_internal(result_);
+                    take_continuations(ready);
+                }
+                run_continuations(ready);
             }
             void mark_finished_with_result(rvalue_source_type result_)
             {
-                boost::lock_guard<boost::mutex> lock(mutex);
-                mark_finished_with_result_internal(result_);
+                continuation_list ready;
+                {
+                    boost::lock_guard<boost::mutex> lock(mutex);
+                    mark_finished_with_result_internal(static_cast<rvalue_source_type>(result_));
+                    take_continuations(ready);
+                }
+                run_continuations(ready);
             }
 
             move_dest_type get()
@@ -363,8 +424,13 @@ namespace boost
 
             void mark_finished_with_result()
             {
-                boost::lock_guard<boost::mutex> lock(mutex);
-                mark_finished_with_result_internal();
+                continuation_list ready;
+                {
+                    boost::lock_guard<boost::mutex> lock(mutex);
+                    mark_finished_with_result_internal();
+                    take_continuations(ready);
+                }
+                run_continuations(ready);
             }
 
             void get()
@@ -613,6 +679,17 @@ namespace boost
     template <typename R>
     class packaged_task;
 
+    namespace detail
+    {
+        class future_access;
+
+        template<typename R,typename Future,typename F>
+        struct future_continuation_call;
+
+        template<typename Executor,typename R>
+        void submit_continuation(Executor* executor,boost::shared_ptr<packaged_task<R> > const& task);
+    }
+
     template <typename R>
     class unique_future
     {
@@ -627,6 +704,7 @@ namespace boost
         friend class promise<R>;
         friend class packaged_task<R>;
         friend class detail::future_waiter;
+        friend class detail::future_access;
 
         typedef typename detail::future_traits<R>::move_dest_type move_dest_type;
 
@@ -739,7 +817,50 @@ namespace boost
             }
             return future->timed_wait_until(abs_time);
         }
-        
+
+        // continuations
+        template<typename F>
+        unique_future<typename boost::result_of<F(unique_future&)>::type> then(F f)
+        {
+            typedef typename boost::result_of<F(unique_future&)>::type result_type;
+            boost::shared_ptr<packaged_task<result_type> > task(make_continuation_task<result_type>(f));
+            unique_future<result_type> result(task->get_future());
+            future_ptr parent;
+            parent.swap(future);
+            parent->add_continuation(boost::bind(&packaged_task<result_type>::operator(),task));
+#ifndef BOOST_NO_RVALUE_REFERENCES
+            return static_cast<unique_future<result_type>&&>(result);
+#else
+            return unique_future<result_type>(boost::move(result));
+#endif
+        }
+
+        template<typename Executor,typename F>
+        unique_future<typename boost::result_of<F(unique_future&)>::type> then(Executor& executor,F f)
+        {
+            typedef typename boost::result_of<F(unique_future&)>::type result_type;
+            boost::shared_ptr<packaged_task<result_type> > task(make_continuation_task<result_type>(f));
+            unique_future<result_type> result(task->get_future());
+            future_ptr parent;
+            parent.swap(future);
+            parent->add_continuation(boost::bind(&detail::submit_continuation<Executor,result_type>,&executor,task));
+#ifndef BOOST_NO_RVALUE_REFERENCES
+            return static_cast<unique_future<result_type>&&>(result);
+#else
+            return unique_future<result_type>(boost::move(result));
+#endif
+        }
+
+    private:
+        template<typename Result,typename F>
+        packaged_task<Result>* make_continuation_task(F const& f)
+        {
+            if(!future)
+            {
+                boost::throw_exception(future_uninitialized());
+            }
+            return new packaged_task<Result>(detail::future_continuation_call<R,unique_future,F>(future,f));
+        }
     };
 
     template <typename R>
@@ -755,6 +876,7 @@ namespace boost
         friend class detail::future_waiter;
         friend class promise<R>;
         friend class packaged_task<R>;
+        friend class detail::future_access;
         
         shared_future(future_ptr future_):
             future(future_)
@@ -896,7 +1018,46 @@ namespace boost
             }
             return future->timed_wait_until(abs_time);
         }
-        
+
+        // continuations
+        template<typename F>
+        unique_future<typename boost::result_of<F(shared_future&)>::type> then(F f) const
+        {
+            typedef typename boost::result_of<F(shared_future&)>::type result_type;
+            boost::shared_ptr<packaged_task<result_type> > task(make_continuation_task<result_type>(f));
+            unique_future<result_type> result(task->get_future());
+            future->add_continuation(boost::bind(&packaged_task<result_type>::operator(),task));
+#ifndef BOOST_NO_RVALUE_REFERENCES
+            return static_cast<unique_future<result_type>&&>(result);
+#else
+            return unique_future<result_type>(boost::move(result));
+#endif
+        }
+
+        template<typename Executor,typename F>
+        unique_future<typename boost::result_of<F(shared_future&)>::type> then(Executor& executor,F f) const
+        {
+            typedef typename boost::result_of<F(shared_future&)>::type result_type;
+            boost::shared_ptr<packaged_task<result_type> > task(make_continuation_task<result_type>(f));
+            unique_future<result_type> result(task->get_future());
+            future->add_continuation(boost::bind(&detail::submit_continuation<Executor,result_type>,&executor,task));
+#ifndef BOOST_NO_RVALUE_REFERENCES
+            return static_cast<unique_future<result_type>&&>(result);
+#else
+            return unique_future<result_type>(boost::move(result));
+#endif
+        }
+
+    private:
+        template<typename Result,typename F>
+        packaged_task<Result>* make_continuation_task(F const& f) const
+        {
+            if(!future)
+            {
+                boost::throw_exception(future_uninitialized());
+            }
+            return new packaged_task<Result>(detail::future_continuation_call<R,shared_future,F>(future,f));
+        }
     };
 
     template <typename R>
@@ -930,12 +1091,17 @@ namespace boost
         {
             if(future)
             {
-                boost::lock_guard<boost::mutex> lock(future->mutex);
-
-                if(!future->done)
+                detail::future_object_base::continuation_list ready;
                 {
-                    future->mark_exceptional_finish_internal(boost::copy_exception(broken_promise()));
+                    boost::lock_guard<boost::mutex> lock(future->mutex);
+
+                    if(!future->done)
+                    {
+                        future->mark_exceptional_finish_internal(boost::copy_exception(broken_promise()));
+                        future->take_continuations(ready);
+                    }
                 }
+                detail::future_object_base::run_continuations(ready);
             }
         }
 
@@ -998,35 +1164,50 @@ namespace boost
         void set_value(typename detail::future_traits<R>::source_reference_type r)
         {
             lazy_init();
-            boost::lock_guard<boost::mutex> lock(future->mutex);
-            if(future->done)
+            detail::future_object_base::continuation_list ready;
             {
-                boost::throw_exception(promise_already_satisfied());
+                boost::lock_guard<boost::mutex> lock(future->mutex);
+                if(future->done)
+                {
+                    boost::throw_exception(promise_already_satisfied());
+                }
+                future->mark_finished_with_result_internal(r);
+                future->take_continuations(ready);
             }
-            future->mark_finished_with_result_internal(r);
+            detail::future_object_base::run_continuations(ready);
         }
 
 //         void set_value(R && r);
         void set_value(typename detail::future_traits<R>::rvalue_source_type r)
         {
             lazy_init();
-            boost::lock_guard<boost::mutex> lock(future->mutex);
-            if(future->done)
+            detail::future_object_base::continuation_list ready;
             {
-                boost::throw_exception(promise_already_satisfied());
+                boost::lock_guard<boost::mutex> lock(future->mutex);
+                if(future->done)
+                {
+                    boost::throw_exception(promise_already_satisfied());
+                }
+                future->mark_finished_with_result_internal(static_cast<typename detail::future_traits<R>::rvalue_source_type>(r));
+                future->take_continuations(ready);
             }
-            future->mark_finished_with_result_internal(static_cast<typename detail::future_traits<R>::rvalue_source_type>(r));
+            detail::future_object_base::run_continuations(ready);
         }
 
         void set_exception(boost::exception_ptr p)
         {
             lazy_init();
-            boost::lock_guard<boost::mutex> lock(future->mutex);
-            if(future->done)
+            detail::future_object_base::continuation_list ready;
             {
-                boost::throw_exception(promise_already_satisfied());
+                boost::lock_guard<boost::mutex> lock(future->mutex);
+                if(future->done)
+                {
+                    boost::throw_exception(promise_already_satisfied());
+                }
+                future->mark_exceptional_finish_internal(p);
+                future->take_continuations(ready);
             }
-            future->mark_exceptional_finish_internal(p);
+            detail::future_object_base::run_continuations(ready);
         }
 
         template<typename F>
@@ -1068,12 +1249,17 @@ namespace boost
         {
             if(future)
             {
-                boost::lock_guard<boost::mutex> lock(future->mutex);
-
-                if(!future->done)
+                detail::future_object_base::continuation_list ready;
                 {
-                    future->mark_exceptional_finish_internal(boost::copy_exception(broken_promise()));
+                    boost::lock_guard<boost::mutex> lock(future->mutex);
+
+                    if(!future->done)
+                    {
+                        future->mark_exceptional_finish_internal(boost::copy_exception(broken_promise()));
+                        future->take_continuations(ready);
+                    }
                 }
+                detail::future_object_base::run_continuations(ready);
             }
         }
 
@@ -1137,23 +1323,33 @@ namespace boost
         void set_value()
         {
             lazy_init();
-            boost::lock_guard<boost::mutex> lock(future->mutex);
-            if(future->done)
+            detail::future_object_base::continuation_list ready;
             {
-                boost::throw_exception(promise_already_satisfied());
+                boost::lock_guard<boost::mutex> lock(future->mutex);
+                if(future->done)
+                {
+                    boost::throw_exception(promise_already_satisfied());
+                }
+                future->mark_finished_with_result_internal();
+                future->take_continuations(ready);
             }
-            future->mark_finished_with_result_internal();
+            detail::future_object_base::run_continuations(ready);
         }
 
         void set_exception(boost::exception_ptr p)
         {
             lazy_init();
-            boost::lock_guard<boost::mutex> lock(future->mutex);
-            if(future->done)
+            detail::future_object_base::continuation_list ready;
             {
-                boost::throw_exception(promise_already_satisfied());
+                boost::lock_guard<boost::mutex> lock(future->mutex);
+                if(future->done)
+                {
+                    boost::throw_exception(promise_already_satisfied());
+                }
+                future->mark_exceptional_finish_internal(p);
+                future->take_continuations(ready);
             }
-            future->mark_exceptional_finish_internal(p);
+            detail::future_object_base::run_continuations(ready);
         }
 
         template<typename F>
@@ -1192,12 +1388,17 @@ namespace boost
 
             void owner_destroyed()
             {
-                boost::lock_guard<boost::mutex> lk(this->mutex);
-                if(!started)
+                detail::future_object_base::continuation_list ready;
                 {
-                    started=true;
-                    this->mark_exceptional_finish_internal(boost::copy_exception(boost::broken_promise()));
+                    boost::lock_guard<boost::mutex> lk(this->mutex);
+                    if(!started)
+                    {
+                        started=true;
+                        this->mark_exceptional_finish_internal(boost::copy_exception(boost::broken_promise()));
+                        this->take_continuations(ready);
+                    }
                 }
+                this->run_continuations(ready);
             }
             
             
@@ -1377,6 +1578,244 @@ namespace boost
         
     };
 
+    template<typename Sequence>
+    struct when_any_result
+    {
+        std::size_t index;
+        Sequence futures;
+
+        when_any_result():
+            index(static_cast<std::size_t>(-1))
+        {}
+    };
+
+    namespace detail
+    {
+        class future_access
+        {
+        public:
+            template<typename Future>
+            static typename Future::future_ptr const& get(Future const& f)
+            {
+                return f.future;
+            }
+
+            template<typename Future,typename Ptr>
+            static void attach(Future& f,Ptr const& p)
+            {
+                f.future=p;
+            }
+
+            template<typename Future>
+            static void reset(Future& f)
+            {
+                f.future.reset();
+            }
+        };
+
+        template<typename R,typename Future,typename F>
+        struct future_continuation_call
+        {
+            boost::shared_ptr<future_object<R> > parent;
+            F f;
+
+            future_continuation_call(boost::shared_ptr<future_object<R> > const& parent_,F const& f_):
+                parent(parent_),f(f_)
+            {}
+
+            typename boost::result_of<F(Future&)>::type operator()()
+            {
+                Future ready;
+                future_access::attach(ready,parent);
+                parent.reset();
+                return f(ready);
+            }
+        };
+
+        template<typename R>
+        struct continuation_task
+        {
+            typedef void result_type;
+
+            boost::shared_ptr<packaged_task<R> > task;
+
+            explicit continuation_task(boost::shared_ptr<packaged_task<R> > const& task_):
+                task(task_)
+            {}
+
+            void operator()()
+            {
+                (*task)();
+            }
+        };
+
+        template<typename Executor,typename R>
+        void submit_continuation(Executor* executor,boost::shared_ptr<packaged_task<R> > const& task)
+        {
+            executor->submit(continuation_task<R>(task));
+        }
+
+        template<typename Future>
+        struct future_value;
+
+        template<typename R>
+        struct future_value<unique_future<R> >
+        {
+            typedef R type;
+        };
+
+        template<typename R>
+        struct future_value<shared_future<R> >
+        {
+            typedef R type;
+        };
+
+        template<typename R>
+        void share_future(shared_future<R>& target,unique_future<R>& source)
+        {
+            future_access::attach(target,future_access::get(source));
+            future_access::reset(source);
+        }
+
+        template<typename R>
+        void share_future(shared_future<R>& target,shared_future<R> const& source)
+        {
+            future_access::attach(target,future_access::get(source));
+        }
+
+        template<typename R>
+        struct when_all_state
+        {
+            boost::mutex mutex;
+            std::size_t remaining;
+            std::vector<shared_future<R> > futures;
+            promise<std::vector<shared_future<R> > > result;
+
+            void future_ready()
+            {
+                {
+                    boost::lock_guard<boost::mutex> lk(mutex);
+                    if(--remaining)
+                    {
+                        return;
+                    }
+                }
+                result.set_value(futures);
+            }
+        };
+
+        // Until one of the futures is ready, each future that is not ready
+        // holds a reference to the state, which holds a reference to the
+        // future. When the first future is ready, the futures and the result
+        // promise are moved out of the state before the result is set, so
+        // the futures that are still pending refer only to an empty state
+        // and the result does not keep them alive through it.
+        template<typename R>
+        struct when_any_state
+        {
+            boost::mutex mutex;
+            bool done;
+            std::vector<shared_future<R> > futures;
+            promise<when_any_result<std::vector<shared_future<R> > > > result;
+
+            when_any_state():
+                done(false)
+            {}
+
+            void future_ready(std::size_t index)
+            {
+                when_any_result<std::vector<shared_future<R> > > ready;
+                promise<when_any_result<std::vector<shared_future<R> > > > ready_result;
+                {
+                    boost::lock_guard<boost::mutex> lk(mutex);
+                    if(done)
+                    {
+                        return;
+                    }
+                    done=true;
+                    ready.index=index;
+                    ready.futures.swap(futures);
+                    ready_result.swap(result);
+                }
+                ready_result.set_value(ready);
+            }
+        };
+
+        template<typename R,typename Iterator>
+        std::vector<boost::shared_ptr<future_object<R> > > share_futures(
+            std::vector<shared_future<R> >& futures,Iterator begin,Iterator end)
+        {
+            for(Iterator current=begin;current!=end;++current)
+            {
+                if(current->get_state()==future_state::uninitialized)
+                {
+                    boost::throw_exception(future_uninitialized());
+                }
+            }
+            std::vector<boost::shared_ptr<future_object<R> > > objects;
+            for(Iterator current=begin;current!=end;++current)
+            {
+                futures.push_back(shared_future<R>());
+                share_future(futures.back(),*current);
+                objects.push_back(future_access::get(futures.back()));
+            }
+            return objects;
+        }
+    }
+
+    template<typename Iterator>
+    unique_future<std::vector<shared_future<typename detail::future_value<typename std::iterator_traits<Iterator>::value_type>::type> > >
+    when_all(Iterator begin,Iterator end)
+    {
+        typedef typename detail::future_value<typename std::iterator_traits<Iterator>::value_type>::type value_type;
+        typedef std::vector<shared_future<value_type> > sequence_type;
+
+        boost::shared_ptr<detail::when_all_state<value_type> > state(new detail::when_all_state<value_type>);
+        unique_future<sequence_type> result(state->result.get_future());
+        std::vector<boost::shared_ptr<detail::future_object<value_type> > > const objects=
+            detail::share_futures(state->futures,begin,end);
+        state->remaining=objects.size();
+        if(objects.empty())
+        {
+            state->result.set_value(state->futures);
+        }
+        for(std::size_t i=0;i<objects.size();++i)
+        {
+            objects[i]->add_continuation(boost::bind(&detail::when_all_state<value_type>::future_ready,state));
+        }
+#ifndef BOOST_NO_RVALUE_REFERENCES
+        return static_cast<unique_future<sequence_type>&&>(result);
+#else
+        return unique_future<sequence_type>(boost::move(result));
+#endif
+    }
+
+    template<typename Iterator>
+    unique_future<when_any_result<std::vector<shared_future<typename detail::future_value<typename std::iterator_traits<Iterator>::value_type>::type> > > >
+    when_any(Iterator begin,Iterator end)
+    {
+        typedef typename detail::future_value<typename std::iterator_traits<Iterator>::value_type>::type value_type;
+        typedef when_any_result<std::vector<shared_future<value_type> > > result_type;
+
+        boost::shared_ptr<detail::when_any_state<value_type> > state(new detail::when_any_state<value_type>);
+        unique_future<result_type> result(state->result.get_future());
+        std::vector<boost::shared_ptr<detail::future_object<value_type> > > const objects=
+            detail::share_futures(state->futures,begin,end);
+        if(objects.empty())
+        {
+            state->result.set_value(result_type());
+        }
+        for(std::size_t i=0;i<objects.size();++i)
+        {
+            objects[i]->add_continuation(boost::bind(&detail::when_any_state<value_type>::future_ready,state,i));
+        }
+#ifndef BOOST_NO_RVALUE_REFERENCES
+        return static_cast<unique_future<result_type>&&>(result);
+#else
+        return unique_future<result_type>(boost::move(result));
+#endif
+    }
+
 }
 
 
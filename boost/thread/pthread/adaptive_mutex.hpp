@@ -0,0 +1,252 @@
+#ifndef BOOST_THREAD_PTHREAD_ADAPTIVE_MUTEX_HPP
+#define BOOST_THREAD_PTHREAD_ADAPTIVE_MUTEX_HPP
+// (C) Copyright 2011 Anthony Williams
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/pthread/futex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <boost/thread/xtime.hpp>
+#include <boost/thread/detail/thread_interruption.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+    class adaptive_condition_variable;
+
+    // A mutex that spins briefly before sleeping on a futex. The state is
+    // 0 when unlocked, 1 when locked and 2 when locked and there may be
+    // threads sleeping on the futex, which unlock() must then wake.
+    class adaptive_mutex
+    {
+    private:
+        adaptive_mutex(adaptive_mutex const&);
+        adaptive_mutex& operator=(adaptive_mutex const&);
+
+        friend class adaptive_condition_variable;
+
+        static int const max_spin_count=100;
+        static unsigned const max_pause_count=16;
+
+        int volatile state;
+        int volatile spin_estimate;
+
+        static void pause()
+        {
+#if defined(BOOST_SMT_PAUSE)
+            BOOST_SMT_PAUSE
+#else
+            __asm__ __volatile__("" ::: "memory");
+#endif
+        }
+
+        // Spins for up to about twice as long as recent acquisitions have
+        // needed, doubling the delay between attempts each time.
+        bool spin()
+        {
+            int const limit=spin_estimate*2+10<max_spin_count?spin_estimate*2+10:max_spin_count;
+            unsigned pauses=1;
+            for(int k=0;k<limit;++k)
+            {
+                if(!state && !__sync_val_compare_and_swap(&state,0,1))
+                {
+                    spin_estimate+=(k-spin_estimate)/8;
+                    return true;
+                }
+                for(unsigned i=0;i<pauses;++i)
+                {
+                    pause();
+                }
+                if(pauses<max_pause_count)
+                {
+                    pauses*=2;
+                }
+            }
+            spin_estimate+=(limit-spin_estimate)/8;
+            return false;
+        }
+
+        bool lock_contended(boost::system_time const* timeout)
+        {
+            while(__sync_lock_test_and_set(&state,2))
+            {
+                if(!detail::futex_wait(&state,2,timeout))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    public:
+        adaptive_mutex():
+            state(0),spin_estimate(0)
+        {}
+
+        ~adaptive_mutex()
+        {}
+
+        void lock()
+        {
+            if(!try_lock() && !spin())
+            {
+                lock_contended(0);
+            }
+        }
+
+        bool try_lock()
+        {
+            return !__sync_val_compare_and_swap(&state,0,1);
+        }
+
+        bool timed_lock(boost::system_time const& abs_time)
+        {
+            return try_lock() || spin() || lock_contended(&abs_time);
+        }
+
+        template<typename TimeDuration>
+        bool timed_lock(TimeDuration const & relative_time)
+        {
+            return timed_lock(get_system_time()+relative_time);
+        }
+
+        bool timed_lock(boost::xtime const & absolute_time)
+        {
+            return timed_lock(system_time(absolute_time));
+        }
+
+        void unlock()
+        {
+            if(__sync_fetch_and_sub(&state,1)!=1)
+            {
+                state=0;
+                detail::futex_wake(&state,1);
+            }
+        }
+
+        typedef unique_lock<adaptive_mutex> scoped_lock;
+        typedef detail::try_lock_wrapper<adaptive_mutex> scoped_try_lock;
+        typedef scoped_lock scoped_timed_lock;
+    };
+
+    // A condition variable for use with adaptive_mutex. notify_all() wakes
+    // one waiter and moves the others onto the mutex's futex, so they are
+    // woken one at a time as the mutex is released.
+    class adaptive_condition_variable
+    {
+    private:
+        adaptive_condition_variable(adaptive_condition_variable&);
+        adaptive_condition_variable& operator=(adaptive_condition_variable&);
+
+        int volatile sequence;
+        int volatile waiters;
+        adaptive_mutex* volatile waiters_mutex;
+
+        bool do_wait(unique_lock<adaptive_mutex>& m,boost::system_time const* timeout)
+        {
+            this_thread::interruption_point();
+            adaptive_mutex* const mutex=m.mutex();
+            waiters_mutex=mutex;
+            __sync_fetch_and_add(&waiters,1);
+            int const seq=sequence;
+            mutex->unlock();
+            bool const woken=detail::futex_wait(&sequence,seq,timeout);
+            __sync_fetch_and_sub(&waiters,1);
+            // Threads moved onto the mutex's futex by notify_all() are only
+            // woken if the mutex is marked as having sleepers.
+            mutex->lock_contended(0);
+            this_thread::interruption_point();
+            return woken;
+        }
+
+    public:
+        adaptive_condition_variable():
+            sequence(0),waiters(0),waiters_mutex(0)
+        {}
+
+        ~adaptive_condition_variable()
+        {}
+
+        void wait(unique_lock<adaptive_mutex>& m)
+        {
+            do_wait(m,0);
+        }
+
+        template<typename predicate_type>
+        void wait(unique_lock<adaptive_mutex>& m,predicate_type pred)
+        {
+            while(!pred()) wait(m);
+        }
+
+        bool timed_wait(unique_lock<adaptive_mutex>& m,boost::system_time const& wait_until)
+        {
+            return do_wait(m,&wait_until);
+        }
+
+        bool timed_wait(unique_lock<adaptive_mutex>& m,xtime const& wait_until)
+        {
+            return timed_wait(m,system_time(wait_until));
+        }
+
+        template<typename duration_type>
+        bool timed_wait(unique_lock<adaptive_mutex>& m,duration_type const& wait_duration)
+        {
+            return timed_wait(m,get_system_time()+wait_duration);
+        }
+
+        template<typename predicate_type>
+        bool timed_wait(unique_lock<adaptive_mutex>& m,boost::system_time const& wait_until,predicate_type pred)
+        {
+            while (!pred())
+            {
+                if(!timed_wait(m, wait_until))
+                    return pred();
+            }
+            return true;
+        }
+
+        template<typename predicate_type>
+        bool timed_wait(unique_lock<adaptive_mutex>& m,xtime const& wait_until,predicate_type pred)
+        {
+            return timed_wait(m,system_time(wait_until),pred);
+        }
+
+        template<typename duration_type,typename predicate_type>
+        bool timed_wait(unique_lock<adaptive_mutex>& m,duration_type const& wait_duration,predicate_type pred)
+        {
+            return timed_wait(m,get_system_time()+wait_duration,pred);
+        }
+
+        void notify_one()
+        {
+            __sync_fetch_and_add(&sequence,1);
+            if(waiters)
+            {
+                detail::futex_wake(&sequence,1);
+            }
+        }
+
+        void notify_all()
+        {
+            int seq=__sync_add_and_fetch(&sequence,1);
+            if(!waiters)
+            {
+                return;
+            }
+            adaptive_mutex* const mutex=waiters_mutex;
+            while(!detail::futex_requeue(&sequence,seq,&mutex->state))
+            {
+                seq=sequence;
+            }
+        }
+    };
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
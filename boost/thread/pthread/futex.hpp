@@ -0,0 +1,74 @@
+#ifndef BOOST_THREAD_PTHREAD_FUTEX_HPP
+#define BOOST_THREAD_PTHREAD_FUTEX_HPP
+// (C) Copyright 2011 Anthony Williams
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#if defined(__linux__) && defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 1)))
+#define BOOST_THREAD_HAS_FUTEX
+#endif
+
+#ifdef BOOST_THREAD_HAS_FUTEX
+
+#include <boost/thread/thread_time.hpp>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <limits.h>
+
+#ifdef FUTEX_PRIVATE_FLAG
+#define BOOST_THREAD_FUTEX_OP(op) ((op)|FUTEX_PRIVATE_FLAG)
+#else
+#define BOOST_THREAD_FUTEX_OP(op) (op)
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+    namespace detail
+    {
+        // Blocks while *addr==expected, until woken or until timeout has
+        // passed. Returns false only if the timeout expired.
+        inline bool futex_wait(int volatile* addr,int expected,boost::system_time const* timeout=0)
+        {
+            struct timespec relative={0,0};
+            if(timeout)
+            {
+                boost::posix_time::time_duration const remaining=*timeout-get_system_time();
+                if(remaining.is_negative() || !remaining.ticks())
+                {
+                    return false;
+                }
+                relative.tv_sec=remaining.total_seconds();
+                relative.tv_nsec=(long)(remaining.fractional_seconds()*(1000000000l/remaining.ticks_per_second()));
+            }
+            int const res=syscall(SYS_futex,addr,BOOST_THREAD_FUTEX_OP(FUTEX_WAIT),expected,timeout?&relative:0,0,0);
+            return !res || errno!=ETIMEDOUT;
+        }
+
+        inline void futex_wake(int volatile* addr,int count)
+        {
+            syscall(SYS_futex,addr,BOOST_THREAD_FUTEX_OP(FUTEX_WAKE),count,0,0,0);
+        }
+
+        // Wakes one thread waiting on addr and moves the rest to wait on
+        // target instead, provided *addr is still expected. Returns false
+        // if *addr has changed.
+        inline bool futex_requeue(int volatile* addr,int expected,int volatile* target)
+        {
+            int const res=syscall(SYS_futex,addr,BOOST_THREAD_FUTEX_OP(FUTEX_CMP_REQUEUE),1,
+                                  reinterpret_cast<struct timespec const*>(static_cast<long>(INT_MAX)),target,expected);
+            return res>=0 || errno!=EAGAIN;
+        }
+    }
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
+
+#endif
@@ -14,7 +14,8 @@
 #include <pthread.h>
 #include <boost/assert.hpp>
 #include "condition_variable_fwd.hpp"
-#include <map>
+#include <vector>
+#include <cstddef>
 
 #include <boost/config/abi_prefix.hpp>
 
@@ -30,10 +31,11 @@ namespace boost
         {
             boost::shared_ptr<boost::detail::tss_cleanup_function> func;
             void* value;
+            // the generation of the key the value was set for, or zero
+            std::size_t generation;
 
-            tss_data_node(boost::shared_ptr<boost::detail::tss_cleanup_function> func_,
-                          void* value_):
-                func(func_),value(value_)
+            tss_data_node():
+                value(0),generation(0)
             {}
         };
 
@@ -53,7 +55,8 @@ namespace boost
             bool join_started;
             bool joined;
             boost::detail::thread_exit_callback_node* thread_exit_callbacks;
-            std::map<void const*,boost::detail::tss_data_node> tss_data;
+            std::vector<boost::detail::tss_data_node> tss_data;
+            std::vector<boost::detail::tss_data_node> orphaned_tss_data;
             bool interrupt_enabled;
             bool interrupt_requested;
             pthread_mutex_t* cond_mutex;
@@ -0,0 +1,441 @@
+#ifndef BOOST_THREAD_SCALABLE_SHARED_MUTEX_HPP
+#define BOOST_THREAD_SCALABLE_SHARED_MUTEX_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// (C) Copyright 2011 Anthony Williams
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/platform.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <boost/thread/detail/thread_interruption.hpp>
+#include <boost/detail/atomic_count.hpp>
+#include <cstddef>
+
+#if defined(BOOST_THREAD_PLATFORM_WIN32)
+#include <boost/thread/win32/thread_primitives.hpp>
+#else
+#include <pthread.h>
+#endif
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+    namespace detail
+    {
+        // A cheap hash that is stable for the lifetime of the calling thread.
+        inline std::size_t current_thread_hash()
+        {
+#if defined(BOOST_THREAD_PLATFORM_WIN32)
+            std::size_t const h=win32::GetCurrentThreadId();
+#else
+            pthread_t const self=pthread_self();
+            unsigned char const* const bytes=reinterpret_cast<unsigned char const*>(&self);
+            std::size_t h=2166136261U;
+            for(std::size_t i=0;i<sizeof(self);++i)
+            {
+                h=(h^bytes[i])*16777619U;
+            }
+#endif
+            return h^(h>>16);
+        }
+    }
+
+    class scalable_shared_mutex
+    {
+    public:
+        enum preference
+        {
+            prefer_writers,
+            prefer_readers
+        };
+
+    private:
+        scalable_shared_mutex(scalable_shared_mutex&);
+        scalable_shared_mutex& operator=(scalable_shared_mutex&);
+
+        static std::size_t const slot_count=64;
+        static std::size_t const cache_line_size=64;
+
+        // Each reader increments the slot chosen by its thread, so readers
+        // on different threads rarely write to the same cache line.
+        struct reader_slot
+        {
+            detail::atomic_count readers;
+            char padding[sizeof(detail::atomic_count)<cache_line_size?cache_line_size-sizeof(detail::atomic_count):1];
+
+            reader_slot():
+                readers(0)
+            {}
+        };
+
+        // writer_waiting asks readers to notify drain_cond as they leave;
+        // writer_blocking also stops new readers from entering.
+        enum writer_states
+        {
+            no_writer,
+            writer_waiting,
+            writer_blocking
+        };
+
+        reader_slot slots[slot_count];
+        detail::atomic_count writer_state;
+        preference const readers_or_writers;
+
+        boost::mutex state_change;
+        bool exclusive;
+        bool upgrade;
+        boost::condition_variable shared_cond;
+        boost::condition_variable exclusive_cond;
+        boost::condition_variable drain_cond;
+
+        reader_slot& current_slot()
+        {
+            return slots[detail::current_thread_hash()%slot_count];
+        }
+
+        // Only called with state_change locked. The increments and
+        // decrements are full memory barriers, which the handshake with
+        // try_enter() relies on.
+        void set_writer_state(long new_state)
+        {
+            while(writer_state<new_state)
+            {
+                ++writer_state;
+            }
+            while(writer_state>new_state)
+            {
+                --writer_state;
+            }
+        }
+
+        bool try_enter(reader_slot& slot)
+        {
+            ++slot.readers;
+            if(writer_state!=writer_blocking)
+            {
+                return true;
+            }
+            leave(slot);
+            return false;
+        }
+
+        void leave(reader_slot& slot)
+        {
+            --slot.readers;
+            if(writer_state!=no_writer)
+            {
+                boost::lock_guard<boost::mutex> lk(state_change);
+                drain_cond.notify_one();
+            }
+        }
+
+        // A shared lock may be released by a thread other than the one
+        // that acquired it, which leaves one slot above zero and another
+        // below, so it is the total that counts. Only a reader that enters
+        // and leaves during the scan could make the total too low, and
+        // none can while writer_blocking is set, which is how every
+        // decision to let a writer in is made.
+        bool no_readers()
+        {
+            long total=0;
+            for(std::size_t i=0;i<slot_count;++i)
+            {
+                total+=slots[i].readers;
+            }
+            return !total;
+        }
+
+        bool wait_for_no_readers(boost::unique_lock<boost::mutex>& lk,system_time const* timeout)
+        {
+            while(!no_readers())
+            {
+                if(!timeout)
+                {
+                    drain_cond.wait(lk);
+                }
+                else if(!drain_cond.timed_wait(lk,*timeout))
+                {
+                    return no_readers();
+                }
+            }
+            return true;
+        }
+
+        // Called with state_change locked and exclusive set. Waits until all
+        // readers have left while keeping new readers out.
+        bool exclude_readers(boost::unique_lock<boost::mutex>& lk,system_time const* timeout)
+        {
+            if(readers_or_writers==prefer_writers)
+            {
+                set_writer_state(writer_blocking);
+                return wait_for_no_readers(lk,timeout);
+            }
+            // New readers may enter until the writer has seen the count
+            // drop to zero, and only then are they kept out. If a reader
+            // got in first, they are let in again and the writer retries.
+            for(;;)
+            {
+                set_writer_state(writer_waiting);
+                if(!wait_for_no_readers(lk,timeout))
+                {
+                    return false;
+                }
+                set_writer_state(writer_blocking);
+                if(no_readers())
+                {
+                    return true;
+                }
+                set_writer_state(writer_waiting);
+                shared_cond.notify_all();
+            }
+        }
+
+        void release_waiters()
+        {
+            exclusive_cond.notify_all();
+            shared_cond.notify_all();
+        }
+
+        void abandon_exclusive()
+        {
+            exclusive=false;
+            set_writer_state(no_writer);
+            release_waiters();
+        }
+
+    public:
+        explicit scalable_shared_mutex(preference readers_or_writers_=prefer_writers):
+            writer_state(no_writer),readers_or_writers(readers_or_writers_),exclusive(false),upgrade(false)
+        {}
+
+        ~scalable_shared_mutex()
+        {
+        }
+
+        void lock_shared()
+        {
+            reader_slot& slot=current_slot();
+            if(try_enter(slot))
+            {
+                return;
+            }
+            boost::this_thread::disable_interruption do_not_disturb;
+            do
+            {
+                boost::mutex::scoped_lock lk(state_change);
+                while(writer_state==writer_blocking)
+                {
+                    shared_cond.wait(lk);
+                }
+            }
+            while(!try_enter(slot));
+        }
+
+        bool try_lock_shared()
+        {
+            return try_enter(current_slot());
+        }
+
+        bool timed_lock_shared(system_time const& timeout)
+        {
+            reader_slot& slot=current_slot();
+            if(try_enter(slot))
+            {
+                return true;
+            }
+            boost::this_thread::disable_interruption do_not_disturb;
+            do
+            {
+                boost::mutex::scoped_lock lk(state_change);
+                while(writer_state==writer_blocking)
+                {
+                    if(!shared_cond.timed_wait(lk,timeout))
+                    {
+                        if(writer_state==writer_blocking)
+                        {
+                            return false;
+                        }
+                        break;
+                    }
+                }
+            }
+            while(!try_enter(slot));
+            return true;
+        }
+
+        template<typename TimeDuration>
+        bool timed_lock_shared(TimeDuration const & relative_time)
+        {
+            return timed_lock_shared(get_system_time()+relative_time);
+        }
+
+        void unlock_shared()
+        {
+            leave(current_slot());
+        }
+
+        void lock()
+        {
+            boost::this_thread::disable_interruption do_not_disturb;
+            boost::mutex::scoped_lock lk(state_change);
+            while(exclusive || upgrade)
+            {
+                exclusive_cond.wait(lk);
+            }
+            exclusive=true;
+            exclude_readers(lk,0);
+        }
+
+        bool timed_lock(system_time const& timeout)
+        {
+            boost::this_thread::disable_interruption do_not_disturb;
+            boost::mutex::scoped_lock lk(state_change);
+            while(exclusive || upgrade)
+            {
+                if(!exclusive_cond.timed_wait(lk,timeout))
+                {
+                    if(exclusive || upgrade)
+                    {
+                        return false;
+                    }
+                    break;
+                }
+            }
+            exclusive=true;
+            if(!exclude_readers(lk,&timeout))
+            {
+                abandon_exclusive();
+                return false;
+            }
+            return true;
+        }
+
+        template<typename TimeDuration>
+        bool timed_lock(TimeDuration const & relative_time)
+        {
+            return timed_lock(get_system_time()+relative_time);
+        }
+
+        bool try_lock()
+        {
+            boost::mutex::scoped_lock lk(state_change);
+            if(exclusive || upgrade)
+            {
+                return false;
+            }
+            set_writer_state(writer_blocking);
+            if(!no_readers())
+            {
+                set_writer_state(no_writer);
+                shared_cond.notify_all();
+                return false;
+            }
+            exclusive=true;
+            return true;
+        }
+
+        void unlock()
+        {
+            boost::mutex::scoped_lock lk(state_change);
+            abandon_exclusive();
+        }
+
+        // Upgrade ownership excludes writers and other upgraders but not
+        // readers, so it does not need a reader slot.
+        void lock_upgrade()
+        {
+            boost::this_thread::disable_interruption do_not_disturb;
+            boost::mutex::scoped_lock lk(state_change);
+            while(exclusive || upgrade)
+            {
+                exclusive_cond.wait(lk);
+            }
+            upgrade=true;
+        }
+
+        bool timed_lock_upgrade(system_time const& timeout)
+        {
+            boost::this_thread::disable_interruption do_not_disturb;
+            boost::mutex::scoped_lock lk(state_change);
+            while(exclusive || upgrade)
+            {
+                if(!exclusive_cond.timed_wait(lk,timeout))
+                {
+                    if(exclusive || upgrade)
+                    {
+                        return false;
+                    }
+                    break;
+                }
+            }
+            upgrade=true;
+            return true;
+        }
+
+        template<typename TimeDuration>
+        bool timed_lock_upgrade(TimeDuration const & relative_time)
+        {
+            return timed_lock_upgrade(get_system_time()+relative_time);
+        }
+
+        bool try_lock_upgrade()
+        {
+            boost::mutex::scoped_lock lk(state_change);
+            if(exclusive || upgrade)
+            {
+                return false;
+            }
+            upgrade=true;
+            return true;
+        }
+
+        void unlock_upgrade()
+        {
+            boost::mutex::scoped_lock lk(state_change);
+            upgrade=false;
+            exclusive_cond.notify_all();
+        }
+
+        void unlock_upgrade_and_lock()
+        {
+            boost::this_thread::disable_interruption do_not_disturb;
+            boost::mutex::scoped_lock lk(state_change);
+            upgrade=false;
+            exclusive=true;
+            exclude_readers(lk,0);
+        }
+
+        void unlock_and_lock_upgrade()
+        {
+            boost::mutex::scoped_lock lk(state_change);
+            exclusive=false;
+            upgrade=true;
+            set_writer_state(no_writer);
+            shared_cond.notify_all();
+        }
+
+        void unlock_and_lock_shared()
+        {
+            ++current_slot().readers;
+            boost::mutex::scoped_lock lk(state_change);
+            abandon_exclusive();
+        }
+
+        void unlock_upgrade_and_lock_shared()
+        {
+            ++current_slot().readers;
+            boost::mutex::scoped_lock lk(state_change);
+            upgrade=false;
+            exclusive_cond.notify_all();
+        }
+    };
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
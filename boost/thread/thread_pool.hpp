@@ -0,0 +1,331 @@
+#ifndef BOOST_THREAD_THREAD_POOL_HPP
+#define BOOST_THREAD_THREAD_POOL_HPP
+// Distributed under the Boost Software License, Version 1.0. (See
+// accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+// (C) Copyright 2011 Anthony Williams
+
+#include <boost/thread/detail/config.hpp>
+#include <boost/thread/detail/work_stealing_deque.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/future.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/atomic.hpp>
+#include <boost/utility/result_of.hpp>
+#include <boost/bind.hpp>
+#include <deque>
+#include <vector>
+#include <memory>
+
+#include <boost/config/abi_prefix.hpp>
+
+namespace boost
+{
+    namespace detail
+    {
+        class thread_pool_task
+        {
+        public:
+            virtual ~thread_pool_task()
+            {}
+
+            virtual void run()=0;
+        };
+
+        template<typename R>
+        class thread_pool_task_impl:
+            public thread_pool_task
+        {
+        private:
+            packaged_task<R> task;
+
+        public:
+            template<typename F>
+            explicit thread_pool_task_impl(F const& f):
+                task(f)
+            {}
+
+            unique_future<R> get_future()
+            {
+                return task.get_future();
+            }
+
+            void run()
+            {
+                task();
+            }
+        };
+
+        struct thread_pool_worker
+        {
+            work_stealing_deque<thread_pool_task> tasks;
+            unsigned random_state;
+
+            explicit thread_pool_worker(unsigned index):
+                random_state(index*2654435761U+1)
+            {}
+
+            // xorshift generator used to pick victims to steal from.
+            unsigned next_random()
+            {
+                random_state^=random_state<<13;
+                random_state^=random_state>>17;
+                random_state^=random_state<<5;
+                return random_state;
+            }
+        };
+    }
+
+    class thread_pool
+    {
+    private:
+        thread_pool(thread_pool&);
+        thread_pool& operator=(thread_pool&);
+
+        // The number of times an idle worker looks for work before sleeping.
+        static unsigned const spin_count=64;
+
+        std::vector<detail::thread_pool_worker*> workers;
+        thread_group threads;
+        thread_specific_ptr<detail::thread_pool_worker> current_worker;
+
+        // Tasks submitted by threads that are not workers of this pool.
+        boost::mutex queue_mutex;
+        std::deque<detail::thread_pool_task*> queue;
+        long volatile queue_size;
+
+        // Idle workers sleep on wakeup while holding wakeup_mutex.
+        boost::mutex wakeup_mutex;
+        boost::condition_variable wakeup;
+        boost::atomic<long> sleepers;
+        bool stopping;
+
+        detail::thread_pool_task* pop_queue()
+        {
+            if(!queue_size)
+            {
+                return 0;
+            }
+            boost::lock_guard<boost::mutex> lk(queue_mutex);
+            if(queue.empty())
+            {
+                return 0;
+            }
+            detail::thread_pool_task* const task=queue.front();
+            queue.pop_front();
+            queue_size=static_cast<long>(queue.size());
+            return task;
+        }
+
+        detail::thread_pool_task* steal(unsigned first)
+        {
+            unsigned const count=static_cast<unsigned>(workers.size());
+            for(unsigned i=0;i<count;++i)
+            {
+                if(detail::thread_pool_task* const task=workers[(first+i)%count]->tasks.steal())
+                {
+                    return task;
+                }
+            }
+            return 0;
+        }
+
+        detail::thread_pool_task* find_task(detail::thread_pool_worker* self)
+        {
+            if(self)
+            {
+                if(detail::thread_pool_task* const task=self->tasks.pop())
+                {
+                    return task;
+                }
+            }
+            if(detail::thread_pool_task* const task=pop_queue())
+            {
+                return task;
+            }
+            return steal(self?self->next_random():0);
+        }
+
+        bool work_available()
+        {
+            if(queue_size)
+            {
+                return true;
+            }
+            for(unsigned i=0;i<workers.size();++i)
+            {
+                if(!workers[i]->tasks.empty())
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void run_task(detail::thread_pool_task* task)
+        {
+            std::auto_ptr<detail::thread_pool_task> owner(task);
+            task->run();
+        }
+
+        // Called after a task has been made available to other threads.
+        void wake_one()
+        {
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            if(sleepers.load(boost::memory_order_relaxed))
+            {
+                boost::lock_guard<boost::mutex> lk(wakeup_mutex);
+                wakeup.notify_one();
+            }
+        }
+
+        void worker_thread(detail::thread_pool_worker* self)
+        {
+            current_worker.reset(self);
+            for(;;)
+            {
+                detail::thread_pool_task* task=0;
+                for(unsigned i=0;!task&&i<spin_count;++i)
+                {
+                    if(i)
+                    {
+                        this_thread::yield();
+                    }
+                    task=find_task(self);
+                }
+                if(task)
+                {
+                    run_task(task);
+                    continue;
+                }
+
+                // Register as a sleeper before the final check, so that a
+                // thread which makes a task available after the check is
+                // certain to see the registration and notify us.
+                boost::unique_lock<boost::mutex> lk(wakeup_mutex);
+                ++sleepers;
+                boost::atomic_thread_fence(boost::memory_order_seq_cst);
+                if(!work_available())
+                {
+                    if(stopping)
+                    {
+                        --sleepers;
+                        break;
+                    }
+                    wakeup.wait(lk);
+                }
+                --sleepers;
+            }
+            current_worker.release();
+        }
+
+        void stop()
+        {
+            {
+                boost::lock_guard<boost::mutex> lk(wakeup_mutex);
+                stopping=true;
+                wakeup.notify_all();
+            }
+            threads.join_all();
+        }
+
+        void push(detail::thread_pool_task* task)
+        {
+            if(detail::thread_pool_worker* const self=current_worker.get())
+            {
+                self->tasks.push(task);
+            }
+            else
+            {
+                boost::lock_guard<boost::mutex> lk(queue_mutex);
+                queue.push_back(task);
+                queue_size=static_cast<long>(queue.size());
+            }
+            wake_one();
+        }
+
+    public:
+        explicit thread_pool(unsigned thread_count=0):
+            current_worker(0),queue_size(0),sleepers(0),stopping(false)
+        {
+            if(!thread_count)
+            {
+                thread_count=thread::hardware_concurrency();
+            }
+            if(!thread_count)
+            {
+                thread_count=1;
+            }
+            try
+            {
+                workers.reserve(thread_count);
+                for(unsigned i=0;i<thread_count;++i)
+                {
+                    workers.push_back(0);
+                    workers.back()=new detail::thread_pool_worker(i);
+                }
+                for(unsigned i=0;i<thread_count;++i)
+                {
+                    threads.create_thread(boost::bind(&thread_pool::worker_thread,this,workers[i]));
+                }
+            }
+            catch(...)
+            {
+                stop();
+                for(unsigned i=0;i<workers.size();++i)
+                {
+                    delete workers[i];
+                }
+                throw;
+            }
+        }
+
+        ~thread_pool()
+        {
+            stop();
+            for(unsigned i=0;i<workers.size();++i)
+            {
+                delete workers[i];
+            }
+        }
+
+        unsigned size() const
+        {
+            return static_cast<unsigned>(workers.size());
+        }
+
+        template<typename F>
+        unique_future<typename boost::result_of<F()>::type> submit(F f)
+        {
+            typedef typename boost::result_of<F()>::type result_type;
+            std::auto_ptr<detail::thread_pool_task_impl<result_type> > task(
+                new detail::thread_pool_task_impl<result_type>(f));
+            unique_future<result_type> result(task->get_future());
+            push(task.get());
+            task.release();
+#ifndef BOOST_NO_RVALUE_REFERENCES
+            return static_cast<unique_future<result_type>&&>(result);
+#else
+            return unique_future<result_type>(boost::move(result));
+#endif
+        }
+
+        bool run_pending_task()
+        {
+            if(detail::thread_pool_task* const task=find_task(current_worker.get()))
+            {
+                run_task(task);
+                return true;
+            }
+            this_thread::yield();
+            return false;
+        }
+    };
+}
+
+#include <boost/config/abi_suffix.hpp>
+
+#endif
@@ -8,6 +8,7 @@
 #include <boost/thread/detail/config.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread/detail/thread_heap_alloc.hpp>
+#include <cstddef>
 
 #include <boost/config/abi_prefix.hpp>
 
@@ -23,8 +24,21 @@ namespace boost
             virtual void operator()(void* data)=0;
         };
         
-        BOOST_THREAD_DECL void set_tss_data(void const* key,boost::shared_ptr<tss_cleanup_function> func,void* tss_data,bool cleanup_existing);
-        BOOST_THREAD_DECL void* get_tss_data(void const* key);
+        // Identifies a thread_specific_ptr. Each thread holds its values in
+        // an array indexed by the key's index. Indices are reused once a
+        // key is released, so a value left by an earlier key with the same
+        // index is recognized by its generation, which is never reused. The
+        // Win32 implementation searches a list by generation instead.
+        struct tss_key
+        {
+            std::size_t index;
+            std::size_t generation;
+        };
+
+        BOOST_THREAD_DECL tss_key allocate_tss_key();
+        BOOST_THREAD_DECL void release_tss_key(tss_key key);
+        BOOST_THREAD_DECL void set_tss_data(tss_key key,boost::shared_ptr<tss_cleanup_function> func,void* tss_data,bool cleanup_existing);
+        BOOST_THREAD_DECL void* get_tss_data(tss_key key);
     }
 
     template <typename T>
@@ -58,30 +72,39 @@ namespace boost
             }
         };
 
+        static boost::shared_ptr<detail::tss_cleanup_function> custom_cleanup(void (*func_)(T*))
+        {
+            if(!func_)
+            {
+                return boost::shared_ptr<detail::tss_cleanup_function>();
+            }
+            return boost::shared_ptr<detail::tss_cleanup_function>(
+                detail::heap_new<run_custom_cleanup_function>(func_),detail::do_heap_delete<run_custom_cleanup_function>());
+        }
 
         boost::shared_ptr<detail::tss_cleanup_function> cleanup;
+        detail::tss_key const key;
         
     public:
         typedef T element_type;
         
         thread_specific_ptr():
-            cleanup(detail::heap_new<delete_data>(),detail::do_heap_delete<delete_data>())
+            cleanup(detail::heap_new<delete_data>(),detail::do_heap_delete<delete_data>()),
+            key(detail::allocate_tss_key())
+        {}
+        explicit thread_specific_ptr(void (*func_)(T*)):
+            cleanup(custom_cleanup(func_)),
+            key(detail::allocate_tss_key())
         {}
-        explicit thread_specific_ptr(void (*func_)(T*))
-        {
-            if(func_)
-            {
-                cleanup.reset(detail::heap_new<run_custom_cleanup_function>(func_),detail::do_heap_delete<run_custom_cleanup_function>());
-            }
-        }
         ~thread_specific_ptr()
         {
-            detail::set_tss_data(this,boost::shared_ptr<detail::tss_cleanup_function>(),0,true);
+            detail::set_tss_data(key,boost::shared_ptr<detail::tss_cleanup_function>(),0,true);
+            detail::release_tss_key(key);
         }
 
         T* get() const
         {
-            return static_cast<T*>(detail::get_tss_data(this));
+            return static_cast<T*>(detail::get_tss_data(key));
         }
         T* operator->() const
         {
@@ -94,7 +117,7 @@ namespace boost
         T* release()
         {
             T* const temp=get();
-            detail::set_tss_data(this,boost::shared_ptr<detail::tss_cleanup_function>(),0,false);
+            detail::set_tss_data(key,boost::shared_ptr<detail::tss_cleanup_function>(),0,false);
             return temp;
         }
         void reset(T* new_value=0)
@@ -102,7 +125,7 @@ namespace boost
             T* const current_value=get();
             if(current_value!=new_value)
             {
-                detail::set_tss_data(this,cleanup,new_value,true);
+                detail::set_tss_data(key,cleanup,new_value,true);
             }
         }
     };
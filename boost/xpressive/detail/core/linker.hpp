@@ -236,6 +236,12 @@ struct xpression_linker
         matcher.xpr_.link(*this);
     }
 
+    template<typename Xpr, uint_t Count>
+    void accept(fixed_repeat_matcher<Xpr, Count> const &matcher, void const *)
+    {
+        matcher.xpr_.link(*this);
+    }
+
     // accessors
     bool has_backrefs() const
     {
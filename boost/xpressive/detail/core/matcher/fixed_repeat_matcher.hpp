@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// fixed_repeat_matcher.hpp
+//
+//  Copyright 2011 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_XPRESSIVE_DETAIL_CORE_MATCHER_FIXED_REPEAT_MATCHER_HPP_EAN_06_21_2011
+#define BOOST_XPRESSIVE_DETAIL_CORE_MATCHER_FIXED_REPEAT_MATCHER_HPP_EAN_06_21_2011
+
+// MS compatible compilers support #pragma once
+#if defined(_MSC_VER) && (_MSC_VER >= 1020)
+# pragma once
+#endif
+
+#include <boost/assert.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/size_t.hpp>
+#include <boost/xpressive/detail/detail_fwd.hpp>
+#include <boost/xpressive/detail/core/quant_style.hpp>
+#include <boost/xpressive/detail/core/state.hpp>
+
+namespace boost { namespace xpressive { namespace detail
+{
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // fixed_repeat_width
+    //
+    template<typename Xpr, uint_t Count>
+    struct fixed_repeat_width
+      : mpl::size_t<
+            Xpr::width == unknown_width::value
+          ? unknown_width::value
+          : Count * Xpr::width
+        >
+    {};
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // fixed_repeat_matcher
+    //   Used by static regexes for repeat<Count>(xpr) when xpr could be handled
+    //   by the simple_repeat_matcher. Since the count is known at compile time,
+    //   there is nothing to back off: xpr is matched exactly Count times, in
+    //   straight-line code when Count is small, and then next is tried once.
+    //
+    template<typename Xpr, uint_t Count>
+    struct fixed_repeat_matcher
+      : quant_style<quant_fixed_width, fixed_repeat_width<Xpr, Count>::value>
+    {
+        typedef Xpr xpr_type;
+
+        Xpr xpr_;
+        std::size_t width_;
+
+        fixed_repeat_matcher(Xpr const &xpr, std::size_t width)
+          : xpr_(xpr)
+          , width_(width)
+        {
+            BOOST_ASSERT(0 != width && unknown_width() != width);
+            BOOST_ASSERT(Xpr::width == unknown_width() || Xpr::width == width);
+        }
+
+        template<typename BidiIter, typename Next>
+        bool match(match_state<BidiIter> &state, Next const &next) const
+        {
+            BidiIter const tmp = state.cur_;
+            if(this->match_n_(state, mpl::size_t<Count>(), mpl::bool_<(Count <= 8)>()) && next.match(state))
+            {
+                return true;
+            }
+            state.cur_ = tmp;
+            return false;
+        }
+
+        detail::width get_width() const
+        {
+            return Count * this->width_;
+        }
+
+    private:
+        fixed_repeat_matcher &operator =(fixed_repeat_matcher const &);
+
+        // a few repeats are unrolled ...
+        template<typename BidiIter, std::size_t N>
+        bool match_n_(match_state<BidiIter> &state, mpl::size_t<N>, mpl::true_) const
+        {
+            return this->xpr_.match(state)
+                && this->match_n_(state, mpl::size_t<N - 1>(), mpl::true_());
+        }
+
+        template<typename BidiIter>
+        bool match_n_(match_state<BidiIter> &, mpl::size_t<0>, mpl::true_) const
+        {
+            return true;
+        }
+
+        // ... and more are looped over
+        template<typename BidiIter, std::size_t N>
+        bool match_n_(match_state<BidiIter> &state, mpl::size_t<N>, mpl::false_) const
+        {
+            for(std::size_t i = 0; i != N; ++i)
+            {
+                if(!this->xpr_.match(state))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+}}}
+
+#endif
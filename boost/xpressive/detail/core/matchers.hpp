@@ -26,6 +26,7 @@
 #include <boost/xpressive/detail/core/matcher/charset_matcher.hpp>
 #include <boost/xpressive/detail/core/matcher/end_matcher.hpp>
 #include <boost/xpressive/detail/core/matcher/epsilon_matcher.hpp>
+#include <boost/xpressive/detail/core/matcher/fixed_repeat_matcher.hpp>
 #include <boost/xpressive/detail/core/matcher/keeper_matcher.hpp>
 #include <boost/xpressive/detail/core/matcher/literal_matcher.hpp>
 #include <boost/xpressive/detail/core/matcher/logical_newline_matcher.hpp>
@@ -237,6 +237,13 @@ struct xpression_peeker
         return mpl::false_();
     }
 
+    template<typename Xpr, uint_t Count>
+    mpl::false_ accept(fixed_repeat_matcher<Xpr, Count> const &xpr)
+    {
+        0 != Count ? xpr.xpr_.peek(*this) : this->fail();
+        return mpl::false_();
+    }
+
     template<typename Xpr>
     mpl::false_ accept(keeper_matcher<Xpr> const &xpr)
     {
@@ -129,6 +129,9 @@ namespace boost { namespace xpressive { namespace detail
     template<typename Xpr, typename Greedy>
     struct simple_repeat_matcher;
 
+    template<typename Xpr, uint_t Count>
+    struct fixed_repeat_matcher;
+
     struct repeat_begin_matcher;
 
     template<typename Greedy>
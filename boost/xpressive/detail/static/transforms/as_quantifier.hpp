@@ -61,6 +61,36 @@ namespace boost { namespace xpressive { namespace grammar_detail
     template<>
     struct max_type<proto::tag::logical_not> : mpl::integral_c<uint_t, 1> {};
 
+    ///////////////////////////////////////////////////////////////////////////////
+    // simple_quantifier_matcher
+    //   repeats whose count is known at compile time get a fixed_repeat_matcher.
+    template<typename Xpr, typename Greedy, typename Tag>
+    struct simple_quantifier_matcher
+    {
+        typedef detail::simple_repeat_matcher<Xpr, Greedy> type;
+
+        static type make(Xpr const &xpr)
+        {
+            return type(
+                xpr
+              , (uint_t)min_type<Tag>::value
+              , (uint_t)max_type<Tag>::value
+              , xpr.get_width().value()
+            );
+        }
+    };
+
+    template<typename Xpr, typename Greedy, uint_t Count>
+    struct simple_quantifier_matcher<Xpr, Greedy, detail::generic_quant_tag<Count, Count> >
+    {
+        typedef detail::fixed_repeat_matcher<Xpr, Count> type;
+
+        static type make(Xpr const &xpr)
+        {
+            return type(xpr, xpr.get_width().value());
+        }
+    };
+
     ///////////////////////////////////////////////////////////////////////////////
     // as_simple_quantifier
     template<typename Grammar, typename Greedy, typename Callable = proto::callable>
@@ -78,7 +108,11 @@ namespace boost { namespace xpressive { namespace grammar_detail
             xpr_type;
 
             typedef
-                detail::simple_repeat_matcher<xpr_type, Greedy>
+                simple_quantifier_matcher<xpr_type, Greedy, typename impl::expr::proto_tag>
+            quantifier_type;
+
+            typedef
+                typename quantifier_type::type
             matcher_type;
 
             typedef
@@ -97,15 +131,7 @@ namespace boost { namespace xpressive { namespace grammar_detail
                   , data
                 );
 
-                typedef typename impl::expr expr_type;
-                matcher_type matcher(
-                    xpr
-                  , (uint_t)min_type<typename expr_type::proto_tag>::value
-                  , (uint_t)max_type<typename expr_type::proto_tag>::value
-                  , xpr.get_width().value()
-                );
-
-                return result_type::make(matcher);
+                return result_type::make(quantifier_type::make(xpr));
             }
         };
     };
@@ -20,17 +20,46 @@
 
 #include <climits>  // for UCHAR_MAX
 #include <cstddef>  // for std::ptrdiff_t
+#include <cstring>  // for std::memchr and std::memcmp
+#include <string>
 #include <utility>  // for std::max
 #include <vector>
+#include <boost/mpl/and.hpp>
 #include <boost/mpl/bool.hpp>
+#include <boost/mpl/or.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/iterator/iterator_traits.hpp>
 #include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/xpressive/detail/detail_fwd.hpp>
 
 namespace boost { namespace xpressive { namespace detail
 {
 
+///////////////////////////////////////////////////////////////////////////////
+// is_char_array_iterator
+//   true for iterators over a contiguous array of char
+//   (std::string's iterators may themselves be char pointers, so they are
+//   compared rather than specialized on)
+template<typename Iter>
+struct is_char_array_iterator
+  : mpl::or_<
+        is_same<Iter, char *>
+      , is_same<Iter, char const *>
+      , is_same<Iter, std::string::iterator>
+      , is_same<Iter, std::string::const_iterator>
+    >
+{};
+
+///////////////////////////////////////////////////////////////////////////////
+// is_untranslated_char_traits
+//   true for char traits whose translate() returns its argument unchanged
+template<typename Traits>
+struct is_untranslated_char_traits : mpl::false_ {};
+
+template<> struct is_untranslated_char_traits<cpp_regex_traits<char> > : mpl::true_ {};
+template<> struct is_untranslated_char_traits<c_regex_traits<char> > : mpl::true_ {};
+
 ///////////////////////////////////////////////////////////////////////////////
 // boyer_moore
 //
@@ -94,8 +123,44 @@ private:
         this->fold_.push_back(tr.fold_case(*this->last_));
     }
 
-    // case-sensitive Boyer-Moore search
+    // case-sensitive search
     BidiIter find_(BidiIter begin, BidiIter end, Traits const &tr) const
+    {
+        typedef mpl::and_<is_char_array_iterator<BidiIter>, is_untranslated_char_traits<Traits> > use_memchr;
+        return this->find_case_(begin, end, tr, use_memchr());
+    }
+
+    // case-sensitive search of a char array: memchr finds the candidates
+    // for the first character much faster than the Boyer-Moore loop can
+    // skip to them, and memcmp checks the rest.
+    BidiIter find_case_(BidiIter begin, BidiIter end, Traits const &, mpl::true_) const
+    {
+        std::size_t const len = static_cast<std::size_t>(this->length_) + 1;
+        if(static_cast<std::size_t>(end - begin) < len)
+        {
+            return end;
+        }
+
+        char const *const first = &*begin;
+        char const *const last = first + (end - begin) - len + 1;
+        for(char const *cur = first; cur != last; ++cur)
+        {
+            cur = static_cast<char const *>(std::memchr(cur, *this->begin_, last - cur));
+            if(0 == cur)
+            {
+                break;
+            }
+            else if(0 == std::memcmp(cur + 1, this->begin_ + 1, len - 1))
+            {
+                return begin + (cur - first);
+            }
+        }
+
+        return end;
+    }
+
+    // case-sensitive Boyer-Moore search
+    BidiIter find_case_(BidiIter begin, BidiIter end, Traits const &tr, mpl::false_) const
     {
         typedef typename boost::iterator_difference<BidiIter>::type diff_type;
         diff_type const endpos = std::distance(begin, end);
@@ -0,0 +1,161 @@
+//
+// handler_recycling.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Recycling must be compiled in to be tested.
+#if !defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+#define BOOST_ASIO_ENABLE_HANDLER_RECYCLING 1
+#endif // !defined(BOOST_ASIO_ENABLE_HANDLER_RECYCLING)
+
+// Test that header file is self-contained.
+#include <boost/asio/handler_recycling.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/placeholders.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include "unit_test.hpp"
+
+using namespace boost::asio;
+
+const int warm_up_count = 10;
+const int total_count = 1000;
+
+void repost(io_service* ios, handler_recycling* recycling, int* count)
+{
+  if (++(*count) == warm_up_count)
+    recycling->reset_statistics();
+  if (*count < total_count)
+    ios->post(boost::bind(repost, ios, recycling, count));
+}
+
+void handler_recycling_post_test()
+{
+  io_service ios;
+  handler_recycling recycling(ios);
+
+  // Recycling is disabled by default, and nothing is counted.
+  BOOST_CHECK(!recycling.enabled());
+
+  int count = 0;
+  ios.post(boost::bind(repost, &ios, &recycling, &count));
+  ios.run();
+  BOOST_CHECK(count == total_count);
+
+  handler_recycling::statistics s = recycling.get_statistics();
+  BOOST_CHECK(s.allocations == 0);
+  BOOST_CHECK(s.deallocations == 0);
+  BOOST_CHECK(s.heap_allocations == 0);
+  BOOST_CHECK(s.heap_deallocations == 0);
+
+  // A handler allocated before recycling is enabled may be freed into a cache.
+  count = 0;
+  ios.reset();
+  ios.post(boost::bind(repost, &ios, &recycling, &count));
+
+  // Settings are shared by all objects for the same io_service.
+  recycling.enabled(true);
+  handler_recycling recycling2(ios);
+  BOOST_CHECK(recycling2.enabled());
+
+  // Once the cache has warmed up, handlers are allocated without using the
+  // heap.
+  ios.run();
+  BOOST_CHECK(count == total_count);
+
+  s = recycling.get_statistics();
+  BOOST_CHECK(s.allocations == total_count - warm_up_count);
+  BOOST_CHECK(s.deallocations == s.allocations);
+  BOOST_CHECK(s.heap_allocations == 0);
+
+  recycling.reset_statistics();
+  s = recycling.get_statistics();
+  BOOST_CHECK(s.allocations == 0);
+  BOOST_CHECK(s.heap_deallocations == 0);
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+struct ping_pong
+{
+  ping_pong(io_service& ios, handler_recycling& recycling)
+    : s1(ios), s2(ios), recycling(recycling), count(0)
+  {
+    local::connect_pair(s1, s2);
+  }
+
+  void start()
+  {
+    async_write(s1, buffer(write_data), boost::bind(&ping_pong::handle_write,
+          this, placeholders::error));
+    async_read(s2, buffer(read_data), boost::bind(&ping_pong::handle_read,
+          this, placeholders::error));
+  }
+
+  void handle_write(const boost::system::error_code& err)
+  {
+    BOOST_CHECK(!err);
+  }
+
+  void handle_read(const boost::system::error_code& err)
+  {
+    BOOST_CHECK(!err);
+    if (++count == warm_up_count)
+      recycling.reset_statistics();
+    if (!err && count < total_count)
+      start();
+  }
+
+  local::stream_protocol::socket s1;
+  local::stream_protocol::socket s2;
+  handler_recycling& recycling;
+  char write_data[128];
+  char read_data[128];
+  int count;
+};
+
+void handler_recycling_socket_test()
+{
+  io_service ios;
+  handler_recycling recycling(ios);
+  recycling.enabled(true);
+
+  ping_pong p(ios, recycling);
+  p.start();
+  ios.run();
+  BOOST_CHECK(p.count == total_count);
+
+  handler_recycling::statistics s = recycling.get_statistics();
+  BOOST_CHECK(s.allocations > 0);
+  BOOST_CHECK(s.heap_allocations == 0);
+}
+
+#else // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+void handler_recycling_socket_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("handler_recycling");
+  test->add(BOOST_TEST_CASE(&handler_recycling_post_test));
+  test->add(BOOST_TEST_CASE(&handler_recycling_socket_test));
+  return test;
+}
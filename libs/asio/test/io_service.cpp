@@ -20,6 +20,7 @@
 #include <boost/thread/thread.hpp>
 #include <boost/bind.hpp>
 #include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/detail/mutex.hpp>
 #include "unit_test.hpp"
 
 using namespace boost::asio;
@@ -75,6 +76,13 @@ void start_sleep_increments(io_service* ios, int* count)
   ios->post(boost::bind(sleep_increment, ios, count));
 }
 
+void atomic_increment(int* count)
+{
+  static boost::asio::detail::mutex mutex;
+  boost::asio::detail::mutex::scoped_lock lock(mutex);
+  ++(*count);
+}
+
 void throw_exception()
 {
   throw 1;
@@ -254,6 +262,117 @@ void io_service_test()
   BOOST_CHECK(exception_count == 2);
 }
 
+void post_from_thread(io_service* ios, int* count)
+{
+  ios->post(boost::bind(increment, count));
+}
+
+void io_service_one_thread_test()
+{
+  io_service ios(1);
+  int count = 0;
+
+  ios.post(boost::bind(increment, &count));
+  ios.post(boost::bind(increment, &count));
+
+  // No handlers can be called until run() is called.
+  BOOST_CHECK(!ios.stopped());
+  BOOST_CHECK(count == 0);
+
+  ios.run();
+
+  // The run() call will not return until all work has finished.
+  BOOST_CHECK(ios.stopped());
+  BOOST_CHECK(count == 2);
+
+  count = 10;
+  ios.reset();
+  ios.post(boost::bind(decrement_to_zero, &ios, &count));
+
+  // Handlers posted from within run() are queued privately, but must still be
+  // counted as outstanding work.
+  ios.run();
+  BOOST_CHECK(ios.stopped());
+  BOOST_CHECK(count == 0);
+
+  count = 10;
+  ios.reset();
+  ios.post(boost::bind(nested_decrement_to_zero, &ios, &count));
+  ios.run();
+  BOOST_CHECK(ios.stopped());
+  BOOST_CHECK(count == 0);
+
+  // Handlers posted from another thread must still wake the running thread.
+  count = 0;
+  ios.reset();
+  io_service::work* w = new io_service::work(ios);
+  boost::thread thread1(boost::bind(io_service_run, &ios));
+  for (int i = 0; i < 100; ++i)
+    post_from_thread(&ios, &count);
+  ios.post(boost::bind(&io_service::stop, &ios));
+  thread1.join();
+  delete w;
+  BOOST_CHECK(ios.stopped());
+  BOOST_CHECK(count == 100);
+
+  count = 0;
+  int exception_count = 0;
+  ios.reset();
+  ios.post(&throw_exception);
+  ios.post(boost::bind(increment, &count));
+  ios.post(&throw_exception);
+  ios.post(boost::bind(increment, &count));
+
+  for (;;)
+  {
+    try
+    {
+      ios.run();
+      break;
+    }
+    catch (int)
+    {
+      ++exception_count;
+    }
+  }
+
+  BOOST_CHECK(ios.stopped());
+  BOOST_CHECK(count == 2);
+  BOOST_CHECK(exception_count == 2);
+}
+
+void post_many_from_thread(io_service* ios, int* count, int n)
+{
+  for (int i = 0; i < n; ++i)
+    ios->post(boost::bind(atomic_increment, count));
+}
+
+void io_service_cross_thread_post_test()
+{
+  // Handlers posted concurrently from threads that are not running the
+  // io_service must all be executed, without any being lost while the
+  // running threads go idle.
+  for (int round = 0; round < 10; ++round)
+  {
+    io_service ios;
+    int count = 0;
+    io_service::work* w = new io_service::work(ios);
+    boost::thread runner1(boost::bind(io_service_run, &ios));
+    boost::thread runner2(boost::bind(io_service_run, &ios));
+    boost::thread poster1(
+        boost::bind(post_many_from_thread, &ios, &count, 10000));
+    boost::thread poster2(
+        boost::bind(post_many_from_thread, &ios, &count, 10000));
+    poster1.join();
+    poster2.join();
+    delete w;
+    runner1.join();
+    runner2.join();
+    BOOST_CHECK(ios.stopped());
+    BOOST_CHECK(count == 20000);
+  }
+}
+
 class test_service : public boost::asio::io_service::service
 {
 public:
@@ -328,6 +447,8 @@ test_suite* init_unit_test_suite(int, char*[])
 {
   test_suite* test = BOOST_TEST_SUITE("io_service");
   test->add(BOOST_TEST_CASE(&io_service_test));
+  test->add(BOOST_TEST_CASE(&io_service_one_thread_test));
+  test->add(BOOST_TEST_CASE(&io_service_cross_thread_post_test));
   test->add(BOOST_TEST_CASE(&io_service_service_test));
   return test;
 }
@@ -0,0 +1,114 @@
+//
+// io_service_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/io_service_pool.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include "unit_test.hpp"
+
+using namespace boost::asio;
+
+struct pool_state
+{
+  boost::asio::detail::mutex mutex;
+  int count;
+  int not_dispatched;
+  int expected;
+  io_service_pool* pool;
+};
+
+void set_flag(bool* flag)
+{
+  *flag = true;
+}
+
+void count_and_maybe_stop(pool_state* state, io_service* ios)
+{
+  // Each io_service is run by its own thread, so a dispatch() on the same
+  // io_service from within a handler must invoke the handler immediately.
+  bool dispatched = false;
+  ios->dispatch(boost::bind(set_flag, &dispatched));
+
+  boost::asio::detail::mutex::scoped_lock lock(state->mutex);
+  if (!dispatched)
+    ++state->not_dispatched;
+  if (++state->count == state->expected)
+    state->pool->stop();
+}
+
+void io_service_pool_test()
+{
+  io_service_pool pool(4);
+  BOOST_CHECK(pool.size() == 4);
+
+  // Round-robin selection visits every io_service in turn.
+  io_service* first = &pool.get_io_service();
+  io_service* second = &pool.get_io_service();
+  BOOST_CHECK(first != second);
+  BOOST_CHECK(&pool.get_io_service(0) == first);
+  BOOST_CHECK(&pool.get_io_service(1) == second);
+  pool.get_io_service();
+  pool.get_io_service();
+  BOOST_CHECK(&pool.get_io_service() == first);
+
+  pool_state state;
+  state.count = 0;
+  state.not_dispatched = 0;
+  state.expected = 100;
+  state.pool = &pool;
+
+  for (int i = 0; i < state.expected; ++i)
+  {
+    io_service& ios = pool.get_io_service();
+    ios.post(boost::bind(count_and_maybe_stop, &state, &ios));
+  }
+
+  pool.run();
+
+  BOOST_CHECK(state.count == state.expected);
+  BOOST_CHECK(state.not_dispatched == 0);
+
+  // The pool may be run again after a reset.
+  state.count = 0;
+  state.expected = 8;
+  pool.reset();
+  for (int i = 0; i < state.expected; ++i)
+  {
+    io_service& ios = pool.get_io_service();
+    ios.post(boost::bind(count_and_maybe_stop, &state, &ios));
+  }
+
+  pool.run();
+
+  BOOST_CHECK(state.count == state.expected);
+  BOOST_CHECK(state.not_dispatched == 0);
+}
+
+void io_service_pool_zero_size_test()
+{
+  io_service_pool pool(0);
+  BOOST_CHECK(pool.size() == 1);
+  BOOST_CHECK(&pool.get_io_service() == &pool.get_io_service());
+}
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("io_service_pool");
+  test->add(BOOST_TEST_CASE(&io_service_pool_test));
+  test->add(BOOST_TEST_CASE(&io_service_pool_zero_size_test));
+  return test;
+}
@@ -0,0 +1,163 @@
+//
+// io_service_stats.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/io_service_stats.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/placeholders.hpp>
+#include "unit_test.hpp"
+
+using namespace boost::asio;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void timer_handler(const boost::system::error_code& err, int* count)
+{
+  BOOST_CHECK(!err);
+  ++(*count);
+}
+
+void io_service_stats_test()
+{
+  io_service ios;
+  io_service_stats stats(ios);
+
+  // Recording is disabled by default.
+  BOOST_CHECK(!stats.enabled());
+
+  int count = 0;
+  for (int i = 0; i < 10; ++i)
+    ios.post(boost::bind(increment, &count));
+  ios.run();
+  BOOST_CHECK(count == 10);
+
+  io_service_stats::statistics s = stats.get_statistics();
+  BOOST_CHECK(s.handlers_posted == 0);
+  BOOST_CHECK(s.handlers_run == 0);
+  BOOST_CHECK(s.queue_depth.total() == 0);
+  BOOST_CHECK(s.run_delay.percentile(0.5) == 0);
+
+  // Settings are shared by all objects for the same io_service.
+  stats.enabled(true);
+  io_service_stats stats2(ios);
+  BOOST_CHECK(stats2.enabled());
+
+  // Each posted handler is counted, along with the depth of the queue and the
+  // time it waited.
+  count = 0;
+  ios.reset();
+  for (int i = 0; i < 10; ++i)
+    ios.post(boost::bind(increment, &count));
+  ios.run();
+  BOOST_CHECK(count == 10);
+
+  s = stats.get_statistics();
+  BOOST_CHECK(s.handlers_posted == 10);
+  BOOST_CHECK(s.handlers_run == 10);
+  BOOST_CHECK(s.queue_depth.total() == 10);
+  BOOST_CHECK(s.queue_depth.counts[0] == 1);
+  BOOST_CHECK(s.queue_depth.percentile(1.0) == 16);
+  BOOST_CHECK(s.run_delay.total() == 10);
+  BOOST_CHECK(s.execution_time.total() == 10);
+
+  // Operations completed by the reactor are counted separately.
+  stats.reset_statistics();
+  s = stats.get_statistics();
+  BOOST_CHECK(s.handlers_posted == 0);
+  BOOST_CHECK(s.handlers_run == 0);
+  BOOST_CHECK(s.execution_time.total() == 0);
+
+  count = 0;
+  ios.reset();
+  deadline_timer t(ios, boost::posix_time::milliseconds(10));
+  t.async_wait(boost::bind(timer_handler, placeholders::error, &count));
+  ios.run();
+  BOOST_CHECK(count == 1);
+
+  s = stats.get_statistics();
+  BOOST_CHECK(s.operations_completed == 1);
+  BOOST_CHECK(s.handlers_run == 1);
+  BOOST_CHECK(s.task_runs > 0);
+  BOOST_CHECK(s.run_delay.total() == 1);
+
+  // Recording stops when disabled.
+  stats.enabled(false);
+  stats.reset_statistics();
+  count = 0;
+  ios.reset();
+  ios.post(boost::bind(increment, &count));
+  ios.run();
+  BOOST_CHECK(count == 1);
+
+  s = stats.get_statistics();
+  BOOST_CHECK(s.handlers_posted == 0);
+  BOOST_CHECK(s.handlers_run == 0);
+
+  // Handlers queued while recording are taken off the count of queued
+  // handlers even if recording is disabled before they run.
+  stats.enabled(true);
+  count = 0;
+  ios.reset();
+  for (int i = 0; i < 3; ++i)
+    ios.post(boost::bind(increment, &count));
+  stats.enabled(false);
+  ios.run();
+  BOOST_CHECK(count == 3);
+
+  stats.enabled(true);
+  stats.reset_statistics();
+  ios.reset();
+  ios.post(boost::bind(increment, &count));
+  ios.run();
+
+  s = stats.get_statistics();
+  BOOST_CHECK(s.queue_depth.total() == 1);
+  BOOST_CHECK(s.queue_depth.counts[0] == 1);
+
+  // Handlers still queued when the io_service is destroyed are discarded.
+  ios.reset();
+  ios.post(boost::bind(increment, &count));
+}
+
+void io_service_stats_histogram_test()
+{
+  io_service_stats::histogram h;
+  for (std::size_t i = 0; i < io_service_stats::histogram_buckets; ++i)
+    h.counts[i] = 0;
+  BOOST_CHECK(h.total() == 0);
+  BOOST_CHECK(h.percentile(0.5) == 0);
+
+  h.counts[3] = 90;
+  h.counts[10] = 10;
+  BOOST_CHECK(h.total() == 100);
+  BOOST_CHECK(h.percentile(0.0) == 8);
+  BOOST_CHECK(h.percentile(0.5) == 8);
+  BOOST_CHECK(h.percentile(0.9) == 1024);
+  BOOST_CHECK(h.percentile(1.0) == 1024);
+}
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("io_service_stats");
+  test->add(BOOST_TEST_CASE(&io_service_stats_test));
+  test->add(BOOST_TEST_CASE(&io_service_stats_histogram_test));
+  return test;
+}
@@ -16,8 +16,10 @@
 // Test that header file is self-contained.
 #include <boost/asio/ip/udp.hpp>
 
+#include <boost/array.hpp>
 #include <boost/bind.hpp>
 #include <cstring>
+#include <vector>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/placeholders.hpp>
 #include "../unit_test.hpp"
@@ -299,6 +301,31 @@ void test()
         endpoint, in_flags, &receive_handler);
     socket1.async_receive_from(null_buffers(),
         endpoint, in_flags, &receive_handler);
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+    boost::array<mutable_buffer, 2> mutable_buffers = {{
+      buffer(mutable_char_buffer, 64), buffer(mutable_char_buffer) + 64 }};
+    boost::array<const_buffer, 2> const_buffers = {{
+      buffer(const_char_buffer, 64), buffer(const_char_buffer) + 64 }};
+    ip::udp::endpoint endpoints[2];
+    std::size_t sizes[2];
+
+    socket1.send_batch(mutable_buffers, endpoints);
+    socket1.send_batch(const_buffers, endpoints);
+    socket1.send_batch(const_buffers, 0, in_flags, ec);
+
+    socket1.async_send_batch(mutable_buffers, endpoints, &send_handler);
+    socket1.async_send_batch(const_buffers, endpoints, &send_handler);
+    socket1.async_send_batch(const_buffers, 0, in_flags, &send_handler);
+
+    socket1.receive_batch(mutable_buffers, endpoints, sizes);
+    socket1.receive_batch(mutable_buffers, 0, sizes, in_flags, ec);
+
+    socket1.async_receive_batch(mutable_buffers,
+        endpoints, sizes, &receive_handler);
+    socket1.async_receive_batch(mutable_buffers,
+        0, sizes, in_flags, &receive_handler);
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
   }
   catch (std::exception&)
   {
@@ -376,6 +403,147 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_udp_socket_batch_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the batched send and
+// receive functions of the ip::udp::socket class.
+
+namespace ip_udp_socket_batch_runtime {
+
+#if !defined(BOOST_ASIO_HAS_IOCP)
+
+const std::size_t batch_size = 8;
+
+void handle_batch(size_t expected_datagrams,
+    const boost::system::error_code& err, size_t datagrams)
+{
+  BOOST_CHECK(!err);
+  BOOST_CHECK(expected_datagrams == datagrams);
+}
+
+void handle_partial_batch(size_t* total_datagrams,
+    const boost::system::error_code& err, size_t datagrams)
+{
+  BOOST_CHECK(!err);
+  BOOST_CHECK(datagrams > 0);
+  *total_datagrams += datagrams;
+}
+
+void test()
+{
+  using namespace std; // For memcmp and memset.
+  using namespace boost::asio;
+  namespace ip = boost::asio::ip;
+
+  io_service ios;
+
+  ip::udp::socket s1(ios, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ios, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::endpoint s1_endpoint = s1.local_endpoint();
+
+  // Datagrams of differing sizes so that they can be told apart.
+  char send_msgs[batch_size][32];
+  boost::array<const_buffer, batch_size> send_bufs;
+  ip::udp::endpoint destinations[batch_size];
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    memset(send_msgs[i], 'a' + static_cast<int>(i), sizeof(send_msgs[i]));
+    send_bufs[i] = buffer(send_msgs[i], i + 1);
+    destinations[i] = s1_endpoint;
+  }
+
+  char recv_msgs[batch_size][32];
+  boost::array<mutable_buffer, batch_size> recv_bufs;
+  for (std::size_t i = 0; i < batch_size; ++i)
+    recv_bufs[i] = buffer(recv_msgs[i]);
+  ip::udp::endpoint senders[batch_size];
+  std::size_t sizes[batch_size];
+
+  // Synchronous batch.
+
+  std::size_t sent = s2.send_batch(send_bufs, destinations);
+  BOOST_CHECK(sent == batch_size);
+
+  std::size_t received = 0;
+  while (received < batch_size)
+  {
+    std::vector<mutable_buffer> remaining(
+        recv_bufs.begin() + received, recv_bufs.end());
+    std::size_t n = s1.receive_batch(
+        remaining, senders + received, sizes + received);
+    BOOST_CHECK(n > 0);
+    received += n;
+  }
+
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    BOOST_CHECK(sizes[i] == i + 1);
+    BOOST_CHECK(memcmp(recv_msgs[i], send_msgs[i], sizes[i]) == 0);
+    BOOST_CHECK(senders[i] == s2.local_endpoint());
+  }
+
+  // Asynchronous batch on a connected socket.
+
+  memset(recv_msgs, 0, sizeof(recv_msgs));
+  s2.connect(s1_endpoint);
+  s2.async_send_batch(send_bufs, 0,
+      boost::bind(handle_batch, batch_size,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred));
+  ios.run();
+
+  received = 0;
+  while (received < batch_size)
+  {
+    std::vector<mutable_buffer> remaining(
+        recv_bufs.begin() + received, recv_bufs.end());
+    ios.reset();
+    s1.async_receive_batch(
+        remaining, senders + received, sizes + received,
+        boost::bind(handle_partial_batch, &received,
+          boost::asio::placeholders::error,
+          boost::asio::placeholders::bytes_transferred));
+    ios.run();
+  }
+
+  BOOST_CHECK(received == batch_size);
+  for (std::size_t i = 0; i < batch_size; ++i)
+  {
+    BOOST_CHECK(sizes[i] == i + 1);
+    BOOST_CHECK(memcmp(recv_msgs[i], send_msgs[i], sizes[i]) == 0);
+    BOOST_CHECK(senders[i] == s2.local_endpoint());
+  }
+
+  // An empty socket waits for data.
+
+  bool received_late = false;
+  std::size_t late_received = 0;
+  ios.reset();
+  s1.async_receive_batch(recv_bufs, 0, sizes,
+      boost::bind(handle_partial_batch, &late_received,
+        boost::asio::placeholders::error,
+        boost::asio::placeholders::bytes_transferred));
+  ios.poll();
+  received_late = (late_received == 0);
+  s2.send(buffer(send_msgs[0], 5));
+  ios.run();
+  BOOST_CHECK(received_late);
+  BOOST_CHECK(late_received == 1);
+  BOOST_CHECK(sizes[0] == 5);
+}
+
+#else // !defined(BOOST_ASIO_HAS_IOCP)
+
+void test()
+{
+}
+
+#endif // !defined(BOOST_ASIO_HAS_IOCP)
+
+} // namespace ip_udp_socket_batch_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_udp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -443,6 +611,7 @@ test_suite* init_unit_test_suite(int, char*[])
   test_suite* test = BOOST_TEST_SUITE("ip/udp");
   test->add(BOOST_TEST_CASE(&ip_udp_socket_compile::test));
   test->add(BOOST_TEST_CASE(&ip_udp_socket_runtime::test));
+  test->add(BOOST_TEST_CASE(&ip_udp_socket_batch_runtime::test));
   test->add(BOOST_TEST_CASE(&ip_udp_resolver_compile::test));
   return test;
 }
@@ -0,0 +1,222 @@
+//
+// echo_threading.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares the throughput of a TCP echo server running on a single io_service
+// shared by N threads against the same server running on an io_service_pool
+// of N single-threaded io_services.
+//
+// Usage: echo_threading [<connections> <block_size> <seconds> [<threads>...]]
+//
+// When no thread counts are given the benchmark is run for 1, 2, 4, ... 64
+// threads.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/asio.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+
+using boost::asio::ip::tcp;
+
+// Source of io_service objects for the benchmark. In the shared model every
+// I/O object uses one io_service that is run by all threads. In the pool
+// model each I/O object is pinned to one io_service of the pool.
+class io_service_source
+{
+public:
+  io_service_source(bool use_pool, std::size_t threads)
+    : threads_(threads)
+  {
+    if (use_pool)
+      pool_.reset(new boost::asio::io_service_pool(threads));
+    else
+    {
+      shared_.reset(new boost::asio::io_service);
+      work_.reset(new boost::asio::io_service::work(*shared_));
+    }
+  }
+
+  boost::asio::io_service& get_io_service()
+  {
+    return pool_ ? pool_->get_io_service() : *shared_;
+  }
+
+  void run()
+  {
+    if (pool_)
+      pool_->run();
+    else
+    {
+      boost::thread_group threads;
+      for (std::size_t i = 1; i < threads_; ++i)
+        threads.create_thread(boost::bind(
+              &boost::asio::io_service::run, shared_.get()));
+      shared_->run();
+      threads.join_all();
+    }
+  }
+
+  void stop()
+  {
+    if (pool_)
+      pool_->stop();
+    else
+      shared_->stop();
+  }
+
+private:
+  std::size_t threads_;
+  boost::scoped_ptr<boost::asio::io_service_pool> pool_;
+  boost::scoped_ptr<boost::asio::io_service> shared_;
+  boost::scoped_ptr<boost::asio::io_service::work> work_;
+};
+
+// One end of an echo exchange. The server side echoes whatever it reads, and
+// the client side writes one block and then waits for it to come back.
+class session
+{
+public:
+  session(boost::asio::io_service& ios, std::size_t block_size)
+    : socket_(ios),
+      buffer_(block_size),
+      bytes_(0)
+  {
+  }
+
+  tcp::socket& socket()
+  {
+    return socket_;
+  }
+
+  std::size_t bytes() const
+  {
+    return bytes_;
+  }
+
+  void start_write()
+  {
+    boost::asio::async_write(socket_, boost::asio::buffer(buffer_),
+        boost::bind(&session::handle_write, this,
+          boost::asio::placeholders::error));
+  }
+
+  void start_read()
+  {
+    boost::asio::async_read(socket_, boost::asio::buffer(buffer_),
+        boost::bind(&session::handle_read, this,
+          boost::asio::placeholders::error,
+          boost::asio::placeholders::bytes_transferred));
+  }
+
+private:
+  void handle_read(const boost::system::error_code& err, std::size_t n)
+  {
+    if (!err)
+    {
+      bytes_ += n;
+      start_write();
+    }
+  }
+
+  void handle_write(const boost::system::error_code& err)
+  {
+    if (!err)
+      start_read();
+  }
+
+  tcp::socket socket_;
+  std::vector<char> buffer_;
+  std::size_t bytes_;
+};
+
+double run_benchmark(bool use_pool, std::size_t threads,
+    std::size_t connections, std::size_t block_size, int seconds)
+{
+  io_service_source source(use_pool, threads);
+
+  tcp::acceptor acceptor(source.get_io_service(),
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+  std::vector<boost::shared_ptr<session> > servers;
+  std::vector<boost::shared_ptr<session> > clients;
+  for (std::size_t i = 0; i < connections; ++i)
+  {
+    boost::shared_ptr<session> server(
+        new session(source.get_io_service(), block_size));
+    boost::shared_ptr<session> client(
+        new session(source.get_io_service(), block_size));
+    client->socket().connect(acceptor.local_endpoint());
+    acceptor.accept(server->socket());
+    tcp::no_delay no_delay(true);
+    server->socket().set_option(no_delay);
+    client->socket().set_option(no_delay);
+    servers.push_back(server);
+    clients.push_back(client);
+  }
+
+  for (std::size_t i = 0; i < connections; ++i)
+  {
+    servers[i]->start_read();
+    clients[i]->start_write();
+  }
+
+  boost::asio::deadline_timer timer(source.get_io_service(),
+      boost::posix_time::seconds(seconds));
+  timer.async_wait(boost::bind(&io_service_source::stop, &source));
+
+  source.run();
+
+  std::size_t total = 0;
+  for (std::size_t i = 0; i < connections; ++i)
+    total += clients[i]->bytes();
+
+  // Close all sockets before the io_services are destroyed.
+  servers.clear();
+  clients.clear();
+
+  return static_cast<double>(total) / seconds / (1024 * 1024);
+}
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    std::size_t connections = argc > 1 ? std::atoi(argv[1]) : 256;
+    std::size_t block_size = argc > 2 ? std::atoi(argv[2]) : 1024;
+    int seconds = argc > 3 ? std::atoi(argv[3]) : 5;
+
+    std::vector<std::size_t> thread_counts;
+    for (int i = 4; i < argc; ++i)
+      thread_counts.push_back(std::atoi(argv[i]));
+    if (thread_counts.empty())
+      for (std::size_t n = 1; n <= 64; n *= 2)
+        thread_counts.push_back(n);
+
+    std::cout << "threads\tshared MB/s\tpool MB/s\n";
+    for (std::size_t i = 0; i < thread_counts.size(); ++i)
+    {
+      std::size_t n = thread_counts[i];
+      double shared = run_benchmark(false, n, connections, block_size, seconds);
+      double pooled = run_benchmark(true, n, connections, block_size, seconds);
+      std::cout << n << "\t" << shared << "\t" << pooled << std::endl;
+    }
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << "\n";
+    return 1;
+  }
+
+  return 0;
+}
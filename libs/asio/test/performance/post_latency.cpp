@@ -0,0 +1,112 @@
+//
+// post_latency.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Measures the latency from io_service::post() on one thread to execution of
+// the handler on another, by bouncing a handler between two io_services that
+// are each run by their own thread.
+//
+// Usage: post_latency [<round_trips>]
+//
+// Build with BOOST_ASIO_TASK_IO_SERVICE_SPIN_COUNT=0 to compare against idle
+// threads that block immediately.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <boost/asio/io_service.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+class ping_pong
+{
+public:
+  ping_pong(boost::asio::io_service& a, boost::asio::io_service& b,
+      long round_trips)
+    : a_(a),
+      b_(b),
+      remaining_(round_trips)
+  {
+  }
+
+  void ping()
+  {
+    if (remaining_-- > 0)
+      b_.post(boost::bind(&ping_pong::pong, this));
+    else
+    {
+      a_.stop();
+      b_.stop();
+    }
+  }
+
+  void pong()
+  {
+    a_.post(boost::bind(&ping_pong::ping, this));
+  }
+
+private:
+  boost::asio::io_service& a_;
+  boost::asio::io_service& b_;
+  long remaining_;
+};
+
+// Runs an io_service with a thread kept idle in run() between handlers.
+class runner
+{
+public:
+  runner(boost::asio::io_service& ios)
+    : work_(ios),
+      thread_(boost::bind(&boost::asio::io_service::run, &ios))
+  {
+  }
+
+  void join()
+  {
+    thread_.join();
+  }
+
+private:
+  boost::asio::io_service::work work_;
+  boost::thread thread_;
+};
+
+double run_benchmark(std::size_t concurrency_hint, long round_trips)
+{
+  boost::asio::io_service a(concurrency_hint);
+  boost::asio::io_service b(concurrency_hint);
+  ping_pong p(a, b, round_trips);
+
+  boost::posix_time::ptime start =
+    boost::posix_time::microsec_clock::universal_time();
+
+  a.post(boost::bind(&ping_pong::ping, &p));
+  runner ra(a);
+  runner rb(b);
+  ra.join();
+  rb.join();
+
+  boost::posix_time::ptime stop =
+    boost::posix_time::microsec_clock::universal_time();
+
+  double ns = static_cast<double>((stop - start).total_microseconds()) * 1000;
+  return ns / (2.0 * round_trips);
+}
+
+int main(int argc, char* argv[])
+{
+  long round_trips = argc > 1 ? std::atol(argv[1]) : 1000000;
+
+  std::cout << "post-to-execute latency, default hint: "
+    << run_benchmark(16, round_trips) << " ns\n";
+  std::cout << "post-to-execute latency, hint of 1:    "
+    << run_benchmark(1, round_trips) << " ns\n";
+
+  return 0;
+}
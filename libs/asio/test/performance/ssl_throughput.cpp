@@ -0,0 +1,201 @@
+//
+// ssl_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Measures the rate at which a single thread can transfer data through a pair
+// of connected ssl::stream objects, comparing the default buffer size with a
+// larger one set using ssl::stream::set_buffer_size. The certificate and
+// Diffie-Hellman parameter files default to those used by the SSL example,
+// which must be run from the example directory.
+//
+// Usage: ssl_throughput [<buffer size>] [<megabytes>] [<pem file>] [<dh file>]
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+namespace ssl = boost::asio::ssl;
+typedef boost::asio::local::stream_protocol::socket socket_type;
+typedef ssl::stream<socket_type> stream_type;
+
+const std::size_t chunk_size = 64 * 1024;
+
+std::string password()
+{
+  return "test";
+}
+
+class transfer
+{
+public:
+  transfer(stream_type& client, stream_type& server, std::size_t total)
+    : client_(client),
+      server_(server),
+      total_(total),
+      written_(0),
+      read_(0),
+      handshakes_(0),
+      write_data_(chunk_size, 'x'),
+      read_data_(chunk_size)
+  {
+  }
+
+  void start()
+  {
+    client_.async_handshake(ssl::stream_base::client,
+        boost::bind(&transfer::handle_handshake, this, _1));
+    server_.async_handshake(ssl::stream_base::server,
+        boost::bind(&transfer::handle_handshake, this, _1));
+  }
+
+  std::size_t bytes_read() const
+  {
+    return read_;
+  }
+
+private:
+  void handle_handshake(const boost::system::error_code& ec)
+  {
+    if (ec)
+    {
+      std::cerr << "handshake: " << ec.message() << std::endl;
+    }
+    else if (++handshakes_ == 2)
+    {
+      start_write();
+      start_read();
+    }
+  }
+
+  void start_write()
+  {
+    if (written_ < total_)
+    {
+      boost::asio::async_write(client_, boost::asio::buffer(write_data_),
+          boost::bind(&transfer::handle_write, this, _1, _2));
+    }
+  }
+
+  void handle_write(const boost::system::error_code& ec, std::size_t n)
+  {
+    if (!ec)
+    {
+      written_ += n;
+      start_write();
+    }
+  }
+
+  void start_read()
+  {
+    if (read_ < total_)
+    {
+      server_.async_read_some(boost::asio::buffer(read_data_),
+          boost::bind(&transfer::handle_read, this, _1, _2));
+    }
+  }
+
+  void handle_read(const boost::system::error_code& ec, std::size_t n)
+  {
+    if (!ec)
+    {
+      read_ += n;
+      start_read();
+    }
+  }
+
+  stream_type& client_;
+  stream_type& server_;
+  std::size_t total_;
+  std::size_t written_;
+  std::size_t read_;
+  int handshakes_;
+  std::vector<char> write_data_;
+  std::vector<char> read_data_;
+};
+
+double run_test(std::size_t buffer_size, std::size_t megabytes,
+    const char* pem_file, const char* dh_file)
+{
+  boost::asio::io_service ios;
+
+  ssl::context client_ctx(ssl::context::sslv23);
+  ssl::context server_ctx(ssl::context::sslv23);
+  server_ctx.set_options(ssl::context::default_workarounds
+      | ssl::context::no_sslv2 | ssl::context::single_dh_use);
+  server_ctx.set_password_callback(boost::bind(&password));
+  server_ctx.use_certificate_chain_file(pem_file);
+  server_ctx.use_private_key_file(pem_file, ssl::context::pem);
+  server_ctx.use_tmp_dh_file(dh_file);
+
+  stream_type client(ios, client_ctx);
+  stream_type server(ios, server_ctx);
+  boost::asio::local::connect_pair(client.next_layer(), server.next_layer());
+
+  if (buffer_size)
+  {
+    client.set_buffer_size(buffer_size);
+    server.set_buffer_size(buffer_size);
+  }
+
+  transfer t(client, server, megabytes * 1024 * 1024);
+  t.start();
+
+  boost::posix_time::ptime start =
+    boost::posix_time::microsec_clock::universal_time();
+  ios.run();
+  boost::posix_time::ptime stop =
+    boost::posix_time::microsec_clock::universal_time();
+
+  double seconds = (stop - start).total_microseconds() / 1000000.0;
+  return t.bytes_read() / (1024.0 * 1024.0) / seconds;
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t buffer_size = argc > 1 ? std::atoi(argv[1]) : 65536;
+  std::size_t megabytes = argc > 2 ? std::atoi(argv[2]) : 256;
+  const char* pem_file = argc > 3 ? argv[3] : "server.pem";
+  const char* dh_file = argc > 4 ? argv[4] : "dh512.pem";
+
+  try
+  {
+    std::cout << "default\t\t" << run_test(0, megabytes, pem_file, dh_file)
+      << " MB/sec" << std::endl;
+    std::cout << buffer_size << "\t\t"
+      << run_test(buffer_size, megabytes, pem_file, dh_file)
+      << " MB/sec" << std::endl;
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << "Exception: " << e.what() << std::endl;
+  }
+
+  return 0;
+}
+
+#else // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+int main()
+{
+  std::cerr << "Local sockets not supported on this platform." << std::endl;
+  return 0;
+}
+
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
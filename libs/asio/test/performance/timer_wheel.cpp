@@ -0,0 +1,152 @@
+//
+// timer_wheel.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Compares the cost of the heap-based timer queue used by default with the
+// timing wheel selected by timer_wheel_traits. For each queue size the
+// benchmark measures:
+//
+//   schedule - adding a timer with a random expiry time in the next minute;
+//   rearm    - cancelling a timer and scheduling it again one minute later, as
+//              is done for an idle timeout when a connection sees activity;
+//   expire   - advancing the clock in 1ms steps until all timers complete.
+//
+// Times are reported in nanoseconds per timer. The queues are driven through
+// a manually advanced clock, so no time is spent waiting.
+//
+// Usage: timer_wheel [<max_timers>]
+//
+// Queue sizes of 10^3, 10^4, ... up to max_timers (default 10^7) are used.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/timer_wheel_traits.hpp>
+#include <boost/asio/detail/timer_queue.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/scoped_array.hpp>
+
+using namespace boost::posix_time;
+using boost::asio::detail::op_queue;
+using boost::asio::detail::operation;
+using boost::asio::detail::timer_op;
+
+// Time traits with a clock that is advanced manually.
+struct manual_time_traits
+  : boost::asio::time_traits<ptime>
+{
+  static ptime current;
+
+  static ptime now()
+  {
+    return current;
+  }
+};
+
+ptime manual_time_traits::current(boost::gregorian::date(2011, 1, 1));
+
+typedef boost::asio::detail::timer_queue<manual_time_traits> heap_queue;
+typedef boost::asio::detail::timer_queue<
+  boost::asio::timer_wheel_traits<manual_time_traits> > wheel_queue;
+
+struct null_op
+  : timer_op
+{
+  null_op()
+    : timer_op(&null_op::do_complete)
+  {
+  }
+
+  static void do_complete(boost::asio::detail::io_service_impl*,
+      operation*, boost::system::error_code, std::size_t)
+  {
+  }
+};
+
+ptime wall_clock()
+{
+  return microsec_clock::universal_time();
+}
+
+double ns_per_timer(const time_duration& d, std::size_t n)
+{
+  return d.total_microseconds() * 1000.0 / n;
+}
+
+template <typename Queue>
+void run_benchmark(std::size_t n, double results[3])
+{
+  Queue queue;
+  boost::scoped_array<typename Queue::per_timer_data> timers(
+      new typename Queue::per_timer_data[n]);
+  boost::scoped_array<null_op> ops(new null_op[n]);
+  const ptime start = manual_time_traits::current;
+
+  // Schedule.
+  boost::uint32_t seed = 1;
+  ptime t0 = wall_clock();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    seed = seed * 1664525 + 1013904223;
+    queue.enqueue_timer(start + milliseconds(seed % 60000),
+        timers[i], &ops[i]);
+  }
+  results[0] = ns_per_timer(wall_clock() - t0, n);
+
+  // Re-arm.
+  op_queue<operation> cancelled;
+  t0 = wall_clock();
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    seed = seed * 1664525 + 1013904223;
+    queue.cancel_timer(timers[i], cancelled);
+    cancelled.pop();
+    queue.enqueue_timer(start + milliseconds(60000 + seed % 60000),
+        timers[i], &ops[i]);
+  }
+  results[1] = ns_per_timer(wall_clock() - t0, n);
+
+  // Expire.
+  std::size_t completed = 0;
+  t0 = wall_clock();
+  while (completed < n)
+  {
+    manual_time_traits::current += milliseconds(1);
+    op_queue<operation> ready;
+    queue.get_ready_timers(ready);
+    while (ready.front())
+    {
+      ready.pop();
+      ++completed;
+    }
+  }
+  results[2] = ns_per_timer(wall_clock() - t0, n);
+}
+
+int main(int argc, char* argv[])
+{
+  std::size_t max_timers = argc > 1 ? std::atol(argv[1]) : 10000000;
+
+  std::cout << "timers\tqueue\tschedule\trearm\texpire (ns/timer)\n";
+  for (std::size_t n = 1000; n <= max_timers; n *= 10)
+  {
+    double heap[3];
+    run_benchmark<heap_queue>(n, heap);
+    std::cout << n << "\theap\t" << heap[0] << "\t"
+      << heap[1] << "\t" << heap[2] << std::endl;
+
+    double wheel[3];
+    run_benchmark<wheel_queue>(n, wheel);
+    std::cout << n << "\twheel\t" << wheel[0] << "\t"
+      << wheel[1] << "\t" << wheel[2] << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+//
+// udp_batch.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Measures the rate at which a single thread can receive small datagrams over
+// the loopback interface, comparing async_receive_from, which receives one
+// datagram per operation, with async_receive_batch. Senders on other threads
+// use send_batch to keep the receiver's socket buffer full, so the receive
+// rate is limited by the receiving thread.
+//
+// Usage: udp_batch [<seconds>] [<senders>]
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/array.hpp>
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+using boost::asio::ip::udp;
+
+const std::size_t batch_size = 32;
+const std::size_t datagram_size = 64;
+
+volatile bool stopped = false;
+
+void send_loop(udp::endpoint target)
+{
+  boost::asio::io_service ios;
+  udp::socket socket(ios, udp::v4());
+  socket.connect(target);
+
+  char data[batch_size][datagram_size] = { { 0 } };
+  boost::array<boost::asio::const_buffer, batch_size> buffers;
+  for (std::size_t i = 0; i < batch_size; ++i)
+    buffers[i] = boost::asio::buffer(data[i]);
+
+  boost::system::error_code ec;
+  while (!stopped)
+    socket.send_batch(buffers, 0, 0, ec);
+}
+
+class receiver
+{
+public:
+  receiver(udp::socket& socket, bool batch)
+    : socket_(socket),
+      batch_(batch),
+      datagrams_(0)
+  {
+    for (std::size_t i = 0; i < batch_size; ++i)
+      buffers_[i] = boost::asio::buffer(data_[i]);
+  }
+
+  void start()
+  {
+    if (batch_)
+    {
+      socket_.async_receive_batch(buffers_, senders_, sizes_,
+          boost::bind(&receiver::handle_receive, this, _1, _2));
+    }
+    else
+    {
+      socket_.async_receive_from(boost::asio::buffer(data_[0]), senders_[0],
+          boost::bind(&receiver::handle_receive, this, _1, 1));
+    }
+  }
+
+  void handle_receive(const boost::system::error_code& ec, std::size_t n)
+  {
+    if (!ec)
+    {
+      datagrams_ += n;
+      start();
+    }
+  }
+
+  std::size_t datagrams() const
+  {
+    return datagrams_;
+  }
+
+private:
+  udp::socket& socket_;
+  bool batch_;
+  std::size_t datagrams_;
+  char data_[batch_size][datagram_size];
+  boost::array<boost::asio::mutable_buffer, batch_size> buffers_;
+  udp::endpoint senders_[batch_size];
+  std::size_t sizes_[batch_size];
+};
+
+double run_test(bool batch, int seconds, int senders)
+{
+  boost::asio::io_service ios;
+  udp::socket socket(ios,
+      udp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+  socket.set_option(udp::socket::receive_buffer_size(4 * 1024 * 1024));
+
+  stopped = false;
+  boost::thread_group threads;
+  for (int i = 0; i < senders; ++i)
+    threads.create_thread(boost::bind(send_loop, socket.local_endpoint()));
+
+  receiver r(socket, batch);
+  r.start();
+
+  boost::asio::deadline_timer timer(ios,
+      boost::posix_time::seconds(seconds));
+  timer.async_wait(boost::bind(&boost::asio::io_service::stop, &ios));
+  ios.run();
+
+  stopped = true;
+  threads.join_all();
+
+  return static_cast<double>(r.datagrams()) / seconds;
+}
+
+int main(int argc, char* argv[])
+{
+  int seconds = argc > 1 ? std::atoi(argv[1]) : 5;
+  int senders = argc > 2 ? std::atoi(argv[2]) : 2;
+
+  std::cout << "receive_from\t" << run_test(false, seconds, senders)
+    << " datagrams/sec" << std::endl;
+  std::cout << "receive_batch\t" << run_test(true, seconds, senders)
+    << " datagrams/sec" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+//
+// reactor_control.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/reactor_control.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/placeholders.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+using namespace boost::asio;
+
+void read_handler(const boost::system::error_code& err,
+    std::size_t bytes_transferred, std::size_t* total)
+{
+  if (!err)
+    *total += bytes_transferred;
+}
+
+void reactor_control_test()
+{
+  io_service ios;
+  reactor_control control(ios);
+
+  // Defaults.
+  BOOST_CHECK(control.event_batch_size() == 128);
+  BOOST_CHECK(control.busy_poll_count() == 0);
+
+  // Batch sizes are clamped to the supported range.
+  control.event_batch_size(0);
+  BOOST_CHECK(control.event_batch_size() == 1);
+  control.event_batch_size(reactor_control::max_event_batch_size + 1);
+  BOOST_CHECK(control.event_batch_size()
+      == reactor_control::max_event_batch_size);
+
+  // Settings are shared by all controls for the same io_service.
+  control.event_batch_size(4);
+  control.busy_poll_count(100);
+  reactor_control control2(ios);
+  BOOST_CHECK(control2.event_batch_size() == 4);
+  BOOST_CHECK(control2.busy_poll_count() == 100);
+
+  control.reset_statistics();
+  reactor_control::statistics s = control.get_statistics();
+  BOOST_CHECK(s.waits == 0);
+  BOOST_CHECK(s.events == 0);
+
+  // Exchange data so that the reactor has to wait for readiness.
+  local::stream_protocol::socket s1(ios);
+  local::stream_protocol::socket s2(ios);
+  local::connect_pair(s1, s2);
+
+  char read_data[1024];
+  char write_data[1024] = "";
+  std::size_t total = 0;
+  async_read(s2, buffer(read_data), boost::bind(read_handler,
+        placeholders::error, placeholders::bytes_transferred, &total));
+  async_write(s1, buffer(write_data), boost::bind(read_handler,
+        placeholders::error, placeholders::bytes_transferred, &total));
+  ios.run();
+
+  BOOST_CHECK(total == 2 * sizeof(read_data));
+
+  s = control.get_statistics();
+  BOOST_CHECK(s.waits > 0);
+  BOOST_CHECK(s.events > 0);
+  BOOST_CHECK(s.full_batches <= s.waits);
+  BOOST_CHECK(s.empty_waits <= s.waits);
+
+  control.reset_statistics();
+  s = control.get_statistics();
+  BOOST_CHECK(s.waits == 0);
+  BOOST_CHECK(s.busy_polls == 0);
+}
+
+#else // defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+void reactor_control_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_EPOLL) && defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("reactor_control");
+  test->add(BOOST_TEST_CASE(&reactor_control_test));
+  return test;
+}
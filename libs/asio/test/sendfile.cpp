@@ -0,0 +1,167 @@
+//
+// sendfile.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/sendfile.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_SENDFILE)
+
+#include <unistd.h>
+#include <fcntl.h>
+
+using namespace boost::asio;
+
+const std::size_t file_size = 1024 * 1024;
+
+// Creates an unlinked temporary file with known content.
+int create_file(std::vector<char>& content)
+{
+  char name[] = "/tmp/asio_sendfile_XXXXXX";
+  int fd = ::mkstemp(name);
+  BOOST_CHECK(fd != -1);
+  ::unlink(name);
+
+  content.resize(file_size);
+  for (std::size_t i = 0; i < file_size; ++i)
+    content[i] = static_cast<char>(i * 7 + i / 251);
+  BOOST_CHECK(::write(fd, &content[0], file_size)
+      == static_cast<ssize_t>(file_size));
+  return fd;
+}
+
+void connect_pair(ip::tcp::socket& client, ip::tcp::socket& server)
+{
+  ip::tcp::acceptor acceptor(client.get_io_service(),
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+}
+
+void handle_sendfile(const boost::system::error_code& err,
+    std::size_t bytes_transferred, boost::system::error_code* out_err,
+    std::size_t* out_bytes, bool* called)
+{
+  *out_err = err;
+  *out_bytes = bytes_transferred;
+  *called = true;
+}
+
+void handle_read(const boost::system::error_code& err,
+    std::size_t bytes_transferred, std::size_t expected)
+{
+  BOOST_CHECK(!err);
+  BOOST_CHECK(bytes_transferred == expected);
+}
+
+void sendfile_sync_test()
+{
+  std::vector<char> content;
+  int fd = create_file(content);
+
+  io_service ios;
+  ip::tcp::socket client(ios), server(ios);
+  connect_pair(client, server);
+
+  // Keep the transfer small enough to fit in the socket buffers.
+  const std::size_t offset = 1000, length = 20000;
+  boost::system::error_code ec;
+  std::size_t bytes = boost::asio::sendfile(server, fd, offset, length, ec);
+  BOOST_CHECK(!ec);
+  BOOST_CHECK(bytes == length);
+
+  std::vector<char> received(length);
+  boost::asio::read(client, buffer(received));
+  BOOST_CHECK(std::memcmp(&received[0], &content[offset], length) == 0);
+
+  // The file descriptor's own offset is not used.
+  BOOST_CHECK(::lseek(fd, 0, SEEK_CUR) == static_cast<off_t>(file_size));
+
+  // Reading beyond the end of the file stops with eof.
+  bytes = boost::asio::sendfile(server, fd, file_size - 10, 100, ec);
+  BOOST_CHECK(ec == boost::asio::error::eof);
+  BOOST_CHECK(bytes == 10);
+
+  ::close(fd);
+}
+
+void sendfile_async_test()
+{
+  std::vector<char> content;
+  int fd = create_file(content);
+
+  io_service ios;
+  ip::tcp::socket client(ios), server(ios);
+  connect_pair(client, server);
+
+  // The whole file is larger than the socket buffers, so the operation must
+  // wait for the reader.
+  boost::system::error_code ec;
+  std::size_t bytes = 0;
+  bool called = false;
+  boost::asio::async_sendfile(server, fd, 0, file_size,
+      boost::bind(handle_sendfile, _1, _2, &ec, &bytes, &called));
+  BOOST_CHECK(!called);
+
+  std::vector<char> received(file_size);
+  boost::asio::async_read(client, buffer(received),
+      boost::bind(handle_read, _1, _2, file_size));
+
+  ios.run();
+  BOOST_CHECK(called);
+  BOOST_CHECK(!ec);
+  BOOST_CHECK(bytes == file_size);
+  BOOST_CHECK(received == content);
+
+  // Reading beyond the end of the file stops with eof.
+  called = false;
+  boost::asio::async_sendfile(server, fd, file_size - 10, 100,
+      boost::bind(handle_sendfile, _1, _2, &ec, &bytes, &called));
+  ios.reset();
+  ios.run();
+  BOOST_CHECK(called);
+  BOOST_CHECK(ec == boost::asio::error::eof);
+  BOOST_CHECK(bytes == 10);
+
+  ::close(fd);
+}
+
+#else // defined(BOOST_ASIO_HAS_SENDFILE)
+
+void sendfile_sync_test()
+{
+}
+
+void sendfile_async_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_SENDFILE)
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("sendfile");
+  test->add(BOOST_TEST_CASE(&sendfile_sync_test));
+  test->add(BOOST_TEST_CASE(&sendfile_async_test));
+  return test;
+}
@@ -101,6 +101,9 @@ void test()
 
     stream1.set_verify_callback(verify_callback);
     stream1.set_verify_callback(verify_callback, ec);
+
+    stream1.set_buffer_size(65536);
+    stream1.set_buffer_size(65536, ec);
 #endif // !defined(BOOST_ASIO_ENABLE_OLD_SSL)
 
     stream1.handshake(ssl::stream_base::client);
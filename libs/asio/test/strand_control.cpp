@@ -0,0 +1,173 @@
+//
+// strand_control.cpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/strand_control.hpp>
+
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+#include "unit_test.hpp"
+
+using namespace boost::asio;
+
+void increment(int* count)
+{
+  ++(*count);
+}
+
+void record(int* count, int* recorded)
+{
+  *recorded = *count;
+}
+
+void nested_dispatch(io_service::strand* s, int* count)
+{
+  int original_count = *count;
+
+  s->dispatch(boost::bind(increment, count));
+
+  // The strand is already running on this thread, so the dispatch should
+  // have nested.
+  BOOST_CHECK(*count == original_count + 1);
+}
+
+void check_exclusive(int* in_strand, int* count)
+{
+  BOOST_CHECK(++(*in_strand) == 1);
+  ++(*count);
+  boost::this_thread::yield();
+  --(*in_strand);
+}
+
+void io_service_run(io_service* ios)
+{
+  ios->run();
+}
+
+void strand_control_settings_test()
+{
+  io_service ios;
+  strand_control control(ios);
+
+  // Defaults.
+  BOOST_CHECK(!control.dedicated_implementations());
+  BOOST_CHECK(control.max_handlers_per_dispatch() == 1);
+
+  control.max_handlers_per_dispatch(0);
+  BOOST_CHECK(control.max_handlers_per_dispatch() == 1);
+
+  // Settings are shared by all controls for the same io_service.
+  control.dedicated_implementations(true);
+  control.max_handlers_per_dispatch(8);
+  strand_control control2(ios);
+  BOOST_CHECK(control2.dedicated_implementations());
+  BOOST_CHECK(control2.max_handlers_per_dispatch() == 8);
+}
+
+void strand_control_dedicated_test()
+{
+  io_service ios;
+  strand_control control(ios);
+  control.dedicated_implementations(true);
+
+  // Copies of a strand refer to the same strand.
+  int count = 0;
+  io_service::strand s1(ios);
+  io_service::strand s1_copy(s1);
+  s1.post(boost::bind(nested_dispatch, &s1_copy, &count));
+  ios.run();
+  BOOST_CHECK(count == 1);
+
+  // Handlers are serialised when run by several threads.
+  count = 0;
+  int in_strand = 0;
+  ios.reset();
+  for (int i = 0; i < 1000; ++i)
+    s1.post(boost::bind(check_exclusive, &in_strand, &count));
+  boost::thread thread1(boost::bind(io_service_run, &ios));
+  boost::thread thread2(boost::bind(io_service_run, &ios));
+  thread1.join();
+  thread2.join();
+  BOOST_CHECK(count == 1000);
+
+  // Handlers posted through an orphaned strand still run.
+  count = 0;
+  ios.reset();
+  {
+    io_service::strand s2(ios);
+    s2.post(boost::bind(increment, &count));
+    s2.post(boost::bind(increment, &count));
+  }
+  ios.run();
+  BOOST_CHECK(count == 2);
+
+  // Check for clean shutdown when handlers posted through an orphaned strand
+  // are abandoned.
+  ios.reset();
+  {
+    io_service::strand s3(ios);
+    s3.post(boost::bind(increment, &count));
+    s3.post(boost::bind(increment, &count));
+  }
+}
+
+void strand_control_batching_test()
+{
+  io_service ios;
+  strand_control control(ios);
+  io_service::strand s(ios);
+
+  // By default the strand yields to other ready work after each handler.
+  int count = 0;
+  int recorded = -1;
+  for (int i = 0; i < 8; ++i)
+    s.post(boost::bind(increment, &count));
+  ios.post(boost::bind(record, &count, &recorded));
+  ios.run();
+  BOOST_CHECK(count == 8);
+  BOOST_CHECK(recorded == 1);
+
+  // With a larger limit the strand runs a batch of handlers before yielding.
+  control.max_handlers_per_dispatch(4);
+  count = 0;
+  recorded = -1;
+  ios.reset();
+  for (int i = 0; i < 8; ++i)
+    s.post(boost::bind(increment, &count));
+  ios.post(boost::bind(record, &count, &recorded));
+  ios.run();
+  BOOST_CHECK(count == 8);
+  BOOST_CHECK(recorded == 4);
+
+  // A batch ends early when the strand has no more handlers.
+  control.max_handlers_per_dispatch(100);
+  count = 0;
+  ios.reset();
+  for (int i = 0; i < 3; ++i)
+    s.post(boost::bind(increment, &count));
+  ios.run();
+  BOOST_CHECK(count == 3);
+}
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("strand_control");
+  test->add(BOOST_TEST_CASE(&strand_control_settings_test));
+  test->add(BOOST_TEST_CASE(&strand_control_dedicated_test));
+  test->add(BOOST_TEST_CASE(&strand_control_batching_test));
+  return test;
+}
@@ -0,0 +1,301 @@
+//
+// timer_wheel_traits.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/timer_wheel_traits.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/asio/basic_deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/placeholders.hpp>
+#include <boost/asio/detail/timer_queue.hpp>
+#include "unit_test.hpp"
+
+using namespace boost::posix_time;
+
+typedef boost::asio::basic_deadline_timer<ptime,
+    boost::asio::timer_wheel_traits<> > wheel_timer;
+
+ptime now()
+{
+#if defined(BOOST_DATE_TIME_HAS_HIGH_PRECISION_CLOCK)
+  return microsec_clock::universal_time();
+#else // defined(BOOST_DATE_TIME_HAS_HIGH_PRECISION_CLOCK)
+  return second_clock::universal_time();
+#endif // defined(BOOST_DATE_TIME_HAS_HIGH_PRECISION_CLOCK)
+}
+
+void record_completion(const ptime* expiry, int* count, int* early,
+    const boost::system::error_code& ec)
+{
+  if (!ec)
+  {
+    ++(*count);
+    if (now() < *expiry)
+      ++(*early);
+  }
+}
+
+void record_abort(int* count, const boost::system::error_code& ec)
+{
+  if (ec == boost::asio::error::operation_aborted)
+    ++(*count);
+}
+
+void start_short_timer(wheel_timer* short_timer, wheel_timer* long_timer)
+{
+  // The long timer is already being waited on, so the short timer must
+  // interrupt that wait for it to complete in time.
+  short_timer->expires_from_now(milliseconds(10));
+  short_timer->async_wait(boost::bind(&wheel_timer::cancel, long_timer));
+}
+
+void wheel_timer_test()
+{
+  boost::asio::io_service ios;
+
+  ptime start = now();
+  int count = 0;
+  int early = 0;
+  int aborted = 0;
+
+  wheel_timer t1(ios, milliseconds(20));
+  ptime t1_expiry = t1.expires_at();
+  t1.async_wait(boost::bind(record_completion, &t1_expiry, &count, &early,
+        boost::asio::placeholders::error));
+
+  wheel_timer t2(ios, milliseconds(50));
+  ptime t2_expiry = t2.expires_at();
+  t2.async_wait(boost::bind(record_completion, &t2_expiry, &count, &early,
+        boost::asio::placeholders::error));
+
+  wheel_timer t3(ios, seconds(5));
+  t3.async_wait(boost::bind(record_abort, &aborted,
+        boost::asio::placeholders::error));
+  BOOST_CHECK(t3.cancel() == 1);
+
+  wheel_timer t4(ios, ptime(pos_infin));
+  t4.async_wait(boost::bind(record_abort, &aborted,
+        boost::asio::placeholders::error));
+
+  wheel_timer t5(ios, milliseconds(60));
+  t5.async_wait(boost::bind(&wheel_timer::cancel, &t4));
+
+  ios.run();
+
+  BOOST_CHECK(count == 2);
+  BOOST_CHECK(early == 0);
+  BOOST_CHECK(aborted == 2);
+  BOOST_CHECK(now() - start < seconds(5));
+
+  // Scheduling a timer that is earlier than the one being waited on.
+  ios.reset();
+  start = now();
+  wheel_timer long_timer(ios, seconds(10));
+  long_timer.async_wait(boost::bind(record_abort, &aborted,
+        boost::asio::placeholders::error));
+  wheel_timer short_timer(ios);
+  ios.post(boost::bind(start_short_timer, &short_timer, &long_timer));
+
+  ios.run();
+
+  BOOST_CHECK(aborted == 3);
+  BOOST_CHECK(now() - start < seconds(5));
+}
+
+// Time traits with a clock that is advanced manually.
+struct manual_time_traits
+  : boost::asio::time_traits<ptime>
+{
+  static ptime current;
+
+  static ptime now()
+  {
+    return current;
+  }
+};
+
+ptime manual_time_traits::current(boost::gregorian::date(2011, 1, 1));
+
+typedef boost::asio::timer_wheel_traits<manual_time_traits, 1000>
+  manual_wheel_traits;
+typedef boost::asio::detail::timer_queue<manual_wheel_traits>
+  manual_wheel_queue;
+
+struct recording_op
+  : boost::asio::detail::timer_op
+{
+  recording_op()
+    : boost::asio::detail::timer_op(&recording_op::do_complete),
+      fired(false)
+  {
+  }
+
+  static void do_complete(boost::asio::detail::io_service_impl*,
+      boost::asio::detail::operation*, boost::system::error_code, std::size_t)
+  {
+  }
+
+  ptime expiry;
+  bool fired;
+};
+
+void collect(boost::asio::detail::op_queue<
+    boost::asio::detail::operation>& ops, int* count)
+{
+  while (boost::asio::detail::operation* op = ops.front())
+  {
+    ops.pop();
+    static_cast<recording_op*>(op)->fired = true;
+    ++(*count);
+  }
+}
+
+void wheel_queue_test()
+{
+  const ptime start = manual_time_traits::current;
+  manual_wheel_queue queue;
+
+  // Spread expiry times over all levels of the wheel, and beyond its range
+  // of 2^32 ticks.
+  const int num_timers = 2000;
+  boost::scoped_array<manual_wheel_queue::per_timer_data> timers(
+      new manual_wheel_queue::per_timer_data[num_timers]);
+  boost::scoped_array<recording_op> ops(new recording_op[num_timers]);
+  boost::uint64_t seed = 12345;
+  for (int i = 0; i < num_timers; ++i)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    int bits = static_cast<int>((seed >> 33) % 37);
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    boost::int64_t msec = static_cast<boost::int64_t>(
+        (seed >> 20) & ((static_cast<boost::uint64_t>(1) << bits) - 1));
+    ops[i].expiry = start + milliseconds(msec);
+    queue.enqueue_timer(ops[i].expiry, timers[i], &ops[i]);
+  }
+
+  // A timer that never expires.
+  manual_wheel_queue::per_timer_data infinite_timer;
+  recording_op infinite_op;
+  queue.enqueue_timer(pos_infin, infinite_timer, &infinite_op);
+
+  // Cancel every tenth timer.
+  int cancelled = 0;
+  for (int i = 0; i < num_timers; i += 10)
+  {
+    boost::asio::detail::op_queue<boost::asio::detail::operation> ops_out;
+    if (queue.cancel_timer(timers[i], ops_out) == 1)
+      ++cancelled;
+    while (ops_out.front())
+      ops_out.pop();
+  }
+  BOOST_CHECK(cancelled == num_timers / 10);
+
+  // Advance the clock in steps of varying size, checking that each timer
+  // completes at the first step where its expiry time has been reached.
+  int fired = 0;
+  int wrong = 0;
+  int late = 0;
+  while (fired < num_timers - cancelled)
+  {
+    // The reactor must not be told to wait beyond the earliest expiry time.
+    ptime earliest(pos_infin);
+    for (int i = 0; i < num_timers; ++i)
+      if (i % 10 != 0 && !ops[i].fired && ops[i].expiry < earliest)
+        earliest = ops[i].expiry;
+    long wait = queue.wait_duration_usec(5 * 60 * 1000 * 1000);
+    if (manual_time_traits::current + microseconds(wait) > earliest)
+      ++late;
+
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    int bits = static_cast<int>((seed >> 33) % 32);
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    boost::int64_t msec = static_cast<boost::int64_t>(
+        (seed >> 20) & ((static_cast<boost::uint64_t>(1) << bits) - 1));
+    manual_time_traits::current += milliseconds(msec);
+
+    boost::asio::detail::op_queue<boost::asio::detail::operation> ready;
+    queue.get_ready_timers(ready);
+    collect(ready, &fired);
+
+    for (int i = 0; i < num_timers; ++i)
+    {
+      bool due = !(manual_time_traits::current < ops[i].expiry);
+      if (i % 10 != 0 && ops[i].fired != due)
+        ++wrong;
+    }
+  }
+
+  BOOST_CHECK(wrong == 0);
+  BOOST_CHECK(late == 0);
+  BOOST_CHECK(fired == num_timers - cancelled);
+  BOOST_CHECK(!infinite_op.fired);
+  BOOST_CHECK(!queue.empty());
+
+  boost::asio::detail::op_queue<boost::asio::detail::operation> remaining;
+  queue.get_all_timers(remaining);
+  int count = 0;
+  collect(remaining, &count);
+  BOOST_CHECK(count == 1);
+  BOOST_CHECK(queue.empty());
+}
+
+void wheel_queue_cascade_test()
+{
+  const ptime start = manual_time_traits::current;
+  manual_wheel_queue queue;
+  boost::asio::detail::op_queue<boost::asio::detail::operation> ready;
+  int fired = 0;
+
+  // Timer a is too far away for the first level of the wheel, and will be
+  // cascaded when the first level starts its second revolution at 256ms.
+  manual_wheel_queue::per_timer_data a;
+  recording_op a_op;
+  queue.enqueue_timer(start + milliseconds(300), a, &a_op);
+
+  manual_time_traits::current = start + milliseconds(255);
+  queue.get_ready_timers(ready);
+  collect(ready, &fired);
+  BOOST_CHECK(fired == 0);
+
+  // Timer b goes straight into the first level, but expires after timer a.
+  manual_wheel_queue::per_timer_data b;
+  recording_op b_op;
+  queue.enqueue_timer(start + milliseconds(400), b, &b_op);
+  BOOST_CHECK(queue.wait_duration_usec(1000000) <= 45000);
+
+  manual_time_traits::current = start + milliseconds(300);
+  queue.get_ready_timers(ready);
+  collect(ready, &fired);
+  BOOST_CHECK(a_op.fired);
+  BOOST_CHECK(!b_op.fired);
+
+  manual_time_traits::current = start + milliseconds(400);
+  queue.get_ready_timers(ready);
+  collect(ready, &fired);
+  BOOST_CHECK(b_op.fired);
+  BOOST_CHECK(fired == 2);
+  BOOST_CHECK(queue.empty());
+}
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("timer_wheel_traits");
+  test->add(BOOST_TEST_CASE(&wheel_timer_test));
+  test->add(BOOST_TEST_CASE(&wheel_queue_test));
+  test->add(BOOST_TEST_CASE(&wheel_queue_cascade_test));
+  return test;
+}
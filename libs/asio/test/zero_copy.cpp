@@ -0,0 +1,175 @@
+//
+// zero_copy.cpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2011 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/zero_copy.hpp>
+
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include "unit_test.hpp"
+
+#if defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+using namespace boost::asio;
+
+// Returns false if zero-copy sends are not supported by the running kernel.
+bool connect_pair(ip::tcp::socket& client, ip::tcp::socket& server)
+{
+  ip::tcp::acceptor acceptor(client.get_io_service(),
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  client.connect(acceptor.local_endpoint());
+  acceptor.accept(server);
+
+  boost::system::error_code ec;
+  server.set_option(socket_base::zero_copy(true), ec);
+  return !ec;
+}
+
+void handle_completion(const boost::system::error_code& err,
+    const zero_copy_completion& c, boost::system::error_code* out_err,
+    zero_copy_completion* out_c, bool* called)
+{
+  *out_err = err;
+  *out_c = c;
+  *called = true;
+}
+
+void zero_copy_option_test()
+{
+  io_service ios;
+  ip::tcp::socket client(ios), server(ios);
+  if (!connect_pair(client, server))
+    return;
+
+  socket_base::zero_copy option;
+  server.get_option(option);
+  BOOST_CHECK(option.value());
+
+  // With nothing sent there is nothing to report.
+  zero_copy_completion c;
+  boost::system::error_code ec;
+  BOOST_CHECK(!read_zero_copy_completion(server, c, ec));
+  BOOST_CHECK(ec == boost::asio::error::would_block);
+}
+
+void zero_copy_sync_test()
+{
+  io_service ios;
+  ip::tcp::socket client(ios), server(ios);
+  if (!connect_pair(client, server))
+    return;
+
+  std::vector<char> data(64 * 1024, 'x');
+  std::vector<char> received(data.size());
+  for (int i = 0; i < 3; ++i)
+  {
+    BOOST_CHECK(server.send(buffer(data), socket_base::message_zero_copy)
+        == data.size());
+    boost::asio::read(client, buffer(received));
+  }
+
+  // Notifications may be coalesced, but must cover sends 0 to 2 in order.
+  boost::uint32_t expected = 0;
+  while (expected < 3)
+  {
+    zero_copy_completion c;
+    boost::system::error_code ec;
+    if (read_zero_copy_completion(server, c, ec))
+    {
+      BOOST_CHECK(!ec);
+      BOOST_CHECK(c.first == expected);
+      BOOST_CHECK(c.last >= c.first && c.last < 3);
+      expected = c.last + 1;
+    }
+    else
+    {
+      BOOST_CHECK(ec == boost::asio::error::would_block);
+      deadline_timer t(ios, boost::posix_time::milliseconds(1));
+      t.wait();
+    }
+  }
+}
+
+void cancel_socket(ip::tcp::socket* s)
+{
+  s->cancel();
+}
+
+void zero_copy_async_test()
+{
+#if defined(BOOST_ASIO_HAS_EPOLL)
+  io_service ios;
+  ip::tcp::socket client(ios), server(ios);
+  if (!connect_pair(client, server))
+    return;
+
+  // Start waiting before anything is sent.
+  boost::system::error_code ec;
+  zero_copy_completion c = { 0, 0, false };
+  bool called = false;
+  async_read_zero_copy_completion(server,
+      boost::bind(handle_completion, _1, _2, &ec, &c, &called));
+  BOOST_CHECK(!called);
+
+  std::vector<char> data(64 * 1024, 'x');
+  BOOST_CHECK(server.send(buffer(data), socket_base::message_zero_copy)
+      == data.size());
+  std::vector<char> received(data.size());
+  boost::asio::read(client, buffer(received));
+
+  // Don't hang if the notification never arrives.
+  deadline_timer t(ios, boost::posix_time::seconds(5));
+  t.async_wait(boost::bind(cancel_socket, &server));
+
+  while (!called && ios.run_one())
+    ;
+  t.cancel();
+  ios.run();
+
+  BOOST_CHECK(called);
+  BOOST_CHECK(!ec);
+  BOOST_CHECK(c.first == 0);
+  BOOST_CHECK(c.last == 0);
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+}
+
+#else // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+void zero_copy_option_test()
+{
+}
+
+void zero_copy_sync_test()
+{
+}
+
+void zero_copy_async_test()
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_MSG_ZEROCOPY)
+
+test_suite* init_unit_test_suite(int, char*[])
+{
+  test_suite* test = BOOST_TEST_SUITE("zero_copy");
+  test->add(BOOST_TEST_CASE(&zero_copy_option_test));
+  test->add(BOOST_TEST_CASE(&zero_copy_sync_test));
+  test->add(BOOST_TEST_CASE(&zero_copy_async_test));
+  return test;
+}
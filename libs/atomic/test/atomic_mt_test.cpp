@@ -0,0 +1,112 @@
+//
+// atomic_mt_test.cpp
+//
+// Copyright 2011 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+
+#include <boost/atomic.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/detail/lightweight_thread.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+
+int const n_threads = 4;
+int const n_iterations = 100000;
+
+static boost::atomic< long > counter( 0 );
+static boost::atomic< boost::uint16_t > cas_counter( 0 );
+
+static boost::atomic_flag flag;
+static long locked_counter = 0;
+
+static void increment()
+{
+    for( int i = 0; i < n_iterations; ++i )
+    {
+        counter.fetch_add( 1, boost::memory_order_relaxed );
+
+        // A compare-exchange loop on a narrower type
+
+        boost::uint16_t v = cas_counter.load( boost::memory_order_relaxed );
+        while( !cas_counter.compare_exchange_weak( v, static_cast< boost::uint16_t >( v + 1 ) ) );
+
+        // atomic_flag as a spinlock
+
+        for( unsigned k = 0; flag.test_and_set( boost::memory_order_acquire ); ++k )
+        {
+            boost::detail::yield( k );
+        }
+
+        ++locked_counter;
+        flag.clear( boost::memory_order_release );
+    }
+}
+
+static int payload = 0;
+static boost::atomic< int* > message( 0 );
+
+static void produce()
+{
+    for( int i = 1; i <= n_iterations; ++i )
+    {
+        for( unsigned k = 0; message.load( boost::memory_order_relaxed ) != 0; ++k )
+        {
+            boost::detail::yield( k );
+        }
+
+        payload = i;
+        message.store( &payload, boost::memory_order_release );
+    }
+}
+
+static void consume()
+{
+    for( int i = 1; i <= n_iterations; ++i )
+    {
+        int * p;
+
+        for( unsigned k = 0; ( p = message.load( boost::memory_order_acquire ) ) == 0; ++k )
+        {
+            boost::detail::yield( k );
+        }
+
+        BOOST_TEST( *p == i );
+        message.store( 0, boost::memory_order_relaxed );
+    }
+}
+
+int main()
+{
+    {
+        pthread_t a[ n_threads ];
+
+        for( int i = 0; i < n_threads; ++i )
+        {
+            boost::detail::lw_thread_create( a[ i ], increment );
+        }
+
+        for( int i = 0; i < n_threads; ++i )
+        {
+            pthread_join( a[ i ], 0 );
+        }
+
+        BOOST_TEST( counter == n_threads * n_iterations );
+        BOOST_TEST( cas_counter == static_cast< boost::uint16_t >( n_threads * n_iterations ) );
+        BOOST_TEST( locked_counter == n_threads * n_iterations );
+    }
+
+    {
+        pthread_t a[ 2 ];
+
+        boost::detail::lw_thread_create( a[ 0 ], produce );
+        boost::detail::lw_thread_create( a[ 1 ], consume );
+
+        pthread_join( a[ 0 ], 0 );
+        pthread_join( a[ 1 ], 0 );
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,250 @@
+//
+// atomic_test.cpp
+//
+// Copyright 2011 Peter Dimov
+//
+// Distributed under the Boost Software License, Version 1.0.
+// See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt
+//
+
+#include <boost/atomic.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+template< class T > void test_integral()
+{
+    boost::atomic< T > a( 5 );
+
+    BOOST_TEST( a == 5 );
+    BOOST_TEST( a.load( boost::memory_order_relaxed ) == 5 );
+    BOOST_TEST( a.load( boost::memory_order_acquire ) == 5 );
+
+    a.store( 6, boost::memory_order_release );
+    BOOST_TEST( a == 6 );
+
+    a = 7;
+    BOOST_TEST( a == 7 );
+
+    BOOST_TEST( a.exchange( 8 ) == 7 );
+    BOOST_TEST( a == 8 );
+
+    T e = 7;
+    BOOST_TEST( !a.compare_exchange_strong( e, 9 ) );
+    BOOST_TEST( e == 8 );
+    BOOST_TEST( a.compare_exchange_strong( e, 9 ) );
+    BOOST_TEST( a == 9 );
+
+    e = 9;
+    BOOST_TEST( a.compare_exchange_weak( e, 10, boost::memory_order_acq_rel ) );
+    BOOST_TEST( a == 10 );
+
+    BOOST_TEST( a.fetch_add( 2 ) == 10 );
+    BOOST_TEST( a.fetch_sub( 1 ) == 12 );
+    BOOST_TEST( a == 11 );
+
+    BOOST_TEST( ++a == 12 );
+    BOOST_TEST( a++ == 12 );
+    BOOST_TEST( --a == 12 );
+    BOOST_TEST( a-- == 12 );
+    BOOST_TEST( a == 11 );
+
+    BOOST_TEST( ( a += 5 ) == 16 );
+    BOOST_TEST( ( a -= 6 ) == 10 );
+
+    BOOST_TEST( a.fetch_and( 6 ) == 10 );
+    BOOST_TEST( a == 2 );
+    BOOST_TEST( a.fetch_or( 5 ) == 2 );
+    BOOST_TEST( a == 7 );
+    BOOST_TEST( a.fetch_xor( 3 ) == 7 );
+    BOOST_TEST( a == 4 );
+
+    BOOST_TEST( ( a &= 12 ) == 4 );
+    BOOST_TEST( ( a |= 3 ) == 7 );
+    BOOST_TEST( ( a ^= 1 ) == 6 );
+
+    // Wraparound
+
+    a = 0;
+    --a;
+    BOOST_TEST( a == static_cast< T >( -1 ) );
+    ++a;
+    BOOST_TEST( a == 0 );
+
+    boost::atomic< T > const b( 3 );
+    BOOST_TEST( b.load() == 3 );
+
+    boost::atomic< T > volatile c( 4 );
+    c += 1;
+    BOOST_TEST( c == 5 );
+}
+
+struct X
+{
+    char c[ 3 ];
+};
+
+bool operator==( X const & x1, X const & x2 )
+{
+    return x1.c[ 0 ] == x2.c[ 0 ] && x1.c[ 1 ] == x2.c[ 1 ] && x1.c[ 2 ] == x2.c[ 2 ];
+}
+
+struct Y
+{
+    int i;
+    float f;
+};
+
+enum color { red, green, blue };
+
+void test_bitwise()
+{
+    {
+        X x1 = { { 1, 2, 3 } };
+        X x2 = { { 4, 5, 6 } };
+
+        boost::atomic< X > a( x1 );
+        BOOST_TEST( a.load() == x1 );
+
+        BOOST_TEST( a.exchange( x2 ) == x1 );
+        BOOST_TEST( a.load() == x2 );
+
+        X e = x1;
+        BOOST_TEST( !a.compare_exchange_strong( e, x1 ) );
+        BOOST_TEST( e == x2 );
+        BOOST_TEST( a.compare_exchange_strong( e, x1 ) );
+        BOOST_TEST( a.load() == x1 );
+    }
+
+    {
+        Y y1 = { 1, 1.5f };
+        Y y2 = { 2, 2.5f };
+
+        boost::atomic< Y > a;
+        a.store( y1 );
+        BOOST_TEST( a.load().i == 1 && a.load().f == 1.5f );
+
+        Y e = y1;
+        BOOST_TEST( a.compare_exchange_strong( e, y2 ) );
+        BOOST_TEST( a.load().i == 2 && a.load().f == 2.5f );
+    }
+
+    {
+        boost::atomic< color > a( green );
+        BOOST_TEST( a == green );
+
+        a = blue;
+        BOOST_TEST( a.exchange( red ) == blue );
+
+        color e = red;
+        BOOST_TEST( a.compare_exchange_strong( e, green ) );
+        BOOST_TEST( a == green );
+    }
+
+    {
+        boost::atomic< bool > a( false );
+        BOOST_TEST( !a );
+
+        BOOST_TEST( !a.exchange( true ) );
+        BOOST_TEST( a );
+
+        bool e = false;
+        BOOST_TEST( !a.compare_exchange_strong( e, false ) );
+        BOOST_TEST( e );
+    }
+
+    {
+        boost::atomic< double > a( 0.5 );
+        BOOST_TEST( a == 0.5 );
+
+        a = 1.5;
+        BOOST_TEST( a.exchange( 2.5 ) == 1.5 );
+    }
+}
+
+void test_pointer()
+{
+    int v[ 8 ] = { 0 };
+
+    boost::atomic< int* > a( v );
+    BOOST_TEST( a == v );
+
+    BOOST_TEST( a.fetch_add( 2 ) == v );
+    BOOST_TEST( a == v + 2 );
+
+    BOOST_TEST( a.fetch_sub( 1 ) == v + 2 );
+    BOOST_TEST( a == v + 1 );
+
+    BOOST_TEST( ++a == v + 2 );
+    BOOST_TEST( a++ == v + 2 );
+    BOOST_TEST( --a == v + 2 );
+    BOOST_TEST( a-- == v + 2 );
+    BOOST_TEST( ( a += 4 ) == v + 5 );
+    BOOST_TEST( ( a -= 5 ) == v );
+
+    int * e = v + 1;
+    BOOST_TEST( !a.compare_exchange_strong( e, v + 7 ) );
+    BOOST_TEST( e == v );
+    BOOST_TEST( a.compare_exchange_strong( e, v + 7 ) );
+    BOOST_TEST( a.exchange( 0 ) == v + 7 );
+    BOOST_TEST( a == 0 );
+
+    boost::atomic< void* > b( v );
+    BOOST_TEST( b.exchange( 0 ) == v );
+}
+
+void test_flag()
+{
+    boost::atomic_flag f;
+
+    BOOST_TEST( !f.test_and_set() );
+    BOOST_TEST( f.test_and_set() );
+
+    f.clear();
+    BOOST_TEST( !f.test_and_set( boost::memory_order_acquire ) );
+
+    f.clear( boost::memory_order_release );
+}
+
+void test_lock_free()
+{
+    BOOST_TEST( boost::atomic< int >().is_lock_free() == ( BOOST_ATOMIC_INT_LOCK_FREE == 2 ) );
+    BOOST_TEST( boost::atomic< long >().is_lock_free() == ( BOOST_ATOMIC_LONG_LOCK_FREE == 2 ) );
+    BOOST_TEST( boost::atomic< void* >().is_lock_free() == ( BOOST_ATOMIC_POINTER_LOCK_FREE == 2 ) );
+
+#if defined( BOOST_ATOMIC_USE_SPINLOCK )
+
+    BOOST_TEST( !boost::atomic< char >().is_lock_free() );
+
+#endif
+}
+
+int main()
+{
+    test_integral< char >();
+    test_integral< signed char >();
+    test_integral< unsigned char >();
+    test_integral< short >();
+    test_integral< unsigned short >();
+    test_integral< int >();
+    test_integral< unsigned >();
+    test_integral< long >();
+    test_integral< unsigned long >();
+
+#if defined( BOOST_HAS_LONG_LONG )
+
+    test_integral< boost::long_long_type >();
+    test_integral< boost::ulong_long_type >();
+
+#endif
+
+    test_bitwise();
+    test_pointer();
+    test_flag();
+    test_lock_free();
+
+    boost::atomic_thread_fence( boost::memory_order_seq_cst );
+    boost::atomic_thread_fence( boost::memory_order_acquire );
+    boost::atomic_signal_fence( boost::memory_order_seq_cst );
+
+    return boost::report_errors();
+}
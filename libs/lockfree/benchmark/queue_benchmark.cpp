@@ -0,0 +1,212 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Compares each queue in Boost.Lockfree with a std::deque protected by a
+//  boost::mutex, the usual way of passing work between threads.
+//
+//  Throughput is the number of items per second passed from the producers
+//  to the consumers. Latency is the mean time for an item to travel from
+//  one thread to another and back through a pair of queues.
+//
+//  Usage: queue_benchmark [<items>] [<threads>]
+
+#include <boost/lockfree/queue.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/bind.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+#include <boost/ref.hpp>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+
+namespace
+{
+    // The baseline: an unbounded queue protected by a mutex.
+    template<typename T>
+    class locked_queue
+    {
+    public:
+        explicit locked_queue(std::size_t)
+        {}
+
+        bool push(T const& value)
+        {
+            boost::lock_guard<boost::mutex> lk(m);
+            items.push_back(value);
+            return true;
+        }
+
+        bool pop(T& value)
+        {
+            boost::lock_guard<boost::mutex> lk(m);
+            if(items.empty())
+            {
+                return false;
+            }
+            value=items.front();
+            items.pop_front();
+            return true;
+        }
+
+    private:
+        boost::mutex m;
+        std::deque<T> items;
+    };
+
+    // mpsc_queue::push() cannot fail, so adapt it to the common interface.
+    template<typename T>
+    class unbounded_mpsc_queue:
+        public boost::lockfree::mpsc_queue<T>
+    {
+    public:
+        explicit unbounded_mpsc_queue(std::size_t capacity):
+            boost::lockfree::mpsc_queue<T>(capacity)
+        {}
+
+        bool push(T const& value)
+        {
+            boost::lockfree::mpsc_queue<T>::push(value);
+            return true;
+        }
+    };
+
+    std::size_t const queue_capacity=1024;
+
+    template<typename Queue>
+    void produce(Queue& q,unsigned long count)
+    {
+        for(unsigned long i=0;i<count;++i)
+        {
+            while(!q.push(i))
+            {
+                boost::this_thread::yield();
+            }
+        }
+    }
+
+    template<typename Queue>
+    void consume(Queue& q,unsigned long count)
+    {
+        unsigned long value;
+        for(unsigned long i=0;i<count;++i)
+        {
+            while(!q.pop(value))
+            {
+                boost::this_thread::yield();
+            }
+        }
+    }
+
+    double seconds_since(boost::system_time const& start)
+    {
+        return (boost::get_system_time()-start).total_microseconds()/1000000.0;
+    }
+
+    template<typename Queue>
+    double items_per_second(unsigned producers,unsigned consumers,unsigned long items)
+    {
+        Queue q(queue_capacity);
+        unsigned long const per_producer=items/producers;
+        unsigned long const per_consumer=per_producer*producers/consumers;
+        boost::thread_group threads;
+        boost::system_time const start=boost::get_system_time();
+        for(unsigned i=0;i<consumers;++i)
+        {
+            threads.create_thread(boost::bind(consume<Queue>,boost::ref(q),per_consumer));
+        }
+        for(unsigned i=0;i<producers;++i)
+        {
+            threads.create_thread(boost::bind(produce<Queue>,boost::ref(q),per_producer));
+        }
+        threads.join_all();
+        return per_consumer*consumers/seconds_since(start);
+    }
+
+    // Spins briefly, then yields, so that the latency test also works when
+    // there are fewer cores than threads.
+    template<typename Queue>
+    void spin_push(Queue& q,unsigned long value)
+    {
+        for(unsigned k=0;!q.push(value);++k)
+        {
+            boost::detail::yield(k);
+        }
+    }
+
+    template<typename Queue>
+    void spin_pop(Queue& q,unsigned long& value)
+    {
+        for(unsigned k=0;!q.pop(value);++k)
+        {
+            boost::detail::yield(k);
+        }
+    }
+
+    template<typename Queue>
+    void echo(Queue& in,Queue& out,unsigned long count)
+    {
+        unsigned long value;
+        for(unsigned long i=0;i<count;++i)
+        {
+            spin_pop(in,value);
+            spin_push(out,value);
+        }
+    }
+
+    template<typename Queue>
+    double round_trip_nanoseconds(unsigned long trips)
+    {
+        Queue ping(queue_capacity);
+        Queue pong(queue_capacity);
+        boost::thread echoer(boost::bind(echo<Queue>,boost::ref(ping),boost::ref(pong),trips));
+        unsigned long value;
+        boost::system_time const start=boost::get_system_time();
+        for(unsigned long i=0;i<trips;++i)
+        {
+            spin_push(ping,i);
+            spin_pop(pong,value);
+        }
+        double const elapsed=seconds_since(start);
+        echoer.join();
+        return elapsed*1e9/trips;
+    }
+
+    template<typename Queue,typename Baseline>
+    void compare(char const* name,unsigned producers,unsigned consumers,unsigned long items)
+    {
+        double const lockfree=items_per_second<Queue>(producers,consumers,items);
+        double const locked=items_per_second<Baseline>(producers,consumers,items);
+        std::cout<<name<<'\t'<<producers<<'/'<<consumers<<'\t'
+                 <<lockfree<<'\t'<<locked<<'\t'<<lockfree/locked<<std::endl;
+    }
+}
+
+int main(int argc,char* argv[])
+{
+    unsigned long const items=argc>1?std::atol(argv[1]):4000000;
+    unsigned const hardware=boost::thread::hardware_concurrency();
+    unsigned const threads=argc>2?std::atoi(argv[2]):(hardware>2?hardware/2:1);
+
+    typedef locked_queue<unsigned long> baseline;
+
+    std::cout<<"throughput (items/s)\n"
+             <<"queue\tprod/cons\tlockfree\tmutex\tratio"<<std::endl;
+    compare<boost::lockfree::spsc_queue<unsigned long>,baseline>("spsc",1,1,items);
+    compare<boost::lockfree::mpmc_queue<unsigned long>,baseline>("mpmc",threads,threads,items);
+    compare<unbounded_mpsc_queue<unsigned long>,baseline>("mpsc",threads,1,items);
+
+    unsigned long const trips=items/20;
+    std::cout<<"\nround trip latency (ns)\n"
+             <<"queue\tlockfree\tmutex"<<std::endl;
+    std::cout<<"spsc\t"<<round_trip_nanoseconds<boost::lockfree::spsc_queue<unsigned long> >(trips)
+             <<'\t'<<round_trip_nanoseconds<baseline>(trips)<<std::endl;
+    std::cout<<"mpmc\t"<<round_trip_nanoseconds<boost::lockfree::mpmc_queue<unsigned long> >(trips)
+             <<'\t'<<round_trip_nanoseconds<baseline>(trips)<<std::endl;
+    std::cout<<"mpsc\t"<<round_trip_nanoseconds<unbounded_mpsc_queue<unsigned long> >(trips)
+             <<'\t'<<round_trip_nanoseconds<baseline>(trips)<<std::endl;
+}
@@ -0,0 +1,147 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  Compares two ways of letting readers use an object that a writer
+//  replaces from time to time: taking a copy of a shared_ptr with
+//  boost::atomic_load, which locks a spinlock from a pool and updates the
+//  reference count, and reading a plain pointer inside an epoch_guard, with
+//  the old objects passed to epoch_domain::retire.
+//
+//  Usage: reclamation_benchmark [<reads per thread>] [<readers>]
+
+#include <boost/lockfree/epoch.hpp>
+#include <boost/atomic.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+    struct settings
+    {
+        unsigned long values[4];
+
+        explicit settings(unsigned long v)
+        {
+            for(unsigned i=0;i<4;++i)
+            {
+                values[i]=v;
+            }
+        }
+
+        unsigned long sum() const
+        {
+            return values[0]+values[1]+values[2]+values[3];
+        }
+    };
+
+    // Readers and writers for a shared_ptr updated with atomic_store.
+    struct shared_ptr_policy
+    {
+        boost::shared_ptr<settings> current;
+
+        shared_ptr_policy():
+            current(boost::make_shared<settings>(0))
+        {}
+
+        unsigned long read()
+        {
+            boost::shared_ptr<settings> const p=boost::atomic_load(&current);
+            return p->sum();
+        }
+
+        void update(unsigned long v)
+        {
+            boost::atomic_store(&current,boost::make_shared<settings>(v));
+        }
+    };
+
+    // Readers and writers for a plain pointer protected by an epoch_domain.
+    struct epoch_policy
+    {
+        boost::lockfree::epoch_domain domain;
+        boost::atomic<settings*> current;
+
+        epoch_policy():
+            current(new settings(0))
+        {}
+
+        ~epoch_policy()
+        {
+            delete current.load();
+        }
+
+        unsigned long read()
+        {
+            boost::lockfree::epoch_guard guard(domain);
+            return current.load(boost::memory_order_acquire)->sum();
+        }
+
+        void update(unsigned long v)
+        {
+            settings* const old=current.exchange(new settings(v),boost::memory_order_acq_rel);
+            domain.retire(old);
+        }
+    };
+
+    template<typename Policy>
+    void reader(Policy& policy,unsigned long reads,unsigned long& checksum)
+    {
+        unsigned long sum=0;
+        for(unsigned long i=0;i<reads;++i)
+        {
+            sum+=policy.read();
+        }
+        checksum=sum;
+    }
+
+    template<typename Policy>
+    void writer(Policy& policy,boost::atomic<bool>& done)
+    {
+        for(unsigned long v=1;!done.load(boost::memory_order_relaxed);++v)
+        {
+            policy.update(v);
+            boost::this_thread::sleep(boost::posix_time::microseconds(100));
+        }
+    }
+
+    template<typename Policy>
+    double reads_per_second(unsigned readers,unsigned long reads)
+    {
+        Policy policy;
+        boost::atomic<bool> done(false);
+        std::vector<unsigned long> checksums(readers);
+        boost::thread updater(boost::bind(writer<Policy>,boost::ref(policy),boost::ref(done)));
+        boost::thread_group threads;
+        boost::system_time const start=boost::get_system_time();
+        for(unsigned i=0;i<readers;++i)
+        {
+            threads.create_thread(boost::bind(reader<Policy>,boost::ref(policy),reads,boost::ref(checksums[i])));
+        }
+        threads.join_all();
+        double const elapsed=(boost::get_system_time()-start).total_microseconds()/1000000.0;
+        done.store(true,boost::memory_order_relaxed);
+        updater.join();
+        return readers*reads/elapsed;
+    }
+}
+
+int main(int argc,char* argv[])
+{
+    unsigned long const reads=argc>1?std::atol(argv[1]):10000000;
+    unsigned const hardware=boost::thread::hardware_concurrency();
+    unsigned const readers=argc>2?std::atoi(argv[2]):(hardware>1?hardware-1:1);
+
+    double const epoch=reads_per_second<epoch_policy>(readers,reads);
+    double const shared=reads_per_second<shared_ptr_policy>(readers,reads);
+
+    std::cout<<"readers\tepoch (reads/s)\tatomic shared_ptr (reads/s)\tratio\n"
+             <<readers<<'\t'<<epoch<<'\t'<<shared<<'\t'<<epoch/shared<<std::endl;
+}
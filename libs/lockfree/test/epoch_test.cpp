@@ -0,0 +1,279 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/epoch.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/scoped_array.hpp>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+    boost::atomic<int> live_count(0);
+
+    struct counted
+    {
+        unsigned value;
+        bool alive;
+
+        explicit counted(unsigned value_):
+            value(value_),alive(true)
+        {
+            ++live_count;
+        }
+
+        ~counted()
+        {
+            alive=false;
+            --live_count;
+        }
+    };
+
+    // Each collect() advances the epoch at most once, and a batch needs
+    // two advances.
+    void collect_all(boost::lockfree::epoch_domain& domain)
+    {
+        for(unsigned i=0;i<3;++i)
+        {
+            domain.collect();
+        }
+    }
+
+    void hold_guard(boost::lockfree::epoch_domain& domain,boost::barrier& entered,boost::barrier& release)
+    {
+        boost::lockfree::epoch_guard guard(domain);
+        entered.wait();
+        release.wait();
+    }
+
+    // Retired by a thread whose reclaim function then holds an
+    // epoch_guard until released.
+    struct guarded_reclaim
+    {
+        boost::lockfree::epoch_domain* domain;
+        boost::barrier* entered;
+        boost::barrier* release;
+
+        static void reclaim(void* p)
+        {
+            guarded_reclaim& self=*static_cast<guarded_reclaim*>(p);
+            boost::lockfree::epoch_guard guard(*self.domain);
+            self.entered->wait();
+            self.release->wait();
+        }
+    };
+
+    void retire_guarded_reclaim(guarded_reclaim& object)
+    {
+        object.domain->retire(&object,&guarded_reclaim::reclaim);
+        collect_all(*object.domain);
+    }
+
+    void retire_and_exit(boost::lockfree::epoch_domain& domain,unsigned count)
+    {
+        for(unsigned i=0;i<count;++i)
+        {
+            boost::lockfree::epoch_guard guard(domain);
+            domain.retire(new counted(i));
+        }
+    }
+
+    unsigned const reader_count=3;
+    unsigned const updates=20000;
+
+    // The objects shared with the readers are never freed, only marked as
+    // reclaimed, so a reader that sees one too late reads valid memory.
+    struct node
+    {
+        boost::atomic<bool> reclaimed;
+
+        node():
+            reclaimed(false)
+        {}
+
+        static void reclaim(void* p)
+        {
+            static_cast<node*>(p)->reclaimed.store(true,boost::memory_order_relaxed);
+        }
+    };
+
+    void read(boost::lockfree::epoch_domain& domain,boost::atomic<node*>& shared,
+              boost::atomic<bool>& done,boost::atomic<unsigned>& errors)
+    {
+        while(!done.load(boost::memory_order_acquire))
+        {
+            boost::lockfree::epoch_guard guard(domain);
+            node* const p=shared.load(boost::memory_order_acquire);
+            for(unsigned i=0;i<100;++i)
+            {
+                if(p->reclaimed.load(boost::memory_order_relaxed))
+                {
+                    ++errors;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(retired_object_is_reclaimed_after_two_epochs)
+{
+    boost::lockfree::epoch_domain domain;
+    domain.retire(new counted(0));
+    BOOST_CHECK_EQUAL(live_count.load(),1);
+    collect_all(domain);
+    BOOST_CHECK_EQUAL(live_count.load(),0);
+}
+
+BOOST_AUTO_TEST_CASE(custom_reclaim_function_is_called)
+{
+    struct local
+    {
+        static void reclaim(void* p)
+        {
+            *static_cast<bool*>(p)=true;
+        }
+    };
+
+    bool reclaimed=false;
+    boost::lockfree::epoch_domain domain;
+    domain.retire(&reclaimed,&local::reclaim);
+    collect_all(domain);
+    BOOST_CHECK(reclaimed);
+}
+
+BOOST_AUTO_TEST_CASE(pinned_thread_delays_reclamation)
+{
+    boost::lockfree::epoch_domain domain;
+    boost::barrier entered(2);
+    boost::barrier release(2);
+    boost::thread reader(hold_guard,boost::ref(domain),boost::ref(entered),boost::ref(release));
+    entered.wait();
+
+    domain.retire(new counted(0));
+    for(unsigned i=0;i<10;++i)
+    {
+        domain.collect();
+    }
+    BOOST_CHECK_EQUAL(live_count.load(),1);
+
+    release.wait();
+    reader.join();
+    collect_all(domain);
+    BOOST_CHECK_EQUAL(live_count.load(),0);
+}
+
+BOOST_AUTO_TEST_CASE(guard_inside_reclaim_function_delays_reclamation)
+{
+    boost::lockfree::epoch_domain domain;
+    boost::barrier entered(2);
+    boost::barrier release(2);
+    guarded_reclaim object={&domain,&entered,&release};
+    boost::thread reclaimer(retire_guarded_reclaim,boost::ref(object));
+    entered.wait();
+
+    domain.retire(new counted(0));
+    for(unsigned i=0;i<10;++i)
+    {
+        domain.collect();
+    }
+    BOOST_CHECK_EQUAL(live_count.load(),1);
+
+    release.wait();
+    reclaimer.join();
+    collect_all(domain);
+    BOOST_CHECK_EQUAL(live_count.load(),0);
+}
+
+BOOST_AUTO_TEST_CASE(nested_guards_and_retire_inside_guard)
+{
+    boost::lockfree::epoch_domain domain;
+    {
+        boost::lockfree::epoch_guard outer(domain);
+        {
+            boost::lockfree::epoch_guard inner(domain);
+            domain.retire(new counted(0));
+        }
+        domain.collect();
+        domain.collect();
+        BOOST_CHECK_EQUAL(live_count.load(),1);
+    }
+    collect_all(domain);
+    BOOST_CHECK_EQUAL(live_count.load(),0);
+}
+
+BOOST_AUTO_TEST_CASE(exiting_thread_hands_over_retired_objects)
+{
+    boost::lockfree::epoch_domain domain;
+    boost::thread t(retire_and_exit,boost::ref(domain),10);
+    t.join();
+    BOOST_CHECK_EQUAL(live_count.load(),10);
+    collect_all(domain);
+    BOOST_CHECK_EQUAL(live_count.load(),0);
+
+    // The exited thread's record is reused.
+    boost::thread t2(retire_and_exit,boost::ref(domain),200);
+    t2.join();
+    collect_all(domain);
+    BOOST_CHECK_EQUAL(live_count.load(),0);
+}
+
+BOOST_AUTO_TEST_CASE(destroying_domain_reclaims_everything)
+{
+    {
+        boost::lockfree::epoch_domain domain;
+        for(unsigned i=0;i<100;++i)
+        {
+            domain.retire(new counted(i));
+        }
+        boost::thread t(retire_and_exit,boost::ref(domain),10);
+        t.join();
+    }
+    BOOST_CHECK_EQUAL(live_count.load(),0);
+
+    // A new domain, possibly at the same address, starts afresh.
+    boost::lockfree::epoch_domain domain;
+    domain.retire(new counted(0));
+    collect_all(domain);
+    BOOST_CHECK_EQUAL(live_count.load(),0);
+}
+
+BOOST_AUTO_TEST_CASE(readers_never_see_reclaimed_objects)
+{
+    boost::scoped_array<node> nodes(new node[updates+1]);
+    boost::lockfree::epoch_domain domain;
+    boost::atomic<node*> shared(&nodes[0]);
+    boost::atomic<bool> done(false);
+    boost::atomic<unsigned> errors(0);
+
+    boost::thread_group readers;
+    for(unsigned i=0;i<reader_count;++i)
+    {
+        readers.create_thread(boost::bind(read,boost::ref(domain),boost::ref(shared),
+                                          boost::ref(done),boost::ref(errors)));
+    }
+    for(unsigned i=1;i<=updates;++i)
+    {
+        node* const old=shared.exchange(&nodes[i],boost::memory_order_acq_rel);
+        domain.retire(old,&node::reclaim);
+        if(!(i%16))
+        {
+            boost::this_thread::yield();
+        }
+    }
+    done.store(true,boost::memory_order_release);
+    readers.join_all();
+
+    BOOST_CHECK_EQUAL(errors.load(),0u);
+    collect_all(domain);
+    BOOST_CHECK(nodes[updates-1].reclaimed.load());
+    BOOST_CHECK(!nodes[updates].reclaimed.load());
+}
@@ -0,0 +1,123 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpmc_queue.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+    unsigned const thread_count=4;
+    unsigned const items_per_thread=200000;
+
+    void produce(boost::lockfree::mpmc_queue<unsigned>& q,unsigned id)
+    {
+        for(unsigned i=0;i<items_per_thread;++i)
+        {
+            while(!q.push(id*items_per_thread+i))
+            {
+                boost::this_thread::yield();
+            }
+        }
+    }
+
+    void consume(boost::lockfree::mpmc_queue<unsigned>& q,std::vector<unsigned>& seen)
+    {
+        for(unsigned i=0;i<items_per_thread;++i)
+        {
+            unsigned value;
+            while(!q.pop(value))
+            {
+                boost::this_thread::yield();
+            }
+            seen.push_back(value);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(capacity_is_rounded_up_to_a_power_of_two)
+{
+    boost::lockfree::mpmc_queue<int> q(5);
+    BOOST_CHECK_EQUAL(q.capacity(),8U);
+    for(int i=0;i<8;++i)
+    {
+        BOOST_CHECK(q.push(i));
+    }
+    BOOST_CHECK(!q.push(8));
+    BOOST_CHECK_THROW(boost::lockfree::mpmc_queue<int> empty(0),std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(single_thread_is_fifo_across_laps)
+{
+    boost::lockfree::mpmc_queue<std::string> q(4);
+    BOOST_CHECK(q.empty());
+    std::string s;
+    for(int lap=0;lap<10;++lap)
+    {
+        BOOST_CHECK(q.push("a"));
+        BOOST_CHECK(q.push("b"));
+        BOOST_CHECK(q.push("c"));
+        BOOST_CHECK(!q.empty());
+        BOOST_CHECK(q.pop(s));
+        BOOST_CHECK_EQUAL(s,"a");
+        BOOST_CHECK(q.pop(s));
+        BOOST_CHECK_EQUAL(s,"b");
+        BOOST_CHECK(q.pop(s));
+        BOOST_CHECK_EQUAL(s,"c");
+    }
+    BOOST_CHECK(!q.pop(s));
+    BOOST_CHECK(q.empty());
+    q.push(std::string(100,'x'));
+}
+
+BOOST_AUTO_TEST_CASE(every_item_is_delivered_exactly_once)
+{
+    boost::lockfree::mpmc_queue<unsigned> q(64);
+    std::vector<unsigned> seen[thread_count];
+    boost::thread_group threads;
+    for(unsigned i=0;i<thread_count;++i)
+    {
+        threads.create_thread(boost::bind(produce,boost::ref(q),i));
+        threads.create_thread(boost::bind(consume,boost::ref(q),boost::ref(seen[i])));
+    }
+    threads.join_all();
+
+    std::vector<unsigned> count(thread_count*items_per_thread);
+    unsigned out_of_order=0;
+    for(unsigned t=0;t<thread_count;++t)
+    {
+        std::vector<int> previous(thread_count,-1);
+        for(unsigned i=0;i<seen[t].size();++i)
+        {
+            unsigned const value=seen[t][i];
+            ++count[value];
+            // Items from one producer reach each consumer in order.
+            int const index=static_cast<int>(value%items_per_thread);
+            if(index<=previous[value/items_per_thread])
+            {
+                ++out_of_order;
+            }
+            previous[value/items_per_thread]=index;
+        }
+    }
+    unsigned wrong=0;
+    for(unsigned i=0;i<count.size();++i)
+    {
+        if(count[i]!=1)
+        {
+            ++wrong;
+        }
+    }
+    BOOST_CHECK_EQUAL(wrong,0U);
+    BOOST_CHECK_EQUAL(out_of_order,0U);
+    BOOST_CHECK(q.empty());
+}
@@ -0,0 +1,92 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/mpsc_queue.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+    unsigned const thread_count=4;
+    unsigned const items_per_thread=200000;
+
+    void produce(boost::lockfree::mpsc_queue<unsigned>& q,unsigned id)
+    {
+        for(unsigned i=0;i<items_per_thread;++i)
+        {
+            q.push(id*items_per_thread+i);
+        }
+    }
+
+    void push_after_delay(boost::lockfree::mpsc_queue<std::string>& q)
+    {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+        q.push("late");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(single_thread_is_fifo)
+{
+    boost::lockfree::mpsc_queue<std::string> q(2);
+    BOOST_CHECK(q.empty());
+    for(int i=0;i<10;++i)
+    {
+        q.push(std::string(1,static_cast<char>('a'+i)));
+    }
+    BOOST_CHECK(!q.empty());
+    std::string s;
+    for(int i=0;i<10;++i)
+    {
+        BOOST_CHECK(q.pop(s));
+        BOOST_CHECK_EQUAL(s,std::string(1,static_cast<char>('a'+i)));
+    }
+    BOOST_CHECK(!q.pop(s));
+    BOOST_CHECK(q.empty());
+    q.push(std::string(100,'x'));
+}
+
+BOOST_AUTO_TEST_CASE(wait_and_pop_blocks_until_an_item_is_pushed)
+{
+    boost::lockfree::mpsc_queue<std::string> q;
+    boost::thread producer(boost::bind(push_after_delay,boost::ref(q)));
+    std::string s;
+    q.wait_and_pop(s);
+    BOOST_CHECK_EQUAL(s,"late");
+    producer.join();
+}
+
+BOOST_AUTO_TEST_CASE(items_from_each_producer_arrive_once_and_in_order)
+{
+    boost::lockfree::mpsc_queue<unsigned> q(64);
+    boost::thread_group producers;
+    for(unsigned i=0;i<thread_count;++i)
+    {
+        producers.create_thread(boost::bind(produce,boost::ref(q),i));
+    }
+
+    std::vector<int> previous(thread_count,-1);
+    unsigned out_of_order=0;
+    for(unsigned i=0;i<thread_count*items_per_thread;++i)
+    {
+        unsigned value;
+        q.wait_and_pop(value);
+        int const index=static_cast<int>(value%items_per_thread);
+        if(index!=previous[value/items_per_thread]+1)
+        {
+            ++out_of_order;
+        }
+        previous[value/items_per_thread]=index;
+    }
+    producers.join_all();
+    BOOST_CHECK_EQUAL(out_of_order,0U);
+    BOOST_CHECK(q.empty());
+}
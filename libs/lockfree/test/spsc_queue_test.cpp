@@ -0,0 +1,93 @@
+//  Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <string>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+    unsigned const item_count=1000000;
+
+    void produce(boost::lockfree::spsc_queue<unsigned>& q)
+    {
+        for(unsigned i=0;i<item_count;++i)
+        {
+            while(!q.push(i))
+            {
+                boost::this_thread::yield();
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(fills_to_capacity_and_empties_in_order)
+{
+    boost::lockfree::spsc_queue<std::string> q(3);
+    BOOST_CHECK_EQUAL(q.capacity(),3U);
+    BOOST_CHECK(q.empty());
+    BOOST_CHECK(q.push("one"));
+    BOOST_CHECK(q.push("two"));
+    BOOST_CHECK(q.push("three"));
+    BOOST_CHECK(!q.push("four"));
+    BOOST_CHECK(!q.empty());
+
+    std::string s;
+    BOOST_CHECK(q.pop(s));
+    BOOST_CHECK_EQUAL(s,"one");
+    BOOST_CHECK(q.push("four"));
+    BOOST_CHECK(q.pop(s));
+    BOOST_CHECK_EQUAL(s,"two");
+    BOOST_CHECK(q.pop(s));
+    BOOST_CHECK_EQUAL(s,"three");
+    BOOST_CHECK(q.pop(s));
+    BOOST_CHECK_EQUAL(s,"four");
+    BOOST_CHECK(!q.pop(s));
+    BOOST_CHECK(q.empty());
+}
+
+BOOST_AUTO_TEST_CASE(destructor_destroys_remaining_elements)
+{
+    boost::lockfree::spsc_queue<std::string> q(8);
+    q.push(std::string(100,'x'));
+    q.push(std::string(100,'y'));
+}
+
+BOOST_AUTO_TEST_CASE(zero_capacity_is_rejected)
+{
+    BOOST_CHECK_THROW(boost::lockfree::spsc_queue<int> q(0),std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(producer_and_consumer_threads_see_every_item_in_order)
+{
+    boost::lockfree::spsc_queue<unsigned> q(100);
+    boost::thread producer(boost::bind(produce,boost::ref(q)));
+    unsigned mismatches=0;
+    for(unsigned expected=0;expected<item_count;)
+    {
+        unsigned value;
+        if(q.pop(value))
+        {
+            if(value!=expected)
+            {
+                ++mismatches;
+            }
+            ++expected;
+        }
+        else
+        {
+            boost::this_thread::yield();
+        }
+    }
+    producer.join();
+    BOOST_CHECK_EQUAL(mismatches,0U);
+    BOOST_CHECK(q.empty());
+}
@@ -0,0 +1,206 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         dfa_throughput.cpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Measures search throughput over a synthetic log file,
+  *                with and without the lazy DFA.
+  */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <boost/timer.hpp>
+#include <boost/regex.hpp>
+
+namespace{
+
+//
+// Builds roughly mb megabytes of log lines, the same every run:
+//
+std::string make_log(unsigned mb)
+{
+   static const char* levels[] = { "INFO", "DEBUG", "INFO", "WARN", "INFO", "TRACE", "INFO", "ERROR" };
+   static const char* words[] = { "request", "served", "from", "cache", "client", "connection", "closed", "timeout", "user", "session", "started", "payload" };
+   std::string text;
+   unsigned seed = 1;
+   while(text.size() < mb * 1024u * 1024u)
+   {
+      seed = seed * 1103515245u + 12345u;
+      unsigned r = seed >> 8;
+      char buf[64];
+      std::sprintf(buf, "2011-06-%02u %02u:%02u:%02u ", 1 + r % 28, r % 24, (r / 24) % 60, (r / 1440) % 60);
+      text.append(buf);
+      text.append(levels[r % 8]);
+      std::sprintf(buf, " [10.%u.%u.%u] ", r % 256, (r / 256) % 256, (r / 65536) % 256);
+      text.append(buf);
+      for(unsigned i = 0; i < 8 + r % 8; ++i)
+      {
+         seed = seed * 1103515245u + 12345u;
+         text.append(words[(seed >> 8) % 12]);
+         text.append(1, ' ');
+      }
+      text.append(1, '\n');
+   }
+   return text;
+}
+
+//
+// Returns the time taken to find every match, or a negative value if the
+// matcher gave up on the expression:
+//
+double time_find_all(const boost::regex& e, const std::string& text, boost::match_flag_type flags, unsigned& count)
+{
+   try{
+   boost::timer tim;
+   double result = 1e300;
+   for(int repeats = 0; repeats < 3; ++repeats)
+   {
+      count = 0;
+      tim.restart();
+      boost::sregex_iterator i(text.begin(), text.end(), e, flags), j;
+      for(; i != j; ++i)
+         ++count;
+      result = (std::min)(result, tim.elapsed());
+   }
+   return result;
+   }
+   catch(const std::exception& ex)
+   {
+      std::cout << "Exception: " << ex.what() << std::endl;
+      return -1;
+   }
+}
+
+void test(const char* expression, const std::string& text)
+{
+   boost::regex e(expression);
+   unsigned dfa_count, perl_count;
+   double dfa_time = time_find_all(e, text, boost::match_default, dfa_count);
+   double perl_time = time_find_all(e, text, boost::match_no_dfa, perl_count);
+   double mb = text.size() / (1024.0 * 1024.0);
+
+   std::cout << expression << "\n   " << (e.get_data().m_dfa ? "lazy DFA" : "no DFA  ");
+   if(dfa_time > 0)
+      std::cout << std::setw(10) << mb / dfa_time << " MB/s";
+   else
+      std::cout << "          -     ";
+   std::cout << "   backtracking ";
+   if(perl_time > 0)
+      std::cout << std::setw(10) << mb / perl_time << " MB/s";
+   else
+      std::cout << "          -     ";
+   if((dfa_time > 0) && (perl_time > 0) && (dfa_count != perl_count))
+      std::cout << "   MATCH COUNTS DIFFER: " << dfa_count << " vs " << perl_count;
+   std::cout << std::endl;
+}
+
+//
+// Finds which of the expressions match in each of the given ranges, all at
+// once and then one at a time, and prints the throughput of each:
+//
+void time_set(const boost::regex_set& set, const std::vector<std::string::const_iterator>& bounds, const char* title)
+{
+   boost::set_match_results<std::string::const_iterator> what;
+   boost::timer tim;
+   double set_time = 1e300, each_time = 1e300;
+   unsigned set_count = 0, each_count = 0;
+   for(int repeats = 0; repeats < 3; ++repeats)
+   {
+      tim.restart();
+      set_count = 0;
+      for(std::size_t j = 0; j + 1 < bounds.size(); j += 2)
+      {
+         regex_search(bounds[j], bounds[j + 1], what, set, boost::match_any);
+         set_count += static_cast<unsigned>(what.count());
+      }
+      set_time = (std::min)(set_time, tim.elapsed());
+      tim.restart();
+      each_count = 0;
+      for(std::size_t j = 0; j + 1 < bounds.size(); j += 2)
+      {
+         for(unsigned i = 0; i < set.size(); ++i)
+            each_count += regex_search(bounds[j], bounds[j + 1], set[i], boost::match_any);
+      }
+      each_time = (std::min)(each_time, tim.elapsed());
+   }
+   std::size_t size = 0;
+   for(std::size_t j = 0; j + 1 < bounds.size(); j += 2)
+      size += bounds[j + 1] - bounds[j];
+   double mb = size / (1024.0 * 1024.0);
+   std::cout << "   " << title << " regex_set"
+      << std::setw(10) << mb / set_time << " MB/s   one at a time "
+      << std::setw(10) << mb / each_time << " MB/s";
+   if(set_count != each_count)
+      std::cout << "   MATCH COUNTS DIFFER: " << set_count << " vs " << each_count;
+   std::cout << std::endl;
+}
+
+void test_set(const char* const* expressions, unsigned count, const std::string& text, unsigned max_lines)
+{
+   boost::regex_set set;
+   for(unsigned i = 0; i < count; ++i)
+      set.add(expressions[i]);
+   std::cout << "set of " << count << " expressions" << std::endl;
+   //
+   // Over the whole text each expression on its own can skip ahead to its
+   // literal, while the set has to run its DFA over every character:
+   //
+   std::vector<std::string::const_iterator> bounds;
+   bounds.push_back(text.begin());
+   bounds.push_back(text.end());
+   time_set(set, bounds, "whole text");
+   //
+   // Line by line the set reads each line once where the expressions
+   // between them read it once each:
+   //
+   bounds.clear();
+   std::string::const_iterator i = text.begin();
+   while((i != text.end()) && (bounds.size() < 2 * max_lines))
+   {
+      std::string::const_iterator j = std::find(i, text.end(), '\n');
+      bounds.push_back(i);
+      bounds.push_back(j);
+      i = (j == text.end()) ? j : j + 1;
+   }
+   time_set(set, bounds, "per line  ");
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+   unsigned mb = argc > 1 ? std::atoi(argv[1]) : 16;
+   std::string text = make_log(mb ? mb : 1);
+
+   test("ERROR|FATAL|panic", text);
+   test("\\b(?:timeout|closed)\\b", text);
+   test("WARN|ERROR [^\\n]*timeout", text);
+   test("10\\.[0-9]{1,3}\\.[0-9]{1,3}\\.25[0-5]", text);
+   test("[0-9]{2}:[0-9]{2}:5[0-9] (?:ERROR|WARN)", text);
+   test("^[^\\n]*(?:client|user)[^\\n]*timeout", text);
+   test("(?:a|e|i|o|u)[a-z]*?d\\b", text);
+   // pathological for a backtracking matcher:
+   test("(?:[a-z]+[a-z]+)+[!?]", text);
+
+   static const char* const alerts[] = {
+      "FATAL", "panic", "segfault", "out of memory", "deadlock", "\\bcorrupt\\w*", "disk full",
+      "refused", "10\\.0\\.0\\.[0-9]+", "ERROR [^\\n]*payload timeout", "overflow",
+      "assert(?:ion)? failed", "null pointer", "core dumped", "killed", "retry limit" };
+   test_set(alerts, sizeof(alerts) / sizeof(alerts[0]), text, 100000);
+   return 0;
+}
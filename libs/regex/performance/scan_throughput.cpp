@@ -0,0 +1,109 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+ /*
+  *   LOCATION:    see http://www.boost.org for most recent version.
+  *   FILE         scan_throughput.cpp
+  *   VERSION      see <boost/version.hpp>
+  *   DESCRIPTION: Measures search throughput over a large text that mostly
+  *                doesn't match, with and without scanning ahead for
+  *                literals and start characters.
+  */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <deque>
+#include <cstdlib>
+#include <boost/timer.hpp>
+#include <boost/regex.hpp>
+
+namespace{
+
+//
+// Builds roughly mb megabytes of lower case words, the same every run,
+// with the word "needle" about once in every 64K:
+//
+std::string make_text(unsigned mb)
+{
+   static const char* words[] = { "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel", "india", "juliet", "kilo", "lima" };
+   std::string text;
+   unsigned seed = 1;
+   while(text.size() < mb * 1024u * 1024u)
+   {
+      seed = seed * 1103515245u + 12345u;
+      unsigned r = seed >> 8;
+      text.append(((r % 8192) == 0) ? "needle" : words[r % 12]);
+      text.append(1, (r % 16) ? ' ' : '\n');
+   }
+   return text;
+}
+
+//
+// Returns the time taken to find every match in [first, last):
+//
+template <class Iterator>
+double time_find_all(const boost::regex& e, Iterator first, Iterator last, unsigned& count)
+{
+   boost::timer tim;
+   double result = 1e300;
+   for(int repeats = 0; repeats < 3; ++repeats)
+   {
+      count = 0;
+      tim.restart();
+      boost::regex_iterator<Iterator> i(first, last, e), j;
+      for(; i != j; ++i)
+         ++count;
+      result = (std::min)(result, tim.elapsed());
+   }
+   return result;
+}
+
+void test(const char* expression, const std::string& text, const std::deque<char>& copy)
+{
+   //
+   // A std::string is searched by scanning ahead, a std::deque isn't
+   // contiguous and so is searched one character at a time:
+   //
+   boost::regex e(expression);
+   unsigned scan_count, char_count;
+   double scan_time = time_find_all(e, text.begin(), text.end(), scan_count);
+   double char_time = time_find_all(e, copy.begin(), copy.end(), char_count);
+   double mb = text.size() / (1024.0 * 1024.0);
+
+   std::cout << expression << "\n   scanning ahead " << std::setw(10) << mb / scan_time
+      << " MB/s   one character at a time " << std::setw(10) << mb / char_time << " MB/s";
+   if(scan_count != char_count)
+      std::cout << "   MATCH COUNTS DIFFER: " << scan_count << " vs " << char_count;
+   std::cout << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+   unsigned mb = argc > 1 ? std::atoi(argv[1]) : 32;
+   std::string text = make_text(mb ? mb : 1);
+   std::deque<char> copy(text.begin(), text.end());
+
+   // a literal that starts every match:
+   test("needle", text, copy);
+   test("needle [a-z]+", text, copy);
+   // a few characters that can start a match:
+   test("[nNx][a-z]*dle", text, copy);
+   test("needle|Needle|xylophone", text, copy);
+   // a literal that every match contains, but not at the start:
+   test("[a-z]+ needle", text, copy);
+   test("\\w+\\s+haystack\\s+\\w+", text, copy);
+   // nothing to scan for:
+   test("[a-z]+le\\b", text, copy);
+   return 0;
+}
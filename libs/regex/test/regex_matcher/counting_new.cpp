@@ -0,0 +1,72 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+//
+// Replacement operator new and delete that count the allocations made.
+// They are kept out of the test's own translation unit so that they are
+// not inlined into it, and every form is replaced so that each allocation
+// is paired with the matching deallocation:
+//
+
+#include <cstdlib>
+#include <new>
+
+namespace{ unsigned long allocations = 0; }
+
+unsigned long allocation_count()
+{
+   return allocations;
+}
+
+void* operator new(std::size_t n) throw(std::bad_alloc)
+{
+   ++allocations;
+   void* p = std::malloc(n ? n : 1);
+   if(p == 0)
+      throw std::bad_alloc();
+   return p;
+}
+
+void* operator new[](std::size_t n) throw(std::bad_alloc)
+{
+   return operator new(n);
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) throw()
+{
+   ++allocations;
+   return std::malloc(n ? n : 1);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t&) throw()
+{
+   return operator new(n, std::nothrow);
+}
+
+void operator delete(void* p) throw()
+{
+   std::free(p);
+}
+
+void operator delete[](void* p) throw()
+{
+   std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) throw()
+{
+   std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) throw()
+{
+   std::free(p);
+}
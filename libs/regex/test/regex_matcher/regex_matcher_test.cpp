@@ -0,0 +1,176 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <boost/regex.hpp>
+#include <boost/test/test_tools.hpp>
+#include <cstring>
+#include <string>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+//
+// count the allocations made, so that we can check there aren't any.
+// The replacement operator new and delete are in counting_new.cpp:
+//
+unsigned long allocation_count();
+
+namespace{
+
+struct test_case
+{
+   const char* expression;
+   boost::regex::flag_type syntax;
+   boost::match_flag_type flags;
+};
+
+const test_case cases[] =
+{
+   { "needle", boost::regex::perl, boost::match_default },
+   { "(\\w+)\\s+(\\d+)", boost::regex::perl, boost::match_default },
+   { "(a|b|ab)*c", boost::regex::perl, boost::match_default },
+   { "(\\w+)\\s+\\1", boost::regex::perl, boost::match_default },
+   { "(x|y)+?y$", boost::regex::perl, boost::match_default },
+   { "(a|ab)(c|bcd)(d*)", boost::regex::extended, boost::match_default },
+   { "[a-z]+", boost::regex::perl, boost::match_any },
+   { "(\\w+)\\s+(\\d+)", boost::regex::perl, boost::match_no_dfa },
+   { "ERROR.*timeout", boost::regex::perl, boost::match_not_dot_newline },
+   { "^(\\w+) \\w+$", boost::regex::perl, boost::match_not_bol },
+   { "\\b(\\w+)\\b", boost::regex::perl, boost::match_prev_avail },
+   { "^\\w+|\\w+$", boost::regex::perl, boost::match_not_bol | boost::match_not_eol },
+};
+
+const char* texts[] =
+{
+   "",
+   "a haystack with a needle in it",
+   "word 123 other 45",
+   "ababababababababababababababababababc",
+   "the the cat",
+   "xyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxyxy",
+   "abcd",
+   "ERROR: a timeout\nERROR: another\ntimeout",
+};
+
+const unsigned case_count = sizeof(cases) / sizeof(cases[0]);
+const unsigned text_count = sizeof(texts) / sizeof(texts[0]);
+
+const char* text_start(const char* text, boost::match_flag_type flags)
+{
+   // with match_prev_avail the character before the start must be readable:
+   if((flags & boost::match_prev_avail) && *text)
+      ++text;
+   return text;
+}
+
+void check_same(const boost::cmatch& a, const boost::cmatch& b)
+{
+   BOOST_CHECK(a.size() == b.size());
+   for(unsigned i = 0; (i < a.size()) && (i < b.size()); ++i)
+   {
+      BOOST_CHECK(a[i].matched == b[i].matched);
+      if(a[i].matched && b[i].matched)
+      {
+         BOOST_CHECK(a[i].first == b[i].first);
+         BOOST_CHECK(a[i].second == b[i].second);
+      }
+   }
+}
+
+void test_results(boost::cregex_matcher& matcher)
+{
+   //
+   // the matcher must find what regex_search and regex_match find:
+   //
+   for(unsigned c = 0; c < case_count; ++c)
+   {
+      boost::regex e(cases[c].expression, cases[c].syntax);
+      for(unsigned t = 0; t < text_count; ++t)
+      {
+         const char* p = text_start(texts[t], cases[c].flags);
+         const char* end = p + std::strlen(p);
+         boost::cmatch m;
+         bool found = boost::regex_search(p, end, m, e, cases[c].flags);
+         BOOST_CHECK(found == matcher.search(p, end, e, cases[c].flags));
+         if(found && !(cases[c].flags & boost::match_any))
+            check_same(matcher.results(), m);
+         found = boost::regex_match(p, end, m, e, cases[c].flags);
+         BOOST_CHECK(found == matcher.match(p, end, e, cases[c].flags));
+         if(found)
+            check_same(matcher.results(), m);
+      }
+   }
+}
+
+void test_no_allocations()
+{
+   //
+   // once the matcher has seen a search, doing it again allocates nothing:
+   //
+   boost::cregex_matcher matcher;
+   for(unsigned c = 0; c < case_count; ++c)
+   {
+      boost::regex e(cases[c].expression, cases[c].syntax);
+      for(unsigned t = 0; t < text_count; ++t)
+      {
+         const char* p = text_start(texts[t], cases[c].flags);
+         const char* end = p + std::strlen(p);
+         matcher.search(p, end, e, cases[c].flags);
+         matcher.match(p, end, e, cases[c].flags);
+      }
+      unsigned long before = allocation_count();
+      for(int n = 0; n < 10; ++n)
+      {
+         for(unsigned t = 0; t < text_count; ++t)
+         {
+            const char* p = text_start(texts[t], cases[c].flags);
+            const char* end = p + std::strlen(p);
+            matcher.search(p, end, e, cases[c].flags);
+            matcher.match(p, end, e, cases[c].flags);
+         }
+      }
+      BOOST_CHECK_EQUAL(allocation_count(), before);
+   }
+}
+
+void test_deep_backtracking()
+{
+   //
+   // a search that needs many blocks of backtracking state keeps them:
+   //
+   std::string text(20000, 'a');
+   std::string short_text(1000, 'a');
+   short_text += 'b';
+   boost::regex e("(a)*[bc]");
+   boost::sregex_matcher matcher;
+   boost::match_flag_type flags = boost::match_continuous | boost::match_no_dfa;
+   BOOST_CHECK(!matcher.search(text.begin(), text.end(), e, flags));
+   unsigned long before = allocation_count();
+   BOOST_CHECK(matcher.search(short_text.begin(), short_text.end(), e, flags));
+   BOOST_CHECK(matcher.results().length() == 1001);
+   BOOST_CHECK_EQUAL(allocation_count(), before);
+   matcher.release();
+   BOOST_CHECK(matcher.results().empty());
+}
+
+}
+
+int test_main( int , char* [] )
+{
+   boost::cregex_matcher matcher;
+   test_results(matcher);
+   test_no_allocations();
+   test_deep_backtracking();
+   return 0;
+}
+
+#include <boost/test/included/test_exec_monitor.hpp>
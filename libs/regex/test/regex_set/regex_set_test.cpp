@@ -0,0 +1,203 @@
+/*
+ *
+ * Copyright (c) 2011
+ * John Maddock
+ *
+ * Use, modification and distribution are subject to the
+ * Boost Software License, Version 1.0. (See accompanying file
+ * LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+ *
+ */
+
+#include <boost/regex.hpp>
+#include <boost/test/test_tools.hpp>
+#include <cstring>
+#include <list>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_INTEL
+#pragma warning(disable:1418 981 983 383)
+#endif
+
+namespace{
+
+const char* expressions[] =
+{
+   "ERROR|FATAL",
+   "\\btime(?:out)?\\b",
+   "[0-9]+ms",
+   "(a)(b)?c",
+   "x*",
+   "^client",
+   "timeout [0-9]+",
+   "(\\w+)\\1",       // has a back-reference so is never in the DFA
+};
+
+const char* texts[] =
+{
+   "",
+   "INFO request served in 12ms",
+   "WARN client timeout 30000ms\nclient closed",
+   "ERROR abc ac FATAL xx",
+   "time timeout timeouts wordword",
+   "nothing here",
+   "client",
+};
+
+const unsigned expression_count = sizeof(expressions) / sizeof(expressions[0]);
+const unsigned text_count = sizeof(texts) / sizeof(texts[0]);
+
+void check_same(const boost::cmatch& a, const boost::cmatch& b)
+{
+   BOOST_CHECK(a.size() == b.size());
+   for(unsigned i = 0; (i < a.size()) && (i < b.size()); ++i)
+   {
+      BOOST_CHECK(a[i].matched == b[i].matched);
+      if(a[i].matched && b[i].matched)
+      {
+         BOOST_CHECK(a[i].first == b[i].first);
+         BOOST_CHECK(a[i].second == b[i].second);
+      }
+   }
+}
+
+template <class charT>
+void test_search(const boost::basic_regex_set<charT>& set, boost::match_flag_type flags)
+{
+   //
+   // the set must find what searching for each expression finds:
+   //
+   for(unsigned t = 0; t < text_count; ++t)
+   {
+      std::basic_string<charT> text(texts[t], texts[t] + std::strlen(texts[t]));
+      typedef typename std::basic_string<charT>::const_iterator iterator;
+      boost::set_match_results<iterator> what;
+      bool any = regex_search(text, what, set, flags);
+      BOOST_CHECK(what.size() == set.size());
+      BOOST_CHECK(any == regex_search(text, set, flags));
+      BOOST_CHECK(any == (what.count() != 0));
+      for(unsigned i = 0; i < set.size(); ++i)
+      {
+         boost::match_results<iterator> m;
+         bool found = regex_search(text, m, set[i], flags);
+         BOOST_CHECK(found == what.matched(i));
+         if(found && what.matched(i) && !(flags & boost::match_any))
+         {
+            BOOST_CHECK(what[i].position() == m.position());
+            BOOST_CHECK(what[i].length() == m.length());
+            BOOST_CHECK(what[i].size() == m.size());
+         }
+      }
+   }
+}
+
+void test_iterator(const boost::regex_set& set, boost::match_flag_type flags)
+{
+   //
+   // iterating over the set must find what iterating over the
+   // alternation of the expressions finds:
+   //
+   std::string alternation;
+   std::vector<unsigned> first_mark;
+   unsigned marks = 1;
+   for(unsigned i = 0; i < set.size(); ++i)
+   {
+      if(i)
+         alternation += '|';
+      alternation += "(";
+      first_mark.push_back(marks);
+      marks += static_cast<unsigned>(set[i].mark_count());
+      alternation += set[i].str();
+      alternation += ")";
+   }
+   // the back-reference numbering differs in the alternation, so skip it:
+   if(alternation.find("\\1") != std::string::npos)
+      return;
+   boost::regex e(alternation);
+   for(unsigned t = 0; t < text_count; ++t)
+   {
+      const char* p = texts[t];
+      const char* end = p + std::strlen(p);
+      boost::cregex_set_iterator i(p, end, set, flags), j;
+      boost::cregex_iterator k(p, end, e, flags), l;
+      for(; (i != j) && (k != l); ++i, ++k)
+      {
+         BOOST_CHECK(i->position() == k->position());
+         BOOST_CHECK(i->length() == k->length());
+         BOOST_CHECK((*k)[first_mark[i.index()]].matched);
+         boost::cmatch m;
+         BOOST_CHECK(regex_search(p + i->position(), end, m, set[i.index()], flags | boost::match_continuous, p));
+         check_same(*i, m);
+      }
+      BOOST_CHECK(i == j);
+      BOOST_CHECK(k == l);
+   }
+}
+
+void test_bidirectional()
+{
+   //
+   // regex_set_iterator works with any bidirectional iterator, as
+   // regex_iterator does:
+   //
+   std::string text(texts[2]);
+   for(int n = 0; n < 10; ++n)
+      text += text;
+   boost::regex_set set;
+   set.add("timeout [0-9]+");
+   set.add("client");
+   std::vector<std::size_t> counts(set.size());
+   typedef std::list<char>::const_iterator iterator;
+   std::list<char> input(text.begin(), text.end());
+   boost::regex_set_iterator<iterator> i(input.begin(), input.end(), set), j;
+   for(; i != j; ++i)
+      ++counts[i.index()];
+   BOOST_CHECK(counts[0] == 1024);
+   BOOST_CHECK(counts[1] == 2048);
+}
+
+}
+
+int test_main( int , char* [] )
+{
+   boost::regex_set set;
+   BOOST_CHECK(set.empty());
+   for(unsigned i = 0; i < expression_count; ++i)
+   {
+      BOOST_CHECK(set.add(expressions[i]) == i);
+      test_search(set, boost::match_default);
+      test_search(set, boost::match_any);
+      test_search(set, boost::match_not_bol | boost::match_not_bow);
+      test_search(set, boost::match_no_dfa);
+      test_iterator(set, boost::match_default);
+      test_iterator(set, boost::match_no_dfa);
+   }
+   BOOST_CHECK(set.size() == expression_count);
+   // copies share the DFA, adding to one of them doesn't change the other:
+   boost::regex_set small;
+   small.add("ERROR");
+   BOOST_CHECK(regex_search("an ERROR", small));
+   boost::regex_set copy(small);
+   copy.add("nothing");
+   BOOST_CHECK(copy.size() == small.size() + 1);
+   BOOST_CHECK(!regex_search("nothing", small));
+   BOOST_CHECK(regex_search("nothing", copy));
+   set.clear();
+   BOOST_CHECK(set.empty());
+   BOOST_CHECK(!regex_search("ERROR", set));
+
+#ifndef BOOST_NO_WREGEX
+   boost::wregex_set wset;
+   for(unsigned i = 0; i < expression_count; ++i)
+   {
+      std::string s(expressions[i]);
+      wset.add(std::wstring(s.begin(), s.end()));
+   }
+   test_search(wset, boost::match_default);
+#endif
+   test_bidirectional();
+   return 0;
+}
+
+#include <boost/test/included/test_exec_monitor.hpp>
@@ -197,4 +197,43 @@ void test_nosubs()
    TEST_REGEX_SEARCH("(a*)*", perl|nosubs, "bc", match_default, make_array(0, 0, -2, 1, 1, -2, 2, 2, -2, -2));
 }
 
+void test_fast_scan()
+{
+   using namespace boost::regex_constants;
+   //
+   // narrow contiguous text is scanned 16 characters at a time for a literal
+   // that every match contains, or for the characters that can start one,
+   // so these texts are longer than two blocks.
+   //
+   // a leading literal either side of a block boundary, and ending on the last character:
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "abc1------------------------------------", match_default, make_array(0, 4, -2, -2));
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "---------------abc1---------------------", match_default, make_array(15, 19, -2, -2));
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "----------------abc1--------------------", match_default, make_array(16, 20, -2, -2));
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "-----------------abc1-------------------", match_default, make_array(17, 21, -2, -2));
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "------------------------------------abc1", match_default, make_array(36, 40, -2, -2));
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "----------------abc1--------------------", match_default|match_no_dfa, make_array(16, 20, -2, -2));
+   // the literal is found but doesn't start a match:
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "---abc------------------------abc7------", match_default, make_array(30, 34, -2, -2));
+   // the literal is absent, though the text comes close:
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "--abXd----ab-1-bc2-aXc3-----------ab-bc-", match_default, make_array(-2, -2));
+   TEST_REGEX_SEARCH("abc[0-9]", perl, "--abXd----ab-1-bc2-aXc3-----------ab-bc-", match_default|match_no_dfa, make_array(-2, -2));
+   TEST_REGEX_SEARCH("abcdef", perl, "---abXdef-----------abcdeX-abcdf-------a", match_default, make_array(-2, -2));
+   // first and last characters in place but not the middle, then a match:
+   TEST_REGEX_SEARCH("abcdef", perl, "---abXdef-----------abcdeX-abcdef-------", match_default, make_array(27, 33, -2, -2));
+   // a literal that isn't a prefix, across the first and second block boundaries:
+   TEST_REGEX_SEARCH("[0-9]+abcdef", perl, "-----------12abcdef---------------------", match_default, make_array(11, 19, -2, -2));
+   TEST_REGEX_SEARCH("[0-9]+abcdef", perl, "---------------------------12abcdef-----", match_default, make_array(27, 35, -2, -2));
+   TEST_REGEX_SEARCH("[0-9]+abcdef", perl, "--------------------------------12abcdef", match_default, make_array(32, 40, -2, -2));
+   TEST_REGEX_SEARCH("[0-9]+abcdef", perl, "-----------12abcdef---------------------", match_default|match_no_dfa, make_array(11, 19, -2, -2));
+   TEST_REGEX_SEARCH("[0-9]+abcdef", perl, "-----------12abcdXf---------------------", match_default, make_array(-2, -2));
+   // two or three characters that can start a match:
+   TEST_REGEX_SEARCH("[xy]z*", perl, "yz--------------------------------------", match_default, make_array(0, 2, -2, -2));
+   TEST_REGEX_SEARCH("[xy]z*", perl, "---------------yz-----------------------", match_default, make_array(15, 17, -2, -2));
+   TEST_REGEX_SEARCH("[xy]z*", perl, "----------------yz----------------------", match_default, make_array(16, 18, -2, -2));
+   TEST_REGEX_SEARCH("[xy]z*", perl, "-----------------yz---------------------", match_default, make_array(17, 19, -2, -2));
+   TEST_REGEX_SEARCH("[xy]z*", perl, "---------------------------------------y", match_default, make_array(39, 40, -2, -2));
+   TEST_REGEX_SEARCH("[xy]z*", perl, "----------------yz----------------------", match_default|match_no_dfa, make_array(16, 18, -2, -2));
+   TEST_REGEX_SEARCH("[xyw]z*", perl, "---------------wz-------------xzz------y", match_default, make_array(15, 17, -2, 30, 33, -2, 39, 40, -2, -2));
+   TEST_REGEX_SEARCH("[xyw]z*", perl, "----------------------------------------", match_default, make_array(-2, -2));
+}
 
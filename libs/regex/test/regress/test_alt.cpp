@@ -40,6 +40,10 @@ void test_alt()
    TEST_INVALID_REGEX("(|a)", perl|no_empty_expressions);
    TEST_REGEX_SEARCH("(|a)", perl, " a", match_default, make_array(0, 0, 0, 0, -2, 1, 1, 1, 1, -2, 1, 2, 1, 2, -2, 2, 2, 2, 2, -2, -2));
    TEST_REGEX_SEARCH("a\\|", perl, "a|", match_default, make_array(0, 2, -2, -2));
+   // the leftmost match ends after a later-starting one:
+   TEST_REGEX_SEARCH("abcd|b", perl, "xabcd", match_default, make_array(1, 5, -2, -2));
+   TEST_REGEX_SEARCH("abcd|b", perl, "xabcd", match_any, make_array(1, 5, -2, -2));
+   TEST_REGEX_SEARCH("x(?:abcdef|c)|cd", perl, "yxabcdef", match_any, make_array(1, 8, -2, -2));
 
    TEST_REGEX_SEARCH("a|", basic, "a|", match_default, make_array(0, 2, -2, -2));
    TEST_REGEX_SEARCH("a\\|", basic, "a|", match_default, make_array(0, 2, -2, -2));
@@ -93,6 +93,9 @@ void test_assertion_escapes()
    TEST_REGEX_SEARCH("\\>", perl, "  ", match_default, make_array(-2, -2));
    TEST_REGEX_SEARCH(".\\>.", perl, "  ", match_default, make_array(-2, -2));
    TEST_REGEX_SEARCH("abc\\>", perl, "abc", match_default|match_not_eow, make_array(-2, -2));
+   // word assertions after a repeat must not mask out the repeated characters:
+   TEST_REGEX_SEARCH("(?:ba*)*\\>", perl, "bab", match_default, make_array(0, 3, -2, 3, 3, -2, -2));
+   TEST_REGEX_SEARCH("(?: a*)*\\<", perl, " a b", match_default, make_array(0, 3, -2, 3, 3, -2, -2));
    // word boundary:
    TEST_REGEX_SEARCH("\\babcd", perl, "  abcd", match_default, make_array(2, 6, -2, -2));
    TEST_REGEX_SEARCH("\\bab", perl, "cab", match_default, make_array(-2, -2));
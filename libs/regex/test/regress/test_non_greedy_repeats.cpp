@@ -39,6 +39,9 @@ void test_non_greedy_repeats()
    TEST_REGEX_SEARCH("xx.{0,2}?(?:[+-][0-9])??\\z", perl, "xx--", match_default, make_array(0, 4, -2, -2));
    TEST_REGEX_SEARCH("xx.{0,2}?(?:[+-][0-9])??\\z", perl, "xx--", match_default|match_not_dot_newline, make_array(0, 4, -2, -2));
    TEST_REGEX_SEARCH("xx[/-]{0,2}?(?:[+-][0-9])??\\z", perl, "xx--", match_default, make_array(0, 4, -2, -2));
+   // a bounded leading repeat must not skip start positions:
+   TEST_REGEX_SEARCH("\\w{0,2}?\\b([^a])", perl, "b1x ", match_default|match_not_bow, make_array(1, 4, 3, 4, -2, -2));
+   TEST_REGEX_SEARCH("[a-c]{0,2}?[^a]+", perl, "aaax", match_default, make_array(1, 4, -2, -2));
    TEST_INVALID_REGEX("a{1,3}{1}", perl);
    TEST_INVALID_REGEX("a**", perl);
 }
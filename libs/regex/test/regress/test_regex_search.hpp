@@ -111,15 +111,39 @@ void test_simple_search(boost::basic_regex<charT, traits>& r)
       opts))
    {
       test_result(what, search_text.begin(), answer_table);
-      // setting match_any should have no effect on the result returned:
+      // setting match_any should have no effect on the result returned,
+      // and the match found must still be the leftmost one:
+      boost::match_results<const_iterator> any_what;
       if(!boost::regex_search(
          search_text.begin(),
          search_text.end(),
+         any_what,
          r,
          opts|boost::regex_constants::match_any))
       {
          BOOST_REGEX_TEST_ERROR("Expected match was not found when using the match_any flag.", charT);
       }
+      else if(boost::re_detail::distance(search_text.begin(), any_what[0].first) != answer_table[0])
+      {
+         BOOST_REGEX_TEST_ERROR(
+            "Error in start location of match when using the match_any flag, found " 
+            << boost::re_detail::distance(search_text.begin(), any_what[0].first) 
+            << ", expected " << answer_table[0] << ".", charT);
+      }
+      // as should disabling the lazy DFA:
+      if(boost::regex_search(
+         search_text.begin(),
+         search_text.end(),
+         what,
+         r,
+         opts|boost::regex_constants::match_no_dfa))
+      {
+         test_result(what, search_text.begin(), answer_table);
+      }
+      else
+      {
+         BOOST_REGEX_TEST_ERROR("Expected match was not found when using the match_no_dfa flag.", charT);
+      }
    }
    else
    {
@@ -137,6 +161,14 @@ void test_simple_search(boost::basic_regex<charT, traits>& r)
       {
          BOOST_REGEX_TEST_ERROR("Unexpected match was found when using the match_any flag.", charT);
       }
+      else if(boost::regex_search(
+         search_text.begin(),
+         search_text.end(),
+         r,
+         opts|boost::regex_constants::match_no_dfa))
+      {
+         BOOST_REGEX_TEST_ERROR("Unexpected match was found when using the match_no_dfa flag.", charT);
+      }
    }
 #ifdef TEST_ROPE
    std::rope<charT> rsearch_text;
@@ -0,0 +1,224 @@
+//
+//  caching_allocator_test.cpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+
+#include <boost/smart_ptr/caching_allocator.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <vector>
+#include <cstdlib>
+#include <new>
+
+#if defined( BOOST_HAS_PTHREADS )
+#include <boost/detail/lightweight_thread.hpp>
+#endif
+
+// count the blocks taken from the heap
+
+boost::atomic< long > heap_allocations( 0 );
+boost::atomic< long > heap_blocks( 0 );
+
+void * operator new( std::size_t n ) throw( std::bad_alloc )
+{
+    void * p = std::malloc( n == 0? 1: n );
+
+    if( p == 0 )
+    {
+        throw std::bad_alloc();
+    }
+
+    ++heap_allocations;
+    ++heap_blocks;
+
+    return p;
+}
+
+void operator delete( void * p ) throw()
+{
+    if( p != 0 )
+    {
+        --heap_blocks;
+        std::free( p );
+    }
+}
+
+struct X
+{
+    static boost::atomic< int > instances;
+
+    int v[ 4 ];
+
+    explicit X( int a = 0 )
+    {
+        v[ 0 ] = a;
+        ++instances;
+    }
+
+    ~X()
+    {
+        --instances;
+    }
+
+private:
+
+    X( X const & );
+    X & operator=( X const & );
+};
+
+boost::atomic< int > X::instances( 0 );
+
+struct Big
+{
+    char data[ 1024 ];
+};
+
+typedef std::vector< boost::shared_ptr< X > > vector_type;
+
+void produce( vector_type & v, int n )
+{
+    for( int i = 0; i < n; ++i )
+    {
+        v.push_back( boost::allocate_shared< X >( boost::caching_allocator< X >(), i ) );
+    }
+}
+
+void consume( vector_type & v )
+{
+    v.clear();
+}
+
+int main()
+{
+    // blocks are reused by the thread that freed them
+
+    {
+        boost::shared_ptr< X > px = boost::allocate_shared< X >( boost::caching_allocator< X >(), 5 );
+
+        BOOST_TEST( px->v[ 0 ] == 5 );
+        BOOST_TEST( X::instances == 1 );
+
+        // the loop below holds two blocks at a time
+        boost::shared_ptr< X > px2 = boost::allocate_shared< X >( boost::caching_allocator< X >() );
+
+        px.reset();
+        px2.reset();
+
+        BOOST_TEST( X::instances == 0 );
+
+        long n = heap_allocations.load();
+
+        for( int i = 0; i < 1000; ++i )
+        {
+            px = boost::allocate_shared< X >( boost::caching_allocator< void >(), i );
+        }
+
+        px.reset();
+
+        BOOST_TEST( heap_allocations.load() == n );
+    }
+
+    // blocks larger than the largest size class come from the heap
+
+    {
+        boost::caching_allocator< Big > a;
+
+        long n = heap_allocations.load();
+
+        Big * p = a.allocate( 1 );
+        a.deallocate( p, 1 );
+
+        BOOST_TEST( heap_allocations.load() == n + 1 );
+
+        std::vector< int, boost::caching_allocator< int > > v;
+
+        for( int i = 0; i < 1000; ++i )
+        {
+            v.push_back( i );
+        }
+
+        BOOST_TEST( v[ 999 ] == 999 );
+    }
+
+#if defined( BOOST_HAS_PTHREADS )
+
+    // blocks freed by another thread return to the owning thread
+
+    {
+        vector_type v;
+        v.reserve( 32 );
+
+        produce( v, 32 );
+        consume( v );
+        produce( v, 32 );
+
+        pthread_t th;
+        boost::detail::lw_thread_create( th, boost::bind( consume, boost::ref( v ) ) );
+        pthread_join( th, 0 );
+
+        BOOST_TEST( X::instances == 0 );
+
+        long n = heap_allocations.load();
+
+        produce( v, 32 );
+        consume( v );
+
+        BOOST_TEST( heap_allocations.load() == n );
+    }
+
+    // blocks outlive the thread that allocated them
+
+    {
+        long blocks = heap_blocks.load();
+
+        vector_type v;
+        v.reserve( 1000 );
+
+        pthread_t th;
+        boost::detail::lw_thread_create( th, boost::bind( produce, boost::ref( v ), 1000 ) );
+        pthread_join( th, 0 );
+
+        BOOST_TEST( X::instances == 1000 );
+
+        v.clear();
+
+        BOOST_TEST( X::instances == 0 );
+
+        std::vector< boost::shared_ptr< X > >().swap( v );
+
+        BOOST_TEST( heap_blocks.load() == blocks );
+    }
+
+    // and threads that exit with nothing outstanding leave nothing behind
+
+    {
+        long blocks = heap_blocks.load();
+
+        for( int i = 0; i < 8; ++i )
+        {
+            vector_type v;
+
+            pthread_t th;
+            boost::detail::lw_thread_create( th, boost::bind( produce, boost::ref( v ), 100 ) );
+            pthread_join( th, 0 );
+
+            boost::detail::lw_thread_create( th, boost::bind( consume, boost::ref( v ) ) );
+            pthread_join( th, 0 );
+        }
+
+        BOOST_TEST( heap_blocks.load() == blocks );
+    }
+
+#endif
+
+    return boost::report_errors();
+}
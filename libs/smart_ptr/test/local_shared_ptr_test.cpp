@@ -0,0 +1,194 @@
+//
+//  local_shared_ptr_test.cpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+
+#include <boost/local_shared_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/detail/lightweight_test.hpp>
+
+struct X
+{
+    static int instances;
+
+    X()
+    {
+        ++instances;
+    }
+
+    virtual ~X()
+    {
+        --instances;
+    }
+
+private:
+
+    X( X const & );
+    X & operator=( X const & );
+};
+
+int X::instances = 0;
+
+struct Y: public X
+{
+};
+
+static int deleter_calls = 0;
+
+void deleter( X * p )
+{
+    ++deleter_calls;
+    delete p;
+}
+
+int main()
+{
+    {
+        boost::local_shared_ptr< X > p;
+
+        BOOST_TEST( p.get() == 0 );
+        BOOST_TEST( !p );
+        BOOST_TEST( p.local_use_count() == 0 );
+
+        boost::shared_ptr< X > q = p;
+
+        BOOST_TEST( q.get() == 0 );
+        BOOST_TEST( q.use_count() == 0 );
+    }
+
+    {
+        boost::local_shared_ptr< X > p( new X );
+
+        BOOST_TEST( X::instances == 1 );
+        BOOST_TEST( p.get() != 0 );
+        BOOST_TEST( p.local_use_count() == 1 );
+
+        boost::local_shared_ptr< X > p2( p );
+
+        BOOST_TEST( p2 == p );
+        BOOST_TEST( p.local_use_count() == 2 );
+
+        {
+            boost::local_shared_ptr< X > p3;
+            p3 = p2;
+
+            BOOST_TEST( p.local_use_count() == 3 );
+        }
+
+        BOOST_TEST( p.local_use_count() == 2 );
+
+        // the local copies hold a single reference to the control block
+        boost::shared_ptr< X > q = p;
+
+        BOOST_TEST( q.get() == p.get() );
+        BOOST_TEST( q.use_count() == 2 );
+
+        p.reset();
+        p2.reset();
+
+        BOOST_TEST( X::instances == 1 );
+        BOOST_TEST( q.use_count() == 1 );
+
+        q.reset();
+
+        BOOST_TEST( X::instances == 0 );
+    }
+
+    {
+        boost::shared_ptr< Y > q( new Y );
+        boost::weak_ptr< Y > w( q );
+
+        boost::local_shared_ptr< X > p( q );
+
+        BOOST_TEST( p.get() == q.get() );
+        BOOST_TEST( p.local_use_count() == 1 );
+        BOOST_TEST( q.use_count() == 2 );
+
+        boost::local_shared_ptr< X > p2( p );
+
+        BOOST_TEST( q.use_count() == 2 );
+
+        q.reset();
+
+        BOOST_TEST( !w.expired() );
+
+        p.reset();
+        p2.reset();
+
+        BOOST_TEST( w.expired() );
+        BOOST_TEST( X::instances == 0 );
+    }
+
+    {
+        boost::local_shared_ptr< Y > p( new Y );
+        boost::local_shared_ptr< X > p2( p );
+
+        BOOST_TEST( p2.get() == p.get() );
+        BOOST_TEST( p.local_use_count() == 2 );
+
+        // aliasing
+        boost::local_shared_ptr< void > p3( p, static_cast< void* >( p.get() ) );
+
+        BOOST_TEST( p3.get() == p.get() );
+        BOOST_TEST( p.local_use_count() == 3 );
+
+        boost::shared_ptr< void > q = p3;
+
+        BOOST_TEST( q.get() == p.get() );
+        BOOST_TEST( q.use_count() == 2 );
+    }
+
+    BOOST_TEST( X::instances == 0 );
+
+    {
+        boost::local_shared_ptr< X > p( new X, deleter );
+
+        BOOST_TEST( X::instances == 1 );
+
+        boost::shared_ptr< X > q = p;
+
+        BOOST_TEST( boost::get_deleter< void(*)( X* ) >( q ) != 0 );
+
+        p.reset( new Y, deleter );
+
+        BOOST_TEST( X::instances == 2 );
+        BOOST_TEST( deleter_calls == 0 );
+
+        q.reset();
+
+        BOOST_TEST( X::instances == 1 );
+        BOOST_TEST( deleter_calls == 1 );
+    }
+
+    BOOST_TEST( X::instances == 0 );
+    BOOST_TEST( deleter_calls == 2 );
+
+#if defined( BOOST_HAS_RVALUE_REFS )
+
+    {
+        boost::local_shared_ptr< X > p( new X );
+        boost::local_shared_ptr< X > p2( static_cast< boost::local_shared_ptr< X > && >( p ) );
+
+        BOOST_TEST( p.get() == 0 );
+        BOOST_TEST( p.local_use_count() == 0 );
+        BOOST_TEST( p2.local_use_count() == 1 );
+
+        p = static_cast< boost::local_shared_ptr< X > && >( p2 );
+
+        BOOST_TEST( p2.get() == 0 );
+        BOOST_TEST( p.local_use_count() == 1 );
+        BOOST_TEST( X::instances == 1 );
+    }
+
+    BOOST_TEST( X::instances == 0 );
+
+#endif
+
+    return boost::report_errors();
+}
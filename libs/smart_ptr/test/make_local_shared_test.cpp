@@ -0,0 +1,152 @@
+//
+//  make_local_shared_test.cpp
+//
+//  Copyright (c) 2011 Peter Dimov
+//
+//  Distributed under the Boost Software License, Version 1.0.
+//  See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt
+//
+
+#include <boost/make_local_shared.hpp>
+#include <boost/local_shared_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/detail/lightweight_test.hpp>
+#include <memory>
+
+class X
+{
+private:
+
+    X( X const & );
+    X & operator=( X const & );
+
+public:
+
+    static int instances;
+
+    int v;
+
+    explicit X( int a1 = 0, int a2 = 0, int a3 = 0, int a4 = 0, int a5 = 0, int a6 = 0, int a7 = 0, int a8 = 0, int a9 = 0 ): v( a1+a2+a3+a4+a5+a6+a7+a8+a9 )
+    {
+        ++instances;
+    }
+
+    ~X()
+    {
+        --instances;
+    }
+};
+
+int X::instances = 0;
+
+class Z: public boost::enable_shared_from_this< Z >
+{
+};
+
+class Thrower
+{
+public:
+
+    Thrower()
+    {
+        throw 5;
+    }
+};
+
+int main()
+{
+    {
+        boost::local_shared_ptr< int > pi = boost::make_local_shared< int >();
+
+        BOOST_TEST( pi.get() != 0 );
+        BOOST_TEST( *pi == 0 );
+        BOOST_TEST( pi.local_use_count() == 1 );
+    }
+
+    {
+        boost::local_shared_ptr< int > pi = boost::make_local_shared< int >( 5 );
+
+        BOOST_TEST( *pi == 5 );
+    }
+
+    {
+        boost::local_shared_ptr< int > pi = boost::allocate_local_shared< int >( std::allocator< int >(), 5 );
+
+        BOOST_TEST( *pi == 5 );
+    }
+
+    {
+        boost::local_shared_ptr< X > pi = boost::make_local_shared< X >();
+        boost::weak_ptr< X > wp;
+
+        {
+            boost::shared_ptr< X > q = pi;
+            wp = q;
+
+            BOOST_TEST( q.use_count() == 2 );
+        }
+
+        BOOST_TEST( X::instances == 1 );
+        BOOST_TEST( pi->v == 0 );
+
+        boost::local_shared_ptr< X > pi2( pi );
+
+        BOOST_TEST( pi.local_use_count() == 2 );
+
+        pi.reset();
+        pi2.reset();
+
+        BOOST_TEST( X::instances == 0 );
+        BOOST_TEST( wp.expired() );
+    }
+
+    {
+        boost::shared_ptr< X > q;
+
+        {
+            boost::local_shared_ptr< X > pi = boost::make_local_shared< X >( 1, 2, 3, 4, 5, 6, 7, 8, 9 );
+
+            BOOST_TEST( pi->v == 45 );
+
+            q = pi;
+        }
+
+        // the control block outlives the local count
+        BOOST_TEST( X::instances == 1 );
+        BOOST_TEST( q.use_count() == 1 );
+        BOOST_TEST( q->v == 45 );
+    }
+
+    BOOST_TEST( X::instances == 0 );
+
+    {
+        boost::local_shared_ptr< X > pi = boost::allocate_local_shared< X >( std::allocator< void >(), 1, 2, 3 );
+
+        BOOST_TEST( pi->v == 6 );
+        BOOST_TEST( X::instances == 1 );
+    }
+
+    BOOST_TEST( X::instances == 0 );
+
+    {
+        boost::local_shared_ptr< Z > pz = boost::make_local_shared< Z >();
+        boost::shared_ptr< Z > q = pz->shared_from_this();
+
+        BOOST_TEST( q.get() == pz.get() );
+        BOOST_TEST( q.use_count() == 2 );
+    }
+
+    try
+    {
+        boost::make_local_shared< Thrower >();
+        BOOST_ERROR( "make_local_shared< Thrower >() did not throw" );
+    }
+    catch( int )
+    {
+    }
+
+    return boost::report_errors();
+}
@@ -0,0 +1,113 @@
+// Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures how the number of read locks per second taken on a shared lookup
+// table scales with the number of reading threads, for boost::shared_mutex
+// and boost::scalable_shared_mutex. Optionally, one further thread updates
+// the table every <write interval> microseconds.
+//
+// Usage: shared_mutex_scaling [<max threads>] [<seconds>] [<write interval>]
+
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/scalable_shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    template<typename Mutex>
+    struct config_table
+    {
+        Mutex m;
+        std::vector<int> values;
+        bool volatile stop;
+        int volatile checksum;
+
+        config_table():
+            values(64),stop(false),checksum(0)
+        {}
+    };
+
+    template<typename Mutex>
+    void reader(config_table<Mutex>& table,boost::barrier& start,unsigned long& reads)
+    {
+        unsigned long count=0;
+        int sum=0;
+        start.wait();
+        while(!table.stop)
+        {
+            boost::shared_lock<Mutex> lk(table.m);
+            sum+=table.values[count%table.values.size()];
+            ++count;
+        }
+        reads=count;
+        table.checksum+=sum;
+    }
+
+    template<typename Mutex>
+    void writer(config_table<Mutex>& table,boost::barrier& start,unsigned interval)
+    {
+        start.wait();
+        while(!table.stop)
+        {
+            boost::this_thread::sleep(boost::posix_time::microseconds(interval));
+            boost::unique_lock<Mutex> lk(table.m);
+            for(unsigned i=0;i<table.values.size();++i)
+            {
+                ++table.values[i];
+            }
+        }
+    }
+
+    template<typename Mutex>
+    double reads_per_second(unsigned threads,unsigned seconds,unsigned write_interval)
+    {
+        config_table<Mutex> table;
+        std::vector<unsigned long> reads(threads);
+        boost::barrier start(threads+(write_interval?2:1));
+        boost::thread_group group;
+        for(unsigned i=0;i<threads;++i)
+        {
+            group.create_thread(boost::bind(reader<Mutex>,boost::ref(table),boost::ref(start),boost::ref(reads[i])));
+        }
+        if(write_interval)
+        {
+            group.create_thread(boost::bind(writer<Mutex>,boost::ref(table),boost::ref(start),write_interval));
+        }
+        start.wait();
+        boost::this_thread::sleep(boost::posix_time::seconds(seconds));
+        table.stop=true;
+        group.join_all();
+
+        unsigned long total=0;
+        for(unsigned i=0;i<threads;++i)
+        {
+            total+=reads[i];
+        }
+        return static_cast<double>(total)/seconds;
+    }
+}
+
+int main(int argc,char* argv[])
+{
+    unsigned const hardware=boost::thread::hardware_concurrency();
+    unsigned const max_threads=argc>1?std::atoi(argv[1]):(hardware?hardware:1);
+    unsigned const seconds=argc>2?std::atoi(argv[2]):2;
+    unsigned const write_interval=argc>3?std::atoi(argv[3]):0;
+
+    std::cout<<"threads\tshared_mutex(reads/s)\tscalable_shared_mutex(reads/s)"<<std::endl;
+    for(unsigned threads=1;threads<=max_threads;++threads)
+    {
+        double const plain=reads_per_second<boost::shared_mutex>(threads,seconds,write_interval);
+        double const scalable=reads_per_second<boost::scalable_shared_mutex>(threads,seconds,write_interval);
+        std::cout<<threads<<'\t'<<plain<<'\t'<<scalable<<std::endl;
+    }
+}
@@ -0,0 +1,148 @@
+// Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures how the time taken to evaluate two fine-grained task trees, a
+// recursive Fibonacci computation and a parallel quicksort, scales with the
+// number of threads in a boost::thread_pool.
+//
+// Usage: thread_pool_scaling [<max threads>] [<fib n>] [<sort size>]
+
+#include <boost/thread/thread_pool.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    // Below these sizes the work is done in the calling task.
+    unsigned const fib_cutoff=12;
+    std::ptrdiff_t const sort_cutoff=1024;
+
+    unsigned long serial_fib(unsigned n)
+    {
+        return n<2?n:serial_fib(n-1)+serial_fib(n-2);
+    }
+
+    template<typename R>
+    R wait_for(boost::thread_pool& pool,boost::unique_future<R>& f)
+    {
+        while(!f.is_ready())
+        {
+            pool.run_pending_task();
+        }
+        return f.get();
+    }
+
+    struct fib_task
+    {
+        typedef unsigned long result_type;
+
+        boost::thread_pool* pool;
+        unsigned n;
+
+        fib_task(boost::thread_pool& pool_,unsigned n_):
+            pool(&pool_),n(n_)
+        {}
+
+        unsigned long operator()() const
+        {
+            if(n<fib_cutoff)
+            {
+                return serial_fib(n);
+            }
+            boost::unique_future<unsigned long> first=pool->submit(fib_task(*pool,n-1));
+            unsigned long const second=fib_task(*pool,n-2)();
+            return wait_for(*pool,first)+second;
+        }
+    };
+
+    struct sort_task
+    {
+        typedef void result_type;
+
+        boost::thread_pool* pool;
+        int* first;
+        int* last;
+
+        sort_task(boost::thread_pool& pool_,int* first_,int* last_):
+            pool(&pool_),first(first_),last(last_)
+        {}
+
+        void operator()() const
+        {
+            if(last-first<sort_cutoff)
+            {
+                std::sort(first,last);
+                return;
+            }
+            int const pivot=first[(last-first)/2];
+            int* const middle1=std::partition(first,last,std::bind2nd(std::less<int>(),pivot));
+            int* const middle2=std::partition(middle1,last,std::not1(std::bind1st(std::less<int>(),pivot)));
+            boost::unique_future<void> lower=pool->submit(sort_task(*pool,first,middle1));
+            sort_task(*pool,middle2,last)();
+            wait_for(*pool,lower);
+        }
+    };
+
+    double seconds_since(boost::system_time const& start)
+    {
+        return (boost::get_system_time()-start).total_microseconds()/1000000.0;
+    }
+}
+
+int main(int argc,char* argv[])
+{
+    unsigned const hardware=boost::thread::hardware_concurrency();
+    unsigned const max_threads=argc>1?std::atoi(argv[1]):(hardware?hardware:1);
+    unsigned const fib_n=argc>2?std::atoi(argv[2]):32;
+    std::size_t const sort_size=argc>3?std::atoi(argv[3]):4000000;
+
+    std::vector<int> input(sort_size);
+    std::srand(1);
+    for(std::size_t i=0;i<input.size();++i)
+    {
+        input[i]=std::rand();
+    }
+
+    std::cout<<"threads\tfib(s)\tspeedup\tsort(s)\tspeedup"<<std::endl;
+    double fib_base=0;
+    double sort_base=0;
+    for(unsigned threads=1;threads<=max_threads;++threads)
+    {
+        boost::thread_pool pool(threads);
+
+        boost::system_time start=boost::get_system_time();
+        boost::unique_future<unsigned long> fib=pool.submit(fib_task(pool,fib_n));
+        unsigned long const fib_result=fib.get();
+        double const fib_time=seconds_since(start);
+        if(fib_result!=serial_fib(fib_n))
+        {
+            std::cerr<<"fib returned the wrong result"<<std::endl;
+            return 1;
+        }
+
+        std::vector<int> data(input);
+        start=boost::get_system_time();
+        boost::unique_future<void> sorted=pool.submit(sort_task(pool,&data[0],&data[0]+data.size()));
+        sorted.wait();
+        double const sort_time=seconds_since(start);
+        if(!std::equal(data.begin()+1,data.end(),data.begin(),std::not2(std::less<int>())))
+        {
+            std::cerr<<"sort produced unsorted output"<<std::endl;
+            return 1;
+        }
+
+        if(threads==1)
+        {
+            fib_base=fib_time;
+            sort_base=sort_time;
+        }
+        std::cout<<threads<<'\t'<<fib_time<<'\t'<<fib_base/fib_time
+                 <<'\t'<<sort_time<<'\t'<<sort_base/sort_time<<std::endl;
+    }
+}
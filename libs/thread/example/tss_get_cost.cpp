@@ -0,0 +1,65 @@
+// Copyright (C) 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measures the cost of boost::thread_specific_ptr<>::get() with 1, 10 and
+// 100 thread_specific_ptr objects holding a value on the calling thread.
+// The keys are read in turn, so every lookup is for a different key.
+//
+// Usage: tss_get_cost [<million lookups>]
+
+#include <boost/thread/tss.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/thread_time.hpp>
+#include <boost/scoped_array.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+    double nanoseconds_per_get(unsigned keys,unsigned long lookups,unsigned long& checksum)
+    {
+        boost::scoped_array<boost::thread_specific_ptr<unsigned long> > values(
+            new boost::thread_specific_ptr<unsigned long>[keys]);
+        for(unsigned i=0;i<keys;++i)
+        {
+            values[i].reset(new unsigned long(i));
+        }
+
+        unsigned long const rounds=lookups/keys;
+        boost::system_time const start=boost::get_system_time();
+        for(unsigned long r=0;r<rounds;++r)
+        {
+            for(unsigned i=0;i<keys;++i)
+            {
+                checksum+=*values[i].get();
+            }
+        }
+        boost::posix_time::time_duration const elapsed=boost::get_system_time()-start;
+        return static_cast<double>(elapsed.total_microseconds())*1000/(rounds*keys);
+    }
+
+    void run(unsigned long lookups,unsigned long& checksum)
+    {
+        unsigned const key_counts[]={1,10,100};
+        std::cout<<"keys\tns/get"<<std::endl;
+        for(unsigned i=0;i<sizeof(key_counts)/sizeof(key_counts[0]);++i)
+        {
+            std::cout<<key_counts[i]<<'\t'<<nanoseconds_per_get(key_counts[i],lookups,checksum)<<std::endl;
+        }
+    }
+}
+
+int main(int argc,char* argv[])
+{
+    unsigned long const lookups=(argc>1?std::atoi(argv[1]):20)*1000000UL;
+    unsigned long checksum=0;
+
+    // A thread started by Boost.Thread, then the main thread, which is not.
+    boost::thread t(run,lookups,boost::ref(checksum));
+    t.join();
+    run(lookups,checksum);
+
+    return checksum==0;
+}
@@ -13,6 +13,7 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/once.hpp>
 #include <boost/thread/tss.hpp>
+#include <boost/thread/pthread/pthread_mutex_scoped_lock.hpp>
 #include <boost/throw_exception.hpp>
 #ifdef __linux__
 #include <sys/sysinfo.h>
@@ -25,6 +26,12 @@
 
 #include "timeconv.inl"
 
+// The key is still needed to run tls_destructor when a thread not started
+// by Boost.Thread exits, but __thread is considerably faster to read.
+#if defined(__GNUC__) && ((__GNUC__*100+__GNUC_MINOR__)>=303) && !defined(__APPLE__)
+#define BOOST_THREAD_HAS_THREAD_KEYWORD
+#endif
+
 namespace boost
 {
     namespace detail
@@ -47,6 +54,25 @@ namespace boost
         {
             boost::once_flag current_thread_tls_init_flag=BOOST_ONCE_INIT;
             pthread_key_t current_thread_tls_key;
+#ifdef BOOST_THREAD_HAS_THREAD_KEYWORD
+            __thread thread_data_base* current_thread_data_cache=0;
+#endif
+
+            bool has_tss_data(thread_data_base* thread_info)
+            {
+                if(!thread_info->orphaned_tss_data.empty())
+                {
+                    return true;
+                }
+                for(std::size_t i=0;i<thread_info->tss_data.size();++i)
+                {
+                    if(thread_info->tss_data[i].generation)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
 
             extern "C"
             {
@@ -55,7 +81,7 @@ namespace boost
                     boost::detail::thread_data_base* thread_info=static_cast<boost::detail::thread_data_base*>(data);
                     if(thread_info)
                     {
-                        while(!thread_info->tss_data.empty() || thread_info->thread_exit_callbacks)
+                        while(has_tss_data(thread_info) || thread_info->thread_exit_callbacks)
                         {
                             while(thread_info->thread_exit_callbacks)
                             {
@@ -68,20 +94,28 @@ namespace boost
                                 }
                                 delete current_node;
                             }
-                            for(std::map<void const*,tss_data_node>::iterator next=thread_info->tss_data.begin(),
-                                    current,
-                                    end=thread_info->tss_data.end();
-                                next!=end;)
+                            while(!thread_info->orphaned_tss_data.empty())
                             {
-                                current=next;
-                                ++next;
-                                if(current->second.func && (current->second.value!=0))
+                                tss_data_node const current(thread_info->orphaned_tss_data.back());
+                                thread_info->orphaned_tss_data.pop_back();
+                                (*current.func)(current.value);
+                            }
+                            // A cleanup function may set further values, so
+                            // each node is copied out of the array before it
+                            // is run.
+                            for(std::size_t i=0;i<thread_info->tss_data.size();++i)
+                            {
+                                tss_data_node const current(thread_info->tss_data[i]);
+                                thread_info->tss_data[i]=tss_data_node();
+                                if(current.func && (current.value!=0))
                                 {
-                                    (*current->second.func)(current->second.value);
+                                    (*current.func)(current.value);
                                 }
-                                thread_info->tss_data.erase(current);
                             }
                         }
+#ifdef BOOST_THREAD_HAS_THREAD_KEYWORD
+                        current_thread_data_cache=0;
+#endif
                         thread_info->self.reset();
                     }
                 }
@@ -96,14 +130,21 @@ namespace boost
         
         boost::detail::thread_data_base* get_current_thread_data()
         {
+#ifdef BOOST_THREAD_HAS_THREAD_KEYWORD
+            return current_thread_data_cache;
+#else
             boost::call_once(current_thread_tls_init_flag,create_current_thread_tls_key);
             return (boost::detail::thread_data_base*)pthread_getspecific(current_thread_tls_key);
+#endif
         }
 
         void set_current_thread_data(detail::thread_data_base* new_data)
         {
             boost::call_once(current_thread_tls_init_flag,create_current_thread_tls_key);
             BOOST_VERIFY(!pthread_setspecific(current_thread_tls_key,new_data));
+#ifdef BOOST_THREAD_HAS_THREAD_KEYWORD
+            current_thread_data_cache=new_data;
+#endif
         }
     }
     
@@ -533,22 +574,60 @@ namespace boost
             current_thread_data->thread_exit_callbacks=new_node;
         }
 
-        tss_data_node* find_tss_data(void const* key)
+        namespace
+        {
+            pthread_mutex_t tss_key_mutex=PTHREAD_MUTEX_INITIALIZER;
+            std::size_t tss_key_count=0;
+            std::size_t last_tss_key_generation=0;
+            // allocated on first use, as a thread_specific_ptr may be
+            // constructed before this file's static objects
+            std::vector<std::size_t>* free_tss_key_indices=0;
+        }
+
+        tss_key allocate_tss_key()
+        {
+            pthread::pthread_mutex_scoped_lock lk(&tss_key_mutex);
+            if(!free_tss_key_indices)
+            {
+                free_tss_key_indices=new std::vector<std::size_t>();
+            }
+            tss_key key;
+            if(free_tss_key_indices->empty())
+            {
+                // reserve the space release_tss_key() needs, so it cannot throw
+                free_tss_key_indices->reserve(tss_key_count+1);
+                key.index=tss_key_count++;
+            }
+            else
+            {
+                key.index=free_tss_key_indices->back();
+                free_tss_key_indices->pop_back();
+            }
+            key.generation=++last_tss_key_generation;
+            return key;
+        }
+
+        void release_tss_key(tss_key key)
+        {
+            pthread::pthread_mutex_scoped_lock lk(&tss_key_mutex);
+            free_tss_key_indices->push_back(key.index);
+        }
+
+        tss_data_node* find_tss_data(tss_key key)
         {
             detail::thread_data_base* const current_thread_data(get_current_thread_data());
-            if(current_thread_data)
+            if(current_thread_data && (key.index<current_thread_data->tss_data.size()))
             {
-                std::map<void const*,tss_data_node>::iterator current_node=
-                    current_thread_data->tss_data.find(key);
-                if(current_node!=current_thread_data->tss_data.end())
+                tss_data_node& current_node=current_thread_data->tss_data[key.index];
+                if(current_node.generation==key.generation)
                 {
-                    return &current_node->second;
+                    return &current_node;
                 }
             }
             return NULL;
         }
 
-        void* get_tss_data(void const* key)
+        void* get_tss_data(tss_key key)
         {
             if(tss_data_node* const current_node=find_tss_data(key))
             {
@@ -557,30 +636,44 @@ namespace boost
             return NULL;
         }
 
-        void add_new_tss_node(void const* key,
+        void add_new_tss_node(tss_key key,
                               boost::shared_ptr<tss_cleanup_function> func,
                               void* tss_data)
         {
             detail::thread_data_base* const current_thread_data(get_or_make_current_thread_data());
-            current_thread_data->tss_data.insert(std::make_pair(key,tss_data_node(func,tss_data)));
+            if(key.index>=current_thread_data->tss_data.size())
+            {
+                current_thread_data->tss_data.resize(key.index+1);
+            }
+            tss_data_node& current_node=current_thread_data->tss_data[key.index];
+            // A value set for a thread_specific_ptr that has since been
+            // destroyed is still cleaned up when the thread exits.
+            if(current_node.func && (current_node.value!=0))
+            {
+                current_thread_data->orphaned_tss_data.push_back(current_node);
+            }
+            current_node.func=func;
+            current_node.value=tss_data;
+            current_node.generation=key.generation;
         }
 
-        void erase_tss_node(void const* key)
-        {
-            detail::thread_data_base* const current_thread_data(get_or_make_current_thread_data());
-            current_thread_data->tss_data.erase(key);
-        }
-        
-        void set_tss_data(void const* key,
+        void set_tss_data(tss_key key,
                           boost::shared_ptr<tss_cleanup_function> func,
                           void* tss_data,bool cleanup_existing)
         {
-            if(tss_data_node* const current_node=find_tss_data(key))
+            if(cleanup_existing)
             {
-                if(cleanup_existing && current_node->func && (current_node->value!=0))
+                tss_data_node* const current_node=find_tss_data(key);
+                if(current_node && current_node->func && (current_node->value!=0))
                 {
-                    (*current_node->func)(current_node->value);
+                    boost::shared_ptr<tss_cleanup_function> const existing_func(current_node->func);
+                    (*existing_func)(current_node->value);
                 }
+            }
+            // The cleanup function may have set other values and moved the
+            // array, so the node is looked up again.
+            if(tss_data_node* const current_node=find_tss_data(key))
+            {
                 if(func || (tss_data!=0))
                 {
                     current_node->func=func;
@@ -588,10 +681,10 @@ namespace boost
                 }
                 else
                 {
-                    erase_tss_node(key);
+                    *current_node=tss_data_node();
                 }
             }
-            else
+            else if(func || (tss_data!=0))
             {
                 add_new_tss_node(key,func,tss_data);
             }
@@ -118,12 +118,12 @@ namespace boost
 
         struct tss_data_node
         {
-            void const* key;
+            std::size_t key;
             boost::shared_ptr<boost::detail::tss_cleanup_function> func;
             void* value;
             tss_data_node* next;
 
-            tss_data_node(void const* key_,boost::shared_ptr<boost::detail::tss_cleanup_function> func_,void* value_,
+            tss_data_node(std::size_t key_,boost::shared_ptr<boost::detail::tss_cleanup_function> func_,void* value_,
                           tss_data_node* next_):
                 key(key_),func(func_),value(value_),next(next_)
             {}
@@ -561,7 +561,25 @@ namespace boost
             current_thread_data->thread_exit_callbacks=new_node;
         }
 
-        tss_data_node* find_tss_data(void const* key)
+        namespace
+        {
+            long last_tss_key_generation=0;
+        }
+
+        // Values are kept in a list searched by generation, which is never
+        // reused, so the key's index is not needed.
+        tss_key allocate_tss_key()
+        {
+            tss_key key;
+            key.index=0;
+            key.generation=static_cast<unsigned long>(BOOST_INTERLOCKED_INCREMENT(&last_tss_key_generation));
+            return key;
+        }
+
+        void release_tss_key(tss_key)
+        {}
+
+        tss_data_node* find_tss_data(tss_key key)
         {
             detail::thread_data_base* const current_thread_data(get_current_thread_data());
             if(current_thread_data)
@@ -569,7 +587,7 @@ namespace boost
                 detail::tss_data_node* current_node=current_thread_data->tss_data;
                 while(current_node)
                 {
-                    if(current_node->key==key)
+                    if(current_node->key==key.generation)
                     {
                         return current_node;
                     }
@@ -579,7 +597,7 @@ namespace boost
             return NULL;
         }
 
-        void* get_tss_data(void const* key)
+        void* get_tss_data(tss_key key)
         {
             if(tss_data_node* const current_node=find_tss_data(key))
             {
@@ -588,7 +606,7 @@ namespace boost
             return NULL;
         }
         
-        void set_tss_data(void const* key,boost::shared_ptr<tss_cleanup_function> func,void* tss_data,bool cleanup_existing)
+        void set_tss_data(tss_key key,boost::shared_ptr<tss_cleanup_function> func,void* tss_data,bool cleanup_existing)
         {
             if(tss_data_node* const current_node=find_tss_data(key))
             {
@@ -603,7 +621,7 @@ namespace boost
             {
                 detail::thread_data_base* const current_thread_data(get_or_make_current_thread_data());
                 tss_data_node* const new_node=
-                    heap_new<tss_data_node>(key,func,tss_data,current_thread_data->tss_data);
+                    heap_new<tss_data_node>(key.generation,func,tss_data,current_thread_data->tss_data);
                 current_thread_data->tss_data=new_node;
             }
         }
@@ -0,0 +1,205 @@
+//  (C) Copyright 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+
+#include <boost/thread/adaptive_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+    unsigned const thread_count=8;
+
+    struct shared_counter
+    {
+        boost::adaptive_mutex m;
+        unsigned value;
+
+        shared_counter():
+            value(0)
+        {}
+    };
+
+    void increment(shared_counter& c,unsigned iterations)
+    {
+        for(unsigned i=0;i<iterations;++i)
+        {
+            boost::lock_guard<boost::adaptive_mutex> lk(c.m);
+            ++c.value;
+        }
+    }
+
+    struct wait_for_flag
+    {
+        boost::adaptive_mutex m;
+        boost::adaptive_condition_variable cond;
+        bool flag;
+        unsigned waiting;
+        unsigned woken;
+
+        wait_for_flag():
+            flag(false),waiting(0),woken(0)
+        {}
+
+        bool is_set() const
+        {
+            return flag;
+        }
+
+        void wait()
+        {
+            boost::unique_lock<boost::adaptive_mutex> lk(m);
+            ++waiting;
+            cond.notify_all();
+            while(!flag)
+            {
+                cond.wait(lk);
+            }
+            ++woken;
+        }
+
+        void wait_until_waiting(unsigned count)
+        {
+            boost::unique_lock<boost::adaptive_mutex> lk(m);
+            while(waiting<count)
+            {
+                cond.wait(lk);
+            }
+        }
+    };
+
+    struct bounded_queue
+    {
+        boost::adaptive_mutex m;
+        boost::adaptive_condition_variable not_empty;
+        boost::adaptive_condition_variable not_full;
+        unsigned items;
+        unsigned long sum;
+
+        bounded_queue():
+            items(0),sum(0)
+        {}
+    };
+
+    void produce(bounded_queue& q,unsigned count)
+    {
+        for(unsigned i=0;i<count;++i)
+        {
+            boost::unique_lock<boost::adaptive_mutex> lk(q.m);
+            while(q.items==4)
+            {
+                q.not_full.wait(lk);
+            }
+            ++q.items;
+            q.not_empty.notify_one();
+        }
+    }
+
+    void consume(bounded_queue& q,unsigned count)
+    {
+        for(unsigned i=0;i<count;++i)
+        {
+            boost::unique_lock<boost::adaptive_mutex> lk(q.m);
+            while(!q.items)
+            {
+                q.not_empty.wait(lk);
+            }
+            --q.items;
+            ++q.sum;
+            q.not_full.notify_all();
+        }
+    }
+}
+
+void test_contended_increments_are_not_lost()
+{
+    unsigned const iterations=100000;
+    shared_counter c;
+    boost::thread_group threads;
+    for(unsigned i=0;i<thread_count;++i)
+    {
+        threads.create_thread(boost::bind(increment,boost::ref(c),iterations));
+    }
+    threads.join_all();
+    BOOST_CHECK_EQUAL(c.value,thread_count*iterations);
+}
+
+void test_timed_lock_fails_while_locked()
+{
+    boost::adaptive_mutex m;
+    m.lock();
+    BOOST_CHECK(!m.try_lock());
+#ifdef BOOST_THREAD_HAS_FUTEX
+    boost::system_time const start=boost::get_system_time();
+    BOOST_CHECK(!m.timed_lock(boost::posix_time::milliseconds(50)));
+    BOOST_CHECK(boost::get_system_time()-start>=boost::posix_time::milliseconds(40));
+#endif
+    m.unlock();
+    BOOST_CHECK(m.try_lock());
+    m.unlock();
+}
+
+void test_notify_all_wakes_every_waiter()
+{
+    wait_for_flag data;
+    boost::thread_group threads;
+    for(unsigned i=0;i<thread_count;++i)
+    {
+        threads.create_thread(boost::bind(&wait_for_flag::wait,&data));
+    }
+    data.wait_until_waiting(thread_count);
+    {
+        boost::lock_guard<boost::adaptive_mutex> lk(data.m);
+        data.flag=true;
+        data.cond.notify_all();
+    }
+    threads.join_all();
+    BOOST_CHECK_EQUAL(data.woken,thread_count);
+}
+
+void test_timed_wait_times_out()
+{
+    wait_for_flag data;
+    boost::unique_lock<boost::adaptive_mutex> lk(data.m);
+    boost::system_time const timeout=boost::get_system_time()+boost::posix_time::milliseconds(50);
+    BOOST_CHECK(!data.cond.timed_wait(lk,timeout,boost::bind(&wait_for_flag::is_set,&data)));
+    BOOST_CHECK(lk.owns_lock());
+    BOOST_CHECK(boost::get_system_time()>=timeout-boost::posix_time::milliseconds(10));
+}
+
+void test_producers_and_consumers()
+{
+    unsigned const items_per_thread=20000;
+    bounded_queue q;
+    boost::thread_group threads;
+    for(unsigned i=0;i<thread_count/2;++i)
+    {
+        threads.create_thread(boost::bind(produce,boost::ref(q),items_per_thread));
+        threads.create_thread(boost::bind(consume,boost::ref(q),items_per_thread));
+    }
+    threads.join_all();
+    BOOST_CHECK_EQUAL(q.items,0U);
+    BOOST_CHECK_EQUAL(q.sum,static_cast<unsigned long>(thread_count/2*items_per_thread));
+}
+
+boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
+{
+    boost::unit_test_framework::test_suite* test =
+        BOOST_TEST_SUITE("Boost.Threads: adaptive_mutex test suite");
+
+    test->add(BOOST_TEST_CASE(test_contended_increments_are_not_lost));
+    test->add(BOOST_TEST_CASE(test_timed_lock_fails_while_locked));
+    test->add(BOOST_TEST_CASE(test_notify_all_wakes_every_waiter));
+    test->add(BOOST_TEST_CASE(test_timed_wait_times_out));
+    test->add(BOOST_TEST_CASE(test_producers_and_consumers));
+
+    return test;
+}
@@ -8,6 +8,7 @@
 #include "boost/thread/mutex.hpp"
 #include "boost/thread/condition.hpp"
 #include "boost/thread/future.hpp"
+#include "boost/weak_ptr.hpp"
 #include <utility>
 #include <memory>
 #include <string>
@@ -1157,6 +1158,198 @@ void test_wait_for_all_five_futures()
 }
 
 
+int add_one(boost::unique_future<int>& f)
+{
+    return f.get()+1;
+}
+
+int add_two_to_shared(boost::shared_future<int>& f)
+{
+    return f.get()+2;
+}
+
+void test_then_on_ready_future_runs_immediately()
+{
+    boost::promise<int> pi;
+    boost::unique_future<int> fi=pi.get_future();
+    pi.set_value(41);
+    boost::unique_future<int> next=fi.then(add_one);
+    BOOST_CHECK(fi.get_state()==boost::future_state::uninitialized);
+    BOOST_CHECK(next.is_ready());
+    BOOST_CHECK(next.get()==42);
+}
+
+void test_then_runs_when_promise_is_fulfilled()
+{
+    boost::promise<int> pi;
+    boost::unique_future<int> fi=pi.get_future();
+    boost::unique_future<int> next=fi.then(add_one).then(add_one);
+    BOOST_CHECK(!next.is_ready());
+    pi.set_value(40);
+    BOOST_CHECK(next.is_ready());
+    BOOST_CHECK(next.get()==42);
+}
+
+void test_then_runs_when_task_completes_on_another_thread()
+{
+    boost::packaged_task<int> task(make_int_slowly);
+    boost::unique_future<int> fi=task.get_future();
+    boost::unique_future<int> next=fi.then(add_one);
+    boost::thread(::cast_to_rval(task));
+    BOOST_CHECK(next.get()==43);
+}
+
+void test_then_propagates_exception()
+{
+    boost::promise<int> pi;
+    boost::unique_future<int> fi=pi.get_future();
+    boost::unique_future<int> next=fi.then(add_one);
+    pi.set_exception(boost::copy_exception(my_exception()));
+    BOOST_CHECK(next.is_ready());
+    BOOST_CHECK(next.has_exception());
+    BOOST_CHECK_THROW(next.get(),my_exception);
+}
+
+void test_then_runs_on_broken_promise()
+{
+    boost::unique_future<int> next;
+    {
+        boost::promise<int> pi;
+        boost::unique_future<int> fi=pi.get_future();
+        next=fi.then(add_one);
+    }
+    BOOST_CHECK(next.is_ready());
+    BOOST_CHECK_THROW(next.get(),boost::broken_promise);
+}
+
+void test_then_on_uninitialized_future_throws()
+{
+    boost::unique_future<int> fi;
+    BOOST_CHECK_THROW(fi.then(add_one),boost::future_uninitialized);
+}
+
+void test_shared_future_then_leaves_future_valid()
+{
+    boost::promise<int> pi;
+    boost::shared_future<int> sf(pi.get_future());
+    boost::unique_future<int> first=sf.then(add_two_to_shared);
+    boost::unique_future<int> second=sf.then(add_two_to_shared);
+    pi.set_value(40);
+    BOOST_CHECK(sf.get()==40);
+    BOOST_CHECK(first.get()==42);
+    BOOST_CHECK(second.get()==42);
+}
+
+struct deferred_executor
+{
+    std::vector<boost::function<void()> > tasks;
+
+    template<typename F>
+    void submit(F f)
+    {
+        tasks.push_back(f);
+    }
+
+    void run_all()
+    {
+        for(unsigned i=0;i<tasks.size();++i)
+        {
+            tasks[i]();
+        }
+        tasks.clear();
+    }
+};
+
+void test_then_schedules_continuation_on_executor()
+{
+    deferred_executor executor;
+    boost::promise<int> pi;
+    boost::unique_future<int> fi=pi.get_future();
+    boost::unique_future<int> next=fi.then(executor,add_one);
+    BOOST_CHECK(executor.tasks.empty());
+    pi.set_value(41);
+    BOOST_CHECK(executor.tasks.size()==1);
+    BOOST_CHECK(!next.is_ready());
+    executor.run_all();
+    BOOST_CHECK(next.is_ready());
+    BOOST_CHECK(next.get()==42);
+}
+
+void test_when_all_is_ready_when_all_futures_are_ready()
+{
+    unsigned const count=5;
+    boost::promise<int> promises[count];
+    boost::unique_future<int> futures[count];
+    for(unsigned i=0;i<count;++i)
+    {
+        futures[i]=promises[i].get_future();
+    }
+    boost::unique_future<std::vector<boost::shared_future<int> > > all=boost::when_all(futures,futures+count);
+    BOOST_CHECK(futures[0].get_state()==boost::future_state::uninitialized);
+    for(unsigned i=count;i-->0;)
+    {
+        BOOST_CHECK(!all.is_ready());
+        promises[i].set_value(static_cast<int>(i));
+    }
+    BOOST_CHECK(all.is_ready());
+    std::vector<boost::shared_future<int> > results=all.get();
+    BOOST_CHECK(results.size()==count);
+    for(unsigned i=0;i<count;++i)
+    {
+        BOOST_CHECK(results[i].get()==static_cast<int>(i));
+    }
+}
+
+void test_when_all_of_empty_range_is_ready()
+{
+    std::vector<boost::shared_future<int> > futures;
+    boost::unique_future<std::vector<boost::shared_future<int> > > all=boost::when_all(futures.begin(),futures.end());
+    BOOST_CHECK(all.is_ready());
+    BOOST_CHECK(all.get().empty());
+}
+
+void test_when_any_reports_first_ready_future()
+{
+    unsigned const count=4;
+    boost::promise<int> promises[count];
+    std::vector<boost::shared_future<int> > futures;
+    for(unsigned i=0;i<count;++i)
+    {
+        futures.push_back(boost::shared_future<int>(promises[i].get_future()));
+    }
+    typedef boost::when_any_result<std::vector<boost::shared_future<int> > > result_type;
+    boost::unique_future<result_type> any=boost::when_any(futures.begin(),futures.end());
+    BOOST_CHECK(!any.is_ready());
+    promises[2].set_value(42);
+    BOOST_CHECK(any.is_ready());
+    promises[1].set_value(41);
+    result_type result=any.get();
+    BOOST_CHECK(result.index==2);
+    BOOST_CHECK(result.futures.size()==count);
+    BOOST_CHECK(result.futures[2].get()==42);
+    BOOST_CHECK(futures[0].get_state()==boost::future_state::waiting);
+}
+
+void test_when_any_does_not_keep_futures_alive_through_pending_ones()
+{
+    boost::promise<boost::shared_ptr<int> > pending;
+    boost::weak_ptr<int> value;
+    {
+        boost::promise<boost::shared_ptr<int> > ready;
+        std::vector<boost::shared_future<boost::shared_ptr<int> > > futures;
+        futures.push_back(boost::shared_future<boost::shared_ptr<int> >(pending.get_future()));
+        futures.push_back(boost::shared_future<boost::shared_ptr<int> >(ready.get_future()));
+        typedef boost::when_any_result<std::vector<boost::shared_future<boost::shared_ptr<int> > > > result_type;
+        boost::unique_future<result_type> any=boost::when_any(futures.begin(),futures.end());
+        boost::shared_ptr<int> const p(new int(42));
+        value=p;
+        ready.set_value(p);
+        BOOST_CHECK(any.get().index==1);
+    }
+    BOOST_CHECK(value.expired());
+}
+
+
 boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
 {
     boost::unit_test_framework::test_suite* test =
@@ -1215,6 +1408,18 @@ boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
     test->add(BOOST_TEST_CASE(test_wait_for_all_three_futures));
     test->add(BOOST_TEST_CASE(test_wait_for_all_four_futures));
     test->add(BOOST_TEST_CASE(test_wait_for_all_five_futures));
+    test->add(BOOST_TEST_CASE(test_then_on_ready_future_runs_immediately));
+    test->add(BOOST_TEST_CASE(test_then_runs_when_promise_is_fulfilled));
+    test->add(BOOST_TEST_CASE(test_then_runs_when_task_completes_on_another_thread));
+    test->add(BOOST_TEST_CASE(test_then_propagates_exception));
+    test->add(BOOST_TEST_CASE(test_then_runs_on_broken_promise));
+    test->add(BOOST_TEST_CASE(test_then_on_uninitialized_future_throws));
+    test->add(BOOST_TEST_CASE(test_shared_future_then_leaves_future_valid));
+    test->add(BOOST_TEST_CASE(test_then_schedules_continuation_on_executor));
+    test->add(BOOST_TEST_CASE(test_when_all_is_ready_when_all_futures_are_ready));
+    test->add(BOOST_TEST_CASE(test_when_all_of_empty_range_is_ready));
+    test->add(BOOST_TEST_CASE(test_when_any_reports_first_ready_future));
+    test->add(BOOST_TEST_CASE(test_when_any_does_not_keep_futures_alive_through_pending_ones));
 
     return test;
 }
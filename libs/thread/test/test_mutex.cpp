@@ -9,6 +9,7 @@
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/adaptive_mutex.hpp>
 #include <boost/thread/thread_time.hpp>
 #include <boost/thread/condition.hpp>
 
@@ -331,6 +332,20 @@ void test_recursive_timed_mutex()
     timed_test(&do_test_recursive_timed_mutex, 3);
 }
 
+void do_test_adaptive_mutex()
+{
+    test_lock<boost::adaptive_mutex>()();
+    test_trylock<boost::adaptive_mutex>()();
+#ifdef BOOST_THREAD_HAS_FUTEX
+    test_timedlock<boost::adaptive_mutex>()();
+#endif
+}
+
+void test_adaptive_mutex()
+{
+    timed_test(&do_test_adaptive_mutex, 3);
+}
+
 boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
 {
     boost::unit_test_framework::test_suite* test =
@@ -342,6 +357,7 @@ boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
     test->add(BOOST_TEST_CASE(&test_recursive_mutex));
     test->add(BOOST_TEST_CASE(&test_recursive_try_mutex));
     test->add(BOOST_TEST_CASE(&test_recursive_timed_mutex));
+    test->add(BOOST_TEST_CASE(&test_adaptive_mutex));
 
     return test;
 }
@@ -0,0 +1,268 @@
+//  (C) Copyright 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+
+#include <boost/thread/scalable_shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+    boost::posix_time::milliseconds const settle_time(200);
+
+    void hold_shared(boost::scalable_shared_mutex& m,boost::barrier& locked,boost::barrier& release)
+    {
+        boost::shared_lock<boost::scalable_shared_mutex> lk(m);
+        locked.wait();
+        release.wait();
+    }
+
+    void acquire_shared(boost::scalable_shared_mutex& m)
+    {
+        m.lock_shared();
+    }
+
+    struct checked_counter
+    {
+        boost::scalable_shared_mutex m;
+        unsigned value;
+        unsigned copy;
+        unsigned inconsistent;
+
+        explicit checked_counter(boost::scalable_shared_mutex::preference p):
+            m(p),value(0),copy(0),inconsistent(0)
+        {}
+    };
+
+    void read_and_write(checked_counter& c,unsigned iterations)
+    {
+        for(unsigned i=0;i<iterations;++i)
+        {
+            if(i%8==0)
+            {
+                boost::unique_lock<boost::scalable_shared_mutex> lk(c.m);
+                ++c.value;
+                ++c.copy;
+            }
+            else
+            {
+                boost::shared_lock<boost::scalable_shared_mutex> lk(c.m);
+                if(c.value!=c.copy)
+                {
+                    ++c.inconsistent;
+                }
+            }
+        }
+    }
+
+    void try_shared(boost::scalable_shared_mutex& m,bool& acquired)
+    {
+        acquired=m.try_lock_shared();
+        if(acquired)
+        {
+            m.unlock_shared();
+        }
+    }
+
+    void lock_exclusive(boost::scalable_shared_mutex& m,bool& locked)
+    {
+        boost::unique_lock<boost::scalable_shared_mutex> lk(m);
+        locked=true;
+    }
+}
+
+void test_readers_share_the_lock()
+{
+    unsigned const reader_count=8;
+    boost::scalable_shared_mutex m;
+    boost::barrier locked(reader_count+1);
+    boost::barrier release(reader_count+1);
+    boost::thread_group readers;
+    for(unsigned i=0;i<reader_count;++i)
+    {
+        readers.create_thread(boost::bind(hold_shared,boost::ref(m),boost::ref(locked),boost::ref(release)));
+    }
+    locked.wait();
+    BOOST_CHECK(!m.try_lock());
+    BOOST_CHECK(m.try_lock_shared());
+    m.unlock_shared();
+    release.wait();
+    readers.join_all();
+    BOOST_CHECK(m.try_lock());
+    m.unlock();
+}
+
+void test_writer_excludes_readers()
+{
+    boost::scalable_shared_mutex m;
+    m.lock();
+    bool acquired=true;
+    boost::thread t(boost::bind(try_shared,boost::ref(m),boost::ref(acquired)));
+    t.join();
+    BOOST_CHECK(!acquired);
+    BOOST_CHECK(!m.try_lock_upgrade());
+    m.unlock();
+    BOOST_CHECK(m.try_lock_shared());
+    m.unlock_shared();
+}
+
+void check_counter_is_consistent(boost::scalable_shared_mutex::preference p)
+{
+    unsigned const thread_count=4;
+    unsigned const iterations=20000;
+    checked_counter c(p);
+    boost::thread_group threads;
+    for(unsigned i=0;i<thread_count;++i)
+    {
+        threads.create_thread(boost::bind(read_and_write,boost::ref(c),iterations));
+    }
+    threads.join_all();
+    BOOST_CHECK_EQUAL(c.inconsistent,0U);
+    BOOST_CHECK_EQUAL(c.value,thread_count*iterations/8);
+}
+
+void test_counter_is_consistent_preferring_writers()
+{
+    check_counter_is_consistent(boost::scalable_shared_mutex::prefer_writers);
+}
+
+void test_counter_is_consistent_preferring_readers()
+{
+    check_counter_is_consistent(boost::scalable_shared_mutex::prefer_readers);
+}
+
+void test_timed_lock_times_out_while_read_locked()
+{
+    boost::scalable_shared_mutex m;
+    m.lock_shared();
+    BOOST_CHECK(!m.timed_lock(boost::posix_time::milliseconds(50)));
+    BOOST_CHECK(m.try_lock_shared());
+    m.unlock_shared();
+    m.unlock_shared();
+    BOOST_CHECK(m.timed_lock(boost::posix_time::milliseconds(50)));
+    BOOST_CHECK(!m.timed_lock_shared(boost::posix_time::milliseconds(50)));
+    m.unlock();
+}
+
+void test_upgrade_waits_for_readers()
+{
+    boost::scalable_shared_mutex m;
+    boost::upgrade_lock<boost::scalable_shared_mutex> upgrade(m);
+    BOOST_CHECK(!m.try_lock_upgrade());
+    BOOST_CHECK(!m.try_lock());
+
+    m.lock_shared();
+    bool locked=false;
+    boost::thread writer(boost::bind(lock_exclusive,boost::ref(m),boost::ref(locked)));
+    boost::this_thread::sleep(settle_time);
+    BOOST_CHECK(!locked);
+    m.unlock_shared();
+
+    {
+        boost::upgrade_to_unique_lock<boost::scalable_shared_mutex> unique(upgrade);
+        BOOST_CHECK(!m.try_lock_shared());
+    }
+    BOOST_CHECK(m.try_lock_shared());
+    m.unlock_shared();
+    upgrade.unlock();
+    writer.join();
+    BOOST_CHECK(locked);
+}
+
+void check_waiting_writer(boost::scalable_shared_mutex::preference p,bool readers_admitted)
+{
+    boost::scalable_shared_mutex m(p);
+    boost::barrier locked(2);
+    boost::barrier release(2);
+    boost::thread reader(boost::bind(hold_shared,boost::ref(m),boost::ref(locked),boost::ref(release)));
+    locked.wait();
+
+    bool writer_locked=false;
+    boost::thread writer(boost::bind(lock_exclusive,boost::ref(m),boost::ref(writer_locked)));
+    boost::this_thread::sleep(settle_time);
+
+    bool acquired=!readers_admitted;
+    boost::thread late_reader(boost::bind(try_shared,boost::ref(m),boost::ref(acquired)));
+    late_reader.join();
+    BOOST_CHECK_EQUAL(acquired,readers_admitted);
+
+    release.wait();
+    reader.join();
+    writer.join();
+    BOOST_CHECK(writer_locked);
+}
+
+void test_waiting_writer_blocks_new_readers()
+{
+    check_waiting_writer(boost::scalable_shared_mutex::prefer_writers,false);
+}
+
+void test_waiting_writer_admits_new_readers()
+{
+    check_waiting_writer(boost::scalable_shared_mutex::prefer_readers,true);
+}
+
+void test_downgrade_keeps_shared_ownership()
+{
+    boost::scalable_shared_mutex m;
+    m.lock();
+    m.unlock_and_lock_shared();
+    BOOST_CHECK(!m.try_lock());
+    BOOST_CHECK(m.try_lock_upgrade());
+    m.unlock_upgrade_and_lock_shared();
+    m.unlock_shared();
+    BOOST_CHECK(!m.try_lock());
+    m.unlock_shared();
+    BOOST_CHECK(m.try_lock());
+    m.unlock_and_lock_upgrade();
+    BOOST_CHECK(m.try_lock_shared());
+    m.unlock_shared();
+    m.unlock_upgrade();
+}
+
+void test_shared_lock_released_on_another_thread()
+{
+    // Several threads, so that some use a different reader slot to this one.
+    unsigned const reader_count=8;
+    boost::scalable_shared_mutex m;
+    for(unsigned i=0;i<reader_count;++i)
+    {
+        boost::thread reader(acquire_shared,boost::ref(m));
+        reader.join();
+    }
+    BOOST_CHECK(!m.try_lock());
+    for(unsigned i=0;i<reader_count;++i)
+    {
+        m.unlock_shared();
+    }
+    BOOST_CHECK(m.try_lock());
+    m.unlock();
+}
+
+boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
+{
+    boost::unit_test_framework::test_suite* test =
+        BOOST_TEST_SUITE("Boost.Threads: scalable_shared_mutex test suite");
+
+    test->add(BOOST_TEST_CASE(test_readers_share_the_lock));
+    test->add(BOOST_TEST_CASE(test_writer_excludes_readers));
+    test->add(BOOST_TEST_CASE(test_counter_is_consistent_preferring_writers));
+    test->add(BOOST_TEST_CASE(test_counter_is_consistent_preferring_readers));
+    test->add(BOOST_TEST_CASE(test_timed_lock_times_out_while_read_locked));
+    test->add(BOOST_TEST_CASE(test_upgrade_waits_for_readers));
+    test->add(BOOST_TEST_CASE(test_waiting_writer_blocks_new_readers));
+    test->add(BOOST_TEST_CASE(test_waiting_writer_admits_new_readers));
+    test->add(BOOST_TEST_CASE(test_downgrade_keeps_shared_ownership));
+    test->add(BOOST_TEST_CASE(test_shared_lock_released_on_another_thread));
+
+    return test;
+}
@@ -0,0 +1,271 @@
+//  (C) Copyright 2011 Anthony Williams
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/thread/detail/config.hpp>
+
+#include <boost/thread/thread_pool.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/bind.hpp>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+namespace
+{
+    int forty_two()
+    {
+        return 42;
+    }
+
+    int throw_runtime_error()
+    {
+        throw std::runtime_error("task failed");
+    }
+
+    boost::mutex count_mutex;
+    unsigned count=0;
+
+    void increment_count()
+    {
+        boost::lock_guard<boost::mutex> lk(count_mutex);
+        ++count;
+    }
+
+    struct fib_task
+    {
+        typedef unsigned long result_type;
+
+        boost::thread_pool* pool;
+        unsigned n;
+
+        fib_task(boost::thread_pool& pool_,unsigned n_):
+            pool(&pool_),n(n_)
+        {}
+
+        unsigned long operator()() const
+        {
+            if(n<2)
+            {
+                return n;
+            }
+            boost::unique_future<unsigned long> first=pool->submit(fib_task(*pool,n-1));
+            unsigned long const second=fib_task(*pool,n-2)();
+            while(!first.is_ready())
+            {
+                pool->run_pending_task();
+            }
+            return first.get()+second;
+        }
+    };
+}
+
+void test_default_pool_has_at_least_one_thread()
+{
+    boost::thread_pool pool;
+    BOOST_CHECK(pool.size()>=1);
+    BOOST_CHECK(pool.size()==boost::thread::hardware_concurrency() || boost::thread::hardware_concurrency()==0);
+}
+
+void test_submit_returns_result()
+{
+    boost::thread_pool pool(2);
+    BOOST_CHECK_EQUAL(pool.size(),2U);
+    boost::unique_future<int> f=pool.submit(forty_two);
+    BOOST_CHECK_EQUAL(f.get(),42);
+}
+
+void test_submit_void_task()
+{
+    count=0;
+    boost::thread_pool pool(2);
+    boost::unique_future<void> f=pool.submit(increment_count);
+    f.wait();
+    BOOST_CHECK(f.has_value());
+    BOOST_CHECK_EQUAL(count,1U);
+}
+
+void test_exception_is_stored_in_future()
+{
+    boost::thread_pool pool(2);
+    boost::unique_future<int> f=pool.submit(throw_runtime_error);
+    f.wait();
+    BOOST_CHECK(f.has_exception());
+    BOOST_CHECK_THROW(f.get(),std::runtime_error);
+}
+
+void test_destructor_runs_pending_tasks()
+{
+    unsigned const task_count=10000;
+    count=0;
+    {
+        boost::thread_pool pool(4);
+        for(unsigned i=0;i<task_count;++i)
+        {
+            pool.submit(increment_count);
+        }
+    }
+    BOOST_CHECK_EQUAL(count,task_count);
+}
+
+void test_nested_tasks_are_stolen()
+{
+    boost::thread_pool pool(4);
+    boost::unique_future<unsigned long> f=pool.submit(fib_task(pool,22));
+    BOOST_CHECK_EQUAL(f.get(),17711UL);
+}
+
+void test_run_pending_task_from_outside_pool()
+{
+    boost::thread_pool pool(1);
+    boost::unique_future<unsigned long> f=pool.submit(fib_task(pool,15));
+    while(!f.is_ready())
+    {
+        pool.run_pending_task();
+    }
+    BOOST_CHECK_EQUAL(f.get(),610UL);
+}
+
+namespace
+{
+    boost::thread::id continuation_thread;
+
+    int record_thread_and_add_one(boost::unique_future<int>& f)
+    {
+        continuation_thread=boost::this_thread::get_id();
+        return f.get()+1;
+    }
+}
+
+void test_continuation_runs_on_pool()
+{
+    boost::thread_pool pool(1);
+    boost::promise<int> pi;
+    boost::unique_future<int> fi=pi.get_future();
+    boost::unique_future<int> next=fi.then(pool,record_thread_and_add_one);
+    pi.set_value(41);
+    BOOST_CHECK_EQUAL(next.get(),42);
+    BOOST_CHECK(continuation_thread!=boost::this_thread::get_id());
+    BOOST_CHECK(continuation_thread!=boost::thread::id());
+}
+
+void test_deque_order_and_growth()
+{
+    boost::detail::work_stealing_deque<int> deque;
+    std::vector<int> values(100);
+    BOOST_CHECK(deque.empty());
+    BOOST_CHECK(!deque.pop());
+    BOOST_CHECK(!deque.steal());
+    for(unsigned i=0;i<values.size();++i)
+    {
+        deque.push(&values[i]);
+    }
+    BOOST_CHECK(!deque.empty());
+    BOOST_CHECK_EQUAL(deque.steal(),&values[0]);
+    BOOST_CHECK_EQUAL(deque.pop(),&values[99]);
+    for(unsigned i=1;i<99;++i)
+    {
+        BOOST_CHECK_EQUAL(deque.steal(),&values[i]);
+    }
+    BOOST_CHECK(deque.empty());
+    BOOST_CHECK(!deque.pop());
+}
+
+namespace
+{
+    unsigned const item_count=100000;
+    std::vector<int> claimed(item_count);
+    bool volatile done=false;
+
+    void claim(std::vector<int>& items,int* item)
+    {
+        items.push_back(static_cast<int>(item-&claimed[0]));
+    }
+
+    void thief(boost::detail::work_stealing_deque<int>* deque,std::vector<int>* stolen)
+    {
+        while(!done || !deque->empty())
+        {
+            if(int* const item=deque->steal())
+            {
+                claim(*stolen,item);
+            }
+        }
+    }
+}
+
+void test_deque_items_are_claimed_once()
+{
+    boost::detail::work_stealing_deque<int> deque;
+    std::vector<int> popped;
+    std::vector<int> stolen[3];
+    done=false;
+
+    boost::thread_group thieves;
+    for(unsigned i=0;i<3;++i)
+    {
+        thieves.create_thread(boost::bind(thief,&deque,&stolen[i]));
+    }
+    for(unsigned i=0;i<item_count;++i)
+    {
+        deque.push(&claimed[i]);
+        if(i%3==0)
+        {
+            if(int* const item=deque.pop())
+            {
+                claim(popped,item);
+            }
+        }
+    }
+    while(int* const item=deque.pop())
+    {
+        claim(popped,item);
+    }
+    done=true;
+    thieves.join_all();
+
+    std::vector<int> times_claimed(item_count);
+    for(unsigned i=0;i<popped.size();++i)
+    {
+        ++times_claimed[popped[i]];
+    }
+    for(unsigned t=0;t<3;++t)
+    {
+        for(unsigned i=0;i<stolen[t].size();++i)
+        {
+            ++times_claimed[stolen[t][i]];
+        }
+    }
+    unsigned wrong=0;
+    for(unsigned i=0;i<item_count;++i)
+    {
+        if(times_claimed[i]!=1)
+        {
+            ++wrong;
+        }
+    }
+    BOOST_CHECK_EQUAL(wrong,0U);
+}
+
+boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
+{
+    boost::unit_test_framework::test_suite* test =
+        BOOST_TEST_SUITE("Boost.Threads: thread pool test suite");
+
+    test->add(BOOST_TEST_CASE(test_default_pool_has_at_least_one_thread));
+    test->add(BOOST_TEST_CASE(test_submit_returns_result));
+    test->add(BOOST_TEST_CASE(test_submit_void_task));
+    test->add(BOOST_TEST_CASE(test_exception_is_stored_in_future));
+    test->add(BOOST_TEST_CASE(test_destructor_runs_pending_tasks));
+    test->add(BOOST_TEST_CASE(test_nested_tasks_are_stolen));
+    test->add(BOOST_TEST_CASE(test_run_pending_task_from_outside_pool));
+    test->add(BOOST_TEST_CASE(test_continuation_runs_on_pool));
+    test->add(BOOST_TEST_CASE(test_deque_order_and_growth));
+    test->add(BOOST_TEST_CASE(test_deque_items_are_claimed_once));
+
+    return test;
+}
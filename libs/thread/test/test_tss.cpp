@@ -10,6 +10,8 @@
 #include <boost/thread/tss.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/scoped_array.hpp>
 
 #include <boost/test/unit_test.hpp>
 
@@ -342,6 +344,63 @@ void test_tss_cleanup_not_called_for_null_pointer()
 }
 
 
+unsigned counted_cleanups=0;
+
+void tss_counted_cleanup(int* p)
+{
+    ++counted_cleanups;
+    delete p;
+}
+
+void thread_sets_value_then_checks_new_ptr(boost::thread_specific_ptr<int>* const* current,
+                                           boost::barrier* value_set,boost::barrier* ptr_replaced)
+{
+    (*current)->reset(new int(1));
+    value_set->wait();
+    ptr_replaced->wait();
+    // The new thread_specific_ptr may have been given the same slot.
+    BOOST_CHECK(!(*current)->get());
+    (*current)->reset(new int(2));
+}
+
+void test_tss_value_of_destroyed_ptr_not_seen_by_new_ptr()
+{
+    counted_cleanups=0;
+    boost::thread_specific_ptr<int>* current=new boost::thread_specific_ptr<int>(tss_counted_cleanup);
+    boost::barrier value_set(2);
+    boost::barrier ptr_replaced(2);
+    boost::thread t(thread_sets_value_then_checks_new_ptr,&current,&value_set,&ptr_replaced);
+    value_set.wait();
+    delete current;
+    current=new boost::thread_specific_ptr<int>(tss_counted_cleanup);
+    ptr_replaced.wait();
+    t.join();
+    // Both values are cleaned up when the thread exits.
+    BOOST_CHECK_EQUAL(counted_cleanups,2u);
+    delete current;
+}
+
+void test_tss_many_ptrs()
+{
+    unsigned const count=100;
+    counted_cleanups=0;
+    {
+        boost::scoped_array<boost::thread_specific_ptr<int> > ptrs(new boost::thread_specific_ptr<int>[count]);
+        for(unsigned i=0;i<count;++i)
+        {
+            BOOST_CHECK(!ptrs[i].get());
+            ptrs[i].reset(new int(i));
+        }
+        for(unsigned i=0;i<count;++i)
+        {
+            BOOST_CHECK_EQUAL(*ptrs[i],int(i));
+        }
+        boost::thread_specific_ptr<int> counted(tss_counted_cleanup);
+        counted.reset(new int(0));
+        BOOST_CHECK_EQUAL(*counted,0);
+    }
+    BOOST_CHECK_EQUAL(counted_cleanups,1u);
+}
 
 boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
 {
@@ -354,6 +413,8 @@ boost::unit_test_framework::test_suite* init_unit_test_suite(int, char*[])
     test->add(BOOST_TEST_CASE(test_tss_does_no_cleanup_with_null_cleanup_function));
     test->add(BOOST_TEST_CASE(test_tss_does_not_call_cleanup_after_ptr_destroyed));
     test->add(BOOST_TEST_CASE(test_tss_cleanup_not_called_for_null_pointer));
+    test->add(BOOST_TEST_CASE(test_tss_value_of_destroyed_ptr_not_seen_by_new_ptr));
+    test->add(BOOST_TEST_CASE(test_tss_many_ptrs));
 
     return test;
 }
@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+// static_codegen.cpp
+//
+//  Copyright 2011 Eric Niebler. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Compares the same patterns written as static xpressive regexes, as dynamic
+//  xpressive regexes and as boost::regex, searching a synthetic log file and
+//  matching short strings. The patterns are those that static regexes compile
+//  to specialized code for: fixed repeats of single characters, runs of
+//  character tests and leading literals.
+//
+//  Usage: static_codegen [megabytes]
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <iostream>
+#include <boost/timer.hpp>
+#include <boost/regex.hpp>
+#include <boost/xpressive/xpressive.hpp>
+
+using namespace boost::xpressive;
+
+namespace
+{
+    ///////////////////////////////////////////////////////////////////////////////
+    // make_log
+    //   lines of a web server log, one in 64 of them an error
+    std::string make_log(std::size_t size)
+    {
+        static char const *const paths[] = {"/index.html", "/img/logo.png", "/api/v2/users", "/search?q=xpressive"};
+        std::string text;
+        char buf[256];
+        unsigned seed = 1;
+        for(unsigned line = 0; text.size() < size; ++line)
+        {
+            seed = seed * 1103515245u + 12345u;
+            unsigned r = (seed >> 16) & 0x7fff;
+            std::sprintf(buf, "2011-%02u-%02u %02u:%02u:%02u 10.0.%u.%u GET %s %u %u\n"
+              , 1 + r % 12, 1 + r % 28, r % 24, r % 60, (r / 60) % 60
+              , r % 256, (r / 7) % 256, paths[r % 4], (0 == line % 64) ? 500u : 200u, r);
+            text += buf;
+        }
+        return text;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // time_it
+    //   how many megabytes a second fun gets through, if each call to it
+    //   handles the given number of bytes
+    template<typename Fun>
+    double time_it(Fun const &fun, std::size_t bytes, std::size_t &count)
+    {
+        boost::timer t;
+        unsigned iter = 0;
+        do
+        {
+            count = fun();
+            ++iter;
+        }
+        while(t.elapsed() < 0.5);
+        return (double(bytes) * iter / (1024 * 1024)) / t.elapsed();
+    }
+
+    template<typename Regex>
+    struct xpr_search
+    {
+        std::string const &text_;
+        Regex const &rx_;
+        xpr_search(std::string const &text, Regex const &rx) : text_(text), rx_(rx) {}
+        std::size_t operator()() const
+        {
+            std::size_t count = 0;
+            sregex_iterator cur(text_.begin(), text_.end(), rx_), end;
+            for(; cur != end; ++cur)
+                ++count;
+            return count;
+        }
+    };
+
+    struct boost_search
+    {
+        std::string const &text_;
+        boost::regex const &rx_;
+        boost_search(std::string const &text, boost::regex const &rx) : text_(text), rx_(rx) {}
+        std::size_t operator()() const
+        {
+            std::size_t count = 0;
+            boost::sregex_iterator cur(text_.begin(), text_.end(), rx_), end;
+            for(; cur != end; ++cur)
+                ++count;
+            return count;
+        }
+    };
+
+    void compare_search(char const *pattern, sregex const &static_rx, std::string const &text)
+    {
+        sregex dynamic_rx = sregex::compile(pattern);
+        boost::regex boost_rx(pattern);
+        std::size_t n1 = 0, n2 = 0, n3 = 0;
+        double t1 = time_it(xpr_search<sregex>(text, static_rx), text.size(), n1);
+        double t2 = time_it(xpr_search<sregex>(text, dynamic_rx), text.size(), n2);
+        double t3 = time_it(boost_search(text, boost_rx), text.size(), n3);
+        std::cout << pattern << "  (" << n1 << " matches)\n"
+                  << "   static " << t1 << " MB/s   dynamic " << t2 << " MB/s   boost::regex " << t3 << " MB/s\n";
+        if(n1 != n2 || n1 != n3)
+            std::cout << "   *** match counts differ: " << n1 << " " << n2 << " " << n3 << "\n";
+    }
+
+    template<typename Regex>
+    struct xpr_match
+    {
+        std::string const &text_;
+        Regex const &rx_;
+        xpr_match(std::string const &text, Regex const &rx) : text_(text), rx_(rx) {}
+        std::size_t operator()() const
+        {
+            std::size_t count = 0;
+            smatch what;
+            for(int i = 0; i < 100000; ++i)
+                count += regex_match(text_, what, rx_);
+            return count;
+        }
+    };
+
+    struct boost_match
+    {
+        std::string const &text_;
+        boost::regex const &rx_;
+        boost_match(std::string const &text, boost::regex const &rx) : text_(text), rx_(rx) {}
+        std::size_t operator()() const
+        {
+            std::size_t count = 0;
+            boost::smatch what;
+            for(int i = 0; i < 100000; ++i)
+                count += boost::regex_match(text_, what, rx_);
+            return count;
+        }
+    };
+
+    void compare_match(char const *pattern, sregex const &static_rx, std::string const &text)
+    {
+        sregex dynamic_rx = sregex::compile(pattern);
+        boost::regex boost_rx(pattern);
+        std::size_t n1 = 0, n2 = 0, n3 = 0;
+        // count each of the 100000 matches a call makes as a "byte", and
+        // report millions of them a second rather than megabytes:
+        double scale = 1024. * 1024. / 1000000.;
+        double t1 = time_it(xpr_match<sregex>(text, static_rx), 100000, n1) * scale;
+        double t2 = time_it(xpr_match<sregex>(text, dynamic_rx), 100000, n2) * scale;
+        double t3 = time_it(boost_match(text, boost_rx), 100000, n3) * scale;
+        std::cout << pattern << "  against \"" << text << "\"\n"
+                  << "   static " << t1 << " M/s   dynamic " << t2 << " M/s   boost::regex " << t3 << " M/s\n";
+        if(!n1 || !n2 || !n3)
+            std::cout << "   *** no match\n";
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t megabytes = (argc > 1) ? std::atoi(argv[1]) : 16;
+    std::string text = make_log(megabytes * 1024 * 1024);
+
+    std::cout << "Searching " << megabytes << "MB of log lines:\n";
+    compare_search("\\d{4}-\\d{2}-\\d{2}"
+      , repeat<4>(_d) >> '-' >> repeat<2>(_d) >> '-' >> repeat<2>(_d), text);
+    compare_search("\\d\\d:\\d\\d:\\d\\d"
+      , _d >> _d >> ':' >> _d >> _d >> ':' >> _d >> _d, text);
+    compare_search("GET /api/\\w+/\\w+"
+      , "GET /api/" >> +_w >> '/' >> +_w, text);
+    compare_search(" 500 \\d+"
+      , " 500 " >> +_d, text);
+    compare_search("10\\.0\\.\\d{1,3}\\.\\d{1,3}"
+      , "10.0." >> repeat<1,3>(_d) >> '.' >> repeat<1,3>(_d), text);
+
+    std::cout << "\nMatching whole strings, millions of matches a second:\n";
+    compare_match("\\d{3}-\\d{3}-\\d{4}"
+      , repeat<3>(_d) >> '-' >> repeat<3>(_d) >> '-' >> repeat<4>(_d), "555-123-4567");
+    compare_match("#[[:xdigit:]]{6}"
+      , '#' >> repeat<6>(xdigit), "#c0ffee");
+    compare_match("[A-Z]{2}\\d{2} [A-Z]{4} \\d{4}"
+      , repeat<2>(range('A', 'Z')) >> repeat<2>(_d) >> ' ' >> repeat<4>(range('A', 'Z')) >> ' ' >> repeat<4>(_d)
+      , "GB29 NWBK 6016");
+    return 0;
+}
@@ -234,6 +234,42 @@ void test6()
     BOOST_CHECK("9*(10+3)" == what[0]);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// test for fixed repeats and for leading literals found in char arrays
+//
+void test7()
+{
+    sregex date = repeat<4>(_d) >> '-' >> repeat<2>(_d) >> '-' >> repeat<2>(_d);
+    std::string str("on 201-06-21, 2011-6-21 and 2011-06-21");
+    smatch what;
+
+    BOOST_REQUIRE(regex_search(str, what, date));
+    BOOST_CHECK("2011-06-21" == what[0]);
+    BOOST_CHECK(!regex_match(std::string("2011-06-2"), date));
+    BOOST_CHECK(!regex_match(std::string("2011-06-211"), date));
+
+    // what follows a fixed repeat can still backtrack
+    sregex digits = repeat<2>(_d) >> *_d >> _d >> 'x';
+    BOOST_REQUIRE(regex_match(std::string("12345x"), what, digits));
+    BOOST_CHECK(!regex_match(std::string("12x"), digits));
+
+    // many repeats are looped over rather than unrolled
+    sregex hex = '#' >> repeat<12>(xdigit);
+    BOOST_CHECK(regex_match(std::string("#0123456789ab"), hex));
+    BOOST_CHECK(!regex_match(std::string("#0123456789a"), hex));
+
+    sregex lit = "needle" >> +_d;
+    BOOST_REQUIRE(regex_search(std::string("needl needle needle7"), what, lit));
+    BOOST_CHECK(13 == what.position());
+    BOOST_CHECK(!regex_search(std::string("a needl"), lit));
+    BOOST_CHECK(!regex_search(std::string("needle"), lit));
+
+    cregex clit = as_xpr("needle") >> +_d;
+    cmatch cwhat;
+    BOOST_REQUIRE(regex_search("nneedle42", cwhat, clit));
+    BOOST_CHECK("needle42" == cwhat[0]);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // init_unit_test_suite
 //
@@ -247,6 +283,7 @@ test_suite* init_unit_test_suite( int argc, char* argv[] )
     test->add(BOOST_TEST_CASE(&test4));
     test->add(BOOST_TEST_CASE(&test5));
     test->add(BOOST_TEST_CASE(&test6));
+    test->add(BOOST_TEST_CASE(&test7));
 
     return test;
 }